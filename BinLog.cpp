@@ -0,0 +1,461 @@
+//============================================================================
+// Name        : BinLog.cpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : BinLog source file. It contains the definition of the
+//               functions of the BinLog class and its background thread.
+//============================================================================
+#include "BinLog.hpp"
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <map>
+
+
+std::atomic<BinLogLevel> BinLog::minLevel_{BINLOG_OFF};
+BinLogLevel              BinLog::level_ = BINLOG_INFO;
+
+// all rings ever created, a thread takes a free ring or registers a new one
+static std::mutex                binLogMutex;
+static std::vector<BinLogRing*>  binLogRings;
+static std::vector<BinLogFormat> binLogFormats;
+
+// hands the ring back when the thread ends
+struct BinLogOwner {
+	BinLogRing *ring = nullptr;
+	~BinLogOwner(){
+		if(ring != nullptr){
+			ring->release();
+		}
+	}
+};
+static thread_local BinLogOwner  binLogLocal;
+
+// background thread and its sink
+static std::mutex                binLogSinkMutex;
+static std::condition_variable   binLogWake;
+static std::condition_variable   binLogDrained;
+static std::thread               binLogThread;
+static bool                      binLogRunning = false;
+static unsigned long             binLogCycles = 0;
+static unsigned                  binLogPollMs = 2;
+static std::ostream             *binLogText = nullptr;
+static std::ofstream             binLogFile;
+static size_t                    binLogFormatsWritten = 0;
+static std::atomic<unsigned long> binLogWritten{0};
+
+
+uint64_t BinLog::nowNs(){
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+BinLogRing* BinLog::local(){
+	if(binLogLocal.ring == nullptr){
+		std::lock_guard<std::mutex> lock(binLogMutex);
+		for(size_t i = 0; (i < binLogRings.size()) && (binLogLocal.ring == nullptr); i++){
+			if(binLogRings[i]->reuse()){
+				binLogLocal.ring = binLogRings[i];
+			}
+		}
+		if(binLogLocal.ring == nullptr){
+			binLogLocal.ring = new BinLogRing(binLogRings.size() + 1);
+			binLogRings.push_back(binLogLocal.ring);
+		}
+	}
+	return binLogLocal.ring;
+}
+
+uint32_t BinLog::registerFormat(BinLogLevel level, const char *file, unsigned line, const char *format){
+	std::lock_guard<std::mutex> lock(binLogMutex);
+	BinLogFormat f = {level, file, line, format};
+	binLogFormats.push_back(f);
+	return binLogFormats.size() - 1;
+}
+
+void BinLog::setLevel(BinLogLevel level){
+	std::lock_guard<std::mutex> lock(binLogSinkMutex);
+	level_ = level;
+	if(binLogRunning){
+		minLevel_.store(level, std::memory_order_relaxed);
+	}
+}
+
+const char* BinLog::levelName(BinLogLevel level){
+	static const char *names[] = {"DEBUG", "INFO", "WARN", "ERROR", "OFF"};
+	return ((unsigned) level <= BINLOG_OFF) ? names[level] : "?";
+}
+
+void BinLog::setPollMs(unsigned ms){
+	std::lock_guard<std::mutex> lock(binLogSinkMutex);
+	binLogPollMs = (ms == 0) ? 1 : ms;
+}
+
+unsigned long BinLog::getDropped(){
+	std::lock_guard<std::mutex> lock(binLogMutex);
+	unsigned long n = 0;
+	for(size_t i = 0; i < binLogRings.size(); i++){
+		n += binLogRings[i]->getDropped();
+	}
+	return n;
+}
+
+unsigned BinLog::getRings(){
+	std::lock_guard<std::mutex> lock(binLogMutex);
+	return binLogRings.size();
+}
+
+unsigned long BinLog::getWritten(){
+	return binLogWritten.load(std::memory_order_relaxed);
+}
+
+
+
+vector<BinLogArg> BinLog::decode(const BinLogRecord &r){
+	vector<BinLogArg> args;
+	unsigned pos = 0;
+	for(unsigned i = 0; i < r.nargs; i++){
+		BinLogArg a;
+		a.type = r.types[i];
+		switch(a.type){
+		case BINLOG_T_INT:
+			memcpy(&a.i, r.payload + pos, 8);
+			pos += 8;
+			break;
+		case BINLOG_T_UINT:
+			memcpy(&a.u, r.payload + pos, 8);
+			pos += 8;
+			break;
+		case BINLOG_T_DOUBLE:
+			memcpy(&a.d, r.payload + pos, 8);
+			pos += 8;
+			break;
+		case BINLOG_T_CHAR:
+		case BINLOG_T_BOOL:
+			a.u = r.payload[pos];
+			pos += 1;
+			break;
+		case BINLOG_T_STATIC:{
+			const char *p;
+			memcpy(&p, r.payload + pos, 8);
+			a.s = (p != nullptr) ? p : "(null)";
+			a.type = BINLOG_T_STRING;
+			pos += 8;
+			break;
+		}
+		case BINLOG_T_STRING:
+			a.s = string((const char*) r.payload + pos + 1, r.payload[pos]);
+			pos += 1 + r.payload[pos];
+			break;
+		}
+		args.push_back(a);
+	}
+	return args;
+}
+
+string BinLog::format(const char *format, const vector<BinLogArg> &args){
+	stringstream ss;
+	size_t next = 0;
+	for(const char *p = format; *p != 0; p++){
+		if((p[0] == '{') && (p[1] == '}')){
+			p++;
+			if(next >= args.size()){
+				ss << "{?}";
+				continue;
+			}
+			const BinLogArg &a = args[next++];
+			switch(a.type){
+			case BINLOG_T_INT:    ss << a.i; break;
+			case BINLOG_T_UINT:   ss << a.u; break;
+			case BINLOG_T_DOUBLE: ss << a.d; break;
+			case BINLOG_T_CHAR:   ss << (char) a.u; break;
+			case BINLOG_T_BOOL:   ss << (a.u ? "true" : "false"); break;
+			default:              ss << a.s; break;
+			}
+		}else{
+			ss << *p;
+		}
+	}
+	return ss.str();
+}
+
+string BinLog::line(uint64_t tsNs, unsigned tid, BinLogLevel level, const char *file, unsigned line,
+					const string &message){
+	const char *base = strrchr(file, '/');
+	stringstream ss;
+	ss << fixed << setprecision(6) << (tsNs / 1.0e9) << " " << setw(5) << left << levelName(level)
+	   << right << " T" << tid << " " << ((base != nullptr) ? base + 1 : file) << ":" << line << " " << message;
+	return ss.str();
+}
+
+
+
+/*
+ * Binary log file: the magic, then entries of
+ *  'F' u32 id, u8 level, u32 line, u16 length, file, u16 length, format
+ *  'R' u64 time ns, u32 format id, u32 thread, u8 number of arguments,
+ *      per argument u8 type and 8 bytes (i, u, d), 1 byte (c, b) or
+ *      u16 length and the characters (s, literals are resolved)
+ *  'D' u64 records dropped, written when the log is stopped
+ * in the byte order of the host.
+ */
+template<typename T>
+static void put(ostream &out, T v){
+	out.write((const char*) &v, sizeof(T));
+}
+
+static void putString(ostream &out, const string &s){
+	put<uint16_t>(out, (uint16_t) s.size());
+	out.write(s.data(), s.size());
+}
+
+static void writeRecord(ostream &out, const BinLogRecord &r, unsigned tid){
+	vector<BinLogArg> args = BinLog::decode(r);
+	put<char>(out, 'R');
+	put<uint64_t>(out, r.tsNs);
+	put<uint32_t>(out, r.formatId);
+	put<uint32_t>(out, tid);
+	put<uint8_t>(out, (uint8_t) args.size());
+	for(size_t i = 0; i < args.size(); i++){
+		put<char>(out, args[i].type);
+		switch(args[i].type){
+		case BINLOG_T_INT:    put<int64_t>(out, args[i].i); break;
+		case BINLOG_T_UINT:   put<uint64_t>(out, args[i].u); break;
+		case BINLOG_T_DOUBLE: put<double>(out, args[i].d); break;
+		case BINLOG_T_CHAR:
+		case BINLOG_T_BOOL:   put<uint8_t>(out, (uint8_t) args[i].u); break;
+		default:              putString(out, args[i].s); break;
+		}
+	}
+}
+
+struct BinLogTaken {
+	BinLogRecord record;
+	unsigned     tid;
+};
+
+/*
+ * Takes the records of all rings, orders them by time and passes them
+ * to the sink. Returns the number of records.
+ */
+static size_t binLogDrain(){
+	vector<BinLogRing*> rings;
+	vector<BinLogFormat> formats;
+	{
+		std::lock_guard<std::mutex> lock(binLogMutex);
+		rings = binLogRings;
+		formats = binLogFormats;
+	}
+
+	vector<BinLogTaken> taken;
+	BinLogTaken t;
+	for(size_t i = 0; i < rings.size(); i++){
+		t.tid = rings[i]->getTid();
+		while(rings[i]->pop(t.record)){
+			taken.push_back(t);
+		}
+	}
+	std::stable_sort(taken.begin(), taken.end(), [](const BinLogTaken &a, const BinLogTaken &b){
+		return a.record.tsNs < b.record.tsNs;
+	});
+
+	if(binLogText != nullptr){
+		for(size_t i = 0; i < taken.size(); i++){
+			const BinLogRecord &r = taken[i].record;
+			const BinLogFormat &f = formats[r.formatId];
+			*binLogText << BinLog::line(r.tsNs, taken[i].tid, f.level, f.file, f.line,
+										BinLog::format(f.format, BinLog::decode(r))) << "\n";
+		}
+		if(!taken.empty()){
+			binLogText->flush();
+		}
+	}else if(binLogFile.is_open()){
+		for(; binLogFormatsWritten < formats.size(); binLogFormatsWritten++){
+			const BinLogFormat &f = formats[binLogFormatsWritten];
+			put<char>(binLogFile, 'F');
+			put<uint32_t>(binLogFile, (uint32_t) binLogFormatsWritten);
+			put<uint8_t>(binLogFile, (uint8_t) f.level);
+			put<uint32_t>(binLogFile, f.line);
+			putString(binLogFile, f.file);
+			putString(binLogFile, f.format);
+		}
+		for(size_t i = 0; i < taken.size(); i++){
+			writeRecord(binLogFile, taken[i].record, taken[i].tid);
+		}
+		if(!taken.empty()){
+			binLogFile.flush();
+		}
+	}
+	binLogWritten.fetch_add(taken.size(), std::memory_order_relaxed);
+	return taken.size();
+}
+
+static void binLogRun(){
+	std::unique_lock<std::mutex> lock(binLogSinkMutex);
+	while(true){
+		bool running = binLogRunning;
+		lock.unlock();
+		binLogDrain();
+		lock.lock();
+		binLogCycles++;
+		binLogDrained.notify_all();
+		if(!running){
+			return;
+		}
+		binLogWake.wait_for(lock, std::chrono::milliseconds(binLogPollMs));
+	}
+}
+
+static void binLogStart(){
+	binLogRunning = true;
+	binLogFormatsWritten = 0;
+	binLogThread = std::thread(binLogRun);
+}
+
+void BinLog::startText(ostream &out){
+	stop();
+	std::lock_guard<std::mutex> lock(binLogSinkMutex);
+	binLogText = &out;
+	binLogStart();
+	minLevel_.store(level_, std::memory_order_relaxed);
+}
+
+void BinLog::startFile(const string &filename){
+	stop();
+	std::lock_guard<std::mutex> lock(binLogSinkMutex);
+	binLogFile.open(filename.c_str(), std::ios::binary | std::ios::trunc);
+	if(!binLogFile.is_open()){
+		throw new ExceptionBinLog(string("startFile:: cannot write ") + filename);
+	}
+	binLogFile.write(BINLOG_FILE_MAGIC, strlen(BINLOG_FILE_MAGIC));
+	binLogStart();
+	minLevel_.store(level_, std::memory_order_relaxed);
+}
+
+void BinLog::stop(){
+	std::unique_lock<std::mutex> lock(binLogSinkMutex);
+	if(!binLogRunning){
+		return;
+	}
+	minLevel_.store(BINLOG_OFF, std::memory_order_relaxed);
+	binLogRunning = false;
+	binLogWake.notify_all();
+	lock.unlock();
+	binLogThread.join(); // the last cycle takes the remaining records
+	lock.lock();
+	if(binLogFile.is_open()){
+		put<char>(binLogFile, 'D');
+		put<uint64_t>(binLogFile, getDropped());
+		binLogFile.close();
+	}
+	binLogText = nullptr;
+}
+
+void BinLog::flush(){
+	std::unique_lock<std::mutex> lock(binLogSinkMutex);
+	if(!binLogRunning){
+		return;
+	}
+	// a complete cycle has to start after this call
+	unsigned long target = binLogCycles + 2;
+	binLogWake.notify_all();
+	binLogDrained.wait(lock, [target](){return (binLogCycles >= target) || !binLogRunning;});
+}
+
+
+
+template<typename T>
+static bool get(istream &in, T &v){
+	return (bool) in.read((char*) &v, sizeof(T));
+}
+
+static bool getString(istream &in, string &s){
+	uint16_t n;
+	if(!get(in, n)){
+		return false;
+	}
+	s.resize(n);
+	return (n == 0) || (bool) in.read(&s[0], n);
+}
+
+static bool getArg(istream &in, BinLogArg &a){
+	if(!get(in, a.type)){
+		return false;
+	}
+	switch(a.type){
+	case BINLOG_T_INT:    return get(in, a.i);
+	case BINLOG_T_UINT:   return get(in, a.u);
+	case BINLOG_T_DOUBLE: return get(in, a.d);
+	case BINLOG_T_CHAR:
+	case BINLOG_T_BOOL:{
+		uint8_t b;
+		bool ok = get(in, b);
+		a.u = b;
+		return ok;
+	}
+	case BINLOG_T_STRING: return getString(in, a.s);
+	}
+	return false;
+}
+
+struct BinLogFileFormat {
+	BinLogLevel level;
+	unsigned    line;
+	string      file;
+	string      format;
+};
+
+unsigned long BinLog::decodeFile(istream &in, ostream &out, BinLogLevel minLevel){
+	char magic[8];
+	if(!in.read(magic, 8) || (memcmp(magic, BINLOG_FILE_MAGIC, 8) != 0)){
+		throw new ExceptionBinLog(string("decodeFile:: not a binary log file."));
+	}
+
+	map<uint32_t, BinLogFileFormat> formats;
+	unsigned long records = 0;
+	char kind;
+	while(get(in, kind)){
+		bool ok = false;
+		if(kind == 'F'){
+			uint32_t id;
+			uint8_t level;
+			BinLogFileFormat f;
+			ok = get(in, id) && get(in, level) && get(in, f.line) && getString(in, f.file) && getString(in, f.format);
+			f.level = (BinLogLevel) level;
+			formats[id] = f;
+		}else if(kind == 'R'){
+			uint64_t ts;
+			uint32_t id, tid;
+			uint8_t n;
+			ok = get(in, ts) && get(in, id) && get(in, tid) && get(in, n);
+			vector<BinLogArg> args(ok ? n : 0);
+			for(size_t i = 0; ok && (i < args.size()); i++){
+				ok = getArg(in, args[i]);
+			}
+			map<uint32_t, BinLogFileFormat>::iterator f = formats.find(id);
+			ok = ok && (f != formats.end());
+			if(ok){
+				records++;
+				if(f->second.level >= minLevel){
+					out << line(ts, tid, f->second.level, f->second.file.c_str(), f->second.line,
+								format(f->second.format.c_str(), args)) << "\n";
+				}
+			}
+		}else if(kind == 'D'){
+			uint64_t dropped;
+			ok = get(in, dropped);
+			if(ok && (dropped > 0)){
+				out << dropped << " records were dropped (ring full).\n";
+			}
+		}
+		if(!ok){
+			throw new ExceptionBinLog(string("decodeFile:: corrupt entry after ") + to_string(records) + " records.");
+		}
+	}
+	return records;
+}
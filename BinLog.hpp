@@ -0,0 +1,402 @@
+//============================================================================
+// Name        : BinLog.hpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : BinLog header file. It contains a low overhead logging
+//               facility: the caller stores a fixed size binary record
+//               (format id and raw arguments) in a lock-free ring of its
+//               thread, a background thread formats the records or writes
+//               them to a binary file rendered offline by logDecode.
+//============================================================================
+#ifndef BINLOG_HPP_INCLUDED
+#define BINLOG_HPP_INCLUDED
+
+#include "SerialCom.hpp"
+#include <string>
+#include <ostream>
+#include <istream>
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+
+using namespace std;
+
+
+/**
+ * \brief Records a thread can hold until the background thread took them
+ * (power of two). Records logged into a full ring are dropped and counted.
+ */
+#define BINLOG_RING_RECORDS 1024
+
+/**
+ * \brief Bytes of the arguments of a record.
+ */
+#define BINLOG_PAYLOAD 44
+
+/**
+ * \brief Maximal number of arguments of a record.
+ */
+#define BINLOG_MAX_ARGS 6
+
+/**
+ * \brief Magic of the binary log file.
+ */
+#define BINLOG_FILE_MAGIC "MEXLOG1\n"
+
+
+enum BinLogLevel {
+	BINLOG_DEBUG = 0,
+	BINLOG_INFO,
+	BINLOG_WARN,
+	BINLOG_ERROR,
+	BINLOG_OFF
+};
+
+
+/**
+ * \brief Types of the arguments stored in a record.
+ */
+enum BinLogType {
+	BINLOG_T_INT    = 'i', /**< 8 bytes, signed */
+	BINLOG_T_UINT   = 'u', /**< 8 bytes, unsigned */
+	BINLOG_T_DOUBLE = 'd', /**< 8 bytes */
+	BINLOG_T_CHAR   = 'c', /**< 1 byte */
+	BINLOG_T_BOOL   = 'b', /**< 1 byte */
+	BINLOG_T_STATIC = 'p', /**< 8 bytes, pointer to a string literal */
+	BINLOG_T_STRING = 's'  /**< 1 byte length and the (truncated) characters */
+};
+
+
+/**
+ * \brief One record, 64 bytes.
+ */
+struct BinLogRecord {
+	uint64_t tsNs;                     /**< steady clock */
+	uint32_t formatId;
+	uint8_t  nargs;
+	uint8_t  used;                     /**< bytes of payload used */
+	uint8_t  types[BINLOG_MAX_ARGS];
+	uint8_t  payload[BINLOG_PAYLOAD];
+};
+
+
+/**
+ * \brief A decoded argument.
+ */
+struct BinLogArg {
+	char     type;
+	int64_t  i = 0;
+	uint64_t u = 0;
+	double   d = 0.0;
+	string   s;
+};
+
+
+/**
+ * \brief A registered format: "{}" is replaced by the next argument.
+ */
+struct BinLogFormat {
+	BinLogLevel level;
+	const char *file;
+	unsigned    line;
+	const char *format;
+};
+
+
+/**
+ *
+ * \class BinLogRing
+ *
+ * \brief Single producer (the owning thread), single consumer (the
+ * background thread) ring of records. Neither side blocks.
+ *
+ */
+class BinLogRing {
+public:
+	BinLogRing(unsigned tid) : tid_(tid){};
+
+	/**
+	 * \brief Returns the slot to fill, NULL if the ring is full.
+	 */
+	BinLogRecord* claim(){
+		uint32_t head = head_.load(std::memory_order_relaxed);
+		if(head - tail_.load(std::memory_order_acquire) >= BINLOG_RING_RECORDS){
+			dropped_.fetch_add(1, std::memory_order_relaxed);
+			return nullptr;
+		}
+		return &records_[head & (BINLOG_RING_RECORDS - 1)];
+	}
+
+	void publish(){head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release);};
+
+	/**
+	 * \brief Takes the oldest record, false if the ring is empty.
+	 */
+	bool pop(BinLogRecord &r){
+		uint32_t tail = tail_.load(std::memory_order_relaxed);
+		if(tail == head_.load(std::memory_order_acquire)){
+			return false;
+		}
+		r = records_[tail & (BINLOG_RING_RECORDS - 1)];
+		tail_.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	unsigned getTid() const {return tid_;};
+	unsigned long getDropped() const {return dropped_.load(std::memory_order_relaxed);};
+
+	/**
+	 * \brief Called by the owning thread when it ends.
+	 */
+	void release(){owned_.store(false, std::memory_order_release);};
+
+	/**
+	 * \brief Takes the ring for another thread if its owner ended and
+	 * the background thread took all its records.
+	 */
+	bool reuse(){
+		if(owned_.load(std::memory_order_acquire) ||
+				(tail_.load(std::memory_order_acquire) != head_.load(std::memory_order_relaxed))){
+			return false;
+		}
+		owned_.store(true, std::memory_order_relaxed);
+		return true;
+	}
+
+protected:
+	BinLogRecord               records_[BINLOG_RING_RECORDS];
+	std::atomic<uint32_t>      head_{0};
+	std::atomic<uint32_t>      tail_{0};
+	std::atomic<unsigned long> dropped_{0};
+	std::atomic<bool>          owned_{true};
+	unsigned                   tid_;
+};
+
+
+/**
+ *
+ * \class BinLogEncoder
+ *
+ * \brief Appends the arguments to a record, one overload per type.
+ * Arguments that do not fit are left out (the format shows "{?}").
+ *
+ */
+class BinLogEncoder {
+public:
+	BinLogEncoder(BinLogRecord &r) : r_(r){r_.nargs = 0; r_.used = 0;};
+
+	void add(long long v)          {raw(BINLOG_T_INT, &v, 8);};
+	void add(long v)               {add((long long) v);};
+	void add(int v)                {add((long long) v);};
+	void add(short v)              {add((long long) v);};
+	void add(unsigned long long v) {raw(BINLOG_T_UINT, &v, 8);};
+	void add(unsigned long v)      {add((unsigned long long) v);};
+	void add(unsigned v)           {add((unsigned long long) v);};
+	void add(unsigned short v)     {add((unsigned long long) v);};
+	void add(unsigned char v)      {add((unsigned long long) v);};
+	void add(double v)             {raw(BINLOG_T_DOUBLE, &v, 8);};
+	void add(float v)              {add((double) v);};
+	void add(char v)               {raw(BINLOG_T_CHAR, &v, 1);};
+	void add(bool v)               {uint8_t b = v; raw(BINLOG_T_BOOL, &b, 1);};
+
+	/**
+	 * \brief A char pointer is taken as a string literal: only the
+	 * pointer is stored. Use string(...) for other character arrays.
+	 */
+	void add(const char *v)        {raw(BINLOG_T_STATIC, &v, 8);};
+
+	/**
+	 * \brief A string is copied into the record. If it does not fit, its
+	 * end is kept behind "..." (the innermost cause of nested exception
+	 * messages).
+	 */
+	void add(const string &v){
+		if((r_.nargs >= BINLOG_MAX_ARGS) || (r_.used + 4 >= BINLOG_PAYLOAD)){
+			return;
+		}
+		size_t room = BINLOG_PAYLOAD - r_.used - 1;
+		uint8_t *dst = r_.payload + r_.used + 1;
+		size_t n = v.size();
+		if(n <= room){
+			memcpy(dst, v.data(), n);
+		}else{
+			memcpy(dst, "...", 3);
+			memcpy(dst + 3, v.data() + v.size() - (room - 3), room - 3);
+			n = room;
+		}
+		r_.types[r_.nargs++] = BINLOG_T_STRING;
+		r_.payload[r_.used] = (uint8_t) n;
+		r_.used += n + 1;
+	}
+
+protected:
+	void raw(BinLogType type, const void *v, unsigned size){
+		if((r_.nargs >= BINLOG_MAX_ARGS) || (r_.used + size > BINLOG_PAYLOAD)){
+			return;
+		}
+		r_.types[r_.nargs++] = type;
+		memcpy(r_.payload + r_.used, v, size);
+		r_.used += size;
+	}
+
+	BinLogRecord &r_;
+};
+
+
+/**
+ *
+ * \class BinLog
+ *
+ * \brief Entry points of the logging facility. Nothing is recorded until
+ * a sink is started; the log macros check the level with one relaxed
+ * load. A record costs a clock read, the copy of the arguments and a
+ * release store: no lock, no allocation, no system call. The background
+ * thread wakes up every BinLog::setPollMs() milli seconds.
+ *
+ */
+class BinLog {
+public:
+
+	/**
+	 * \brief Registers a format, called once per log statement.
+	 */
+	static uint32_t registerFormat(BinLogLevel level, const char *file, unsigned line, const char *format);
+
+	static bool isEnabled(BinLogLevel level){return level >= minLevel_.load(std::memory_order_relaxed);};
+
+	/**
+	 * \brief Sets the lowest level recorded (if a sink is started).
+	 */
+	static void setLevel(BinLogLevel level);
+
+	static BinLogLevel getLevel(){return level_;};
+
+	template<typename... A>
+	static void log(uint32_t formatId, const A&... args){
+		BinLogRing *ring = local();
+		BinLogRecord *r = ring->claim();
+		if(r == nullptr){
+			return;
+		}
+		r->tsNs     = nowNs();
+		r->formatId = formatId;
+		BinLogEncoder e(*r);
+		int expand[] = {0, (e.add(args), 0)...};
+		(void) expand;
+		ring->publish();
+	}
+
+	/**
+	 * \brief Starts the background thread formatting the records as
+	 * text lines to the given stream. The stream has to outlive stop().
+	 */
+	static void startText(ostream &out);
+
+	/**
+	 *
+	 * \brief Starts the background thread writing the binary log file.
+	 * If the file cannot be written an exception (IException) is thrown.
+	 *
+	 */
+	static void startFile(const string &filename);
+
+	/**
+	 * \brief Takes the remaining records, stops the background thread and
+	 * closes the sink. Logging is disabled afterwards.
+	 */
+	static void stop();
+
+	/**
+	 * \brief Waits until the background thread took all records logged
+	 * by now.
+	 */
+	static void flush();
+
+	static void setPollMs(unsigned ms);
+
+	static unsigned long getDropped();
+
+	/**
+	 * \brief Number of rings created, a ring of an ended thread is reused.
+	 */
+	static unsigned getRings();
+
+	/**
+	 * \brief Number of records taken by the background thread.
+	 */
+	static unsigned long getWritten();
+
+	static uint64_t nowNs();
+
+	/**
+	 * \brief Renders a format with the decoded arguments.
+	 */
+	static string format(const char *format, const vector<BinLogArg> &args);
+
+	/**
+	 * \brief Decodes the arguments of a record. Literal pointers are only
+	 * valid within the logging process.
+	 */
+	static vector<BinLogArg> decode(const BinLogRecord &r);
+
+	/**
+	 * \brief Text line of a record: time in seconds, level, thread, file:line
+	 * and the message.
+	 */
+	static string line(uint64_t tsNs, unsigned tid, BinLogLevel level, const char *file, unsigned line,
+					   const string &message);
+
+	static const char* levelName(BinLogLevel level);
+
+	/**
+	 *
+	 * \brief Renders a binary log file (see startFile(...)) as text lines
+	 * of at least the given level. Returns the number of records read.
+	 * If the file is corrupt an exception (IException) is thrown.
+	 *
+	 */
+	static unsigned long decodeFile(istream &in, ostream &out, BinLogLevel minLevel = BINLOG_DEBUG);
+
+protected:
+	static BinLogRing* local();
+
+	static std::atomic<BinLogLevel> minLevel_; // BINLOG_OFF without sink
+	static BinLogLevel              level_;
+};
+
+
+/**
+ *
+ * \class ExceptionBinLog
+ *
+ * \brief Exception class of BinLog.
+ *
+ */
+class ExceptionBinLog : public IException{
+	public:
+		ExceptionBinLog(string msg){
+			msg_ = string("ExceptionBinLog::") + msg;
+		};
+		string getMsg(){return msg_;};
+	protected:
+		string msg_;
+	private:
+		ExceptionBinLog(){};
+};
+
+
+#define MEX_LOG(level, format, ...) \
+	do{ \
+		if(BinLog::isEnabled(level)){ \
+			static const uint32_t mexLogFormatId = BinLog::registerFormat(level, __FILE__, __LINE__, format); \
+			BinLog::log(mexLogFormatId, ##__VA_ARGS__); \
+		} \
+	}while(0)
+
+#define MEX_LOG_DEBUG(format, ...) MEX_LOG(BINLOG_DEBUG, format, ##__VA_ARGS__)
+#define MEX_LOG_INFO(format, ...)  MEX_LOG(BINLOG_INFO,  format, ##__VA_ARGS__)
+#define MEX_LOG_WARN(format, ...)  MEX_LOG(BINLOG_WARN,  format, ##__VA_ARGS__)
+#define MEX_LOG_ERROR(format, ...) MEX_LOG(BINLOG_ERROR, format, ##__VA_ARGS__)
+
+#endif // BINLOG_HPP_INCLUDED
@@ -0,0 +1,52 @@
+//============================================================================
+// Name        : Clock.cpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : Clock source file. It contains the definition of the
+//               functions of the SystemClock and VirtualClock classes.
+//============================================================================
+#include "Clock.hpp"
+#include <chrono>
+#include <thread>
+
+
+unsigned long long SystemClock::nowUs(){
+	return std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void SystemClock::sleepUs(unsigned long long us){
+	if(us > 0){
+		std::this_thread::sleep_for(std::chrono::microseconds(us));
+	}
+}
+
+SystemClock& SystemClock::instance(){
+	static SystemClock clock;
+	return clock;
+}
+
+
+
+unsigned long long VirtualClock::nowUs(){
+	std::lock_guard<std::mutex> guard(mutex_);
+	return timeUs_;
+}
+
+void VirtualClock::sleepUs(unsigned long long us){
+	std::lock_guard<std::mutex> guard(mutex_);
+	timeUs_ += us;
+	sleeps_++;
+}
+
+void VirtualClock::advanceTo(unsigned long long timeUs){
+	std::lock_guard<std::mutex> guard(mutex_);
+	if(timeUs > timeUs_){
+		timeUs_ = timeUs;
+	}
+}
+
+unsigned long VirtualClock::getSleeps(){
+	std::lock_guard<std::mutex> guard(mutex_);
+	return sleeps_;
+}
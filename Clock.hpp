@@ -0,0 +1,97 @@
+//============================================================================
+// Name        : Clock.hpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : Clock header file. It contains the IClock interface used by
+//               timeouts, backoff delays and waits, the SystemClock based on
+//               the monotonic clock of the system and the VirtualClock that
+//               lets simulations and tests run faster than real time.
+//============================================================================
+#ifndef CLOCK_HPP_INCLUDED
+#define CLOCK_HPP_INCLUDED
+
+#include <mutex>
+
+
+/**
+ *
+ * \class IClock
+ *
+ * \brief Time source and sleep of a component. The time is given in
+ * micro seconds since an arbitrary start and never goes backwards.
+ *
+ */
+class IClock {
+public:
+	virtual ~IClock(){};
+
+	/**
+	 * \brief Current time in micro seconds.
+	 */
+	virtual unsigned long long nowUs() = 0;
+
+	/**
+	 * \brief Blocks the caller for the given time in micro seconds.
+	 */
+	virtual void sleepUs(unsigned long long us) = 0;
+};
+
+
+/**
+ *
+ * \class SystemClock
+ *
+ * \brief Wall clock time (std::chrono::steady_clock), sleeps block the
+ * calling thread.
+ *
+ */
+class SystemClock : public IClock {
+public:
+	unsigned long long nowUs();
+	void sleepUs(unsigned long long us);
+
+	/**
+	 * \brief Process wide instance, the default clock of all components.
+	 */
+	static SystemClock& instance();
+};
+
+
+/**
+ *
+ * \class VirtualClock
+ *
+ * \brief Clock that only moves when it is told to. A sleep advances the
+ * time at once, so waiting for a servo motion of an hour costs no real
+ * time. Used together with SerialComSim, which drives the
+ * MaestroSimulator with the time of this clock.
+ *
+ */
+class VirtualClock : public IClock {
+public:
+	VirtualClock(unsigned long long startUs = 0) : timeUs_(startUs){};
+
+	unsigned long long nowUs();
+
+	/**
+	 * \brief Advances the time by us micro seconds without blocking.
+	 */
+	void sleepUs(unsigned long long us);
+
+	/**
+	 * \brief Sets the time; earlier times are ignored.
+	 */
+	void advanceTo(unsigned long long timeUs);
+
+	/**
+	 * \brief Number of sleeps, i.e. of waits that did not block.
+	 */
+	unsigned long getSleeps();
+
+protected:
+	std::mutex         mutex_;
+	unsigned long long timeUs_;
+	unsigned long      sleeps_ = 0;
+};
+
+#endif // CLOCK_HPP_INCLUDED
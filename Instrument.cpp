@@ -0,0 +1,314 @@
+//============================================================================
+// Name        : Instrument.cpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : Instrument source file. It contains the definition of the
+//               functions of the Instrument classes and, with
+//               MEX_INSTRUMENT, the counting operators new/delete and the
+//               system call wrappers.
+//============================================================================
+#include "Instrument.hpp"
+#include <mutex>
+#include <sstream>
+#include <iomanip>
+#include <cstdlib>
+#include <new>
+
+#ifdef MEX_INSTRUMENT
+	#include <stdarg.h>
+	#include <unistd.h>
+	#include <fcntl.h>
+	#include <poll.h>
+	#include <termios.h>
+	#include <sys/uio.h>
+#endif
+
+
+static thread_local InstrumentCounts instrumentLocal;
+
+static std::mutex                    instrumentMutex;
+static std::vector<InstrumentSite*> *instrumentSites = nullptr;
+
+static const char* instrumentSyscallNames[MEX_SYS_COUNT] = {
+		"read", "write", "poll", "tcflush", "tcsetattr", "other"
+};
+
+
+unsigned long InstrumentCounts::getSyscalls() const {
+	unsigned long n = 0;
+	for(unsigned i = 0; i < MEX_SYS_COUNT; i++){
+		n += syscalls[i];
+	}
+	return n;
+}
+
+InstrumentCounts InstrumentCounts::operator-(const InstrumentCounts &before) const {
+	InstrumentCounts d;
+	d.allocs     = allocs - before.allocs;
+	d.allocBytes = allocBytes - before.allocBytes;
+	d.frees      = frees - before.frees;
+	for(unsigned i = 0; i < MEX_SYS_COUNT; i++){
+		d.syscalls[i] = syscalls[i] - before.syscalls[i];
+	}
+	return d;
+}
+
+string InstrumentCounts::toXmlAttributes() const {
+	stringstream ss;
+	ss << "allocs=\"" << allocs << "\" allocBytes=\"" << allocBytes << "\" frees=\"" << frees
+	   << "\" syscalls=\"" << getSyscalls() << "\"";
+	for(unsigned i = 0; i < MEX_SYS_COUNT; i++){
+		ss << " " << instrumentSyscallNames[i] << "=\"" << syscalls[i] << "\"";
+	}
+	return ss.str();
+}
+
+
+
+InstrumentSite::InstrumentSite(const char *name){
+	name_ = name;
+	std::lock_guard<std::mutex> lock(instrumentMutex);
+	if(instrumentSites == nullptr){
+		instrumentSites = new std::vector<InstrumentSite*>();
+	}
+	instrumentSites->push_back(this);
+}
+
+
+
+InstrumentScope::InstrumentScope(InstrumentSite &site) : site_(site){
+	start_ = instrumentLocal;
+}
+
+InstrumentScope::~InstrumentScope(){
+	InstrumentCounts d = instrumentLocal - start_;
+	site_.calls.fetch_add(1, std::memory_order_relaxed);
+	site_.allocs.fetch_add(d.allocs, std::memory_order_relaxed);
+	site_.allocBytes.fetch_add(d.allocBytes, std::memory_order_relaxed);
+	site_.syscalls.fetch_add(d.getSyscalls(), std::memory_order_relaxed);
+}
+
+
+
+bool Instrument::isCompiledIn(){
+#ifdef MEX_INSTRUMENT
+	return true;
+#else
+	return false;
+#endif
+}
+
+InstrumentCounts Instrument::current(){
+	return instrumentLocal;
+}
+
+void Instrument::countAlloc(unsigned long bytes){
+	instrumentLocal.allocs++;
+	instrumentLocal.allocBytes += bytes;
+}
+
+void Instrument::countFree(){
+	instrumentLocal.frees++;
+}
+
+void Instrument::countSyscall(InstrumentSyscall kind){
+	instrumentLocal.syscalls[kind]++;
+}
+
+vector<InstrumentSite*> Instrument::getSites(){
+	std::lock_guard<std::mutex> lock(instrumentMutex);
+	if(instrumentSites == nullptr){
+		return vector<InstrumentSite*>();
+	}
+	return *instrumentSites;
+}
+
+void Instrument::resetSites(){
+	vector<InstrumentSite*> sites = getSites();
+	for(size_t i = 0; i < sites.size(); i++){
+		sites[i]->calls      = 0;
+		sites[i]->allocs     = 0;
+		sites[i]->allocBytes = 0;
+		sites[i]->syscalls   = 0;
+	}
+}
+
+string Instrument::sitesToXml(){
+	vector<InstrumentSite*> sites = getSites();
+	stringstream ss;
+	for(size_t i = 0; i < sites.size(); i++){
+		if(sites[i]->calls == 0){
+			continue;
+		}
+		ss << "<ApiCall name=\"" << sites[i]->getName() << "\" calls=\"" << sites[i]->calls
+		   << "\" allocs=\"" << sites[i]->allocs << "\" allocBytes=\"" << sites[i]->allocBytes
+		   << "\" syscalls=\"" << sites[i]->syscalls << "\"/>";
+	}
+	return ss.str();
+}
+
+void Instrument::writeReport(ostream &out){
+	vector<InstrumentSite*> sites = getSites();
+	out << setw(34) << left << "API call" << setw(10) << right << "calls"
+		<< setw(14) << "allocs/call" << setw(14) << "bytes/call" << setw(14) << "syscalls/call" << endl;
+	for(size_t i = 0; i < sites.size(); i++){
+		unsigned long calls = sites[i]->calls;
+		if(calls == 0){
+			continue;
+		}
+		out << setw(34) << left << sites[i]->getName() << setw(10) << right << calls
+			<< setw(14) << fixed << setprecision(2) << ((double) sites[i]->allocs / calls)
+			<< setw(14) << ((double) sites[i]->allocBytes / calls)
+			<< setw(14) << ((double) sites[i]->syscalls / calls) << endl;
+	}
+}
+
+
+
+#ifdef MEX_INSTRUMENT
+
+/*
+ * Counting allocation functions, all forms of new and delete end here.
+ */
+void* operator new(std::size_t size){
+	Instrument::countAlloc(size);
+	void *p = malloc((size == 0) ? 1 : size);
+	if(p == nullptr){
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void* operator new[](std::size_t size){
+	return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+	Instrument::countAlloc(size);
+	return malloc((size == 0) ? 1 : size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+	return operator new(size, std::nothrow);
+}
+
+void operator delete(void *p) noexcept {
+	if(p != nullptr){
+		Instrument::countFree();
+		free(p);
+	}
+}
+
+void operator delete[](void *p) noexcept {
+	operator delete(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+	operator delete(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept {
+	operator delete(p);
+}
+
+
+/*
+ * System call wrappers, the linker redirects the calls of the objects
+ * to __wrap_xxx (-Wl,--wrap=xxx) and __real_xxx to the C library.
+ */
+extern "C" {
+
+ssize_t __real_read(int fd, void *buf, size_t count);
+ssize_t __real_readv(int fd, const struct iovec *iov, int iovcnt);
+ssize_t __real_write(int fd, const void *buf, size_t count);
+ssize_t __real_writev(int fd, const struct iovec *iov, int iovcnt);
+int     __real_poll(struct pollfd *fds, nfds_t nfds, int timeout);
+int     __real_tcflush(int fd, int queue);
+int     __real_tcsetattr(int fd, int actions, const struct termios *t);
+int     __real_tcgetattr(int fd, struct termios *t);
+int     __real_ioctl(int fd, unsigned long request, void *arg);
+int     __real_open(const char *path, int flags, int mode);
+int     __real_close(int fd);
+long    __real_syscall(long number, long a1, long a2, long a3, long a4, long a5, long a6);
+
+ssize_t __wrap_read(int fd, void *buf, size_t count){
+	Instrument::countSyscall(MEX_SYS_READ);
+	return __real_read(fd, buf, count);
+}
+
+ssize_t __wrap_readv(int fd, const struct iovec *iov, int iovcnt){
+	Instrument::countSyscall(MEX_SYS_READ);
+	return __real_readv(fd, iov, iovcnt);
+}
+
+ssize_t __wrap_write(int fd, const void *buf, size_t count){
+	Instrument::countSyscall(MEX_SYS_WRITE);
+	return __real_write(fd, buf, count);
+}
+
+ssize_t __wrap_writev(int fd, const struct iovec *iov, int iovcnt){
+	Instrument::countSyscall(MEX_SYS_WRITE);
+	return __real_writev(fd, iov, iovcnt);
+}
+
+int __wrap_poll(struct pollfd *fds, nfds_t nfds, int timeout){
+	Instrument::countSyscall(MEX_SYS_POLL);
+	return __real_poll(fds, nfds, timeout);
+}
+
+int __wrap_tcflush(int fd, int queue){
+	Instrument::countSyscall(MEX_SYS_TCFLUSH);
+	return __real_tcflush(fd, queue);
+}
+
+int __wrap_tcsetattr(int fd, int actions, const struct termios *t){
+	Instrument::countSyscall(MEX_SYS_TCSETATTR);
+	return __real_tcsetattr(fd, actions, t);
+}
+
+int __wrap_tcgetattr(int fd, struct termios *t){
+	Instrument::countSyscall(MEX_SYS_OTHER);
+	return __real_tcgetattr(fd, t);
+}
+
+int __wrap_ioctl(int fd, unsigned long request, ...){
+	va_list ap;
+	va_start(ap, request);
+	void *arg = va_arg(ap, void *);
+	va_end(ap);
+	Instrument::countSyscall(MEX_SYS_OTHER);
+	return __real_ioctl(fd, request, arg);
+}
+
+int __wrap_open(const char *path, int flags, ...){
+	int mode = 0;
+	if(flags & O_CREAT){
+		va_list ap;
+		va_start(ap, flags);
+		mode = va_arg(ap, int);
+		va_end(ap);
+	}
+	Instrument::countSyscall(MEX_SYS_OTHER);
+	return __real_open(path, flags, mode);
+}
+
+int __wrap_close(int fd){
+	Instrument::countSyscall(MEX_SYS_OTHER);
+	return __real_close(fd);
+}
+
+long __wrap_syscall(long number, ...){
+	va_list ap;
+	va_start(ap, number);
+	long a[6];
+	for(unsigned i = 0; i < 6; i++){
+		a[i] = va_arg(ap, long);
+	}
+	va_end(ap);
+	Instrument::countSyscall(MEX_SYS_OTHER);
+	return __real_syscall(number, a[0], a[1], a[2], a[3], a[4], a[5]);
+}
+
+} // extern "C"
+
+#endif // MEX_INSTRUMENT
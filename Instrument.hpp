@@ -0,0 +1,162 @@
+//============================================================================
+// Name        : Instrument.hpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : Instrument header file. It contains the accounting of heap
+//               allocations and system calls per thread, per test case and
+//               per API call (instrumented builds, see MEX_INSTRUMENT).
+//============================================================================
+#ifndef INSTRUMENT_HPP_INCLUDED
+#define INSTRUMENT_HPP_INCLUDED
+
+#include <string>
+#include <ostream>
+#include <atomic>
+#include <vector>
+
+using namespace std;
+
+
+/**
+ * \brief Classes of system calls counted.
+ */
+enum InstrumentSyscall {
+	MEX_SYS_READ = 0,  /**< read and readv */
+	MEX_SYS_WRITE,     /**< write and writev */
+	MEX_SYS_POLL,
+	MEX_SYS_TCFLUSH,
+	MEX_SYS_TCSETATTR,
+	MEX_SYS_OTHER,     /**< open, close, ioctl, tcgetattr, syscall */
+	MEX_SYS_COUNT
+};
+
+
+/**
+ * \brief Counters of one thread or the difference of two snapshots.
+ */
+struct InstrumentCounts {
+	unsigned long allocs     = 0; /**< operator new (all forms) */
+	unsigned long allocBytes = 0;
+	unsigned long frees      = 0; /**< operator delete of non NULL pointers */
+	unsigned long syscalls[MEX_SYS_COUNT] = {0, 0, 0, 0, 0, 0};
+
+	unsigned long getSyscalls() const;
+
+	/**
+	 * \brief Counts since the snapshot given.
+	 */
+	InstrumentCounts operator-(const InstrumentCounts &before) const;
+
+	/**
+	 * \brief XML attributes, e.g. allocs="3" allocBytes="96" ...
+	 */
+	string toXmlAttributes() const;
+};
+
+
+/**
+ *
+ * \class InstrumentSite
+ *
+ * \brief Accumulated counts of one instrumented API function (inclusive
+ * of the calls below it). A site registers itself with its first call.
+ *
+ */
+class InstrumentSite {
+public:
+	InstrumentSite(const char *name);
+
+	const char *getName() const {return name_;};
+
+	std::atomic<unsigned long> calls{0};
+	std::atomic<unsigned long> allocs{0};
+	std::atomic<unsigned long> allocBytes{0};
+	std::atomic<unsigned long> syscalls{0};
+
+protected:
+	const char *name_;
+};
+
+
+/**
+ *
+ * \class InstrumentScope
+ *
+ * \brief Adds the allocations and system calls of the calling thread
+ * between construction and destruction to a site.
+ *
+ */
+class InstrumentScope {
+public:
+	InstrumentScope(InstrumentSite &site);
+	~InstrumentScope();
+
+protected:
+	InstrumentSite   &site_;
+	InstrumentCounts  start_;
+};
+
+
+/**
+ *
+ * \class Instrument
+ *
+ * \brief Access to the counters. Allocations are counted by replaced
+ * global operators new and delete, system calls by wrappers the linker
+ * puts in place of read, write, ... ("make INSTRUMENT=1" passes
+ * -Wl,--wrap=...). Both are only compiled in with MEX_INSTRUMENT,
+ * otherwise all counts stay 0.
+ *
+ * The counters belong to the calling thread, so threads of simulators
+ * or servers do not blur the numbers of the control path.
+ *
+ */
+class Instrument {
+public:
+
+	static bool isCompiledIn();
+
+	/**
+	 * \brief Snapshot of the counters of the calling thread.
+	 */
+	static InstrumentCounts current();
+
+	static void countAlloc(unsigned long bytes);
+	static void countFree();
+	static void countSyscall(InstrumentSyscall kind);
+
+	/**
+	 * \brief All sites called so far.
+	 */
+	static vector<InstrumentSite*> getSites();
+
+	/**
+	 * \brief Sets the counts of all sites to 0.
+	 */
+	static void resetSites();
+
+	/**
+	 * \brief Sites with at least one call as XML elements
+	 * <ApiCall name="Pololu::setPosition" calls=".." allocs=".." .../>.
+	 */
+	static string sitesToXml();
+
+	/**
+	 * \brief Table of the sites with the counts per call.
+	 */
+	static void writeReport(ostream &out);
+};
+
+
+#define MEX_INSTRUMENT_CONCAT2(a, b) a##b
+#define MEX_INSTRUMENT_CONCAT(a, b) MEX_INSTRUMENT_CONCAT2(a, b)
+
+#ifdef MEX_INSTRUMENT
+	#define MEX_INSTRUMENT_CALL(name) \
+		static InstrumentSite MEX_INSTRUMENT_CONCAT(mexInstrumentSite, __LINE__)(name); \
+		InstrumentScope MEX_INSTRUMENT_CONCAT(mexInstrumentScope, __LINE__)(MEX_INSTRUMENT_CONCAT(mexInstrumentSite, __LINE__))
+#else
+	#define MEX_INSTRUMENT_CALL(name)
+#endif
+
+#endif // INSTRUMENT_HPP_INCLUDED
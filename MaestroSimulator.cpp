@@ -0,0 +1,515 @@
+//============================================================================
+// Name        : MaestroSimulator.cpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : MaestroSimulator source file. It contains the definition of
+//               the functions of the MaestroSimulator, MaestroPty and
+//               MaestroSocketServer classes.
+//============================================================================
+#include "MaestroSimulator.hpp"
+#include "PololuErrors.hpp"
+#include "PololuFrames.hpp"
+#include "SerialCom.hpp"
+#include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <poll.h>
+#include <termios.h>
+#include <string.h>
+#include <sstream>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+
+MaestroSimulator::MaestroSimulator(unsigned channels, unsigned short neutral){
+	channels_ = (channels > MAX_CHANNELS) ? MAX_CHANNELS : channels;
+	for(unsigned i = 0; i < MAX_CHANNELS; i++){
+		channel_[i].position     = neutral;
+		channel_[i].velocity     = 0.0;
+		channel_[i].target       = neutral;
+		channel_[i].speed        = 0;
+		channel_[i].acceleration = 0;
+		channel_[i].miniSscNeutral = neutral;
+		channel_[i].miniSscRange   = 1905; // 476.25 us, factory setting
+		channel_[i].pending        = false;
+		channel_[i].pendingTarget  = 0;
+		channel_[i].pendingAtUs    = 0;
+	}
+}
+
+unsigned MaestroSimulator::commandLength(unsigned char cmd){
+	switch(cmd){
+	case 0x84: // set target
+	case 0x87: // set speed
+	case 0x89: // set acceleration
+		return 4;
+	case 0xFF: // Mini SSC set target
+		return 3;
+	case 0x90: // get position
+		return 2;
+	case 0x93: // get moving state
+	case 0xA1: // get errors
+	case 0xA2: // go home
+		return 1;
+	default:
+		return 0;
+	}
+}
+
+unsigned MaestroSimulator::process(const unsigned char *in, unsigned sizeIn, unsigned char *out, unsigned sizeOut){
+	unsigned produced = 0;
+	bytesIn_ += sizeIn;
+
+	for(unsigned i = 0; i < sizeIn; i++){
+		unsigned char b = in[i];
+
+		if(frameLen_ == 0){
+			if(commandLength(b) == 0){
+				// data byte without command or unknown command
+				errors_ |= POLOLU_ERR_SERIAL_PROTOCOL;
+				continue;
+			}
+		}else if((b & 0x80) && (frame_[0] != 0xFF)){
+			// a new command byte interrupts an incomplete command,
+			// the Mini SSC target is a full 8 bit data byte
+			errors_ |= POLOLU_ERR_SERIAL_PROTOCOL;
+			frameLen_ = 0;
+			if(commandLength(b) == 0){
+				continue;
+			}
+		}
+
+		frame_[frameLen_++] = b;
+		if(frameLen_ == commandLength(frame_[0]) + (crc_ ? 1 : 0)){
+			if(crc_){
+				// the CRC over command and CRC byte is 0 for an intact frame
+				if(pololuCrc7(frame_, frameLen_) != 0){
+					errors_ |= POLOLU_ERR_SERIAL_CRC;
+					frameLen_ = 0;
+					continue;
+				}
+				frameLen_--;
+			}
+			unsigned reply = execute(out + produced, sizeOut - produced);
+			if(reply > 0){
+				replies_++;
+			}
+			produced += reply;
+			frameLen_ = 0;
+		}
+	}
+	bytesOut_ += produced;
+	return produced;
+}
+
+unsigned MaestroSimulator::execute(unsigned char *out, unsigned sizeOut){
+	commands_++;
+	unsigned char cmd = frame_[0];
+	unsigned ch = (frameLen_ > 1) ? frame_[1] : 0;
+	unsigned short value = (frameLen_ > 3) ? (frame_[2] + (frame_[3] << 7)) : 0;
+
+	if((frameLen_ > 1) && (ch >= channels_)){
+		errors_ |= POLOLU_ERR_SERIAL_PROTOCOL;
+		return 0;
+	}
+
+	switch(cmd){
+	case 0x84:
+		this->setTarget(channel_[ch], value);
+		return 0;
+	case 0xFF:{
+		Channel &c = channel_[ch];
+		int target = c.miniSscNeutral + ((((int) frame_[2]) - 127) * ((int) c.miniSscRange)) / 127;
+		this->setTarget(c, (target < 0) ? 0 : target);
+		return 0;
+	}
+	case 0x87:
+		channel_[ch].speed = value;
+		return 0;
+	case 0x89:
+		channel_[ch].acceleration = value;
+		return 0;
+	case 0x90:{
+		if(sizeOut < 2){
+			return 0;
+		}
+		unsigned short p = (unsigned short) (channel_[ch].position + 0.5);
+		out[0] = p & 0xFF;
+		out[1] = (p >> 8) & 0xFF;
+		return 2;
+	}
+	case 0x93:
+		if(sizeOut < 1){
+			return 0;
+		}
+		out[0] = this->isMoving() ? 1 : 0;
+		return 1;
+	case 0xA1:
+		if(sizeOut < 2){
+			return 0;
+		}
+		out[0] = errors_ & 0xFF;
+		out[1] = (errors_ >> 8) & 0xFF;
+		errors_ = 0;
+		return 2;
+	case 0xA2:
+		for(unsigned i = 0; i < channels_; i++){
+			channel_[i].target = 0;
+		}
+		return 0;
+	}
+	return 0;
+}
+
+void MaestroSimulator::setTarget(Channel &c, unsigned short target){
+	unsigned long deadTimeUs = c.model.getParams().deadTimeUs;
+	if(deadTimeUs > 0){
+		// the servo reacts after its dead time, see ServoEstimator
+		c.pending       = true;
+		c.pendingTarget = target;
+		c.pendingAtUs   = nowUs_ + deadTimeUs;
+		return;
+	}
+	c.target = target;
+	if(target == 0){ // target 0 switches the pulses off
+		c.velocity = 0.0;
+	}
+}
+
+void MaestroSimulator::step(Channel &c){
+	if(c.pending && (timeUs_ >= c.pendingAtUs)){
+		c.pending = false;
+		c.target  = c.pendingTarget;
+		if(c.target == 0){
+			c.velocity = 0.0;
+		}
+	}
+	c.model.step(c.position, c.velocity, c.target, c.speed, c.acceleration);
+}
+
+void MaestroSimulator::setTime(unsigned long long timeUs){
+	if(timeUs > nowUs_){
+		nowUs_ = timeUs;
+	}
+	// the firmware updates the pulse widths every 10 ms
+	while(timeUs_ + 10000 <= timeUs){
+		timeUs_ += 10000;
+		for(unsigned i = 0; i < channels_; i++){
+			step(channel_[i]);
+		}
+	}
+}
+
+unsigned short MaestroSimulator::getPosition(unsigned channel){
+	if(channel >= channels_){
+		return 0;
+	}
+	return (unsigned short) (channel_[channel].position + 0.5);
+}
+
+unsigned short MaestroSimulator::getTarget(unsigned channel){
+	return (channel < channels_) ? channel_[channel].target : 0;
+}
+
+unsigned short MaestroSimulator::getSpeed(unsigned channel){
+	return (channel < channels_) ? channel_[channel].speed : 0;
+}
+
+unsigned short MaestroSimulator::getAcceleration(unsigned channel){
+	return (channel < channels_) ? channel_[channel].acceleration : 0;
+}
+
+bool MaestroSimulator::isMoving(){
+	for(unsigned i = 0; i < channels_; i++){
+		if(channel_[i].pending){
+			return true;
+		}
+		if((channel_[i].target != 0) &&
+				(fabs(((float) channel_[i].target) - channel_[i].position) >= 0.5)){
+			return true;
+		}
+	}
+	return false;
+}
+
+void MaestroSimulator::setMiniSscRange(unsigned channel, unsigned short neutral, unsigned short range){
+	if(channel >= channels_){
+		return;
+	}
+	channel_[channel].miniSscNeutral = neutral;
+	channel_[channel].miniSscRange   = range;
+}
+
+void MaestroSimulator::setPosition(unsigned channel, unsigned short position){
+	if(channel >= channels_){
+		return;
+	}
+	channel_[channel].position = position;
+	channel_[channel].target   = position;
+	channel_[channel].velocity = 0.0;
+	channel_[channel].pending  = false;
+}
+
+void MaestroSimulator::setServoModel(unsigned channel, const ServoModelParams &params){
+	if(channel >= channels_){
+		return;
+	}
+	channel_[channel].model.setParams(params);
+}
+
+unsigned MaestroSimulator::loadServoModels(const string &filename){
+	vector<ServoModelParams> params = ServoModelFile::load(filename);
+	unsigned set = 0;
+	for(unsigned i = 0; i < params.size(); i++){
+		if(params[i].servo < channels_){
+			this->setServoModel(params[i].servo, params[i]);
+			set++;
+		}
+	}
+	return set;
+}
+
+
+
+MaestroPty::MaestroPty(MaestroSimulator *sim){
+	sim_ = sim;
+	running_ = false;
+}
+
+MaestroPty::~MaestroPty(){
+	this->stop();
+}
+
+void MaestroPty::start(){
+	if(running_){
+		return;
+	}
+	master_ = posix_openpt(O_RDWR | O_NOCTTY);
+	if(master_ < 0){
+		throw new ExceptionSerialCom(string("MaestroPty::start: cannot open pseudo terminal."));
+	}
+	if((grantpt(master_) != 0) || (unlockpt(master_) != 0)){
+		close(master_);
+		master_ = -1;
+		throw new ExceptionSerialCom(string("MaestroPty::start: cannot unlock pseudo terminal."));
+	}
+	slaveName_ = string(ptsname(master_));
+
+	// keep the slave side open, so the master does not see a hang up
+	// while the host closes and reopens the port
+	slave_ = open(slaveName_.c_str(), O_RDWR | O_NOCTTY);
+	struct termios options;
+	if((slave_ >= 0) && (tcgetattr(slave_, &options) == 0)){
+		cfmakeraw(&options);
+		tcsetattr(slave_, TCSANOW, &options);
+	}
+
+	running_ = true;
+	thread_ = std::thread(&MaestroPty::run, this);
+}
+
+void MaestroPty::stop(){
+	if(!running_){
+		return;
+	}
+	running_ = false;
+	thread_.join();
+	close(master_);
+	if(slave_ >= 0){
+		close(slave_);
+	}
+	master_ = -1;
+	slave_  = -1;
+}
+
+void MaestroPty::run(){
+	typedef std::chrono::steady_clock clock;
+	clock::time_point start = clock::now();
+	unsigned char in[256];
+	unsigned char out[512];
+	struct pollfd pfd;
+	pfd.fd = master_;
+	pfd.events = POLLIN;
+	clock::time_point rxFree = start;
+	clock::time_point txFree = start;
+
+	while(running_){
+		pfd.revents = 0;
+		if(poll(&pfd, 1, 20) <= 0){
+			continue;
+		}
+		ssize_t n = read(master_, in, sizeof(in));
+		if(n <= 0){
+			continue;
+		}
+		unsigned baudRate = baudRate_;
+		if(baudRate > 0){
+			// the bytes are complete after their time on the wire (8N1)
+			rxFree = std::max(rxFree, clock::now()) + std::chrono::microseconds(n * 10000000ULL / baudRate);
+			std::this_thread::sleep_until(rxFree);
+		}
+		unsigned produced;
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			sim_->setTime(std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count());
+			produced = sim_->process(in, (unsigned) n, out, sizeof(out));
+		}
+		if((baudRate > 0) && (produced > 0)){
+			txFree = std::max(txFree, clock::now()) + std::chrono::microseconds(produced * 10000000ULL / baudRate);
+			std::this_thread::sleep_until(txFree);
+		}
+		unsigned written = 0;
+		while(written < produced){
+			ssize_t w = write(master_, out + written, produced - written);
+			if(w <= 0){
+				break;
+			}
+			written += w;
+		}
+	}
+}
+
+
+
+MaestroSocketServer::MaestroSocketServer(MaestroSimulator *sim){
+	sim_ = sim;
+	running_ = false;
+}
+
+MaestroSocketServer::~MaestroSocketServer(){
+	this->stop();
+}
+
+void MaestroSocketServer::start(const string &address){
+	if(running_){
+		return;
+	}
+	if(address.compare(0, 4, "tcp:") == 0){
+		// numeric IPv4 address, e.g. tcp:127.0.0.1:0
+		size_t colon = address.rfind(':');
+		struct sockaddr_in addr;
+		memset(&addr, 0, sizeof(addr));
+		addr.sin_family = AF_INET;
+		addr.sin_port   = htons((unsigned short) atoi(address.c_str() + colon + 1));
+		string host = address.substr(4, colon - 4);
+		listen_ = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+		int one = 1;
+		setsockopt(listen_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+		socklen_t len = sizeof(addr);
+		if((listen_ < 0) || (inet_pton(AF_INET, host.c_str(), &addr.sin_addr) != 1) ||
+				(bind(listen_, (struct sockaddr *) &addr, sizeof(addr)) != 0) ||
+				(listen(listen_, 4) != 0) ||
+				(getsockname(listen_, (struct sockaddr *) &addr, &len) != 0)){
+			if(listen_ >= 0){
+				close(listen_);
+			}
+			listen_ = -1;
+			throw new ExceptionSerialCom(string("MaestroSocketServer::start: cannot listen on '") + address + string("'."));
+		}
+		stringstream ss;
+		ss << "tcp:" << host << ":" << ntohs(addr.sin_port);
+		portName_ = ss.str();
+	}else if(address.compare(0, 5, "unix:") == 0){
+		struct sockaddr_un addr;
+		memset(&addr, 0, sizeof(addr));
+		addr.sun_family = AF_UNIX;
+		unixPath_ = address.substr(5);
+		strncpy(addr.sun_path, unixPath_.c_str(), sizeof(addr.sun_path) - 1);
+		unlink(unixPath_.c_str());
+		listen_ = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+		if((listen_ < 0) || (bind(listen_, (struct sockaddr *) &addr, sizeof(addr)) != 0) ||
+				(listen(listen_, 4) != 0)){
+			if(listen_ >= 0){
+				close(listen_);
+			}
+			listen_ = -1;
+			throw new ExceptionSerialCom(string("MaestroSocketServer::start: cannot listen on '") + address + string("'."));
+		}
+		portName_ = address;
+	}else{
+		throw new ExceptionSerialCom(string("MaestroSocketServer::start: unknown address '") + address + string("'."));
+	}
+
+	running_ = true;
+	thread_ = std::thread(&MaestroSocketServer::run, this);
+}
+
+void MaestroSocketServer::stop(){
+	if(!running_){
+		return;
+	}
+	running_ = false;
+	thread_.join();
+	close(listen_);
+	listen_ = -1;
+	if(!unixPath_.empty()){
+		unlink(unixPath_.c_str());
+	}
+}
+
+void MaestroSocketServer::run(){
+	typedef std::chrono::steady_clock clock;
+	clock::time_point start = clock::now();
+	unsigned char in[256];
+	unsigned char out[512];
+	struct pollfd pfd[2];
+	pfd[0].fd = listen_;
+	pfd[0].events = POLLIN;
+	pfd[1].fd = -1;
+	pfd[1].events = POLLIN;
+
+	while(running_){
+		pfd[0].revents = 0;
+		pfd[1].revents = 0;
+		if(poll(pfd, 2, 20) <= 0){
+			continue;
+		}
+		if(pfd[0].revents & POLLIN){
+			int client = accept(listen_, nullptr, nullptr);
+			if(client >= 0){
+				// a new client replaces the previous one
+				if(pfd[1].fd >= 0){
+					close(pfd[1].fd);
+				}
+				int one = 1;
+				setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+				pfd[1].fd = client;
+				connections_++;
+			}
+			continue;
+		}
+		if(!(pfd[1].revents & (POLLIN | POLLHUP | POLLERR))){
+			continue;
+		}
+		ssize_t n = read(pfd[1].fd, in, sizeof(in));
+		if(n <= 0){
+			close(pfd[1].fd);
+			pfd[1].fd = -1;
+			continue;
+		}
+		reads_++;
+		unsigned produced;
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			sim_->setTime(std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count());
+			produced = sim_->process(in, (unsigned) n, out, sizeof(out));
+		}
+		unsigned written = 0;
+		while(written < produced){
+			ssize_t w = write(pfd[1].fd, out + written, produced - written);
+			if(w <= 0){
+				break;
+			}
+			written += w;
+		}
+	}
+	if(pfd[1].fd >= 0){
+		close(pfd[1].fd);
+	}
+}
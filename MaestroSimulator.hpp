@@ -0,0 +1,307 @@
+//============================================================================
+// Name        : MaestroSimulator.hpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : MaestroSimulator header file. It contains a software model
+//               of the Maestro servo controller (serial protocol and servo
+//               motion) and a pseudo terminal front-end, so the complete
+//               stack can be exercised without hardware.
+//============================================================================
+#ifndef MAESTROSIMULATOR_HPP_INCLUDED
+#define MAESTROSIMULATOR_HPP_INCLUDED
+
+#include <string>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include "ServoModel.hpp"
+
+using namespace std;
+
+
+/**
+ *
+ * \class MaestroSimulator
+ *
+ * \brief Emulates the compact serial protocol of a Maestro controller
+ * (https://www.pololu.com/docs/0J40/5.e) and the motion of the servos.
+ *
+ * Bytes sent by the host are handed over to process(...), the bytes the
+ * controller would answer are delivered in the output buffer. The motion
+ * of the servos follows the speed and acceleration limits in steps of
+ * 10 ms, the model time is set by the owner via setTime(...).
+ *
+ */
+class MaestroSimulator {
+public:
+
+	/**
+	 * \brief Maximal number of channels of the largest Maestro.
+	 */
+	static const unsigned MAX_CHANNELS = 24;
+
+	/**
+	 *
+	 * \brief Constructor
+	 *
+	 * \param channels unsigned. Number of servo channels (<= MAX_CHANNELS).
+	 * \param neutral unsigned short. Initial position and target of all
+	 *                channels (in units of 1/4 micro seconds).
+	 *
+	 */
+	MaestroSimulator(unsigned channels = 6, unsigned short neutral = 6000);
+
+	/**
+	 *
+	 * \brief Feeds bytes received from the host into the controller model.
+	 *
+	 * \param in const unsigned char*. Bytes sent by the host.
+	 * \param sizeIn unsigned. Number of bytes.
+	 * \param out unsigned char*. Buffer for the reply bytes.
+	 * \param sizeOut unsigned. Capacity of the reply buffer.
+	 *
+	 * \return unsigned. Number of reply bytes written to out.
+	 *
+	 */
+	unsigned process(const unsigned char *in, unsigned sizeIn, unsigned char *out, unsigned sizeOut);
+
+	/**
+	 *
+	 * \brief Advances the motion model to the given model time
+	 * (micro seconds). Earlier times are ignored.
+	 *
+	 */
+	void setTime(unsigned long long timeUs);
+
+	unsigned long long getTime(){return timeUs_;};
+
+	unsigned short getPosition(unsigned channel);
+	unsigned short getTarget(unsigned channel);
+	unsigned short getSpeed(unsigned channel);
+	unsigned short getAcceleration(unsigned channel);
+	bool           isMoving();
+
+	/**
+	 *
+	 * \brief Sets position and target of a channel without motion.
+	 *
+	 */
+	void setPosition(unsigned channel, unsigned short position);
+
+	/**
+	 *
+	 * \brief Neutral and range settings of a channel (in units of 1/4
+	 * micro seconds) used to map the 8 bit Mini SSC targets.
+	 *
+	 */
+	void setMiniSscRange(unsigned channel, unsigned short neutral, unsigned short range);
+
+	/**
+	 *
+	 * \brief Dynamics of the servo of a channel (dead time, effective
+	 * speed and acceleration), e.g. fitted by the servoFit tool. Per
+	 * default the servos follow the limits of the controller exactly.
+	 *
+	 */
+	void setServoModel(unsigned channel, const ServoModelParams &params);
+
+	/**
+	 *
+	 * \brief Loads the servo models of a parameter file (see
+	 * ServoModelFile), lines of unknown channels are ignored. If the
+	 * file cannot be read an exception (IException) is thrown.
+	 *
+	 * \return unsigned. Number of channels set.
+	 *
+	 */
+	unsigned loadServoModels(const string &filename);
+
+	/**
+	 *
+	 * \brief Sets error bits as the firmware would do. The bits are
+	 * cleared when the host reads the error register.
+	 *
+	 */
+	void injectErrors(unsigned short errorBits){errors_ |= errorBits;};
+
+	unsigned short peekErrors(){return errors_;};
+
+	/**
+	 *
+	 * \brief Expects a CRC-7 byte after every command ("Enable CRC").
+	 * Commands with a wrong CRC are dropped and raise the serial CRC
+	 * error bit.
+	 *
+	 */
+	void setCrcEnabled(bool enabled){crc_ = enabled; frameLen_ = 0;};
+
+	unsigned long getCommandCount(){return commands_;};
+	unsigned long getBytesIn(){return bytesIn_;};
+	unsigned long getBytesOut(){return bytesOut_;};
+
+	/**
+	 * \brief Number of commands answered, i.e. the round trips of the host.
+	 */
+	unsigned long getReplyCount(){return replies_;};
+
+protected:
+
+	/**
+	 * \brief State of one servo channel, positions in 1/4 micro seconds.
+	 */
+	struct Channel {
+		float          position;
+		float          velocity;  // units per 10 ms
+		unsigned short target;
+		unsigned short speed;
+		unsigned short acceleration;
+		unsigned short miniSscNeutral;
+		unsigned short miniSscRange;
+		ServoModel     model;
+		bool           pending;       // target waits for the dead time
+		unsigned short pendingTarget;
+		unsigned long long pendingAtUs;
+	};
+
+	void step(Channel &c);
+	void setTarget(Channel &c, unsigned short target);
+	unsigned commandLength(unsigned char cmd);
+	unsigned execute(unsigned char *out, unsigned sizeOut);
+
+	unsigned           channels_;
+	Channel            channel_[MAX_CHANNELS];
+	unsigned long long timeUs_   = 0;
+	unsigned long long nowUs_    = 0; // last time given to setTime
+	unsigned short     errors_   = 0;
+	unsigned char      frame_[8];
+	unsigned           frameLen_ = 0;
+	bool               crc_      = false;
+	unsigned long      commands_ = 0;
+	unsigned long      bytesIn_  = 0;
+	unsigned long      bytesOut_ = 0;
+	unsigned long      replies_  = 0;
+};
+
+
+/**
+ *
+ * \class MaestroPty
+ *
+ * \brief Serves a MaestroSimulator on a pseudo terminal. The name of the
+ * slave side (e.g. /dev/pts/3) is used as port name of SerialCom, the
+ * simulator runs in a thread on the master side. The model time follows
+ * the wall clock.
+ *
+ */
+class MaestroPty {
+public:
+	MaestroPty(MaestroSimulator *sim);
+	~MaestroPty();
+
+	/**
+	 *
+	 * \brief Creates the pseudo terminal and starts the thread.
+	 * If an error occurs an exception (IException) is thrown.
+	 *
+	 */
+	void start();
+
+	void stop();
+
+	/**
+	 *
+	 * \brief Port name to be used by the host side.
+	 *
+	 */
+	const char* getPortName(){return slaveName_.c_str();};
+
+	/**
+	 *
+	 * \brief Serializes access to the simulator from other threads.
+	 *
+	 */
+	std::mutex& getMutex(){return mutex_;};
+
+	/**
+	 *
+	 * \brief Emulates the byte rate of a serial line: received bytes are
+	 * processed and replies are written after their time on the wire
+	 * (10 bits per byte). A pseudo terminal itself has no byte rate,
+	 * 0 (default) keeps it unlimited.
+	 *
+	 */
+	void setBaudRate(unsigned baudRate){baudRate_ = baudRate;};
+
+protected:
+	void run();
+
+	MaestroSimulator *sim_;
+	std::atomic<unsigned> baudRate_{0};
+	int               master_ = -1;
+	int               slave_  = -1;
+	string            slaveName_;
+	std::thread       thread_;
+	std::atomic<bool> running_;
+	std::mutex        mutex_;
+};
+
+
+/**
+ *
+ * \class MaestroSocketServer
+ *
+ * \brief Serves a MaestroSimulator like a serial server (e.g. ser2net)
+ * on a TCP or Unix-domain stream socket, the counterpart of
+ * SerialComSocket. One client is served at a time, the model time
+ * follows the wall clock.
+ *
+ */
+class MaestroSocketServer {
+public:
+	MaestroSocketServer(MaestroSimulator *sim);
+	~MaestroSocketServer();
+
+	/**
+	 *
+	 * \brief Listens on the given address and starts the thread.
+	 * The address is given like the port name of SerialComSocket,
+	 * "tcp:127.0.0.1:0" selects a free port. If an error occurs an
+	 * exception (IException) is thrown.
+	 *
+	 */
+	void start(const string &address = string("tcp:127.0.0.1:0"));
+
+	void stop();
+
+	/**
+	 *
+	 * \brief Port name to be used by the host side, e.g. tcp:127.0.0.1:40211.
+	 *
+	 */
+	const char* getPortName(){return portName_.c_str();};
+
+	std::mutex& getMutex(){return mutex_;};
+
+	/**
+	 * \brief Number of chunks read from the clients, i.e. the writes
+	 * of the host side as far as the stream preserved them.
+	 */
+	unsigned long getReads(){return reads_;};
+
+	unsigned long getConnections(){return connections_;};
+
+protected:
+	void run();
+
+	MaestroSimulator *sim_;
+	int               listen_ = -1;
+	string            portName_;
+	string            unixPath_;
+	std::thread       thread_;
+	std::atomic<bool> running_;
+	std::mutex        mutex_;
+	std::atomic<unsigned long> reads_{0};
+	std::atomic<unsigned long> connections_{0};
+};
+
+#endif // MAESTROSIMULATOR_HPP_INCLUDED
@@ -0,0 +1,162 @@
+//============================================================================
+// Name        : PerfCounters.cpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : PerfCounters source file. It contains the definition of the
+//               functions of the PerfCounters and PerfScope classes.
+//============================================================================
+#include "PerfCounters.hpp"
+#include <sstream>
+#include <iomanip>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <ctime>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+
+static const struct {
+	uint32_t    type;
+	uint64_t    config;
+	const char *name;
+} perfEvents[PERF_EVENT_COUNT] = {
+	{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES,       "cycles"},
+	{PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS,     "instructions"},
+	{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES,     "cache-misses"},
+	{PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES,    "branch-misses"},
+	{PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK,       "task-clock"}
+};
+
+// value, time enabled, time running (PERF_FORMAT_TOTAL_TIME_*)
+struct PerfReadFormat {
+	uint64_t value;
+	uint64_t enabled;
+	uint64_t running;
+};
+
+
+PerfCounters::PerfCounters(){
+	const char *env = getenv("MEX_PERF");
+	bool off = (env != nullptr) && (strcmp(env, "0") == 0);
+	if(off){
+		reason_ = "MEX_PERF=0";
+	}
+
+	for(unsigned e = 0; e < PERF_EVENT_COUNT; e++){
+		fd_[e] = -1;
+		if(off){
+			continue;
+		}
+		struct perf_event_attr attr;
+		memset(&attr, 0, sizeof(attr));
+		attr.size           = sizeof(attr);
+		attr.type           = perfEvents[e].type;
+		attr.config         = perfEvents[e].config;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv     = 1;
+		attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+		// calling thread, any CPU, no group
+		fd_[e] = syscall(__NR_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC);
+		if(fd_[e] < 0){
+			if(!reason_.empty()){
+				reason_ += ", ";
+			}
+			reason_ += string(perfEvents[e].name) + ": " + strerror(errno);
+		}
+	}
+}
+
+PerfCounters::~PerfCounters(){
+	for(unsigned e = 0; e < PERF_EVENT_COUNT; e++){
+		if(fd_[e] >= 0){
+			close(fd_[e]);
+		}
+	}
+}
+
+bool PerfCounters::hasHardware() const {
+	for(unsigned e = 0; e < PERF_EVENT_COUNT; e++){
+		if((perfEvents[e].type == PERF_TYPE_HARDWARE) && (fd_[e] >= 0)){
+			return true;
+		}
+	}
+	return false;
+}
+
+PerfSample PerfCounters::read() const {
+	PerfSample s;
+	for(unsigned e = 0; e < PERF_EVENT_COUNT; e++){
+		PerfReadFormat r;
+		if((fd_[e] < 0) || (::read(fd_[e], &r, sizeof(r)) != sizeof(r))){
+			continue;
+		}
+		s.valid[e] = true;
+		if((r.running > 0) && (r.running < r.enabled)){
+			r.value = (uint64_t) ((double) r.value * r.enabled / r.running);
+		}
+		s.value[e] = r.value;
+	}
+	if(!s.valid[PERF_TASK_CLOCK]){
+		struct timespec ts;
+		clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+		s.value[PERF_TASK_CLOCK] = ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+		s.valid[PERF_TASK_CLOCK] = true;
+	}
+	return s;
+}
+
+const char* PerfCounters::name(PerfEvent e){
+	return ((unsigned) e < PERF_EVENT_COUNT) ? perfEvents[e].name : "?";
+}
+
+
+
+double PerfSample::ipc() const {
+	if(!valid[PERF_CYCLES] || !valid[PERF_INSTRUCTIONS] || (value[PERF_CYCLES] == 0)){
+		return 0.0;
+	}
+	return (double) value[PERF_INSTRUCTIONS] / value[PERF_CYCLES];
+}
+
+string PerfSample::toString() const {
+	stringstream ss;
+	ss << fixed << setprecision(2);
+	for(unsigned e = 0; e < PERF_EVENT_COUNT; e++){
+		ss << setw(16);
+		if(valid[e]){
+			ss << perOp((PerfEvent) e);
+		}else{
+			ss << "n/a";
+		}
+	}
+	ss << setw(8);
+	if(valid[PERF_CYCLES] && valid[PERF_INSTRUCTIONS]){
+		ss << ipc();
+	}else{
+		ss << "n/a";
+	}
+	return ss.str();
+}
+
+string perfHeader(){
+	stringstream ss;
+	ss << setw(16) << "cycles/op" << setw(16) << "instr/op" << setw(16) << "cache-miss/op"
+	   << setw(16) << "branch-miss/op" << setw(16) << "ns/op" << setw(8) << "IPC";
+	return ss.str();
+}
+
+
+
+PerfScope::~PerfScope(){
+	PerfSample end = counters_.read();
+	for(unsigned e = 0; e < PERF_EVENT_COUNT; e++){
+		if(start_.valid[e] && end.valid[e]){
+			// scaled values of multiplexed counters may step back
+			sum_.value[e] += (end.value[e] > start_.value[e]) ? (end.value[e] - start_.value[e]) : 0;
+			sum_.valid[e] = true;
+		}
+	}
+	sum_.ops += ops_;
+}
@@ -0,0 +1,134 @@
+//============================================================================
+// Name        : PerfCounters.hpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : PerfCounters header file. It contains the hardware
+//               performance counters of the calling thread (perf_event_open)
+//               and a scope accumulating cycles, instructions, cache misses
+//               and branch misses per operation.
+//============================================================================
+#ifndef PERFCOUNTERS_HPP_INCLUDED
+#define PERFCOUNTERS_HPP_INCLUDED
+
+#include <string>
+#include <ostream>
+#include <cstdint>
+
+using namespace std;
+
+
+/**
+ * \brief Events counted. The task clock is always valid: without perf
+ * events it is the CPU time of the thread.
+ */
+enum PerfEvent {
+	PERF_CYCLES = 0,
+	PERF_INSTRUCTIONS,
+	PERF_CACHE_MISSES,
+	PERF_BRANCH_MISSES,
+	PERF_TASK_CLOCK,    /**< nano seconds */
+	PERF_EVENT_COUNT
+};
+
+
+/**
+ * \brief Counter values (or the sum of scope differences) and the number
+ * of operations they cover.
+ */
+struct PerfSample {
+	uint64_t      value[PERF_EVENT_COUNT] = {0, 0, 0, 0, 0};
+	bool          valid[PERF_EVENT_COUNT] = {false, false, false, false, false};
+	unsigned long ops = 0;
+
+	/**
+	 * \brief Value per operation, 0.0 without operations.
+	 */
+	double perOp(PerfEvent e) const {return (ops > 0) ? ((double) value[e] / ops) : 0.0;};
+
+	/**
+	 * \brief Instructions per cycle, 0.0 if one of both is not counted.
+	 */
+	double ipc() const;
+
+	/**
+	 * \brief One line: the values per operation, "n/a" for events not counted.
+	 */
+	string toString() const;
+};
+
+
+/**
+ *
+ * \class PerfCounters
+ *
+ * \brief Opens the events for the calling thread (user space only). Each
+ * event is opened on its own: an event the kernel, the virtual machine or
+ * perf_event_paranoid does not allow is left out, the others are counted.
+ * The environment variable MEX_PERF=0 turns all perf events off.
+ *
+ * A read costs one system call per event: wrap loops, not single
+ * operations, into a PerfScope.
+ *
+ */
+class PerfCounters {
+public:
+	PerfCounters();
+	~PerfCounters();
+
+	bool isCounted(PerfEvent e) const {return fd_[e] >= 0;};
+
+	/**
+	 * \brief True if at least one hardware event is counted.
+	 */
+	bool hasHardware() const;
+
+	/**
+	 * \brief Why events are not counted, empty if all are.
+	 */
+	string getUnavailableReason() const {return reason_;};
+
+	/**
+	 * \brief Current values, scaled if the kernel multiplexed the counters.
+	 */
+	PerfSample read() const;
+
+	static const char* name(PerfEvent e);
+
+protected:
+	int    fd_[PERF_EVENT_COUNT];
+	string reason_;
+
+private:
+	PerfCounters(const PerfCounters&);
+	PerfCounters& operator=(const PerfCounters&);
+};
+
+
+/**
+ *
+ * \class PerfScope
+ *
+ * \brief Adds the counter differences of its lifetime and the given number
+ * of operations to a sample.
+ *
+ */
+class PerfScope {
+public:
+	PerfScope(const PerfCounters &counters, PerfSample &sum, unsigned long ops = 1)
+		: counters_(counters), sum_(sum), ops_(ops), start_(counters.read()){};
+	~PerfScope();
+
+protected:
+	const PerfCounters &counters_;
+	PerfSample         &sum_;
+	unsigned long       ops_;
+	PerfSample          start_;
+};
+
+
+/**
+ * \brief Header of the columns of PerfSample::toString().
+ */
+string perfHeader();
+
+#endif // PERFCOUNTERS_HPP_INCLUDED
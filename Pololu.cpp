@@ -7,8 +7,41 @@
 //============================================================================
 #include "Pololu.hpp"
 #include "SerialCom.hpp"
+#include "SerialComRegistry.hpp"
+#include "PololuFrames.hpp"
+#include "PololuStats.hpp"
+#include "BinLog.hpp"
+#include "Trace.hpp"
+#include "Instrument.hpp"
 #include <string>
 #include <iostream>
+#include <chrono>
+#include <thread>
+#include <mutex>
+
+/*
+ * Plausibility checks of the replies, see PololuReplyParser::isPlausible.
+ */
+static bool isPositionReply(const unsigned char *reply, unsigned short){
+	return PololuReplyParser::isPlausible(POLOLU_REPLY_POSITION,
+			PololuReplyParser::decode(POLOLU_REPLY_POSITION, reply));
+}
+
+static bool isMovingStateReply(const unsigned char *reply, unsigned short size){
+	if(!PololuReplyParser::isPlausible(POLOLU_REPLY_MOVING_STATE,
+			PololuReplyParser::decode(POLOLU_REPLY_MOVING_STATE, reply))){
+		return false;
+	}
+	// moving state combined with the error request (see getMovingState)
+	return ((size < 3) || PololuReplyParser::isPlausible(POLOLU_REPLY_ERRORS,
+			PololuReplyParser::decode(POLOLU_REPLY_ERRORS, reply + 1)));
+}
+
+static bool isErrorReply(const unsigned char *reply, unsigned short){
+	return PololuReplyParser::isPlausible(POLOLU_REPLY_ERRORS,
+			PololuReplyParser::decode(POLOLU_REPLY_ERRORS, reply));
+}
+
 
 Pololu::Pololu(){
 	throw new ExceptionPololu(string("This unparameterized constructor shall not be called."));
@@ -18,7 +51,9 @@ Pololu::Pololu(){
 Pololu::Pololu(const char* portName, unsigned short baudRate){
 	try{
 		isComPortOpen_ = false;
-		serialCom_ = new SerialCom(portName, baudRate);
+		retryPolicies_[POLOLU_CMD_GET_ERRORS] = RetryPolicy(5, 0, 1000, 8000);
+		// instances addressing the same device share its connection
+		serialCom_ = SerialComRegistry::instance().acquire(portName, baudRate);
 		if(serialCom_ == nullptr){
 			string msg("Pololu(Contructor)::Could not create a SerialCom instance.");
 			throw new ExceptionPololu(msg);
@@ -32,8 +67,20 @@ Pololu::Pololu(const char* portName, unsigned short baudRate){
 }
 
 
+Pololu::Pololu(ISerialCom *serialCom){
+	if(serialCom == nullptr){
+		string msg("Pololu(Contructor)::The serial connection is a NULL pointer.");
+		throw new ExceptionPololu(msg);
+	}
+	isComPortOpen_ = false;
+	retryPolicies_[POLOLU_CMD_GET_ERRORS] = RetryPolicy(5, 0, 1000, 8000);
+	serialCom_ = serialCom;
+	ownsSerialCom_ = false;
+}
+
+
 Pololu::~Pololu(){
-	if(serialCom_ != nullptr){
+	if((serialCom_ != nullptr) && ownsSerialCom_){
 		serialCom_->closeSerialCom();
 		delete serialCom_;
 	}
@@ -94,6 +141,8 @@ void Pololu::initConnection(const char* portName, unsigned short baudRate){
 
 
 unsigned short Pololu::setPosition(unsigned short servo, unsigned short goToPosition){
+	MEX_TRACE_SPAN_ARG("Pololu::setPosition", servo);
+	MEX_INSTRUMENT_CALL("Pololu::setPosition");
 	if(!isComPortOpen_){
 		string msg("setPosition:: serial communication port is closed. ");
 		msg += string("First call copenConnection methods.");
@@ -106,11 +155,11 @@ unsigned short Pololu::setPosition(unsigned short servo, unsigned short goToPosi
      * servo = servo to address as a transfer parameter
      * goToPositiion = divided into 2 bytes, first the low bits, then the high bits
      */
-    unsigned short sizeCommand = 4;
-    unsigned char command[] = {0x84, (unsigned char)servo, (unsigned char)(goToPosition & 0x7F), (unsigned char)((goToPosition >> 7) & 0x7F)};
+    unsigned char command[POLOLU_MAX_FRAME];
+    unsigned short sizeCommand = PololuFrames::setTarget(command, servo, goToPosition, crcEnabled_);
     try
     {
-        serialCom_->writeSerialCom(command, sizeCommand, NULL, 0);
+        this->transfer(POLOLU_CMD_SET_POSITION, command, sizeCommand, NULL, 0);
     }catch (IException *e){
         string msg("setPosition::error while sending the position data.");
         msg += e->getMsg();
@@ -123,11 +172,55 @@ unsigned short Pololu::setPosition(unsigned short servo, unsigned short goToPosi
         string msg("setPosition::unknown error while sending the position data.");
         throw new ExceptionPololu(msg);
     }
+    if(stats_ != nullptr){
+    	stats_->recordTarget(servo, goToPosition);
+    }
     return goToPosition;
 }
 
 
+unsigned char Pololu::setPositionMiniSsc(unsigned short servo, unsigned char target){
+	MEX_TRACE_SPAN_ARG("Pololu::setPositionMiniSsc", servo);
+	MEX_INSTRUMENT_CALL("Pololu::setPositionMiniSsc");
+	if(!isComPortOpen_){
+		string msg("setPositionMiniSsc:: serial communication port is closed. ");
+		msg += string("First call copenConnection methods.");
+		throw new ExceptionPololu(msg);
+	}
+	if(target > 254){
+		string msg("setPositionMiniSsc:: target 255 is reserved for the command byte.");
+		throw new ExceptionPololu(msg);
+	}
+
+    /* Generates the command for the controller.
+     * 0xFF = Mini SSC command for setting the position
+     * servo = servo to address as a transfer parameter
+     * target = 8 bit target relative to the neutral and range of the channel
+     */
+    unsigned char command[POLOLU_MAX_FRAME];
+    unsigned short sizeCommand = PololuFrames::miniSscTarget(command, servo, target, crcEnabled_);
+    try
+    {
+        this->transfer(POLOLU_CMD_SET_POSITION, command, sizeCommand, NULL, 0);
+    }catch (IException *e){
+        string msg("setPositionMiniSsc::error while sending the position data.");
+        msg += e->getMsg();
+        throw new ExceptionPololu(msg);
+    }catch (std::string &errorMessage){
+        string msg("setPositionMiniSsc::error while sending the position data.");
+        msg += errorMessage;
+        throw new ExceptionPololu(msg);
+    }catch(...){
+        string msg("setPositionMiniSsc::unknown error while sending the position data.");
+        throw new ExceptionPololu(msg);
+    }
+    return target;
+}
+
+
 bool Pololu::setSpeed(unsigned short servo, unsigned short goToSpeed){
+	MEX_TRACE_SPAN_ARG("Pololu::setSpeed", servo);
+	MEX_INSTRUMENT_CALL("Pololu::setSpeed");
 	if(!isComPortOpen_){
 		string msg("setSpeed:: serial communication port is closed");
 		msg += string("First call copenConnection.");
@@ -140,11 +233,11 @@ bool Pololu::setSpeed(unsigned short servo, unsigned short goToSpeed){
      * servo = servo to address as a transfer parameter
      * goToSpeed = divided into 2 bytes, first the low bits, then the high bits
      */
-    unsigned short sizeCommand = 4;
-    unsigned char command[] = {0x87, (unsigned char)servo, (unsigned char)(goToSpeed & 0x7F), (unsigned char)((goToSpeed >> 7) & 0x7F)};
+    unsigned char command[POLOLU_MAX_FRAME];
+    unsigned short sizeCommand = PololuFrames::setSpeed(command, servo, goToSpeed, crcEnabled_);
     try
     {
-        serialCom_->writeSerialCom(command, sizeCommand, NULL, 0);
+        this->transfer(POLOLU_CMD_SET_SPEED, command, sizeCommand, NULL, 0);
     }catch (IException *e){
         string msg("setSpeed::error while sending the max speed data.");
         msg += e->getMsg();
@@ -162,6 +255,8 @@ bool Pololu::setSpeed(unsigned short servo, unsigned short goToSpeed){
 
 
 bool Pololu::setAcceleration(unsigned short servo, unsigned short goToAcceleration){
+	MEX_TRACE_SPAN_ARG("Pololu::setAcceleration", servo);
+	MEX_INSTRUMENT_CALL("Pololu::setAcceleration");
 	if(!isComPortOpen_){
 		string msg("setAcceleration:: serial communication port is closed");
 		msg += string("First call copenConnection.");
@@ -174,12 +269,11 @@ bool Pololu::setAcceleration(unsigned short servo, unsigned short goToAccelerati
      * servo = servo to address as a transfer parameter
      * goToAcceleration = divided into 2 bytes, first the low bits, then the high bits
      */
-    unsigned short sizeCommand = 4;
-
-    unsigned char command[] = {0x89, (unsigned char)servo, (unsigned char)(goToAcceleration & 0x7F), (unsigned char)((goToAcceleration >> 7) & 0x7F)};
+    unsigned char command[POLOLU_MAX_FRAME];
+    unsigned short sizeCommand = PololuFrames::setAcceleration(command, servo, goToAcceleration, crcEnabled_);
     try
     {
-        serialCom_->writeSerialCom(command, sizeCommand, NULL, 0);
+        this->transfer(POLOLU_CMD_SET_ACCELERATION, command, sizeCommand, NULL, 0);
     }catch (IException *e){
         string msg("setAcceleration::error while sending the max acceleration data.");
         msg += e->getMsg();
@@ -196,6 +290,8 @@ bool Pololu::setAcceleration(unsigned short servo, unsigned short goToAccelerati
 }
 
 unsigned short Pololu::getPosition(unsigned short servo){
+	MEX_TRACE_SPAN_ARG("Pololu::getPosition", servo);
+	MEX_INSTRUMENT_CALL("Pololu::getPosition");
 	if(!isComPortOpen_){
 		string msg("getPosition:: serial communication port is closed");
 		msg += string("First call copenConnection.");
@@ -207,14 +303,14 @@ unsigned short Pololu::getPosition(unsigned short servo){
      * 0x90 = Pololu command for reading out the position
      * servo = servo to address as a transfer parameter
      */
-    unsigned short sizeCommand = 2;
     unsigned short sizeResponse = 2;
     unsigned char response[sizeResponse];
 
-    unsigned char command[] = {0x90, (unsigned char)servo};
+    unsigned char command[POLOLU_MAX_FRAME];
+    unsigned short sizeCommand = PololuFrames::getPosition(command, servo, crcEnabled_);
     try
     {
-        serialCom_->writeSerialCom(command, sizeCommand, response, sizeResponse);
+        this->transfer(POLOLU_CMD_GET_POSITION, command, sizeCommand, response, sizeResponse, isPositionReply);
     }catch (IException *e){
         string msg("getPosition::error while sending the 'get position' data:");
         msg += e->getMsg();
@@ -228,11 +324,106 @@ unsigned short Pololu::getPosition(unsigned short servo){
         throw new ExceptionPololu(msg);
     }
 
-    return response[0] + 256 * response[1];
+    unsigned short position = PololuReplyParser::decode(POLOLU_REPLY_POSITION, response);
+    if(stats_ != nullptr){
+    	stats_->recordPosition(servo, position);
+    }
+    return position;
+}
+
+
+void Pololu::getPositions(const unsigned short servos[], unsigned short count, unsigned short positions[]){
+	MEX_TRACE_SPAN_ARG("Pololu::getPositions", count);
+	MEX_INSTRUMENT_CALL("Pololu::getPositions");
+	if(!isComPortOpen_){
+		string msg("getPositions:: serial communication port is closed");
+		msg += string("First call copenConnection.");
+		throw new ExceptionPololu(msg);
+	}
+	if(count > POLOLU_MAX_PIPELINED){
+		string msg("getPositions:: too many servos, at most POLOLU_MAX_PIPELINED requests can be pipelined.");
+		throw new ExceptionPololu(msg);
+	}
+	if(count == 0){
+		return;
+	}
+
+    /* All 0x90 requests are sent with one write, the replies are collected
+     * in the receive ring and sliced out in the order of the requests.
+     */
+    unsigned char command[POLOLU_MAX_FRAME * POLOLU_MAX_PIPELINED];
+    unsigned short sizeCommand = 0;
+    for(unsigned short i = 0; i < count; i++){
+    	sizeCommand += PololuFrames::getPosition(command + sizeCommand, (unsigned char)servos[i], crcEnabled_);
+    }
+
+    RetryStats &stats = retryStats_[POLOLU_CMD_GET_POSITION];
+    bool pipelined = false;
+    bool received  = false;
+    std::lock_guard<ISerialCom> guard(*serialCom_); // requests and replies must not interleave with other users
+    unsigned long long start = clock_->nowUs();
+    try
+    {
+    	stats.calls++;
+    	stats.attempts++;
+    	serialCom_->setReplyTimeout(retryPolicies_[POLOLU_CMD_GET_POSITION].attemptTimeoutUs);
+    	serialCom_->discardInput();
+    	replyParser_.reset();
+    	for(unsigned short i = 0; i < count; i++){
+    		replyParser_.expect(POLOLU_REPLY_POSITION);
+    	}
+    	serialCom_->sendSerialCom(command, sizeCommand);
+    	if(serialCom_->receiveSerialCom(replyParser_.getBytesExpected(), sizeCommand)){
+    		received  = true;
+    		pipelined = true;
+    		PololuReply reply;
+    		for(unsigned short i = 0; i < count; i++){
+    			replyParser_.next(serialCom_->getRxRing(), reply);
+    			pipelined = pipelined && reply.plausible;
+    			positions[i] = reply.value;
+    		}
+    	}
+    }catch (IException *e){
+        string msg("getPositions::error while sending the 'get position' data:");
+        msg += e->getMsg();
+        throw new ExceptionPololu(msg);
+    }catch (std::string &errorMessage){
+        string msg("getPositions::error while sending the 'get position' data:");
+        msg += errorMessage;
+        throw new ExceptionPololu(msg);
+    }catch(...){
+        string msg("getPositions:: unknown error while sending the 'get position' data.");
+        throw new ExceptionPololu(msg);
+    }
+
+    if(pipelined && (stats_ != nullptr)){
+    	stats_->recordTransfer(POLOLU_CMD_GET_POSITION, sizeCommand, count * 2, clock_->nowUs() - start);
+    	for(unsigned short i = 0; i < count; i++){
+    		stats_->recordPosition(servos[i], positions[i]);
+    	}
+    }
+
+    if(!pipelined){
+    	// lost or implausible replies: recover in-band and fall back to
+    	// single requests with their retry policy
+    	if(received){
+    		stats.impossibleReplies++;
+    	}else{
+    		stats.timeouts++;
+    	}
+    	stats.resyncs++;
+    	replyParser_.reset();
+    	serialCom_->resynchronize();
+    	for(unsigned short i = 0; i < count; i++){
+    		positions[i] = this->getPosition(servos[i]);
+    	}
+    }
 }
 
 
 bool Pololu::getMovingState(){
+	MEX_TRACE_SPAN("Pololu::getMovingState");
+	MEX_INSTRUMENT_CALL("Pololu::getMovingState");
 	if(!isComPortOpen_){
 		string msg("getMovingState:: serial communication port is closed");
 		msg += string("First call copenConnection.");
@@ -241,15 +432,21 @@ bool Pololu::getMovingState(){
 
     /* Generates the command for the controller.
      * 0x93 = Pololu command for reading out the movement of all servos
+     * 0xA1 = Pololu command for reading out error flags, appended
+     *        if the error monitor asks for a poll within this idle slot
      */
-    unsigned short sizeCommand = 1;
-    unsigned short sizeResponse = 1;
-    unsigned char response[sizeResponse];
-
-    unsigned char command[] = {0x93};
+    bool pollErrors = (errorMonitor_ != nullptr) && errorMonitor_->isPollDue();
+    unsigned short sizeResponse = pollErrors ? 3 : 1;
+    unsigned char response[3];
+
+    unsigned char command[2 * POLOLU_MAX_FRAME];
+    unsigned short sizeCommand = PololuFrames::getMovingState(command, crcEnabled_);
+    if(pollErrors){
+    	sizeCommand += PololuFrames::getErrors(command + sizeCommand, crcEnabled_);
+    }
     try
     {
-        serialCom_->writeSerialCom(command, sizeCommand, response, sizeResponse);
+        this->transfer(POLOLU_CMD_GET_MOVING_STATE, command, sizeCommand, response, sizeResponse, isMovingStateReply);
     }catch (IException *e){
         string msg("getMovingState:: error while sending the 'moving state' data:");
         msg += e->getMsg();
@@ -262,12 +459,26 @@ bool Pololu::getMovingState(){
         string msg("getMovingState:: unknown error while sending the 'moving state' data.");
         throw new ExceptionPololu(msg);
     }
-    return response[0];
+
+    bool moving = PololuReplyParser::decode(POLOLU_REPLY_MOVING_STATE, response);
+    if(pollErrors){
+    	unsigned short errors = PololuReplyParser::decode(POLOLU_REPLY_ERRORS, response + 1);
+    	errorMonitor_->update(errors);
+    	if(stats_ != nullptr){
+    		stats_->recordErrors(errors);
+    	}
+    }
+    if(stats_ != nullptr){
+    	stats_->recordMoving(moving);
+    }
+    return moving;
 }
 
 
 
 unsigned short Pololu::getErrors(){
+	MEX_TRACE_SPAN("Pololu::getErrors");
+	MEX_INSTRUMENT_CALL("Pololu::getErrors");
 	if(!isComPortOpen_){
 		string msg("getMovingState:: serial communication port is closed");
 		msg += string("First call copenConnection.");
@@ -277,41 +488,140 @@ unsigned short Pololu::getErrors(){
     /* Generates the command for the controller.
      * 0xA1 = Pololu command for reading out error flags
      */
-    unsigned short sizeCommand = 1;
     unsigned short sizeResponse = 2;
     unsigned char response[sizeResponse];
 
-    unsigned char command[] = {0xA1};
-
-    int counter = 0;
-    int limit = 5;
-    while(1){
-    	try
-    	{
-    		counter++;
-     		serialCom_->writeSerialCom(command, sizeCommand, response, sizeResponse);
-     		break;
-    	}catch (IException *e){
-    		if(counter < limit){
-    			continue;
-    		};
-    		string msg("getErrors:: error while trying to read error data:");
-    		msg += e->getMsg();
-    		throw new ExceptionPololu(msg);
-    	}catch (std::string &errorMessage){
-       		if(counter < limit){
-        			continue;
-        	};
-    		string msg("getErrors:: error while trying to read error data:");
-    		msg += errorMessage;
-    		throw new ExceptionPololu(msg);
-    	}catch(...){
-       		if(counter < limit){
-        			continue;
-        	};
-    		string msg("getErrors:: unknown error while trying to read error data.");
-    		throw new ExceptionPololu(msg);
-    	}
+    unsigned char command[POLOLU_MAX_FRAME];
+    unsigned short sizeCommand = PololuFrames::getErrors(command, crcEnabled_);
+
+    try
+    {
+        this->transfer(POLOLU_CMD_GET_ERRORS, command, sizeCommand, response, sizeResponse, isErrorReply);
+    }catch (IException *e){
+        string msg("getErrors:: error while trying to read error data:");
+        msg += e->getMsg();
+        throw new ExceptionPololu(msg);
+    }catch (std::string &errorMessage){
+        string msg("getErrors:: error while trying to read error data:");
+        msg += errorMessage;
+        throw new ExceptionPololu(msg);
+    }catch(...){
+        string msg("getErrors:: unknown error while trying to read error data.");
+        throw new ExceptionPololu(msg);
+    }
+    unsigned short errors = PololuReplyParser::decode(POLOLU_REPLY_ERRORS, response);
+    if(errorMonitor_ != nullptr){
+    	errorMonitor_->update(errors);
     }
-    return response[0] + (256 * response[1]);
+    if(stats_ != nullptr){
+    	stats_->recordErrors(errors);
+    }
+    return errors;
+}
+
+
+PololuErrorFlags Pololu::getErrorFlags(){
+	return PololuErrorFlags(this->getErrors());
+}
+
+
+
+void Pololu::transfer(PololuCommand id, unsigned char command[], unsigned short sizeCommand,
+					  unsigned char *response, unsigned short sizeResponse,
+					  PololuReplyCheck check){
+	const RetryPolicy &policy = retryPolicies_[id];
+	RetryStats &stats = retryStats_[id];
+	unsigned attempts = (policy.maxAttempts == 0) ? 1 : policy.maxAttempts;
+	unsigned long long start = clock_->nowUs();
+	bool resynced = false;
+	std::lock_guard<ISerialCom> guard(*serialCom_);
+
+	stats.calls++;
+	for(unsigned attempt = 1; ; attempt++){
+		stats.attempts++;
+		if(attempt > 1){
+			stats.retries++;
+		}
+		unsigned long long attemptStart = (stats_ != nullptr) ? clock_->nowUs() : 0;
+		try{
+			serialCom_->setReplyTimeout(policy.attemptTimeoutUs);
+			serialCom_->writeSerialCom(command, sizeCommand, response, sizeResponse);
+			while((check != nullptr) && !check(response, sizeResponse)){
+				// misaligned reply: recover in-band and ask once more
+				stats.impossibleReplies++;
+				stats.resyncs++;
+				MEX_LOG_WARN("Pololu::transfer: implausible reply to command {}, resynchronizing", (unsigned) id);
+				serialCom_->resynchronize();
+				if(resynced){
+					throw new ExceptionPololu(string("transfer:: implausible reply, line resynchronized."));
+				}
+				resynced = true;
+				serialCom_->writeSerialCom(command, sizeCommand, response, sizeResponse);
+			}
+			if(stats_ != nullptr){
+				stats_->recordTransfer(id, sizeCommand, sizeResponse, clock_->nowUs() - attemptStart);
+			}
+			return;
+		}catch(IException *e){
+			if(attempt >= attempts){
+				stats.failures++;
+				MEX_LOG_ERROR("Pololu::transfer: command {} failed after {} attempts", (unsigned) id, attempt);
+				if(stats_ != nullptr){
+					stats_->recordFailure(id);
+				}
+				throw;
+			}
+
+			unsigned long delayUs = backoff_.delayUs(policy, attempt);
+			if(policy.totalBudgetUs > 0){
+				// stop early if the next attempt cannot finish within the budget
+				unsigned long elapsedUs = clock_->nowUs() - start;
+				if((elapsedUs + delayUs + policy.attemptTimeoutUs) >= policy.totalBudgetUs){
+					stats.failures++;
+					stats.budgetExhausted++;
+					MEX_LOG_ERROR("Pololu::transfer: command {} failed, budget of {} us exhausted after {} attempts",
+								  (unsigned) id, policy.totalBudgetUs, attempt);
+					if(stats_ != nullptr){
+						stats_->recordFailure(id);
+					}
+					throw;
+				}
+			}
+			// retried, the exception of this attempt is not passed on
+			delete e;
+			stats.backoffUs += delayUs;
+			MEX_LOG_WARN("Pololu::transfer: attempt {} of command {} failed, retry in {} us", attempt, (unsigned) id, delayUs);
+			if(delayUs > 0){
+				clock_->sleepUs(delayUs);
+			}
+		}
+	}
+}
+
+
+void Pololu::setRetryPolicy(PololuCommand id, const RetryPolicy &policy){
+	if((id < 0) || (id >= POLOLU_CMD_COUNT)){
+		throw new ExceptionPololu(string("setRetryPolicy:: unknown command id."));
+	}
+	retryPolicies_[id] = policy;
+}
+
+RetryPolicy Pololu::getRetryPolicy(PololuCommand id){
+	if((id < 0) || (id >= POLOLU_CMD_COUNT)){
+		throw new ExceptionPololu(string("getRetryPolicy:: unknown command id."));
+	}
+	return retryPolicies_[id];
+}
+
+RetryStats Pololu::getRetryStats(PololuCommand id){
+	if((id < 0) || (id >= POLOLU_CMD_COUNT)){
+		throw new ExceptionPololu(string("getRetryStats:: unknown command id."));
+	}
+	return retryStats_[id];
+}
+
+void Pololu::resetRetryStats(){
+	for(int i = 0; i < POLOLU_CMD_COUNT; i++){
+		retryStats_[i] = RetryStats();
+	}
 }
@@ -9,6 +9,47 @@
 #define POLOLU_HPP_INCLUDED
 
 #include "SerialCom.hpp"
+#include "PololuErrors.hpp"
+#include "RetryPolicy.hpp"
+#include "PololuReplyParser.hpp"
+#include "Clock.hpp"
+
+
+/**
+ *
+ * \brief Maximal number of requests sent at once by Pololu::getPositions(...).
+ *
+ */
+#define POLOLU_MAX_PIPELINED 24
+
+class PololuStats;
+
+
+/**
+ *
+ * \brief Identifies the commands of the Pololu class, e.g.
+ * to configure a retry policy per command (see Pololu::setRetryPolicy).
+ *
+ */
+enum PololuCommand {
+	POLOLU_CMD_SET_POSITION = 0,
+	POLOLU_CMD_SET_SPEED,
+	POLOLU_CMD_SET_ACCELERATION,
+	POLOLU_CMD_GET_POSITION,
+	POLOLU_CMD_GET_MOVING_STATE,
+	POLOLU_CMD_GET_ERRORS,
+	POLOLU_CMD_COUNT
+};
+
+
+/**
+ *
+ * \brief Plausibility check of a reply. Returns false if the reply
+ * cannot have been sent by the controller for the pending request,
+ * i.e. the reply is misaligned because of lost or stray bytes.
+ *
+ */
+typedef bool (*PololuReplyCheck)(const unsigned char *reply, unsigned short size);
 
 
 /**
@@ -39,6 +80,22 @@ public:
      */
 	virtual unsigned short setPosition(unsigned short servoID, unsigned short tragetPos) = 0;
 
+    /**
+     *
+     * \brief Moves motor to a position given on the 8 bit scale of the
+     * Mini SSC protocol (3 bytes instead of 4). The controller maps
+     * 127 to the neutral setting of the channel and 0 / 254 to neutral
+     * -/+ the range setting of the channel.
+     * If an error occurs an exception is thrown.
+     *
+     *  \param unsigned short servoID. ID of the servo motor.
+     *  \param unsigned char target. Target on the 8 bit scale (0 - 254).
+     *
+     *  \return unsigned char target sent.
+     *
+     */
+	virtual unsigned char setPositionMiniSsc(unsigned short servoID, unsigned char target) = 0;
+
     /**
      *
      *
@@ -128,10 +185,35 @@ private:
 	Pololu(); // throws just an exception if ever called
 
 protected:
-    SerialCom *serialCom_ = nullptr;
+    ISerialCom *serialCom_ = nullptr; // handle of the SerialComRegistry
+    bool ownsSerialCom_ = true;
+    IClock *clock_ = &SystemClock::instance(); // timing of retries and backoff delays
     bool isComPortOpen_ = false;
+    PololuErrorMonitor *errorMonitor_ = nullptr;
+    RetryPolicy retryPolicies_[POLOLU_CMD_COUNT];
+    RetryStats  retryStats_[POLOLU_CMD_COUNT];
+    RetryBackoff backoff_;
+    PololuReplyParser replyParser_;
+    bool crcEnabled_ = false;
+    PololuStats *stats_ = nullptr;
+
+    /**
+     *
+     * \brief Sends the command and receives the reply according to the
+     * retry policy of the given command. The exception of the last
+     * attempt is passed on to the caller.
+     *
+     * If the reply fails the given plausibility check, the line is
+     * resynchronized in-band and the request is repeated once before
+     * the attempt counts as failed.
+     *
+     */
+    void transfer(PololuCommand id, unsigned char command[], unsigned short sizeCommand,
+    			  unsigned char *response, unsigned short sizeResponse,
+    			  PololuReplyCheck check = nullptr);
 
     unsigned short setPosition(unsigned short servo, unsigned short goToPosition);
+    unsigned char setPositionMiniSsc(unsigned short servo, unsigned char target);
     bool setSpeed(unsigned short servo, unsigned short goToSpeed);
     bool setAcceleration(unsigned short servo, unsigned short goToAcceleration);
     unsigned short getPosition(unsigned short servo);
@@ -151,6 +233,15 @@ public:
      */
     Pololu(const char* portName, unsigned short baudRate);
 
+    /**
+     *
+     * \brief Constructor using the given connection, e.g. a decorated
+     * one (see SerialComFaultInjector). The connection is not owned and
+     * has to outlive the instance.
+     *
+     */
+    Pololu(ISerialCom *serialCom);
+
 
     /**
      *
@@ -197,11 +288,126 @@ public:
      */
     void closeConnection();
 
+    /**
+     *
+     * \brief True if the serial connection has been opened and not closed
+     * since.
+     *
+     */
+    bool isConnectionOpen() const {return isComPortOpen_;};
+
 
+    /**
+     *
+     * \brief Returns the moving state of all motors. If an error monitor
+     * is attached and a poll is due, the error register is read within
+     * the same round trip (see setErrorMonitor(...)).
+     *
+     */
     bool getMovingState();
 
+    /**
+     *
+     * \brief Reads the positions of several servos within one round trip.
+     * All requests are sent at once and the replies are taken out of the
+     * receive ring of the connection in the order of the requests. If a
+     * reply is missing or implausible, the line is resynchronized and the
+     * positions are requested one by one.
+     *
+     * \param servos const unsigned short[]. Channels to be read.
+     * \param count unsigned short. Number of channels (<= POLOLU_MAX_PIPELINED).
+     * \param positions unsigned short[]. Positions in the order of servos.
+     *
+     * If an error occurs an exception is thrown.
+     *
+     */
+    void getPositions(const unsigned short servos[], unsigned short count, unsigned short positions[]);
+
 
     unsigned short getErrors();
+
+    /**
+     *
+     * \brief Reads the error register and delivers it in decoded form.
+     * If an error monitor is attached, it is updated with the reading.
+     *
+     * If an error occurs an exception is thrown.
+     *
+     */
+    PololuErrorFlags getErrorFlags();
+
+    /**
+     *
+     * \brief Attaches an error monitor. The monitor is not owned by
+     * this instance, NULL detaches the current monitor.
+     *
+     */
+    void setErrorMonitor(PololuErrorMonitor *monitor){errorMonitor_ = monitor;};
+
+    PololuErrorMonitor* getErrorMonitor(){return errorMonitor_;};
+
+    /**
+     *
+     * \brief Sets the retry and timeout policy of the given command.
+     * Per default every command is tried once, except the error
+     * request which is tried up to five times.
+     *
+     */
+    void setRetryPolicy(PololuCommand id, const RetryPolicy &policy);
+
+    RetryPolicy getRetryPolicy(PololuCommand id);
+
+    /**
+     *
+     * \brief Delivers the retry counters of the given command.
+     *
+     */
+    RetryStats getRetryStats(PololuCommand id);
+
+    void resetRetryStats();
+
+    /**
+     *
+     * \brief Sets the clock used for the backoff delays and the time
+     * budget of the retry policies, e.g. a VirtualClock shared with a
+     * SerialComSim. The clock is not owned.
+     *
+     */
+    void setClock(IClock *clock){clock_ = (clock == nullptr) ? &SystemClock::instance() : clock;};
+
+    IClock* getClock(){return clock_;};
+
+    /**
+     * \brief Attaches a publisher of the statistics and the joint state
+     * (targets, positions, round trips, error flags), e.g. for mexTop.
+     * The publisher is not owned by this instance, NULL detaches it.
+     */
+    void setStats(PololuStats *stats){stats_ = stats;};
+
+    PololuStats* getStats(){return stats_;};
+
+    /**
+     *
+     * \brief Appends a CRC-7 byte to every command. It has to match the
+     * "Enable CRC" setting of the serial interface of the controller,
+     * otherwise the controller ignores all commands (with CRC) or takes
+     * the CRC byte as a protocol error (without CRC). Disabled per default.
+     *
+     */
+    void setCrcMode(bool enabled){crcEnabled_ = enabled;};
+
+    bool getCrcMode(){return crcEnabled_;};
+
+    /**
+     *
+     * \brief Estimated time (in micro seconds) until a new command of the
+     * given size would be on the wire, taking the bytes still queued for
+     * the controller into account (see ISerialCom::estimateTimeToWireUs(...)).
+     *
+     */
+    unsigned long estimateTimeToWireUs(unsigned short sizeCommand = 4){
+    	return serialCom_->estimateTimeToWireUs(sizeCommand + (crcEnabled_ ? 1 : 0));
+    };
 };
 
 
@@ -0,0 +1,90 @@
+//============================================================================
+// Name        : PololuErrors.cpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : PololuErrors source file. It contains the definition of the
+//               functions of the PololuErrorFlags and PololuErrorMonitor
+//               classes.
+//============================================================================
+#include "PololuErrors.hpp"
+#include <string>
+
+
+string PololuErrorFlags::toString() const {
+	static const char* names[] = {
+			"SerialSignal",
+			"SerialOverrun",
+			"SerialRxBufferFull",
+			"SerialCRC",
+			"SerialProtocol",
+			"SerialTimeout",
+			"ScriptStack",
+			"ScriptCallStack",
+			"ScriptProgramCounter"
+	};
+
+	if(raw_ == 0){
+		return string("none");
+	}
+
+	string s("");
+	for(unsigned i = 0; i < sizeof(names) / sizeof(names[0]); i++){
+		if(raw_ & (1 << i)){
+			if(!s.empty()){
+				s += "|";
+			}
+			s += names[i];
+		}
+	}
+	if(!isValid(raw_)){
+		if(!s.empty()){
+			s += "|";
+		}
+		s += "Undefined";
+	}
+	return s;
+}
+
+
+
+PololuErrorMonitor::PololuErrorMonitor(IPololuErrorListener *listener, unsigned pollInterval){
+	listener_ = listener;
+	this->setPollInterval(pollInterval);
+}
+
+void PololuErrorMonitor::setPollInterval(unsigned pollInterval){
+	// an interval of 0 would never poll, treat it like polling every slot
+	pollInterval_ = (pollInterval == 0) ? 1 : pollInterval;
+	idleSlots_ = 0;
+}
+
+bool PololuErrorMonitor::isPollDue(){
+	idleSlots_++;
+	if(idleSlots_ < pollInterval_){
+		return false;
+	}
+	idleSlots_ = 0;
+	return true;
+}
+
+void PololuErrorMonitor::update(unsigned short raw){
+	PololuErrorFlags current(raw);
+	polls_++;
+	accumulated_ |= raw;
+
+	if(current == last_){
+		return;
+	}
+
+	PololuErrorEvent event;
+	event.previous = last_;
+	event.current  = current;
+	event.raised   = raw & ~last_.getRaw();
+	event.cleared  = last_.getRaw() & ~raw;
+	last_ = current;
+	events_++;
+
+	if(listener_ != nullptr){
+		listener_->errorFlagsChanged(event);
+	}
+}
@@ -0,0 +1,255 @@
+//============================================================================
+// Name        : PololuErrors.hpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : PololuErrors header file. It contains the decoding of the
+//               Maestro error register (command 0xA1) and the error monitor
+//               that delivers error transitions as events.
+//============================================================================
+#ifndef POLOLUERRORS_HPP_INCLUDED
+#define POLOLUERRORS_HPP_INCLUDED
+
+#include <string>
+
+using namespace std;
+
+
+/**
+ *
+ * \brief Bits of the error register of the Maestro controller
+ * (see https://www.pololu.com/docs/0J40/4.b).
+ *
+ */
+enum PololuErrorBit {
+	POLOLU_ERR_SERIAL_SIGNAL          = 0x0001, /**< framing error on the TTL serial line */
+	POLOLU_ERR_SERIAL_OVERRUN         = 0x0002, /**< UART receive buffer overrun */
+	POLOLU_ERR_SERIAL_RX_BUFFER_FULL  = 0x0004, /**< firmware receive ring buffer full */
+	POLOLU_ERR_SERIAL_CRC             = 0x0008, /**< CRC byte of a command did not match */
+	POLOLU_ERR_SERIAL_PROTOCOL        = 0x0010, /**< command was not formatted correctly */
+	POLOLU_ERR_SERIAL_TIMEOUT         = 0x0020, /**< serial timeout period elapsed */
+	POLOLU_ERR_SCRIPT_STACK           = 0x0040, /**< script stack over- or underflow */
+	POLOLU_ERR_SCRIPT_CALL_STACK      = 0x0080, /**< script call stack over- or underflow */
+	POLOLU_ERR_SCRIPT_PROGRAM_COUNTER = 0x0100  /**< script program counter out of bounds */
+};
+
+
+/**
+ *
+ * \class PololuErrorFlags
+ *
+ * \brief Structured view on the 16 bit error code delivered
+ * by the Maestro controller.
+ *
+ */
+class PololuErrorFlags {
+public:
+
+	/**
+	 *
+	 * \brief Mask of all bits defined by the Maestro firmware.
+	 *
+	 */
+	static const unsigned short VALID_MASK  = 0x01FF;
+
+	/**
+	 *
+	 * \brief Mask of the bits related to the serial interface.
+	 *
+	 */
+	static const unsigned short SERIAL_MASK = 0x003F;
+
+	/**
+	 *
+	 * \brief Mask of the bits related to the internal script.
+	 *
+	 */
+	static const unsigned short SCRIPT_MASK = 0x01C0;
+
+	/**
+	 *
+	 * \brief Constructor
+	 *
+	 * \param raw unsigned short. Error code as delivered by the controller.
+	 *
+	 */
+	PololuErrorFlags(unsigned short raw = 0){raw_ = raw;};
+
+	unsigned short getRaw() const {return raw_;};
+
+	bool isSet(PololuErrorBit bit) const {return ((raw_ & bit) != 0);};
+
+	bool serialSignalError() const         {return isSet(POLOLU_ERR_SERIAL_SIGNAL);};
+	bool serialOverrunError() const        {return isSet(POLOLU_ERR_SERIAL_OVERRUN);};
+	bool serialRxBufferFullError() const   {return isSet(POLOLU_ERR_SERIAL_RX_BUFFER_FULL);};
+	bool serialCrcError() const            {return isSet(POLOLU_ERR_SERIAL_CRC);};
+	bool serialProtocolError() const       {return isSet(POLOLU_ERR_SERIAL_PROTOCOL);};
+	bool serialTimeoutError() const        {return isSet(POLOLU_ERR_SERIAL_TIMEOUT);};
+	bool scriptStackError() const          {return isSet(POLOLU_ERR_SCRIPT_STACK);};
+	bool scriptCallStackError() const      {return isSet(POLOLU_ERR_SCRIPT_CALL_STACK);};
+	bool scriptProgramCounterError() const {return isSet(POLOLU_ERR_SCRIPT_PROGRAM_COUNTER);};
+
+	/**
+	 *
+	 * \brief Returns true if any of the serial error bits is set.
+	 *
+	 */
+	bool hasSerialErrors() const {return ((raw_ & SERIAL_MASK) != 0);};
+
+	/**
+	 *
+	 * \brief Returns true if any of the script error bits is set.
+	 *
+	 */
+	bool hasScriptErrors() const {return ((raw_ & SCRIPT_MASK) != 0);};
+
+	/**
+	 *
+	 * \brief Returns true if any error bit is set.
+	 *
+	 */
+	bool any() const {return (raw_ != 0);};
+
+	/**
+	 *
+	 * \brief Tests whether or not the given value can be a reply
+	 * of the controller, i.e. no undefined bit is set.
+	 *
+	 */
+	static bool isValid(unsigned short raw){return ((raw & ~VALID_MASK) == 0);};
+
+	/**
+	 *
+	 * \brief Returns the names of all set error bits separated by '|'.
+	 * If no bit is set the string "none" is returned.
+	 *
+	 */
+	string toString() const;
+
+	bool operator==(const PololuErrorFlags &other) const {return raw_ == other.raw_;};
+	bool operator!=(const PololuErrorFlags &other) const {return raw_ != other.raw_;};
+
+protected:
+	unsigned short raw_;
+};
+
+
+/**
+ *
+ * \brief Describes a change of the error register between two
+ * consecutive readings.
+ *
+ */
+struct PololuErrorEvent {
+	PololuErrorFlags previous; /**< flags of the previous reading */
+	PololuErrorFlags current;  /**< flags of the current reading */
+	unsigned short   raised;   /**< bits set now but not before */
+	unsigned short   cleared;  /**< bits set before but not now */
+};
+
+
+/**
+ *
+ * \brief Interface of objects that want to be informed about
+ * changes of the error register of the controller.
+ *
+ */
+class IPololuErrorListener {
+public:
+	virtual ~IPololuErrorListener(){};
+
+	/**
+	 *
+	 * \brief Called once for every reading that differs from
+	 * the previous one.
+	 *
+	 */
+	virtual void errorFlagsChanged(const PololuErrorEvent &event) = 0;
+};
+
+
+/**
+ *
+ * \class PololuErrorMonitor
+ *
+ * \brief Keeps track of the error register of a controller without
+ * requiring dedicated round trips.
+ *
+ * The monitor is attached to a \ref Pololu instance
+ * (see Pololu::setErrorMonitor). Every idle slot of the
+ * request pipeline (currently every moving state request, which
+ * is typically issued in busy waiting loops) is counted. When a
+ * poll is due the Pololu instance appends the 0xA1 request to the
+ * pending request and hands the reply over to update().
+ *
+ */
+class PololuErrorMonitor {
+public:
+
+	/**
+	 *
+	 * \brief Constructor
+	 *
+	 * \param listener IPololuErrorListener*. Receiver of the error
+	 *                 transitions, can be NULL.
+	 * \param pollInterval unsigned. Number of idle slots between two
+	 *                 polls of the error register (1 = every slot).
+	 *
+	 */
+	PololuErrorMonitor(IPololuErrorListener *listener = nullptr, unsigned pollInterval = 10);
+
+	void setListener(IPololuErrorListener *listener){listener_ = listener;};
+
+	void setPollInterval(unsigned pollInterval);
+
+	/**
+	 *
+	 * \brief Reports an idle slot to the monitor.
+	 *
+	 * \return bool true if the error register shall be read within
+	 * this slot.
+	 *
+	 */
+	bool isPollDue();
+
+	/**
+	 *
+	 * \brief Stores a new reading of the error register and informs
+	 * the listener if the reading differs from the previous one.
+	 *
+	 * \param raw unsigned short. Error code delivered by the controller.
+	 *
+	 */
+	void update(unsigned short raw);
+
+	/**
+	 *
+	 * \brief Delivers the most recent reading without any communication.
+	 *
+	 */
+	PololuErrorFlags getLastFlags() const {return last_;};
+
+	/**
+	 *
+	 * \brief Delivers all bits seen since construction or the last
+	 * call of clearAccumulated().
+	 *
+	 */
+	PololuErrorFlags getAccumulatedFlags() const {return PololuErrorFlags(accumulated_);};
+
+	void clearAccumulated(){accumulated_ = 0;};
+
+	unsigned long getPollCount() const {return polls_;};
+
+	unsigned long getEventCount() const {return events_;};
+
+protected:
+	IPololuErrorListener *listener_ = nullptr;
+	unsigned         pollInterval_ = 10;
+	unsigned         idleSlots_    = 0;
+	unsigned long    polls_        = 0;
+	unsigned long    events_       = 0;
+	unsigned short   accumulated_  = 0;
+	PololuErrorFlags last_;
+};
+
+#endif // POLOLUERRORS_HPP_INCLUDED
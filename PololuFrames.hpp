@@ -0,0 +1,142 @@
+//============================================================================
+// Name        : PololuFrames.hpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : PololuFrames header file. It contains the encoders of the
+//               Maestro compact protocol commands and the CRC-7 checksum
+//               that can be appended to every command.
+//============================================================================
+#ifndef POLOLUFRAMES_HPP_INCLUDED
+#define POLOLUFRAMES_HPP_INCLUDED
+
+
+/**
+ *
+ * \brief CRC-7 polynomial (x^7 + x^3 + 1) in the bit reversed form
+ * used by the Maestro (https://www.pololu.com/docs/0J40/5.d).
+ *
+ */
+#define POLOLU_CRC7_POLY 0x91
+
+/**
+ *
+ * \brief Maximal size of an encoded command including the CRC byte.
+ *
+ */
+#define POLOLU_MAX_FRAME 5
+
+
+/**
+ *
+ * \brief Lookup table of the CRC-7, entry i is the checksum register
+ * after shifting the byte i through the polynomial.
+ *
+ */
+extern const unsigned char pololuCrc7Table[256];
+
+/**
+ *
+ * \brief CRC-7 of the message computed byte wise with the lookup table.
+ *
+ */
+inline unsigned char pololuCrc7(const unsigned char *message, unsigned length){
+	unsigned char crc = 0;
+	for(unsigned i = 0; i < length; i++){
+		crc = pololuCrc7Table[crc ^ message[i]];
+	}
+	return crc;
+}
+
+/**
+ *
+ * \brief Reference implementation of the CRC-7 shifting bit by bit,
+ * as given in the Maestro documentation.
+ *
+ */
+unsigned char pololuCrc7Bitwise(const unsigned char *message, unsigned length);
+
+
+/**
+ *
+ * \class PololuFrames
+ *
+ * \brief Encoders of the Maestro commands. Each encoder writes the
+ * command into the given buffer (at least POLOLU_MAX_FRAME bytes) and
+ * returns its size. If crc is true the CRC-7 byte is appended, as
+ * required by a Maestro configured with "Enable CRC".
+ *
+ * Several frames can be written one after the other into one buffer to
+ * send them with a single write; each frame carries its own CRC byte.
+ *
+ */
+class PololuFrames {
+public:
+
+	/**
+	 * \brief Appends the CRC byte if requested and returns the frame size.
+	 */
+	static unsigned short finish(unsigned char *frame, unsigned short size, bool crc){
+		if(crc){
+			frame[size] = pololuCrc7(frame, size);
+			return size + 1;
+		}
+		return size;
+	};
+
+	static unsigned short setTarget(unsigned char *frame, unsigned char servo, unsigned short target, bool crc = false){
+		return PololuFrames::command4(frame, 0x84, servo, target, crc);
+	};
+
+	static unsigned short setSpeed(unsigned char *frame, unsigned char servo, unsigned short speed, bool crc = false){
+		return PololuFrames::command4(frame, 0x87, servo, speed, crc);
+	};
+
+	static unsigned short setAcceleration(unsigned char *frame, unsigned char servo, unsigned short acceleration, bool crc = false){
+		return PololuFrames::command4(frame, 0x89, servo, acceleration, crc);
+	};
+
+	/**
+	 * \brief Mini SSC command (0xFF), target on the 8 bit scale (0 - 254).
+	 */
+	static unsigned short miniSscTarget(unsigned char *frame, unsigned char servo, unsigned char target, bool crc = false){
+		frame[0] = 0xFF;
+		frame[1] = servo;
+		frame[2] = target;
+		return PololuFrames::finish(frame, 3, crc);
+	};
+
+	static unsigned short getPosition(unsigned char *frame, unsigned char servo, bool crc = false){
+		frame[0] = 0x90;
+		frame[1] = servo;
+		return PololuFrames::finish(frame, 2, crc);
+	};
+
+	static unsigned short getMovingState(unsigned char *frame, bool crc = false){
+		frame[0] = 0x93;
+		return PololuFrames::finish(frame, 1, crc);
+	};
+
+	static unsigned short getErrors(unsigned char *frame, bool crc = false){
+		frame[0] = 0xA1;
+		return PololuFrames::finish(frame, 1, crc);
+	};
+
+	static unsigned short goHome(unsigned char *frame, bool crc = false){
+		frame[0] = 0xA2;
+		return PololuFrames::finish(frame, 1, crc);
+	};
+
+private:
+	/*
+	 * command byte, channel and a 14 bit value as two 7 bit data bytes
+	 */
+	static unsigned short command4(unsigned char *frame, unsigned char cmd, unsigned char servo, unsigned short value, bool crc){
+		frame[0] = cmd;
+		frame[1] = servo;
+		frame[2] = value & 0x7F;
+		frame[3] = (value >> 7) & 0x7F;
+		return PololuFrames::finish(frame, 4, crc);
+	};
+};
+
+#endif // POLOLUFRAMES_HPP_INCLUDED
@@ -0,0 +1,64 @@
+//============================================================================
+// Name        : PololuReplyParser.cpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : PololuReplyParser source file. It contains the definition of
+//               the functions of the PololuReplyParser class.
+//============================================================================
+#include "PololuReplyParser.hpp"
+#include "PololuErrors.hpp"
+
+
+unsigned short PololuReplyParser::replySize(PololuReplyType type){
+	return (type == POLOLU_REPLY_MOVING_STATE) ? 1 : 2;
+}
+
+unsigned short PololuReplyParser::decode(PololuReplyType type, const unsigned char *bytes){
+	if(type == POLOLU_REPLY_MOVING_STATE){
+		return bytes[0];
+	}
+	return bytes[0] + 256 * bytes[1];
+}
+
+bool PololuReplyParser::isPlausible(PololuReplyType type, unsigned short value){
+	switch(type){
+	case POLOLU_REPLY_POSITION:
+		return (value <= 16383);
+	case POLOLU_REPLY_MOVING_STATE:
+		return (value <= 1);
+	case POLOLU_REPLY_ERRORS:
+		return PololuErrorFlags::isValid(value);
+	}
+	return false;
+}
+
+bool PololuReplyParser::expect(PololuReplyType type){
+	if(count_ >= MAX_OUTSTANDING){
+		return false;
+	}
+	queue_[(first_ + count_) % MAX_OUTSTANDING] = type;
+	count_++;
+	bytesExpected_ += replySize(type);
+	return true;
+}
+
+bool PololuReplyParser::next(SerialRxRing &ring, PololuReply &reply){
+	if(count_ == 0){
+		return false;
+	}
+	PololuReplyType type = queue_[first_];
+	unsigned short size = replySize(type);
+	if(ring.available() < size){
+		return false;
+	}
+
+	reply.type  = type;
+	reply.value = (size == 1) ? ring.peek(0) : ring.peekWord(0);
+	reply.plausible = isPlausible(type, reply.value);
+	ring.consume(size);
+
+	first_ = (first_ + 1) % MAX_OUTSTANDING;
+	count_--;
+	bytesExpected_ -= size;
+	return true;
+}
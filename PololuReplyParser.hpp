@@ -0,0 +1,112 @@
+//============================================================================
+// Name        : PololuReplyParser.hpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : PololuReplyParser header file. It contains the incremental
+//               parser that slices typed replies of the Maestro out of the
+//               receive ring of a serial connection.
+//============================================================================
+#ifndef POLOLUREPLYPARSER_HPP_INCLUDED
+#define POLOLUREPLYPARSER_HPP_INCLUDED
+
+#include "SerialRxRing.hpp"
+
+
+/**
+ *
+ * \brief Replies of the Maestro compact protocol.
+ *
+ */
+enum PololuReplyType {
+	POLOLU_REPLY_POSITION = 0,  /**< 0x90, 2 bytes, quarter micro seconds */
+	POLOLU_REPLY_MOVING_STATE,  /**< 0x93, 1 byte, 0 or 1 */
+	POLOLU_REPLY_ERRORS         /**< 0xA1, 2 bytes, error bits */
+};
+
+
+/**
+ *
+ * \brief A decoded reply.
+ *
+ */
+struct PololuReply {
+	PololuReplyType type;
+	unsigned short  value;
+	bool            plausible; /**< false if the value cannot be sent by a Maestro */
+};
+
+
+/**
+ *
+ * \class PololuReplyParser
+ *
+ * \brief Incremental parser of Maestro replies.
+ *
+ * The Maestro replies do not carry a header, their meaning follows from
+ * the order of the requests. Each request expecting a reply is announced
+ * with expect(...) when it is sent; next(...) takes the oldest expected
+ * reply out of the receive ring as soon as all its bytes have arrived.
+ * The values are decoded in place, nothing is copied out of the ring.
+ *
+ */
+class PololuReplyParser {
+public:
+
+	/**
+	 * \brief Maximal number of outstanding replies.
+	 */
+	static const unsigned MAX_OUTSTANDING = 32;
+
+	/**
+	 * \brief Number of bytes of a reply.
+	 */
+	static unsigned short replySize(PololuReplyType type);
+
+	/**
+	 * \brief Decodes the reply bytes (low byte first) of the given type.
+	 */
+	static unsigned short decode(PololuReplyType type, const unsigned char *bytes);
+
+	/**
+	 * \brief Returns true if the value can be sent by a Maestro: positions
+	 * up to 4095.75 us, a moving state of 0 or 1 and the lower 9 error bits.
+	 */
+	static bool isPlausible(PololuReplyType type, unsigned short value);
+
+	/**
+	 *
+	 * \brief Announces a reply of a request that has been sent.
+	 *
+	 * \return bool. False if MAX_OUTSTANDING replies are outstanding already.
+	 */
+	bool expect(PololuReplyType type);
+
+	/**
+	 *
+	 * \brief Takes the oldest expected reply out of the ring.
+	 *
+	 * \return bool. False if no reply is expected or its bytes are not
+	 * complete yet, the ring is left untouched in that case.
+	 */
+	bool next(SerialRxRing &ring, PololuReply &reply);
+
+	unsigned getOutstanding() const {return count_;};
+
+	/**
+	 * \brief Number of bytes of all outstanding replies.
+	 */
+	unsigned getBytesExpected() const {return bytesExpected_;};
+
+	/**
+	 * \brief Forgets all outstanding replies, e.g. after a resynchronization.
+	 */
+	void reset(){first_ = 0; count_ = 0; bytesExpected_ = 0;};
+
+private:
+	PololuReplyType queue_[MAX_OUTSTANDING];
+	unsigned        first_ = 0;
+	unsigned        count_ = 0;
+	unsigned        bytesExpected_ = 0;
+};
+
+#endif // POLOLUREPLYPARSER_HPP_INCLUDED
@@ -0,0 +1,239 @@
+//============================================================================
+// Name        : PololuStats.cpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : PololuStats source file. It contains the definition of the
+//               functions of the PololuStats and PololuStatsView classes.
+//============================================================================
+#include "PololuStats.hpp"
+#include <chrono>
+#include <thread>
+#include <cstring>
+#include <cerrno>
+#include <csignal>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+
+
+static uint64_t statsNowUs(){
+	return std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+PololuStats::PololuStats(const string &name, const string &port){
+	name_ = name.empty() ? (string(POLOLU_STATS_PREFIX) + to_string(getpid())) : name;
+	if(name_[0] != '/'){
+		name_ = string("/") + name_;
+	}
+
+	int fd = shm_open(name_.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+	if(fd < 0){
+		throw new ExceptionPololuStats(string("PololuStats:: cannot create ") + name_ + ": " + strerror(errno));
+	}
+	if(ftruncate(fd, sizeof(PololuStatsBlock)) != 0){
+		close(fd);
+		shm_unlink(name_.c_str());
+		throw new ExceptionPololuStats(string("PololuStats:: cannot size ") + name_ + ": " + strerror(errno));
+	}
+	void *p = mmap(nullptr, sizeof(PololuStatsBlock), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if(p == MAP_FAILED){
+		shm_unlink(name_.c_str());
+		throw new ExceptionPololuStats(string("PololuStats:: cannot map ") + name_ + ": " + strerror(errno));
+	}
+
+	// the new segment is zero filled, the magic is written last
+	block_ = static_cast<PololuStatsBlock*>(p);
+	block_->version = POLOLU_STATS_VERSION;
+	block_->pid     = getpid();
+	strncpy(block_->port, port.c_str(), sizeof(block_->port) - 1);
+	block_->startUs  = statsNowUs();
+	block_->updateUs = block_->startUs;
+	std::atomic_thread_fence(std::memory_order_release);
+	block_->magic = POLOLU_STATS_MAGIC;
+}
+
+PololuStats::~PololuStats(){
+	munmap(block_, sizeof(PololuStatsBlock));
+	shm_unlink(name_.c_str());
+}
+
+void PololuStats::begin(){
+	block_->seq.store(block_->seq.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+}
+
+void PololuStats::end(){
+	block_->updateUs = statsNowUs();
+	block_->seq.store(block_->seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void PololuStats::recordTransfer(PololuCommand id, unsigned short bytesOut, unsigned short bytesIn, unsigned long long rttUs){
+	std::lock_guard<std::mutex> lock(mutex_);
+	begin();
+	block_->calls[id]++;
+	block_->bytesOut += bytesOut;
+	block_->bytesIn  += bytesIn;
+	if(bytesIn > 0){
+		block_->rtt[rttBin(rttUs)]++;
+		if(rttUs > block_->rttMaxUs){
+			block_->rttMaxUs = rttUs;
+		}
+	}
+	end();
+}
+
+void PololuStats::recordFailure(PololuCommand id){
+	std::lock_guard<std::mutex> lock(mutex_);
+	begin();
+	block_->failures[id]++;
+	end();
+}
+
+void PololuStats::recordTarget(unsigned short servo, unsigned short target){
+	if(servo >= POLOLU_STATS_SERVOS){
+		return;
+	}
+	std::lock_guard<std::mutex> lock(mutex_);
+	begin();
+	block_->servo[servo].target   = target;
+	block_->servo[servo].targetUs = statsNowUs();
+	end();
+}
+
+void PololuStats::recordPosition(unsigned short servo, unsigned short position){
+	if(servo >= POLOLU_STATS_SERVOS){
+		return;
+	}
+	std::lock_guard<std::mutex> lock(mutex_);
+	begin();
+	block_->servo[servo].position   = position;
+	block_->servo[servo].positionUs = statsNowUs();
+	end();
+}
+
+void PololuStats::recordErrors(unsigned short errors){
+	std::lock_guard<std::mutex> lock(mutex_);
+	begin();
+	block_->errors   = errors;
+	block_->errorsUs = statsNowUs();
+	if(errors != 0){
+		block_->errorReads++;
+	}
+	end();
+}
+
+void PololuStats::recordMoving(bool moving){
+	std::lock_guard<std::mutex> lock(mutex_);
+	begin();
+	block_->moving = moving ? 1 : 0;
+	end();
+}
+
+unsigned PololuStats::rttBin(unsigned long long us){
+	if(us < 8){
+		return (unsigned) us;
+	}
+	unsigned e = 63 - __builtin_clzll(us); // us >= 2^e
+	if(e >= POLOLU_STATS_RTT_OCTAVES){
+		return POLOLU_STATS_RTT_BINS - 1;
+	}
+	return (e - 2) * 8 + (unsigned) ((us >> (e - 3)) & 7);
+}
+
+unsigned long long PololuStats::rttBinUs(unsigned bin){
+	if(bin < 8){
+		return bin;
+	}
+	unsigned e = bin / 8 + 2;
+	return (1ULL << e) + (unsigned long long) (bin % 8) * (1ULL << (e - 3));
+}
+
+unsigned long long PololuStats::rttPercentile(const uint64_t rtt[POLOLU_STATS_RTT_BINS], double q){
+	uint64_t total = 0;
+	for(unsigned i = 0; i < POLOLU_STATS_RTT_BINS; i++){
+		total += rtt[i];
+	}
+	if(total == 0){
+		return 0;
+	}
+	uint64_t rank = (uint64_t) (q * (total - 1)) + 1;
+	uint64_t sum = 0;
+	for(unsigned i = 0; i < POLOLU_STATS_RTT_BINS; i++){
+		sum += rtt[i];
+		if(sum >= rank){
+			return rttBinUs(i);
+		}
+	}
+	return rttBinUs(POLOLU_STATS_RTT_BINS - 1);
+}
+
+
+
+PololuStatsView::PololuStatsView(const string &name){
+	name_ = (name[0] != '/') ? (string("/") + name) : name;
+	int fd = shm_open(name_.c_str(), O_RDONLY, 0);
+	if(fd < 0){
+		throw new ExceptionPololuStats(string("PololuStatsView:: cannot open ") + name_ + ": " + strerror(errno));
+	}
+	struct stat st;
+	if((fstat(fd, &st) != 0) || (st.st_size < (off_t) sizeof(PololuStatsBlock))){
+		close(fd);
+		throw new ExceptionPololuStats(string("PololuStatsView:: ") + name_ + " is not a statistics segment.");
+	}
+	void *p = mmap(nullptr, sizeof(PololuStatsBlock), PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if(p == MAP_FAILED){
+		throw new ExceptionPololuStats(string("PololuStatsView:: cannot map ") + name_ + ": " + strerror(errno));
+	}
+	block_ = static_cast<const PololuStatsBlock*>(p);
+	if((block_->magic != POLOLU_STATS_MAGIC) || (block_->version != POLOLU_STATS_VERSION)){
+		munmap((void*) block_, sizeof(PololuStatsBlock));
+		throw new ExceptionPololuStats(string("PololuStatsView:: ") + name_ + " has an unknown layout.");
+	}
+}
+
+PololuStatsView::~PololuStatsView(){
+	munmap((void*) block_, sizeof(PololuStatsBlock));
+}
+
+bool PololuStatsView::snapshot(PololuStatsBlock &copy, unsigned tries){
+	for(unsigned i = 0; i < tries; i++){
+		uint32_t s1 = block_->seq.load(std::memory_order_acquire);
+		if((s1 & 1) == 0){
+			memcpy((void*) &copy, (const void*) block_, sizeof(PololuStatsBlock));
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if(block_->seq.load(std::memory_order_relaxed) == s1){
+				return true;
+			}
+		}
+		std::this_thread::yield();
+	}
+	return false;
+}
+
+bool PololuStatsView::isAlive(){
+	return (kill(block_->pid, 0) == 0) || (errno == EPERM);
+}
+
+string PololuStatsView::findFirst(){
+	string prefix(POLOLU_STATS_PREFIX + 1); // without '/'
+	DIR *dir = opendir("/dev/shm");
+	if(dir == nullptr){
+		return string("");
+	}
+	string found;
+	struct dirent *e;
+	while((e = readdir(dir)) != nullptr){
+		if(strncmp(e->d_name, prefix.c_str(), prefix.size()) == 0){
+			found = string("/") + e->d_name;
+			break;
+		}
+	}
+	closedir(dir);
+	return found;
+}
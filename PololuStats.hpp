@@ -0,0 +1,218 @@
+//============================================================================
+// Name        : PololuStats.hpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : PololuStats header file. It contains the statistics and the
+//               joint state a Pololu instance publishes in a shared memory
+//               segment, and the read-only view used by monitors (mexTop).
+//============================================================================
+#ifndef POLOLUSTATS_HPP_INCLUDED
+#define POLOLUSTATS_HPP_INCLUDED
+
+#include "SerialCom.hpp"
+#include "Pololu.hpp"
+#include <string>
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+
+using namespace std;
+
+
+/**
+ * \brief Identifies a segment of this layout ("MEXS"), the version is
+ * increased with every change of PololuStatsBlock.
+ */
+#define POLOLU_STATS_MAGIC   0x5358454D
+#define POLOLU_STATS_VERSION 1
+
+/**
+ * \brief Number of channels published (the Maestro has up to 24).
+ */
+#define POLOLU_STATS_SERVOS 24
+
+/**
+ * \brief Round trip histogram: values below 8 us have their own bin,
+ * above each power of two is split into 8 bins (12 % resolution) up to
+ * 2^POLOLU_STATS_RTT_OCTAVES us, larger values go to the last bin.
+ */
+#define POLOLU_STATS_RTT_OCTAVES 24
+#define POLOLU_STATS_RTT_BINS    ((POLOLU_STATS_RTT_OCTAVES - 2) * 8)
+
+/**
+ * \brief Prefix of the segment names, the default name is the prefix
+ * followed by the process id ("/mex-stats-1234").
+ */
+#define POLOLU_STATS_PREFIX "/mex-stats-"
+
+
+/**
+ * \brief Published state of one channel, times of the steady clock in
+ * micro seconds (0 = never).
+ */
+struct PololuStatsServo {
+	uint16_t target;      /**< last target set (quarter micro seconds) */
+	uint16_t position;    /**< last position read */
+	uint64_t targetUs;
+	uint64_t positionUs;
+};
+
+
+/**
+ * \brief Layout of the shared memory segment. The writer increments seq
+ * before and after every update (odd while writing), a reader copies the
+ * block and retries if seq was odd or changed meanwhile (seqlock).
+ */
+struct PololuStatsBlock {
+	uint32_t magic;
+	uint32_t version;
+	int32_t  pid;
+	char     port[64];
+	std::atomic<uint32_t> seq;
+
+	uint64_t startUs;
+	uint64_t updateUs;                           /**< time of the last update */
+	uint64_t calls[POLOLU_CMD_COUNT];            /**< completed transfers */
+	uint64_t failures[POLOLU_CMD_COUNT];         /**< transfers that threw */
+	uint64_t bytesOut;
+	uint64_t bytesIn;
+	uint64_t rtt[POLOLU_STATS_RTT_BINS];         /**< round trips of commands with reply */
+	uint64_t rttMaxUs;
+	uint16_t errors;                             /**< last error register read */
+	uint64_t errorsUs;
+	uint64_t errorReads;                         /**< reads with any bit set */
+	uint8_t  moving;                             /**< last moving state */
+	PololuStatsServo servo[POLOLU_STATS_SERVOS];
+};
+
+
+/**
+ *
+ * \class PololuStats
+ *
+ * \brief Publisher of the statistics of a Pololu instance (see
+ * Pololu::setStats(...)). The segment is created read-write by the
+ * controlling process and removed by the destructor; monitors attach
+ * read-only, so they cannot disturb the controlled process. An update
+ * costs a few stores and an uncontended lock, no system call.
+ *
+ */
+class PololuStats {
+public:
+
+	/**
+	 *
+	 * \brief Creates the segment. An empty name selects the default name
+	 * POLOLU_STATS_PREFIX<pid>. If the segment cannot be created an
+	 * exception (IException) is thrown.
+	 *
+	 */
+	PololuStats(const string &name = string(""), const string &port = string(""));
+	~PololuStats();
+
+	string getName(){return name_;};
+
+	void recordTransfer(PololuCommand id, unsigned short bytesOut, unsigned short bytesIn, unsigned long long rttUs);
+	void recordFailure(PololuCommand id);
+	void recordTarget(unsigned short servo, unsigned short target);
+	void recordPosition(unsigned short servo, unsigned short position);
+	void recordErrors(unsigned short errors);
+	void recordMoving(bool moving);
+
+	/**
+	 * \brief Histogram bin of a round trip time.
+	 */
+	static unsigned rttBin(unsigned long long us);
+
+	/**
+	 * \brief Lower bound (in micro seconds) of a histogram bin.
+	 */
+	static unsigned long long rttBinUs(unsigned bin);
+
+	/**
+	 * \brief Round trip time of the given quantile (0..1) of a histogram,
+	 * e.g. of the difference of two snapshots. 0 if empty.
+	 */
+	static unsigned long long rttPercentile(const uint64_t rtt[POLOLU_STATS_RTT_BINS], double q);
+
+protected:
+	void begin();
+	void end();
+
+	string            name_;
+	PololuStatsBlock *block_ = nullptr;
+	std::mutex        mutex_; // serializes the writers of this process
+
+private:
+	PololuStats(const PololuStats&);
+	PololuStats& operator=(const PololuStats&);
+};
+
+
+/**
+ *
+ * \class PololuStatsView
+ *
+ * \brief Read-only view on the segment of another process.
+ *
+ */
+class PololuStatsView {
+public:
+
+	/**
+	 *
+	 * \brief Attaches to the segment. If it does not exist or has another
+	 * layout an exception (IException) is thrown.
+	 *
+	 */
+	PololuStatsView(const string &name);
+	~PololuStatsView();
+
+	/**
+	 *
+	 * \brief Copies a consistent state of the block. Returns false if the
+	 * writer kept the block busy for all tries.
+	 *
+	 */
+	bool snapshot(PololuStatsBlock &copy, unsigned tries = 1000);
+
+	/**
+	 * \brief True while the process that created the segment runs.
+	 */
+	bool isAlive();
+
+	/**
+	 * \brief Name of the first segment found in /dev/shm, empty if none.
+	 */
+	static string findFirst();
+
+protected:
+	string                  name_;
+	const PololuStatsBlock *block_ = nullptr;
+
+private:
+	PololuStatsView(const PololuStatsView&);
+	PololuStatsView& operator=(const PololuStatsView&);
+};
+
+
+/**
+ *
+ * \class ExceptionPololuStats
+ *
+ * \brief Exception class of PololuStats and PololuStatsView.
+ *
+ */
+class ExceptionPololuStats : public IException{
+	public:
+		ExceptionPololuStats(string msg){
+			msg_ = string("ExceptionPololuStats::") + msg;
+		};
+		string getMsg(){return msg_;};
+	protected:
+		string msg_;
+	private:
+		ExceptionPololuStats(){};
+};
+
+#endif // POLOLUSTATS_HPP_INCLUDED
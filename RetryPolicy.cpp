@@ -0,0 +1,47 @@
+//============================================================================
+// Name        : RetryPolicy.cpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : RetryPolicy source file. It contains the definition of the
+//               timeout helpers and of the RetryBackoff class.
+//============================================================================
+#include "RetryPolicy.hpp"
+
+
+unsigned long serialWireTimeUs(unsigned long baudRate, unsigned long bytes){
+	if(baudRate == 0){
+		return 0;
+	}
+	// 10 bits per byte, rounded up to the next micro second
+	return ((bytes * 10UL * 1000000UL) + baudRate - 1) / baudRate;
+}
+
+unsigned long serialReplyTimeoutUs(unsigned long baudRate,
+								   unsigned short sizeCmd,
+								   unsigned short sizeRes,
+								   unsigned long latencyUs){
+	return serialWireTimeUs(baudRate, sizeCmd + sizeRes) + latencyUs;
+}
+
+
+unsigned long RetryBackoff::delayUs(const RetryPolicy &policy, unsigned retry){
+	if((retry == 0) || (policy.backoffInitialUs == 0)){
+		return 0;
+	}
+
+	unsigned long d = policy.backoffInitialUs;
+	for(unsigned i = 1; (i < retry) && (d < policy.backoffMaxUs); i++){
+		d *= 2;
+	}
+	if((policy.backoffMaxUs > 0) && (d > policy.backoffMaxUs)){
+		d = policy.backoffMaxUs;
+	}
+
+	if(policy.backoffJitter > 0.0){
+		float j = (policy.backoffJitter > 1.0) ? 1.0 : policy.backoffJitter;
+		std::uniform_real_distribution<float> dist(-j, j);
+		float f = 1.0 + dist(rng_);
+		d = (unsigned long) (((float) d) * f);
+	}
+	return d;
+}
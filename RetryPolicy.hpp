@@ -0,0 +1,140 @@
+//============================================================================
+// Name        : RetryPolicy.hpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : RetryPolicy header file. It contains the retry and timeout
+//               policy applied per command by the Pololu class as well as
+//               the helpers to derive timeouts from the line parameters.
+//============================================================================
+#ifndef RETRYPOLICY_HPP_INCLUDED
+#define RETRYPOLICY_HPP_INCLUDED
+
+#include <random>
+
+
+/**
+ *
+ * \brief Time (in micro seconds) needed to transfer the given number of
+ * bytes over a serial line with the given baud rate. One byte is
+ * transferred as 10 bits (start bit, 8 data bits, stop bit).
+ *
+ */
+unsigned long serialWireTimeUs(unsigned long baudRate, unsigned long bytes);
+
+/**
+ *
+ * \brief Deadline (in micro seconds) for receiving a reply of sizeRes
+ * bytes after sizeCmd bytes have been sent. The wire time of command and
+ * reply is extended by the given latency allowance that covers USB
+ * polling intervals and the processing time of the controller.
+ *
+ */
+unsigned long serialReplyTimeoutUs(unsigned long baudRate,
+								   unsigned short sizeCmd,
+								   unsigned short sizeRes,
+								   unsigned long latencyUs);
+
+
+/**
+ *
+ * \class RetryPolicy
+ *
+ * \brief Describes how often and how long a command is tried
+ * before the failure is reported to the caller.
+ *
+ */
+struct RetryPolicy {
+
+	/**
+	 * \brief Number of attempts (>= 1). A value of 1 disables retries.
+	 */
+	unsigned maxAttempts;
+
+	/**
+	 * \brief Deadline of a single attempt in micro seconds. The value 0
+	 * derives the deadline from baud rate and reply size.
+	 */
+	unsigned long attemptTimeoutUs;
+
+	/**
+	 * \brief Delay before the first retry in micro seconds. The delay
+	 * is doubled for each further retry.
+	 */
+	unsigned long backoffInitialUs;
+
+	/**
+	 * \brief Upper limit of the delay between two attempts in micro seconds.
+	 */
+	unsigned long backoffMaxUs;
+
+	/**
+	 * \brief Relative jitter (0.0 .. 1.0) applied to each delay.
+	 */
+	float backoffJitter;
+
+	/**
+	 * \brief Upper limit of the time spent for all attempts and delays
+	 * in micro seconds. The value 0 means no limit.
+	 */
+	unsigned long totalBudgetUs;
+
+	RetryPolicy(unsigned      attempts  = 1,
+				unsigned long timeoutUs = 0,
+				unsigned long initialUs = 1000,
+				unsigned long maxUs     = 20000,
+				float         jitter    = 0.25,
+				unsigned long budgetUs  = 0){
+		maxAttempts      = attempts;
+		attemptTimeoutUs = timeoutUs;
+		backoffInitialUs = initialUs;
+		backoffMaxUs     = maxUs;
+		backoffJitter    = jitter;
+		totalBudgetUs    = budgetUs;
+	};
+};
+
+
+/**
+ *
+ * \brief Counters describing how a retry policy behaved.
+ *
+ */
+struct RetryStats {
+	unsigned long calls     = 0; /**< number of requests */
+	unsigned long attempts  = 0; /**< number of attempts over all requests */
+	unsigned long retries   = 0; /**< attempts after a failed attempt */
+	unsigned long failures  = 0; /**< requests that failed after all attempts */
+	unsigned long budgetExhausted = 0; /**< requests stopped by the total budget */
+	unsigned long backoffUs = 0; /**< total time spent in backoff delays */
+	unsigned long impossibleReplies = 0; /**< replies rejected by the plausibility check */
+	unsigned long timeouts  = 0; /**< pipelined replies not received within the deadline */
+	unsigned long resyncs   = 0; /**< in-band resynchronizations of the line */
+};
+
+
+/**
+ *
+ * \class RetryBackoff
+ *
+ * \brief Computes the exponential backoff delays of a retry policy.
+ * The jitter is drawn from a seeded generator, so runs can be reproduced.
+ *
+ */
+class RetryBackoff {
+public:
+	RetryBackoff(unsigned seed = 5489u) : rng_(seed){};
+
+	/**
+	 *
+	 * \brief Delay before the given retry (1 = first retry) in micro seconds.
+	 *
+	 */
+	unsigned long delayUs(const RetryPolicy &policy, unsigned retry);
+
+	void seed(unsigned s){rng_.seed(s);};
+
+protected:
+	std::minstd_rand rng_;
+};
+
+#endif // RETRYPOLICY_HPP_INCLUDED
@@ -6,6 +6,8 @@
 //               functions of the SerialCom class.
 //============================================================================
 #include "SerialCom.hpp"
+#include "RetryPolicy.hpp"
+#include "Trace.hpp"
 #include <stdio.h>
 #include <string>
 #include <iostream>
@@ -19,9 +21,23 @@
 	#include <stdint.h>
 	#include <termios.h>
 	#include <stdbool.h>
+	#include <poll.h>
+	#include <errno.h>
+	#include <string.h>
+	#include <sys/ioctl.h>
+	#include <sys/uio.h>
+	#include <chrono>
 #endif
 
 
+unsigned long SerialComBase::replyDeadlineUs(unsigned short sizeCmd, unsigned short sizeRes){
+	if(replyTimeoutUs_ > 0){
+		return replyTimeoutUs_;
+	}
+	return serialReplyTimeoutUs(baudRate_, sizeCmd, sizeRes, replyLatencyUs_);
+}
+
+
 
 #ifdef _WIN32
     	/**
@@ -135,8 +151,8 @@
 	 			 	 	 	 unsigned char *response,
 	 			 	 	 	 unsigned short sizeResponse){
 
-	 		if ((sizeCommand != 1) && (sizeCommand != 2) && (sizeCommand != 4)){
-	 			throw std::string("SerialCom::writeSerialCom: wrong parameter sizeCommand, allowed parameter 1,2 or 4.");
+	 		if ((sizeCommand < 1) || (sizeCommand > SERIALCOM_MAX_COMMAND)){
+	 			throw std::string("SerialCom::writeSerialCom: wrong parameter sizeCommand, allowed parameter 1 to SERIALCOM_MAX_COMMAND.");
 	 		}
 
 	    	DWORD bytesTrasfered; //Is given to the write or read command as a pointer. After executing the WriteFile or ReadFile, bytesTranfered contains the number of bytes transmitted or received.
@@ -212,6 +228,25 @@
     	    return;
     	};
 
+    	/*
+    	 * Line speed of a baud rate, B0 if the rate is not supported.
+    	 */
+    	static speed_t serialSpeed(unsigned short baudRate){
+    		switch(baudRate){
+    		case 300:   return B300;
+    		case 600:   return B600;
+    		case 1200:  return B1200;
+    		case 1800:  return B1800;
+    		case 2400:  return B2400;
+    		case 4800:  return B4800;
+    		case 9600:  return B9600;
+    		case 19200: return B19200;
+    		case 38400: return B38400;
+    		case 57600: return B57600;
+    		default:    return B0;
+    		}
+    	}
+
     	bool SerialComLINUX::openSerialCom(){
     		int success = -1;
 
@@ -220,7 +255,18 @@
     			throw new ExceptionSerialCom(msg);
     		}
 
-    		port_ = open(portName_, O_RDWR | O_NOCTTY); //success requires  permission
+    		// the reply deadlines are derived from the baud rate, so the
+    		// line has to run at exactly this rate
+    		speed_t speed = serialSpeed(baudRate_);
+    		if(speed == B0){
+    			string msg("openSerialCom: unsupported baud rate ");
+    			msg += to_string(baudRate_) + string(" for port '") + string(portName_) + string("'.");
+    			throw new ExceptionSerialCom(msg);
+    		}
+
+    		// non blocking: a full output buffer must not stall the caller,
+    		// the bytes are held in the output queue instead
+    		port_ = open(portName_, O_RDWR | O_NOCTTY | O_NONBLOCK); //success requires  permission
     		if (port_ == -1){
     			string msg("openSerialCom: LINUX cannot open port, check permission of '");
     			msg += string(portName_) + string("'.");
@@ -251,14 +297,14 @@
     		options.c_oflag &= ~(ONLCR | OCRNL);
     		options.c_lflag &= ~(ECHO | ECHONL | ICANON | ISIG | IEXTEN);
 
-    		// Set up timeouts: Calls to read() will return as soon as there is
-    		// at least one byte available or when 100 ms has passed.
-    		options.c_cc[VTIME] = 1;
+    		// Calls to read() return immediately with the bytes available,
+    		// the reply deadline is enforced by poll() in writeSerialCom.
+    		options.c_cc[VTIME] = 0;
     		options.c_cc[VMIN] = 0;
 
     		// This code only supports certain standard baud rates. Supporting
     		// non-standard baud rates should be possible but takes more work.
-    		cfsetospeed(&options, B9600);
+    		cfsetospeed(&options, speed);
     		cfsetispeed(&options, cfgetospeed(&options));
     		success = tcsetattr(port_, TCSANOW, &options);
     		if (success != 0){
@@ -268,6 +314,8 @@
     			throw new ExceptionSerialCom(msg);
     		}
 
+    		rx_.clear();
+    		tx_.clear();
     		isSerialComOpen_ = true;
     		return true;
     	};
@@ -275,6 +323,9 @@
     	bool SerialComLINUX::closeSerialCom(){
     		if(isSerialComOpen_){
     			try{
+    				// queued bytes get the time they need on the wire
+    				this->flushOutput(this->estimateTimeToWireUs(0) + replyLatencyUs_);
+    				tx_.clear();
     				close(port_);
     			}catch(...){
     				string msg("closeSerialCom:: error while trying to close port.");
@@ -290,59 +341,278 @@
     										unsigned short sizeCmd,
     										unsigned char *res,
     										unsigned short sizeRes){
+    		MEX_TRACE_SPAN_ARG("SerialCom::writeSerialCom", sizeCmd);
     		if(!isSerialComOpen_){
     			string msg("writeSerialCom:: port is not open yet, open port first before write/reading.");
     			throw new ExceptionSerialCom(msg);
     		}
 
     		// check parameter values of this function call
-    		if ((sizeCmd != 1) && (sizeCmd != 2) && (sizeCmd != 4)){
+    		if ((sizeCmd < 1) || (sizeCmd > SERIALCOM_MAX_COMMAND)){
     			string msg("SerialCom::writeSerialCom: wrong parameter sizeCommand,");
-    			msg += string("allowed parameter values are either 1,2 or 4.");
+    			msg += string("allowed parameter values are 1 to SERIALCOM_MAX_COMMAND.");
     			throw new ExceptionSerialCom(msg);
     		}
 
-    		if ((sizeRes != 0) && (sizeRes != 1) && (sizeRes != 2)){
+    		if (sizeRes > 3){
     			string msg("SerialCom::writeSerialCom: wrong parameter sizeRes,");
-    			msg += string("allowed parameter values are either 0,1 or 2.");
+    			msg += string("allowed parameter values are either 0,1,2 or 3.");
     			throw new ExceptionSerialCom(msg);
     		}
 
 
-    		//** Sending the command to the controller via port_. */
-    		if(write(port_, cmd, sizeCmd) == -1){
-    			string msg("SerialCom::writeSerialCom: Failed to write to port '");
-    			msg += string(portName_) + string("'.");
-    			throw new ExceptionSerialCom(msg);
+    		//** Late bytes of a previous reply must not be taken as the reply of this request. */
+    		if (sizeRes > 0){
+    			this->discardInput();
     		}
 
+    		//** Sending the command to the controller via port_. */
+    		stats_.transfers++;
+    		this->sendSerialCom(cmd, sizeCmd);
+
     		//** Check whether data needs to be read. */
     		if (sizeRes > 0){
-    			unsigned counter = 0;
-    			unsigned maxCounterValue = 20; // a kind of timeout
-    			unsigned short dataRecv = 0;
-    			unsigned short dataRecvTotal = 0;
-    			do{ // try to read data from port
-    				counter++;
-    				dataRecv = read(port_, (void *)res, sizeRes);
-    				if(dataRecv > 0){
-    					dataRecvTotal += dataRecv;
-    				}
-    				if(maxCounterValue == counter) break;
-    			}while(dataRecv != sizeRes);
-
-    			if(dataRecv != sizeRes){
+    			// the deadline is derived from baud rate and reply size unless
+    			// it was set explicitly (see setReplyTimeout(...))
+    			if(!this->receiveSerialCom(sizeRes, sizeCmd)){
     				stringstream ss;
     				ss << "SerialCom::writeSerialCom: Failed while reading from port '";
     				ss << portName_ << "'.";
-    				ss << "size of data (byte) received = " << dataRecvTotal << " unequal to expected";
-    				ss << " data size to be received = " << sizeRes << ". ";
-        			throw new ExceptionSerialCom(ss.str());
+    				ss << "size of data (byte) received = " << rx_.available() << " unequal to expected";
+    				ss << " data size to be received = " << sizeRes << " within " << this->replyDeadlineUs(sizeCmd, sizeRes) << " us. ";
+    				throw new ExceptionSerialCom(ss.str());
     			}
+    			rx_.copyOut(res, sizeRes);
     		};
     		return true;
     	};
 
+    	bool SerialComLINUX::sendSerialCom(const unsigned char cmd[], unsigned short sizeCmd){
+    		MEX_TRACE_SPAN_ARG("SerialCom::sendSerialCom", sizeCmd);
+    		if(!isSerialComOpen_){
+    			string msg("sendSerialCom:: port is not open yet, open port first before writing.");
+    			throw new ExceptionSerialCom(msg);
+    		}
+
+    		// make room if the queue is full, but not longer than the
+    		// queued bytes need on the wire
+    		if((tx_.getFree() < sizeCmd) &&
+    				!this->flushOutput(this->estimateTimeToWireUs(sizeCmd) + replyLatencyUs_) &&
+    				(tx_.getFree() < sizeCmd)){
+    			stringstream ss;
+    			ss << "SerialCom::sendSerialCom: output queue of port '" << portName_;
+    			ss << "' is full (" << tx_.available() << " bytes), the port does not drain.";
+    			throw new ExceptionSerialCom(ss.str());
+    		}
+
+    		unsigned char *span[2];
+    		unsigned size[2];
+    		unsigned spans = tx_.freeSpans(span, size);
+    		unsigned short copied = 0;
+    		for(unsigned i = 0; (i < spans) && (copied < sizeCmd); i++){
+    			unsigned chunk = (size[i] < (unsigned) (sizeCmd - copied)) ? size[i] : (sizeCmd - copied);
+    			memcpy(span[i], cmd + copied, chunk);
+    			copied += chunk;
+    		}
+    		tx_.commit(copied);
+    		if(tx_.available() > stats_.maxQueued){
+    			stats_.maxQueued = tx_.available();
+    		}
+
+    		// held bytes are written by the next receive, flush or release
+    		if(holdOutput_ > 0){
+    			return true;
+    		}
+    		if(!this->writeQueued()){
+    			string msg("SerialCom::writeSerialCom: Failed to write to port '");
+    			msg += string(portName_) + string("'.");
+    			throw new ExceptionSerialCom(msg);
+    		}
+    		return true;
+    	};
+
+    	bool SerialComLINUX::writeQueued(){
+    		const unsigned char *span[2];
+    		unsigned size[2];
+    		struct iovec iov[2];
+    		while(tx_.available() > 0){
+    			// both parts of a wrapped queue go out with one call
+    			unsigned spans = tx_.readSpans(span, size);
+    			for(unsigned i = 0; i < spans; i++){
+    				iov[i].iov_base = (void *) span[i];
+    				iov[i].iov_len  = size[i];
+    			}
+    			ssize_t n;
+    			{
+    				MEX_TRACE_SPAN_ARG("writev", tx_.available());
+    				n = writev(port_, iov, spans);
+    			}
+    			if(n > 0){
+    				tx_.consume(n);
+    				stats_.bytesWritten += n;
+    				continue;
+    			}
+    			if((n == -1) && ((errno == EAGAIN) || (errno == EINTR))){
+    				stats_.writeStalls++;
+    				return true;
+    			}
+    			return false;
+    		}
+    		return true;
+    	};
+
+    	bool SerialComLINUX::flushOutput(unsigned long timeoutUs){
+    		if(!isSerialComOpen_){
+    			return (tx_.available() == 0);
+    		}
+
+    		typedef std::chrono::steady_clock clock;
+    		clock::time_point deadline = clock::now() + std::chrono::microseconds(timeoutUs);
+    		struct pollfd pfd;
+    		pfd.fd = port_;
+    		pfd.events = POLLOUT;
+    		while(true){
+    			if(!this->writeQueued()){
+    				return false;
+    			}
+    			if(tx_.available() == 0){
+    				return true;
+    			}
+    			long remainingUs = std::chrono::duration_cast<std::chrono::microseconds>(deadline - clock::now()).count();
+    			if(remainingUs <= 0){
+    				return false;
+    			}
+    			pfd.revents = 0;
+    			poll(&pfd, 1, (int)((remainingUs + 999) / 1000));
+    		}
+    	};
+
+    	unsigned long SerialComLINUX::getOutputQueued(){
+    		unsigned long queued = tx_.available();
+    		int driver = 0;
+    		if(isSerialComOpen_ && (ioctl(port_, TIOCOUTQ, &driver) == 0) && (driver > 0)){
+    			queued += driver;
+    		}
+    		return queued;
+    	};
+
+    	unsigned long SerialComLINUX::estimateTimeToWireUs(unsigned short sizeCmd){
+    		return serialWireTimeUs(baudRate_, this->getOutputQueued() + sizeCmd);
+    	};
+
+    	bool SerialComLINUX::receiveSerialCom(unsigned short minBytes, unsigned short sizeCmd){
+    		MEX_TRACE_SPAN_ARG("SerialCom::receiveSerialCom", minBytes);
+    		if(!isSerialComOpen_){
+    			string msg("receiveSerialCom:: port is not open yet, open port first before reading.");
+    			throw new ExceptionSerialCom(msg);
+    		}
+
+    		typedef std::chrono::steady_clock clock;
+    		unsigned long timeoutUs = this->replyDeadlineUs(sizeCmd, minBytes);
+    		clock::time_point deadline = clock::now() + std::chrono::microseconds(timeoutUs);
+    		struct pollfd pfd;
+    		pfd.fd = port_;
+    		while(rx_.available() < minBytes){
+    			long remainingUs = std::chrono::duration_cast<std::chrono::microseconds>(deadline - clock::now()).count();
+    			if((remainingUs <= 0) || (rx_.getFree() == 0)){
+    				stats_.timeouts++;
+    				return false;
+    			}
+    			// the request may still sit in the output queue
+    			pfd.events = (tx_.available() > 0) ? (POLLIN | POLLOUT) : POLLIN;
+    			pfd.revents = 0;
+    			int ready;
+    			{
+    				MEX_TRACE_SPAN("poll");
+    				ready = poll(&pfd, 1, (int)((remainingUs + 999) / 1000));
+    			}
+    			if(ready == 0){
+    				continue;
+    			}
+    			if(ready < 0){
+    				if(errno == EINTR){
+    					continue;
+    				}
+    				this->failReceive("poll failed");
+    			}
+    			if((pfd.revents & POLLOUT) && !this->writeQueued()){
+    				this->failReceive("Failed to write the request");
+    			}
+    			if(!(pfd.revents & POLLIN)){
+    				if(pfd.revents & (POLLHUP | POLLERR | POLLNVAL)){
+    					// e.g. an unplugged device or a closed connection
+    					this->failReceive("connection lost");
+    				}
+    				continue;
+    			}
+    			// take everything that arrived, not only the missing bytes
+    			long received;
+    			{
+    				MEX_TRACE_SPAN("read");
+    				received = rx_.fill(port_);
+    			}
+    			if(received <= 0){
+    				// readable but nothing read: end of file or read error
+    				this->failReceive((received == 0) ? "end of file" : "read failed");
+    			}
+    			stats_.bytesRead += received;
+    		}
+    		return true;
+    	};
+
+    	void SerialComLINUX::failReceive(const char* reason){
+    		string msg("SerialCom::receiveSerialCom: ");
+    		msg += string(reason) + string(" on port '") + string(portName_) + string("'.");
+    		throw new ExceptionSerialCom(msg);
+    	};
+
+    	unsigned long SerialComLINUX::discardInput(){
+    		if(!isSerialComOpen_){
+    			return 0;
+    		}
+
+    		unsigned char buffer[64];
+    		unsigned long discarded = rx_.available();
+    		rx_.clear();
+    		struct pollfd pfd;
+    		pfd.fd = port_;
+    		pfd.events = POLLIN;
+    		pfd.revents = 0;
+    		while(poll(&pfd, 1, 0) > 0){ // never blocks
+    			ssize_t n = read(port_, (void *)buffer, sizeof(buffer));
+    			if(n <= 0){
+    				break;
+    			}
+    			discarded += n;
+    			pfd.revents = 0;
+    		}
+    		stats_.bytesDiscarded += discarded;
+    		return discarded;
+    	};
+
+    	bool SerialComLINUX::resynchronize(){
+    		if(!isSerialComOpen_){
+    			string msg("resynchronize:: port is not open yet, open port first.");
+    			throw new ExceptionSerialCom(msg);
+    		}
+    		stats_.resyncs++;
+
+    		// the line is considered in sync if no byte arrives within the
+    		// time a complete (longest) reply would need
+    		int quietMs = (int)((this->replyDeadlineUs(0, 3) + 999) / 1000);
+    		struct pollfd pfd;
+    		pfd.fd = port_;
+    		pfd.events = POLLIN;
+    		for(int round = 0; round < 8; round++){
+    			this->discardInput();
+    			pfd.revents = 0;
+    			if(poll(&pfd, 1, quietMs) == 0){
+    				return true;
+    			}
+    		}
+    		return false;
+    	};
+
     	int  SerialComLINUX::getPort(){
     		if(isSerialComOpen_){
     			return port_;
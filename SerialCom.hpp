@@ -9,6 +9,7 @@
 #define SERIALCOM_HPP_INCLUDED
 
 #include <string>
+#include "SerialRxRing.hpp"
 
 
 #ifdef _WIN32
@@ -20,6 +21,50 @@
 
 using namespace std;
 
+
+/**
+ *
+ * \brief Default allowance (in micro seconds) added to the wire time of
+ * command and reply when the reply deadline is derived from the baud rate.
+ * It covers USB polling intervals and the processing time of the controller.
+ *
+ */
+#define SERIALCOM_DEFAULT_LATENCY_US 10000
+
+/**
+ *
+ * \brief Maximal size (in bytes) of a command passed to writeSerialCom(...),
+ * e.g. a 4 byte command with CRC byte or two commands sent together.
+ *
+ */
+#define SERIALCOM_MAX_COMMAND 10
+
+/**
+ *
+ * \brief Capacity (in bytes) of the user space output queue holding the
+ * bytes the kernel did not accept yet.
+ *
+ */
+#define SERIALCOM_TX_QUEUE 4096
+
+
+/**
+ *
+ * \brief Counters of a serial connection.
+ *
+ */
+struct SerialComStats {
+	unsigned long transfers    = 0; /**< calls of writeSerialCom */
+	unsigned long bytesWritten = 0; /**< bytes sent to the controller */
+	unsigned long bytesRead    = 0; /**< bytes received from the controller */
+	unsigned long timeouts     = 0; /**< replies not completed within the deadline */
+	unsigned long bytesDiscarded = 0; /**< stale bytes dropped before a request or during a resync */
+	unsigned long resyncs      = 0; /**< calls of resynchronize */
+	unsigned long writeStalls  = 0; /**< writes that found the kernel output buffer full */
+	unsigned long maxQueued    = 0; /**< largest number of bytes held in the output queue */
+};
+
+
 /**
  *
  * \class SerialCom
@@ -48,6 +93,8 @@ public:
      * parameter. If the port can be successfully be opened the method retuns true.
      * If an error occurs an exception (IException) is thrown.
      * If the serial com is already  open an exception (IException) is thrown.
+     * The line runs at the baud rate given, a rate the port does not
+     * support (standard rates 300 to 57600) throws an exception (IException).
      *
      *  \return Returns TRUE on successful opening of a serial connection.
      *  \throws IException
@@ -68,15 +115,18 @@ public:
      * exception (IException) is thrown. If writing or reading fails, an exception is thrown.
      *
      * \param command[] : Contains the command to be sent
-     *                    (size of 1, 2 or 4 bytes, depending on the command).
+     *                    (size of 1, 2 or 4 bytes, depending on the command,
+     *                    one more if a CRC byte is appended).
      *
-     * \param sizeCommand : Contains the size (in bytes) of the command (1, 2 or 4).
+     * \param sizeCommand : Contains the size (in bytes) of the command
+     *                      (1 to SERIALCOM_MAX_COMMAND).
      *
      * \param response : Array of the given size (sizeResponse) where the response of the micro-controller
      *                   can be / is stored.
      *                   If no return value is expected, the pointer can be NULL.
      *
-     * \param sizeResponse : Contains the size of the command (1 or 2, in case of no
+     * \param sizeResponse : Contains the size of the response (1 or 2, 3 if a request
+     *                       is combined with the error request 0xA1, in case of no
      *                       response is expected the value has to be 0).  Thus, a sizeResponse value
      *                       of 0 indicates that no response from the micro-controller
      *                       will be read.
@@ -85,16 +135,144 @@ public:
      *
      */
     virtual bool writeSerialCom(unsigned char command[], unsigned short sizeCommand, unsigned char *response, unsigned short sizeResponse) = 0;
+
+    /**
+     *
+     * \brief Sets the deadline for receiving a reply in micro seconds.
+     * The value 0 derives the deadline from the baud rate and the size of
+     * command and reply (see serialReplyTimeoutUs(...) in RetryPolicy.hpp).
+     *
+     */
+    virtual void setReplyTimeout(unsigned long timeoutUs) = 0;
+
+    /**
+     *
+     * \brief Delivers the counters of this connection.
+     *
+     */
+    virtual SerialComStats getStats() = 0;
+
+    /**
+     *
+     * \brief Drops all bytes currently waiting in the receive path
+     * without blocking. It is called before every request that expects
+     * a reply, so late bytes of a previous reply cannot be taken as
+     * the reply of the next request.
+     *
+     * \return Number of bytes discarded.
+     *
+     */
+    virtual unsigned long discardInput() = 0;
+
+    /**
+     *
+     * \brief In-band recovery after a lost or stray byte. Incoming bytes
+     * are discarded until the line stayed quiet for the duration of a
+     * complete reply. The port is neither closed nor reconfigured.
+     *
+     * \return Returns true if the line became quiet, false if bytes kept
+     * arriving (e.g. the controller is still streaming data).
+     *
+     */
+    virtual bool resynchronize() = 0;
+
+    /**
+     *
+     * \brief Sends the bytes without waiting for a reply. Several
+     * commands can be sent at once, their replies are collected in the
+     * receive ring (see receiveSerialCom(...) and getRxRing()).
+     * If the port is not open or writing fails, an exception (IException)
+     * is thrown.
+     *
+     */
+    virtual bool sendSerialCom(const unsigned char command[], unsigned short sizeCommand) = 0;
+
+    /**
+     *
+     * \brief Reads into the receive ring until at least minBytes are
+     * available. The deadline is derived like the one of writeSerialCom(...)
+     * for a command of sizeCommand bytes. If the connection is lost
+     * (hang up, end of file, read or write error) an exception
+     * (IException) is thrown.
+     *
+     * \return Returns false if the bytes did not arrive in time.
+     *
+     */
+    virtual bool receiveSerialCom(unsigned short minBytes, unsigned short sizeCommand = 0) = 0;
+
+    /**
+     *
+     * \brief Persistent receive buffer of this connection.
+     *
+     */
+    virtual SerialRxRing& getRxRing() = 0;
+
+    /**
+     *
+     * \brief Number of bytes sent but not on the wire yet, i.e. the bytes
+     * in the user space output queue and in the output buffer of the driver
+     * (TIOCOUTQ).
+     *
+     */
+    virtual unsigned long getOutputQueued() = 0;
+
+    /**
+     *
+     * \brief Estimated time (in micro seconds) until the last byte of a
+     * new command of sizeCommand bytes has been sent, derived from the
+     * queued bytes and the baud rate.
+     *
+     */
+    virtual unsigned long estimateTimeToWireUs(unsigned short sizeCommand) = 0;
+
+    /**
+     *
+     * \brief Hands queued bytes over to the driver. Waits at most
+     * timeoutUs micro seconds for the port to become writable, 0 does
+     * not wait at all.
+     *
+     * \return Returns true if the output queue is empty.
+     *
+     */
+    virtual bool flushOutput(unsigned long timeoutUs = 0) = 0;
+
+    /**
+     *
+     * \brief Reserves the connection for a sequence of calls (e.g. send,
+     * receive and parse of pipelined requests) if it is shared by several
+     * users (see SerialComRegistry). A connection used by one owner only
+     * does not need to lock. Locks can be nested.
+     *
+     */
+    virtual void lock(){};
+
+    virtual void unlock(){};
 };
 
 
 
 
 class SerialComBase : public ISerialCom{
+	public:
+		void setReplyTimeout(unsigned long timeoutUs){replyTimeoutUs_ = timeoutUs;};
+		void setReplyLatency(unsigned long latencyUs){replyLatencyUs_ = latencyUs;};
+		SerialComStats getStats(){return stats_;};
+		SerialRxRing& getRxRing(){return rx_;};
+		SerialComBase() : tx_(SERIALCOM_TX_QUEUE){};
 	protected:
 		bool  isSerialComOpen_ = false;
 		const char* portName_ = nullptr;
 		unsigned short baudRate_ = 0;
+		unsigned long replyTimeoutUs_ = 0;
+		unsigned long replyLatencyUs_ = SERIALCOM_DEFAULT_LATENCY_US;
+		SerialComStats stats_;
+		SerialRxRing rx_;
+		SerialRxRing tx_; // output queue, the ring serves both directions
+
+		/**
+		 * \brief Reply deadline in micro seconds for the given transfer.
+		 */
+		unsigned long replyDeadlineUs(unsigned short sizeCmd, unsigned short sizeRes);
 };
 
 
@@ -118,9 +296,29 @@ class SerialComBase : public ISerialCom{
 		    bool openSerialCom();
 		    bool closeSerialCom();
 		    bool writeSerialCom(unsigned char command[], unsigned short sizeCommand, unsigned char *response, unsigned short sizeResponse);
+		    unsigned long discardInput();
+		    bool resynchronize();
+		    bool sendSerialCom(const unsigned char command[], unsigned short sizeCommand);
+		    bool receiveSerialCom(unsigned short minBytes, unsigned short sizeCommand = 0);
+		    unsigned long getOutputQueued();
+		    unsigned long estimateTimeToWireUs(unsigned short sizeCommand);
+		    bool flushOutput(unsigned long timeoutUs = 0);
 		    int  getPort();
 		protected:
 		    int port_;
+		    unsigned holdOutput_ = 0; // > 0: sendSerialCom only queues the bytes
+
+		    /**
+		     * \brief Writes queued bytes until the queue is empty or the
+		     * driver does not accept more (never blocks).
+		     */
+		    bool writeQueued();
+
+		    /**
+		     * \brief Throws an exception (IException) for a connection that
+		     * failed while a reply is awaited.
+		     */
+		    void failReceive(const char* reason);
 	};
 #endif
 
@@ -154,6 +352,14 @@ class SerialComBase : public ISerialCom{
 class IException{
 	public:
 
+		/**
+		 *
+		 * \brief The exceptions are thrown by pointer and deleted by the
+		 * catching code through this interface.
+		 *
+		 */
+		virtual ~IException(){};
+
 		/**
 		 *
 		 * \return string error messages
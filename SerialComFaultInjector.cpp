@@ -0,0 +1,113 @@
+//============================================================================
+// Name        : SerialComFaultInjector.cpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : SerialComFaultInjector source file. It contains the
+//               definition of the functions of the SerialComFaultInjector
+//               class.
+//============================================================================
+#include "SerialComFaultInjector.hpp"
+#include <sstream>
+
+
+SerialComFaultInjector::SerialComFaultInjector(ISerialCom *inner, unsigned long seed) : random_(seed), uniform_(0.0, 1.0){
+	if(inner == nullptr){
+		throw new ExceptionSerialCom(string("SerialComFaultInjector: the decorated connection is NULL."));
+	}
+	inner_ = inner;
+	for(unsigned i = 0; i < SERIALCOM_FAULT_COUNT; i++){
+		injected_[i] = 0;
+	}
+}
+
+void SerialComFaultInjector::setFault(SerialComFault fault, double probability, unsigned long delayUs){
+	if(fault >= SERIALCOM_FAULT_COUNT){
+		return;
+	}
+	spec_[fault].probability = (probability < 0.0) ? 0.0 : ((probability > 1.0) ? 1.0 : probability);
+	spec_[fault].delayUs     = delayUs;
+}
+
+void SerialComFaultInjector::clearFaults(){
+	for(unsigned i = 0; i < SERIALCOM_FAULT_COUNT; i++){
+		spec_[i] = SerialComFaultSpec();
+	}
+}
+
+unsigned long SerialComFaultInjector::getInjected(){
+	unsigned long sum = 0;
+	for(unsigned i = 0; i < SERIALCOM_FAULT_COUNT; i++){
+		sum += injected_[i];
+	}
+	return sum;
+}
+
+bool SerialComFaultInjector::draw(SerialComFault fault){
+	// no random number is drawn for disabled faults, so enabling one
+	// class does not change the sequence of the others
+	if(spec_[fault].probability <= 0.0){
+		return false;
+	}
+	if(uniform_(random_) >= spec_[fault].probability){
+		return false;
+	}
+	injected_[fault]++;
+	return true;
+}
+
+bool SerialComFaultInjector::writeSerialCom(unsigned char command[], unsigned short sizeCommand, unsigned char *response, unsigned short sizeResponse){
+	// same sequence as SerialComLINUX::writeSerialCom
+	if(sizeResponse > 0){
+		this->discardInput();
+	}
+	this->sendSerialCom(command, sizeCommand);
+	if(sizeResponse > 0){
+		if(!this->receiveSerialCom(sizeResponse, sizeCommand)){
+			stringstream ss;
+			ss << "SerialComFaultInjector::writeSerialCom: size of data (byte) received = ";
+			ss << this->getRxRing().available() << " unequal to expected data size to be received = " << sizeResponse << ".";
+			throw new ExceptionSerialCom(ss.str());
+		}
+		this->getRxRing().copyOut(response, sizeResponse);
+	}
+	return true;
+}
+
+bool SerialComFaultInjector::sendSerialCom(const unsigned char command[], unsigned short sizeCommand){
+	if(this->draw(SERIALCOM_FAULT_WRITE_ERROR)){
+		throw new ExceptionSerialCom(string("SerialComFaultInjector::sendSerialCom: injected write error."));
+	}
+	return inner_->sendSerialCom(command, sizeCommand);
+}
+
+bool SerialComFaultInjector::receiveSerialCom(unsigned short minBytes, unsigned short sizeCommand){
+	SerialRxRing &ring = this->getRxRing();
+	if(ring.available() >= minBytes){
+		return true;
+	}
+
+	if(this->draw(SERIALCOM_FAULT_DELAY)){
+		clock_->sleepUs(spec_[SERIALCOM_FAULT_DELAY].delayUs);
+	}
+
+	if(this->draw(SERIALCOM_FAULT_PARTIAL_READ)){
+		// only a part of the reply is there, the caller gives up early
+		// and the rest turns up as stale bytes later
+		if(minBytes > 1){
+			inner_->receiveSerialCom(minBytes - 1, sizeCommand);
+		}
+		return false;
+	}
+
+	if(!inner_->receiveSerialCom(minBytes, sizeCommand)){
+		return false;
+	}
+
+	if(this->draw(SERIALCOM_FAULT_DROP_BYTE)){
+		// a byte is lost on the line, the reply stays incomplete until
+		// the deadline (or is completed by the next reply)
+		ring.consume(1);
+		return inner_->receiveSerialCom(minBytes, sizeCommand);
+	}
+	return true;
+}
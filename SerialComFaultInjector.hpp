@@ -0,0 +1,135 @@
+//============================================================================
+// Name        : SerialComFaultInjector.hpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : SerialComFaultInjector header file. It contains a decorator
+//               of ISerialCom that injects transmission faults with seeded
+//               randomness, so the recovery paths of the stack can be
+//               tested and measured.
+//============================================================================
+#ifndef SERIALCOMFAULTINJECTOR_HPP_INCLUDED
+#define SERIALCOMFAULTINJECTOR_HPP_INCLUDED
+
+#include "SerialCom.hpp"
+#include "Clock.hpp"
+#include <random>
+
+
+/**
+ *
+ * \brief Classes of injected faults.
+ *
+ */
+enum SerialComFault {
+	SERIALCOM_FAULT_DROP_BYTE = 0, /**< a reply byte is lost, the reply is incomplete at the deadline */
+	SERIALCOM_FAULT_DELAY,         /**< the reply is received delayUs later */
+	SERIALCOM_FAULT_PARTIAL_READ,  /**< the read returns before the reply is complete, the rest arrives later */
+	SERIALCOM_FAULT_WRITE_ERROR,   /**< the command is not sent and the write fails */
+	SERIALCOM_FAULT_COUNT
+};
+
+
+/**
+ *
+ * \brief Probability and parameter of a fault class.
+ *
+ */
+struct SerialComFaultSpec {
+	double        probability = 0.0; /**< per send (write error) or per receive (all others), 0..1 */
+	unsigned long delayUs     = 0;   /**< SERIALCOM_FAULT_DELAY only */
+};
+
+
+/**
+ *
+ * \class SerialComFaultInjector
+ *
+ * \brief Decorator of an ISerialCom that injects faults into the
+ * transfers of the decorated connection. The faults are drawn from a
+ * random generator with the given seed, so a run can be repeated
+ * exactly. Injectors can be stacked.
+ *
+ * writeSerialCom(...) is composed of sendSerialCom(...) and
+ * receiveSerialCom(...) of the injector, so single and pipelined
+ * requests see the same faults. The decorated connection is not owned.
+ *
+ */
+class SerialComFaultInjector : public ISerialCom {
+public:
+	SerialComFaultInjector(ISerialCom *inner, unsigned long seed = 1);
+
+	/**
+	 *
+	 * \brief Sets probability and parameter of a fault class.
+	 *
+	 */
+	void setFault(SerialComFault fault, double probability, unsigned long delayUs = 0);
+
+	SerialComFaultSpec getFault(SerialComFault fault){return spec_[fault];};
+
+	/**
+	 *
+	 * \brief Disables all faults.
+	 *
+	 */
+	void clearFaults();
+
+	/**
+	 *
+	 * \brief Restarts the random sequence.
+	 *
+	 */
+	void setSeed(unsigned long seed){random_.seed(seed);};
+
+	/**
+	 *
+	 * \brief Number of faults of the class injected so far.
+	 *
+	 */
+	unsigned long getInjected(SerialComFault fault){return injected_[fault];};
+
+	/**
+	 *
+	 * \brief Number of faults of all classes injected so far.
+	 *
+	 */
+	unsigned long getInjected();
+
+	ISerialCom* getInner(){return inner_;};
+
+	/**
+	 *
+	 * \brief Clock used for the injected delays (not owned).
+	 *
+	 */
+	void setClock(IClock *clock){clock_ = (clock == nullptr) ? &SystemClock::instance() : clock;};
+
+	void initSerialCom(const char* portName, unsigned short baudRate){inner_->initSerialCom(portName, baudRate);};
+	bool openSerialCom(){return inner_->openSerialCom();};
+	bool closeSerialCom(){return inner_->closeSerialCom();};
+	bool writeSerialCom(unsigned char command[], unsigned short sizeCommand, unsigned char *response, unsigned short sizeResponse);
+	void setReplyTimeout(unsigned long timeoutUs){inner_->setReplyTimeout(timeoutUs);};
+	SerialComStats getStats(){return inner_->getStats();};
+	unsigned long discardInput(){return inner_->discardInput();};
+	bool resynchronize(){return inner_->resynchronize();};
+	bool sendSerialCom(const unsigned char command[], unsigned short sizeCommand);
+	bool receiveSerialCom(unsigned short minBytes, unsigned short sizeCommand = 0);
+	SerialRxRing& getRxRing(){return inner_->getRxRing();};
+	unsigned long getOutputQueued(){return inner_->getOutputQueued();};
+	unsigned long estimateTimeToWireUs(unsigned short sizeCommand){return inner_->estimateTimeToWireUs(sizeCommand);};
+	bool flushOutput(unsigned long timeoutUs = 0){return inner_->flushOutput(timeoutUs);};
+	void lock(){inner_->lock();};
+	void unlock(){inner_->unlock();};
+
+protected:
+	bool draw(SerialComFault fault);
+
+	ISerialCom        *inner_;
+	IClock            *clock_ = &SystemClock::instance();
+	SerialComFaultSpec spec_[SERIALCOM_FAULT_COUNT];
+	unsigned long      injected_[SERIALCOM_FAULT_COUNT];
+	std::mt19937       random_;
+	std::uniform_real_distribution<double> uniform_;
+};
+
+#endif // SERIALCOMFAULTINJECTOR_HPP_INCLUDED
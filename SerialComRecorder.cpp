@@ -0,0 +1,125 @@
+//============================================================================
+// Name        : SerialComRecorder.cpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : SerialComRecorder source file. It contains the definition of
+//               the functions of the SerialComRecorder class.
+//============================================================================
+#include "SerialComRecorder.hpp"
+#include <sstream>
+
+
+SerialComRecorder::SerialComRecorder(ISerialCom *inner, ostream &out, IClock *clock) : out_(out){
+	if(inner == nullptr){
+		throw new ExceptionSerialCom(string("SerialComRecorder: the decorated connection is NULL."));
+	}
+	inner_ = inner;
+	clock_ = (clock == nullptr) ? &SystemClock::instance() : clock;
+}
+
+void SerialComRecorder::record(unsigned long long timeUs, unsigned servo, char kind, unsigned value){
+	out_ << timeUs << "," << servo << "," << kind << "," << value << "\n";
+	records_++;
+}
+
+bool SerialComRecorder::writeSerialCom(unsigned char command[], unsigned short sizeCommand, unsigned char *response, unsigned short sizeResponse){
+	// same sequence as SerialComLINUX::writeSerialCom
+	if(sizeResponse > 0){
+		this->discardInput();
+	}
+	this->sendSerialCom(command, sizeCommand);
+	if(sizeResponse > 0){
+		if(!this->receiveSerialCom(sizeResponse, sizeCommand)){
+			stringstream ss;
+			ss << "SerialComRecorder::writeSerialCom: size of data (byte) received = ";
+			ss << this->getRxRing().available() << " unequal to expected data size to be received = " << sizeResponse << ".";
+			throw new ExceptionSerialCom(ss.str());
+		}
+		this->getRxRing().copyOut(response, sizeResponse);
+	}
+	return true;
+}
+
+bool SerialComRecorder::sendSerialCom(const unsigned char command[], unsigned short sizeCommand){
+	bool result = inner_->sendSerialCom(command, sizeCommand);
+	// the controller acts when the bytes are on the wire
+	unsigned long long timeUs = clock_->nowUs() + inner_->estimateTimeToWireUs(0);
+
+	unsigned short i = 0;
+	while(i < sizeCommand){
+		unsigned char cmd = command[i];
+		unsigned short length;
+		Request r;
+		r.servo = (i + 1 < sizeCommand) ? command[i + 1] : 0;
+		r.position = false;
+		r.timeUs = timeUs;
+		r.replySize = 0;
+		switch(cmd){
+		case 0x84: // set target
+		case 0x87: // set speed
+		case 0x89: // set acceleration
+			length = 4;
+			if(i + 4 <= sizeCommand){
+				char kind = (cmd == 0x84) ? 'T' : ((cmd == 0x87) ? 'S' : 'A');
+				this->record(timeUs, command[i + 1], kind, command[i + 2] + (command[i + 3] << 7));
+			}
+			break;
+		case 0xFF: // Mini SSC, the target depends on the range settings
+			length = 3;
+			break;
+		case 0x90: // get position
+			length = 2;
+			r.position = true;
+			r.replySize = 2;
+			break;
+		case 0x93: // get moving state
+			length = 1;
+			r.replySize = 1;
+			break;
+		case 0xA1: // get errors
+			length = 1;
+			r.replySize = 2;
+			break;
+		case 0xA2: // go home
+			length = 1;
+			break;
+		default:
+			// not a command of the compact protocol, stop decoding
+			return result;
+		}
+		if(r.replySize > 0){
+			pending_.push_back(r);
+		}
+		i += length + (crc_ ? 1 : 0);
+	}
+	return result;
+}
+
+bool SerialComRecorder::receiveSerialCom(unsigned short minBytes, unsigned short sizeCommand){
+	if(!inner_->receiveSerialCom(minBytes, sizeCommand)){
+		return false;
+	}
+	// the replies of the outstanding requests follow each other in the ring
+	SerialRxRing &ring = inner_->getRxRing();
+	unsigned offset = 0;
+	while(!pending_.empty() && (offset + pending_.front().replySize <= ring.available())){
+		const Request &r = pending_.front();
+		if(r.position){
+			this->record(r.timeUs, r.servo, 'P', ring.peekWord(offset));
+		}
+		offset += r.replySize;
+		pending_.pop_front();
+	}
+	return true;
+}
+
+unsigned long SerialComRecorder::discardInput(){
+	// replies still outstanding are dropped with the input
+	pending_.clear();
+	return inner_->discardInput();
+}
+
+bool SerialComRecorder::resynchronize(){
+	pending_.clear();
+	return inner_->resynchronize();
+}
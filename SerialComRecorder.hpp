@@ -0,0 +1,85 @@
+//============================================================================
+// Name        : SerialComRecorder.hpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : SerialComRecorder header file. It contains a decorator of
+//               ISerialCom that records the servo commands and position
+//               readbacks passing through as a trace for the servoFit tool.
+//============================================================================
+#ifndef SERIALCOMRECORDER_HPP_INCLUDED
+#define SERIALCOMRECORDER_HPP_INCLUDED
+
+#include "SerialCom.hpp"
+#include "Clock.hpp"
+#include <ostream>
+#include <deque>
+
+
+/**
+ *
+ * \class SerialComRecorder
+ *
+ * \brief Decorator of an ISerialCom that writes a line
+ *
+ *    timeUs,servo,kind,value
+ *
+ * for every set target (T), set speed (S), set acceleration (A) and
+ * position reply (P) to the given stream (see ServoTraceReader). A
+ * position is stamped with the time its request left the host, i.e.
+ * when the controller sampled it. Replies are assigned to the requests
+ * in the order of the requests, so pipelined requests are recorded as
+ * well. The decorated connection and the stream are not owned.
+ *
+ */
+class SerialComRecorder : public ISerialCom {
+public:
+	SerialComRecorder(ISerialCom *inner, ostream &out, IClock *clock = nullptr);
+
+	/**
+	 *
+	 * \brief Commands carry a CRC byte (see Pololu::setCrcMode).
+	 *
+	 */
+	void setCrcMode(bool enabled){crc_ = enabled;};
+
+	unsigned long getRecords(){return records_;};
+
+	void initSerialCom(const char* portName, unsigned short baudRate){inner_->initSerialCom(portName, baudRate);};
+	bool openSerialCom(){pending_.clear(); return inner_->openSerialCom();};
+	bool closeSerialCom(){pending_.clear(); return inner_->closeSerialCom();};
+	bool writeSerialCom(unsigned char command[], unsigned short sizeCommand, unsigned char *response, unsigned short sizeResponse);
+	void setReplyTimeout(unsigned long timeoutUs){inner_->setReplyTimeout(timeoutUs);};
+	SerialComStats getStats(){return inner_->getStats();};
+	unsigned long discardInput();
+	bool resynchronize();
+	bool sendSerialCom(const unsigned char command[], unsigned short sizeCommand);
+	bool receiveSerialCom(unsigned short minBytes, unsigned short sizeCommand = 0);
+	SerialRxRing& getRxRing(){return inner_->getRxRing();};
+	unsigned long getOutputQueued(){return inner_->getOutputQueued();};
+	unsigned long estimateTimeToWireUs(unsigned short sizeCommand){return inner_->estimateTimeToWireUs(sizeCommand);};
+	bool flushOutput(unsigned long timeoutUs = 0){return inner_->flushOutput(timeoutUs);};
+	void lock(){inner_->lock();};
+	void unlock(){inner_->unlock();};
+
+protected:
+	/**
+	 * \brief Request whose reply is outstanding.
+	 */
+	struct Request {
+		unsigned char      servo;
+		unsigned char      replySize;
+		bool               position;
+		unsigned long long timeUs;
+	};
+
+	void record(unsigned long long timeUs, unsigned servo, char kind, unsigned value);
+
+	ISerialCom         *inner_;
+	ostream            &out_;
+	IClock             *clock_;
+	bool                crc_ = false;
+	std::deque<Request> pending_;
+	unsigned long       records_ = 0;
+};
+
+#endif // SERIALCOMRECORDER_HPP_INCLUDED
@@ -0,0 +1,275 @@
+//============================================================================
+// Name        : SerialComRegistry.cpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : SerialComRegistry source file. It contains the definition of
+//               the functions of the SerialComRegistry and SharedSerialCom
+//               classes.
+//============================================================================
+#include "SerialComRegistry.hpp"
+#include "SerialComSocket.hpp"
+#include <sstream>
+
+
+SerialComRegistry& SerialComRegistry::instance(){
+	static SerialComRegistry registry;
+	return registry;
+}
+
+SerialComRegistry::~SerialComRegistry(){
+	std::lock_guard<std::mutex> guard(mutex_);
+	for(std::map<string, SerialComEntry*>::iterator it = entries_.begin(); it != entries_.end(); it++){
+		try{
+			it->second->com->closeSerialCom();
+		}catch(...){
+		}
+		delete it->second->com;
+		delete it->second;
+	}
+	entries_.clear();
+}
+
+SharedSerialCom* SerialComRegistry::acquire(const char* portName, unsigned short baudRate){
+	return new SharedSerialCom(this->attach(portName, baudRate));
+}
+
+void SerialComRegistry::setKeepIdle(bool keepIdle){
+	keepIdle_ = keepIdle;
+	if(!keepIdle){
+		this->closeIdle();
+	}
+}
+
+bool SerialComRegistry::getKeepIdle(){
+	return keepIdle_;
+}
+
+unsigned SerialComRegistry::closeIdle(){
+	std::lock_guard<std::mutex> guard(mutex_);
+	unsigned closed = 0;
+	std::map<string, SerialComEntry*>::iterator it = entries_.begin();
+	while(it != entries_.end()){
+		SerialComEntry *entry = it->second;
+		{
+			std::lock_guard<std::recursive_mutex> entryGuard(entry->mutex);
+			if(entry->isOpen && (entry->openHandles == 0)){
+				try{
+					entry->com->closeSerialCom();
+				}catch(...){
+				}
+				entry->isOpen = false;
+				closed++;
+			}
+		}
+		if((entry->users == 0) && !entry->isOpen){
+			delete entry->com;
+			delete entry;
+			it = entries_.erase(it);
+		}else{
+			it++;
+		}
+	}
+	return closed;
+}
+
+unsigned SerialComRegistry::getUserCount(const char* portName){
+	std::lock_guard<std::mutex> guard(mutex_);
+	std::map<string, SerialComEntry*>::iterator it = entries_.find(string(portName));
+	return (it == entries_.end()) ? 0 : it->second->users;
+}
+
+unsigned long SerialComRegistry::getOpenCount(const char* portName){
+	std::lock_guard<std::mutex> guard(mutex_);
+	std::map<string, SerialComEntry*>::iterator it = entries_.find(string(portName));
+	return (it == entries_.end()) ? 0 : it->second->opens;
+}
+
+unsigned SerialComRegistry::size(){
+	std::lock_guard<std::mutex> guard(mutex_);
+	return entries_.size();
+}
+
+SerialComEntry* SerialComRegistry::attach(const char* portName, unsigned short baudRate, SerialComEntry *current){
+	std::lock_guard<std::mutex> guard(mutex_);
+	string key(portName);
+	std::map<string, SerialComEntry*>::iterator it = entries_.find(key);
+	if(it != entries_.end()){
+		SerialComEntry *entry = it->second;
+		std::lock_guard<std::recursive_mutex> entryGuard(entry->mutex);
+		if(entry->baudRate != baudRate){
+			// the handle changing its settings does not count as a user
+			unsigned others = entry->users - ((entry == current) ? 1 : 0);
+			if((others > 0) || (entry->openHandles > 0)){
+				stringstream ss;
+				ss << "SerialComRegistry::attach: port '" << portName << "' is in use with baud rate ";
+				ss << entry->baudRate << ", requested " << baudRate << ".";
+				throw new ExceptionSerialCom(ss.str());
+			}
+			// idle connection kept open with other settings
+			if(entry->isOpen){
+				entry->com->closeSerialCom();
+				entry->isOpen = false;
+			}
+			entry->baudRate = baudRate;
+			entry->com->initSerialCom(entry->portName.c_str(), baudRate);
+		}
+		entry->users++;
+		return entry;
+	}
+
+	SerialComEntry *entry = new SerialComEntry();
+	entry->portName = key;
+	entry->baudRate = baudRate;
+	// the port name of the connection refers to the string of the entry
+	if(SerialComSocket::isSocketName(portName)){
+		entry->com  = new SerialComSocket(entry->portName.c_str(), baudRate);
+	}else{
+		entry->com  = new SerialCom(entry->portName.c_str(), baudRate);
+	}
+	entry->users    = 1;
+	entries_[key] = entry;
+	return entry;
+}
+
+void SerialComRegistry::detach(SerialComEntry *entry){
+	std::lock_guard<std::mutex> guard(mutex_);
+	bool remove = false;
+	{
+		std::lock_guard<std::recursive_mutex> entryGuard(entry->mutex);
+		entry->users--;
+		remove = (entry->users == 0) && (entry->openHandles == 0) && !entry->isOpen;
+	}
+	if(remove){
+		entries_.erase(entry->portName);
+		delete entry->com;
+		delete entry;
+	}
+}
+
+void SerialComRegistry::openEntry(SerialComEntry *entry){
+	// called with the lock of the entry
+	if(!entry->isOpen){
+		entry->com->openSerialCom();
+		entry->isOpen = true;
+		entry->opens++;
+	}
+	entry->openHandles++;
+}
+
+void SerialComRegistry::closeEntry(SerialComEntry *entry){
+	// called with the lock of the entry
+	if(entry->openHandles > 0){
+		entry->openHandles--;
+	}
+	if((entry->openHandles == 0) && entry->isOpen && !keepIdle_){
+		entry->isOpen = false;
+		entry->com->closeSerialCom();
+	}
+}
+
+
+
+SharedSerialCom::~SharedSerialCom(){
+	try{
+		this->closeSerialCom();
+	}catch(...){
+	}
+	SerialComRegistry::instance().detach(entry_);
+}
+
+void SharedSerialCom::checkOpen(const char* method){
+	if(!isOpen_){
+		string msg(method);
+		msg += string(":: port is not open yet, open port first before write/reading.");
+		throw new ExceptionSerialCom(msg);
+	}
+}
+
+void SharedSerialCom::initSerialCom(const char* portName, unsigned short baudRate){
+	if(isOpen_){
+		string msg("initSerialCom:: port is already open, close port first before initialization.");
+		throw new ExceptionSerialCom(msg);
+	}
+	SerialComEntry *entry = SerialComRegistry::instance().attach(portName, baudRate, entry_);
+	SerialComRegistry::instance().detach(entry_);
+	entry_ = entry;
+}
+
+bool SharedSerialCom::openSerialCom(){
+	if(isOpen_){
+		string msg("openSerialCom:: port is already open, close port first before open it.");
+		throw new ExceptionSerialCom(msg);
+	}
+	std::lock_guard<std::recursive_mutex> guard(entry_->mutex);
+	SerialComRegistry::instance().openEntry(entry_);
+	isOpen_ = true;
+	return true;
+}
+
+bool SharedSerialCom::closeSerialCom(){
+	if(isOpen_){
+		std::lock_guard<std::recursive_mutex> guard(entry_->mutex);
+		isOpen_ = false;
+		SerialComRegistry::instance().closeEntry(entry_);
+	}
+	return true;
+}
+
+bool SharedSerialCom::writeSerialCom(unsigned char command[], unsigned short sizeCommand, unsigned char *response, unsigned short sizeResponse){
+	this->checkOpen("writeSerialCom");
+	std::lock_guard<std::recursive_mutex> guard(entry_->mutex);
+	entry_->com->setReplyTimeout(replyTimeoutUs_);
+	return entry_->com->writeSerialCom(command, sizeCommand, response, sizeResponse);
+}
+
+SerialComStats SharedSerialCom::getStats(){
+	std::lock_guard<std::recursive_mutex> guard(entry_->mutex);
+	return entry_->com->getStats();
+}
+
+unsigned long SharedSerialCom::discardInput(){
+	if(!isOpen_){
+		return 0;
+	}
+	std::lock_guard<std::recursive_mutex> guard(entry_->mutex);
+	return entry_->com->discardInput();
+}
+
+bool SharedSerialCom::resynchronize(){
+	this->checkOpen("resynchronize");
+	std::lock_guard<std::recursive_mutex> guard(entry_->mutex);
+	entry_->com->setReplyTimeout(replyTimeoutUs_);
+	return entry_->com->resynchronize();
+}
+
+bool SharedSerialCom::sendSerialCom(const unsigned char command[], unsigned short sizeCommand){
+	this->checkOpen("sendSerialCom");
+	std::lock_guard<std::recursive_mutex> guard(entry_->mutex);
+	return entry_->com->sendSerialCom(command, sizeCommand);
+}
+
+bool SharedSerialCom::receiveSerialCom(unsigned short minBytes, unsigned short sizeCommand){
+	this->checkOpen("receiveSerialCom");
+	std::lock_guard<std::recursive_mutex> guard(entry_->mutex);
+	entry_->com->setReplyTimeout(replyTimeoutUs_);
+	return entry_->com->receiveSerialCom(minBytes, sizeCommand);
+}
+
+SerialRxRing& SharedSerialCom::getRxRing(){
+	return entry_->com->getRxRing();
+}
+
+unsigned long SharedSerialCom::getOutputQueued(){
+	std::lock_guard<std::recursive_mutex> guard(entry_->mutex);
+	return entry_->com->getOutputQueued();
+}
+
+unsigned long SharedSerialCom::estimateTimeToWireUs(unsigned short sizeCommand){
+	std::lock_guard<std::recursive_mutex> guard(entry_->mutex);
+	return entry_->com->estimateTimeToWireUs(sizeCommand);
+}
+
+bool SharedSerialCom::flushOutput(unsigned long timeoutUs){
+	std::lock_guard<std::recursive_mutex> guard(entry_->mutex);
+	return entry_->com->flushOutput(timeoutUs);
+}
@@ -0,0 +1,167 @@
+//============================================================================
+// Name        : SerialComRegistry.hpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : SerialComRegistry header file. It contains the process wide
+//               registry of serial connections and the handles sharing one
+//               connection per device.
+//============================================================================
+#ifndef SERIALCOMREGISTRY_HPP_INCLUDED
+#define SERIALCOMREGISTRY_HPP_INCLUDED
+
+#include "SerialCom.hpp"
+#include <map>
+#include <mutex>
+#include <atomic>
+
+
+/**
+ *
+ * \brief Connection to one device shared by several handles.
+ *
+ */
+struct SerialComEntry {
+	string                portName;
+	unsigned short        baudRate    = 0;
+	ISerialCom           *com         = nullptr;
+	std::recursive_mutex  mutex;           /**< serializes the transfers of all handles */
+	unsigned              users       = 0; /**< handles bound to the entry */
+	unsigned              openHandles = 0; /**< handles that opened the connection */
+	bool                  isOpen      = false; /**< device is open */
+	unsigned long         opens       = 0; /**< times the device has been opened */
+};
+
+
+class SharedSerialCom;
+
+
+/**
+ *
+ * \class SerialComRegistry
+ *
+ * \brief Process wide registry of serial connections keyed by the
+ * device path.
+ *
+ * acquire(...) hands out a handle (SharedSerialCom) to the connection of
+ * the device; all handles of a device share one configured connection.
+ * The device is opened by the first handle that opens and closed when
+ * the last handle closes. With setKeepIdle(true) an unused connection
+ * stays open, so opening it again is a lookup in the registry.
+ *
+ * Port names starting with "tcp:" or "unix:" refer to a serial server
+ * and are served by a SerialComSocket, all others by a SerialCom.
+ *
+ */
+class SerialComRegistry {
+	friend class SharedSerialCom;
+public:
+
+	static SerialComRegistry& instance();
+
+	/**
+	 *
+	 * \brief Delivers a new handle to the connection of the device. The
+	 * caller owns the handle and deletes it when done. If the device is
+	 * in use with another baud rate an exception (IException) is thrown.
+	 *
+	 */
+	SharedSerialCom* acquire(const char* portName, unsigned short baudRate);
+
+	/**
+	 *
+	 * \brief Keeps connections open when the last handle closes.
+	 * Disabled per default.
+	 *
+	 */
+	void setKeepIdle(bool keepIdle);
+
+	bool getKeepIdle();
+
+	/**
+	 *
+	 * \brief Closes all connections without open handles.
+	 *
+	 * \return unsigned. Number of connections closed.
+	 */
+	unsigned closeIdle();
+
+	/**
+	 * \brief Number of handles bound to the device.
+	 */
+	unsigned getUserCount(const char* portName);
+
+	/**
+	 * \brief Number of times the device has been opened.
+	 */
+	unsigned long getOpenCount(const char* portName);
+
+	unsigned size();
+
+private:
+	SerialComRegistry(){};
+	~SerialComRegistry();
+	SerialComRegistry(const SerialComRegistry&);
+	SerialComRegistry& operator=(const SerialComRegistry&);
+
+	SerialComEntry* attach(const char* portName, unsigned short baudRate, SerialComEntry *current = nullptr);
+	void detach(SerialComEntry *entry);
+	void openEntry(SerialComEntry *entry);
+	void closeEntry(SerialComEntry *entry);
+
+	std::mutex                        mutex_;
+	std::map<string, SerialComEntry*> entries_;
+	std::atomic<bool>                 keepIdle_{false};
+};
+
+
+/**
+ *
+ * \class SharedSerialCom
+ *
+ * \brief Handle to a connection of the SerialComRegistry. It implements
+ * ISerialCom; every call is executed under the lock of the connection,
+ * so handles used by different threads do not interleave their
+ * transfers. Sequences of calls can be protected with lock() / unlock().
+ *
+ * The reply timeout is a setting of the handle and applied to each of
+ * its transfers.
+ *
+ */
+class SharedSerialCom : public ISerialCom {
+	friend class SerialComRegistry;
+public:
+	~SharedSerialCom();
+
+	/**
+	 * \brief Binds the handle to another device (the handle must be closed).
+	 * The baud rate of a device can be changed by its only handle.
+	 */
+	void initSerialCom(const char* portName, unsigned short baudRate);
+	bool openSerialCom();
+	bool closeSerialCom();
+	bool writeSerialCom(unsigned char command[], unsigned short sizeCommand, unsigned char *response, unsigned short sizeResponse);
+	void setReplyTimeout(unsigned long timeoutUs){replyTimeoutUs_ = timeoutUs;};
+	SerialComStats getStats();
+	unsigned long discardInput();
+	bool resynchronize();
+	bool sendSerialCom(const unsigned char command[], unsigned short sizeCommand);
+	bool receiveSerialCom(unsigned short minBytes, unsigned short sizeCommand = 0);
+	SerialRxRing& getRxRing();
+	unsigned long getOutputQueued();
+	unsigned long estimateTimeToWireUs(unsigned short sizeCommand);
+	bool flushOutput(unsigned long timeoutUs = 0);
+	void lock(){entry_->mutex.lock(); entry_->com->lock();};
+	void unlock(){entry_->com->unlock(); entry_->mutex.unlock();};
+
+	bool isOpen(){return isOpen_;};
+
+protected:
+	SharedSerialCom(SerialComEntry *entry) : entry_(entry){};
+	void checkOpen(const char* method);
+
+	SerialComEntry *entry_;
+	bool            isOpen_ = false;
+	unsigned long   replyTimeoutUs_ = 0;
+};
+
+#endif // SERIALCOMREGISTRY_HPP_INCLUDED
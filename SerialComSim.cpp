@@ -0,0 +1,177 @@
+//============================================================================
+// Name        : SerialComSim.cpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : SerialComSim source file. It contains the definition of the
+//               functions of the SerialComSim class.
+//============================================================================
+#include "SerialComSim.hpp"
+#include "RetryPolicy.hpp"
+#include <sstream>
+
+
+SerialComSim::SerialComSim(MaestroSimulator *sim, IClock *clock, unsigned short baudRate){
+	if((sim == nullptr) || (clock == nullptr)){
+		throw new ExceptionSerialCom(string("SerialComSim: simulator and clock must not be NULL."));
+	}
+	sim_ = sim;
+	clock_ = clock;
+	portName_ = "sim";
+	baudRate_ = baudRate;
+}
+
+void SerialComSim::initSerialCom(const char*, unsigned short baudRate){
+	if(isSerialComOpen_){
+		string msg("initSerialCom:: port is already open, close port first before initialization.");
+		throw new ExceptionSerialCom(msg);
+	}
+	baudRate_ = baudRate;
+}
+
+bool SerialComSim::openSerialCom(){
+	if(isSerialComOpen_){
+		string msg("openSerialCom:: port is already open, close port first before open it.");
+		throw new ExceptionSerialCom(msg);
+	}
+	rx_.clear();
+	inFlight_.clear();
+	isSerialComOpen_ = true;
+	return true;
+}
+
+bool SerialComSim::closeSerialCom(){
+	isSerialComOpen_ = false;
+	return true;
+}
+
+void SerialComSim::deliver(){
+	unsigned long long now = clock_->nowUs();
+	unsigned char byte;
+	while(!inFlight_.empty() && (inFlight_.front().arrivalUs <= now) && (rx_.getFree() > 0)){
+		byte = inFlight_.front().byte;
+		unsigned char *span[2];
+		unsigned size[2];
+		rx_.freeSpans(span, size);
+		span[0][0] = byte;
+		rx_.commit(1);
+		stats_.bytesRead++;
+		inFlight_.pop_front();
+	}
+}
+
+bool SerialComSim::writeSerialCom(unsigned char command[], unsigned short sizeCommand, unsigned char *response, unsigned short sizeResponse){
+	if(!isSerialComOpen_){
+		string msg("writeSerialCom:: port is not open yet, open port first before write/reading.");
+		throw new ExceptionSerialCom(msg);
+	}
+	if((sizeCommand < 1) || (sizeCommand > SERIALCOM_MAX_COMMAND) || (sizeResponse > 3)){
+		string msg("SerialComSim::writeSerialCom: wrong size of command or response.");
+		throw new ExceptionSerialCom(msg);
+	}
+
+	// same sequence as SerialComLINUX::writeSerialCom
+	if(sizeResponse > 0){
+		this->discardInput();
+	}
+	stats_.transfers++;
+	this->sendSerialCom(command, sizeCommand);
+	if(sizeResponse > 0){
+		if(!this->receiveSerialCom(sizeResponse, sizeCommand)){
+			stringstream ss;
+			ss << "SerialComSim::writeSerialCom: size of data (byte) received = " << rx_.available();
+			ss << " unequal to expected data size to be received = " << sizeResponse;
+			ss << " within " << this->replyDeadlineUs(sizeCommand, sizeResponse) << " us. ";
+			throw new ExceptionSerialCom(ss.str());
+		}
+		rx_.copyOut(response, sizeResponse);
+	}
+	return true;
+}
+
+bool SerialComSim::sendSerialCom(const unsigned char command[], unsigned short sizeCommand){
+	if(!isSerialComOpen_){
+		string msg("sendSerialCom:: port is not open yet, open port first before writing.");
+		throw new ExceptionSerialCom(msg);
+	}
+
+	// the controller acts when the last byte is on the wire
+	clock_->sleepUs(serialWireTimeUs(baudRate_, sizeCommand));
+	unsigned long long now = clock_->nowUs();
+	stats_.bytesWritten += sizeCommand;
+
+	unsigned char reply[512];
+	sim_->setTime(now);
+	unsigned produced = sim_->process(command, sizeCommand, reply, sizeof(reply));
+
+	// reply bytes follow each other at the baud rate
+	for(unsigned i = 0; i < produced; i++){
+		InFlight b;
+		b.arrivalUs = now + serialWireTimeUs(baudRate_, i + 1);
+		b.byte = reply[i];
+		inFlight_.push_back(b);
+	}
+	return true;
+}
+
+bool SerialComSim::receiveSerialCom(unsigned short minBytes, unsigned short sizeCommand){
+	if(!isSerialComOpen_){
+		string msg("receiveSerialCom:: port is not open yet, open port first before reading.");
+		throw new ExceptionSerialCom(msg);
+	}
+
+	unsigned long long deadline = clock_->nowUs() + this->replyDeadlineUs(sizeCommand, minBytes);
+	this->deliver();
+	while(rx_.available() < minBytes){
+		unsigned long long now = clock_->nowUs();
+		if(inFlight_.empty() || (inFlight_.front().arrivalUs > deadline) || (rx_.getFree() == 0)){
+			// nothing (more) arrives in time, the deadline passes
+			if(deadline > now){
+				clock_->sleepUs(deadline - now);
+			}
+			this->deliver();
+			stats_.timeouts++;
+			return false;
+		}
+		if(inFlight_.front().arrivalUs > now){
+			clock_->sleepUs(inFlight_.front().arrivalUs - now);
+		}
+		this->deliver();
+	}
+	return true;
+}
+
+unsigned long SerialComSim::discardInput(){
+	if(!isSerialComOpen_){
+		return 0;
+	}
+	this->deliver();
+	unsigned long discarded = rx_.available();
+	rx_.clear();
+	stats_.bytesDiscarded += discarded;
+	return discarded;
+}
+
+bool SerialComSim::resynchronize(){
+	if(!isSerialComOpen_){
+		string msg("resynchronize:: port is not open yet, open port first.");
+		throw new ExceptionSerialCom(msg);
+	}
+	stats_.resyncs++;
+
+	// quiet for the duration of the longest reply, see SerialComLINUX
+	unsigned long long quietUs = this->replyDeadlineUs(0, 3);
+	for(int round = 0; round < 8; round++){
+		this->discardInput();
+		unsigned long long now = clock_->nowUs();
+		if(inFlight_.empty() || (inFlight_.front().arrivalUs > now + quietUs)){
+			clock_->sleepUs(quietUs);
+			return true;
+		}
+		clock_->sleepUs(inFlight_.front().arrivalUs - now);
+	}
+	return false;
+}
+
+unsigned long SerialComSim::estimateTimeToWireUs(unsigned short sizeCommand){
+	return serialWireTimeUs(baudRate_, sizeCommand);
+}
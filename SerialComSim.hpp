@@ -0,0 +1,68 @@
+//============================================================================
+// Name        : SerialComSim.hpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : SerialComSim header file. It contains a connection to a
+//               MaestroSimulator in the same process, timed by an IClock,
+//               so complete motion programs can run on virtual time.
+//============================================================================
+#ifndef SERIALCOMSIM_HPP_INCLUDED
+#define SERIALCOMSIM_HPP_INCLUDED
+
+#include "SerialCom.hpp"
+#include "Clock.hpp"
+#include "MaestroSimulator.hpp"
+#include <deque>
+
+
+/**
+ *
+ * \class SerialComSim
+ *
+ * \brief Serial connection to an in-process MaestroSimulator. No file
+ * descriptor and no thread is involved: a command reaches the simulator
+ * after its wire time at the baud rate, the reply becomes readable after
+ * its own wire time, and a missing reply costs the reply deadline. All
+ * waits are sleeps of the given clock, so with a VirtualClock a timeout
+ * or an hour of servo motion passes without real time.
+ *
+ * The simulator is advanced to the time of the clock before each
+ * command; the owner must not drive it otherwise.
+ *
+ */
+class SerialComSim : public SerialComBase {
+public:
+	SerialComSim(MaestroSimulator *sim, IClock *clock, unsigned short baudRate = 9600);
+	~SerialComSim(){};
+
+	void initSerialCom(const char* portName, unsigned short baudRate);
+	bool openSerialCom();
+	bool closeSerialCom();
+	bool writeSerialCom(unsigned char command[], unsigned short sizeCommand, unsigned char *response, unsigned short sizeResponse);
+	unsigned long discardInput();
+	bool resynchronize();
+	bool sendSerialCom(const unsigned char command[], unsigned short sizeCommand);
+	bool receiveSerialCom(unsigned short minBytes, unsigned short sizeCommand = 0);
+	unsigned long getOutputQueued(){return 0;};
+	unsigned long estimateTimeToWireUs(unsigned short sizeCommand);
+	bool flushOutput(unsigned long = 0){return true;};
+
+	IClock* getClock(){return clock_;};
+
+protected:
+	struct InFlight {
+		unsigned long long arrivalUs;
+		unsigned char      byte;
+	};
+
+	/**
+	 * \brief Moves the reply bytes that arrived until now into the ring.
+	 */
+	void deliver();
+
+	MaestroSimulator    *sim_;
+	IClock              *clock_;
+	std::deque<InFlight> inFlight_;
+};
+
+#endif // SERIALCOMSIM_HPP_INCLUDED
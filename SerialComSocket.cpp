@@ -0,0 +1,163 @@
+//============================================================================
+// Name        : SerialComSocket.cpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : SerialComSocket source file. It contains the definition of
+//               the functions of the SerialComSocket class.
+//============================================================================
+#include "SerialComSocket.hpp"
+#include <string>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+
+SerialComSocket::SerialComSocket(const char* portName, unsigned short baudRate) : SerialComLINUX(portName, baudRate){
+}
+
+SerialComSocket::~SerialComSocket(){
+	try{
+		this->closeSerialCom();
+	}catch(...){
+	}
+}
+
+bool SerialComSocket::isSocketName(const char* portName){
+	return (portName != nullptr) &&
+			((strncmp(portName, "tcp:", 4) == 0) || (strncmp(portName, "unix:", 5) == 0));
+}
+
+bool SerialComSocket::openSerialCom(){
+	if(isSerialComOpen_){
+		string msg("openSerialCom:: port is already open, close port first before open it.");
+		throw new ExceptionSerialCom(msg);
+	}
+
+	string name(portName_);
+	if(name.compare(0, 4, "tcp:") == 0){
+		port_ = this->connectTcp(name.substr(4));
+	}else if(name.compare(0, 5, "unix:") == 0){
+		port_ = this->connectUnix(name.substr(5));
+	}else{
+		string msg("SerialComSocket::openSerialCom: '");
+		msg += name + string("' is neither a tcp: nor a unix: address.");
+		throw new ExceptionSerialCom(msg);
+	}
+
+	rx_.clear();
+	tx_.clear();
+	holdOutput_ = 0;
+	isSerialComOpen_ = true;
+	return true;
+}
+
+int SerialComSocket::connectTcp(const string &address){
+	size_t colon = address.rfind(':');
+	if((colon == string::npos) || (colon == 0) || (colon + 1 == address.size())){
+		string msg("SerialComSocket::openSerialCom: tcp address '");
+		msg += address + string("' has to be given as <host>:<port>.");
+		throw new ExceptionSerialCom(msg);
+	}
+	string host = address.substr(0, colon);
+	string service = address.substr(colon + 1);
+	// [::1]:4001
+	if((host.size() > 2) && (host[0] == '[') && (host[host.size() - 1] == ']')){
+		host = host.substr(1, host.size() - 2);
+	}
+
+	struct addrinfo hints;
+	struct addrinfo *result = nullptr;
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family   = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	if(getaddrinfo(host.c_str(), service.c_str(), &hints, &result) != 0){
+		string msg("SerialComSocket::openSerialCom: cannot resolve '");
+		msg += address + string("'.");
+		throw new ExceptionSerialCom(msg);
+	}
+
+	int fd = -1;
+	for(struct addrinfo *ai = result; (ai != nullptr) && (fd < 0); ai = ai->ai_next){
+		fd = socket(ai->ai_family, ai->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC, ai->ai_protocol);
+		if(fd < 0){
+			continue;
+		}
+		if(connect(fd, ai->ai_addr, ai->ai_addrlen) != 0){
+			// the connection is established in the background
+			bool connected = false;
+			if(errno == EINPROGRESS){
+				struct pollfd pfd;
+				pfd.fd = fd;
+				pfd.events = POLLOUT;
+				pfd.revents = 0;
+				int error = 0;
+				socklen_t len = sizeof(error);
+				connected = (poll(&pfd, 1, SERIALCOM_SOCKET_CONNECT_TIMEOUT_MS) == 1) &&
+						(getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &len) == 0) && (error == 0);
+			}
+			if(!connected){
+				close(fd);
+				fd = -1;
+			}
+		}
+	}
+	freeaddrinfo(result);
+
+	if(fd < 0){
+		string msg("SerialComSocket::openSerialCom: cannot connect to '");
+		msg += address + string("'.");
+		throw new ExceptionSerialCom(msg);
+	}
+
+	// single commands must not wait for more data, see lock()
+	int one = 1;
+	setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+	return fd;
+}
+
+int SerialComSocket::connectUnix(const string &path){
+	struct sockaddr_un addr;
+	if(path.empty() || (path.size() >= sizeof(addr.sun_path))){
+		string msg("SerialComSocket::openSerialCom: invalid unix socket path '");
+		msg += path + string("'.");
+		throw new ExceptionSerialCom(msg);
+	}
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+	int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if((fd < 0) || (connect(fd, (struct sockaddr *) &addr, sizeof(addr)) != 0)){
+		if(fd >= 0){
+			close(fd);
+		}
+		string msg("SerialComSocket::openSerialCom: cannot connect to '");
+		msg += path + string("'.");
+		throw new ExceptionSerialCom(msg);
+	}
+	// local connections are established at once, then switch to non blocking
+	fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+	return fd;
+}
+
+void SerialComSocket::lock(){
+	holdOutput_++;
+}
+
+void SerialComSocket::unlock(){
+	if(holdOutput_ == 0){
+		return;
+	}
+	holdOutput_--;
+	if((holdOutput_ == 0) && isSerialComOpen_){
+		// the held commands leave with one write
+		this->writeQueued();
+	}
+}
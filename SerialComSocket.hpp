@@ -0,0 +1,71 @@
+//============================================================================
+// Name        : SerialComSocket.hpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : SerialComSocket header file. It contains a connection that
+//               exchanges the raw bytes of the serial protocol with a
+//               serial server (e.g. ser2net) via a TCP or Unix-domain
+//               stream socket.
+//============================================================================
+#ifndef SERIALCOMSOCKET_HPP_INCLUDED
+#define SERIALCOMSOCKET_HPP_INCLUDED
+
+#include "SerialCom.hpp"
+
+#ifndef _WIN32
+
+
+/**
+ *
+ * \brief Time (in milli seconds) to wait for a TCP connection to be
+ * established in openSerialCom().
+ *
+ */
+#define SERIALCOM_SOCKET_CONNECT_TIMEOUT_MS 3000
+
+
+/**
+ *
+ * \class SerialComSocket
+ *
+ * \brief Serial connection to a device behind a serial server. The port
+ * name selects the stream:
+ *
+ *    tcp:<host>:<port>    e.g. tcp:192.168.0.17:4001
+ *    unix:<path>          e.g. unix:/run/maestro.sock
+ *
+ * Everything above the file descriptor (output queue, receive ring,
+ * reply deadlines, resynchronization) is the one of SerialComLINUX, so
+ * framing and pipelining of Pololu work unchanged. The baud rate is the
+ * one configured at the serial server and only used for the deadlines.
+ *
+ * Nagle's algorithm is disabled (TCP_NODELAY). Instead, bytes sent while
+ * the connection is locked (see ISerialCom::lock()) are held back and go
+ * out with one write when a reply is awaited or the lock is released.
+ *
+ */
+class SerialComSocket : public SerialComLINUX {
+public:
+	SerialComSocket(const char* portName="tcp:localhost:4001", unsigned short baudRate=9600);
+	~SerialComSocket();
+
+	bool openSerialCom();
+	void lock();
+	void unlock();
+
+	/**
+	 *
+	 * \brief Returns true if the port name refers to a socket
+	 * (prefix "tcp:" or "unix:").
+	 *
+	 */
+	static bool isSocketName(const char* portName);
+
+protected:
+	int connectTcp(const string &address);
+	int connectUnix(const string &path);
+};
+
+#endif // _WIN32
+
+#endif // SERIALCOMSOCKET_HPP_INCLUDED
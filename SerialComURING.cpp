@@ -0,0 +1,360 @@
+//============================================================================
+// Name        : SerialComURING.cpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : SerialComURING source file. It contains the definition of
+//               the functions of the URingLoop and SerialComURING classes.
+//============================================================================
+#include "SerialComURING.hpp"
+
+#ifndef _WIN32
+
+#include <string>
+#include <sstream>
+#include <chrono>
+#include <cstring>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+
+static long long steadyNowUs(){
+	return std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+URingLoop::URingLoop(unsigned entries){
+	struct io_uring_params p;
+	memset(&p, 0, sizeof(p));
+
+	ringFd_ = (int) syscall(__NR_io_uring_setup, entries, &p);
+	if(ringFd_ < 0){
+		string msg("URingLoop: io_uring is not available (io_uring_setup failed).");
+		throw new ExceptionSerialCom(msg);
+	}
+
+	sqRingSize_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+	cqRingSize_ = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+	bool singleMmap = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+	if(singleMmap){
+		if(cqRingSize_ > sqRingSize_){
+			sqRingSize_ = cqRingSize_;
+		}
+		cqRingSize_ = sqRingSize_;
+	}
+
+	sqRing_ = mmap(0, sqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd_, IORING_OFF_SQ_RING);
+	if(sqRing_ == MAP_FAILED){
+		close(ringFd_);
+		throw new ExceptionSerialCom(string("URingLoop: cannot map submission ring."));
+	}
+	if(singleMmap){
+		cqRing_ = sqRing_;
+	}else{
+		cqRing_ = mmap(0, cqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd_, IORING_OFF_CQ_RING);
+		if(cqRing_ == MAP_FAILED){
+			munmap(sqRing_, sqRingSize_);
+			close(ringFd_);
+			throw new ExceptionSerialCom(string("URingLoop: cannot map completion ring."));
+		}
+	}
+
+	sqesSize_ = p.sq_entries * sizeof(struct io_uring_sqe);
+	sqes_ = (struct io_uring_sqe*) mmap(0, sqesSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd_, IORING_OFF_SQES);
+	if(sqes_ == MAP_FAILED){
+		if(!singleMmap){
+			munmap(cqRing_, cqRingSize_);
+		}
+		munmap(sqRing_, sqRingSize_);
+		close(ringFd_);
+		throw new ExceptionSerialCom(string("URingLoop: cannot map submission entries."));
+	}
+
+	char *sq = (char*) sqRing_;
+	sqHead_    = (unsigned*) (sq + p.sq_off.head);
+	sqTail_    = (unsigned*) (sq + p.sq_off.tail);
+	sqMask_    = (unsigned*) (sq + p.sq_off.ring_mask);
+	sqArray_   = (unsigned*) (sq + p.sq_off.array);
+	sqEntries_ = p.sq_entries;
+
+	char *cq = (char*) cqRing_;
+	cqHead_ = (unsigned*) (cq + p.cq_off.head);
+	cqTail_ = (unsigned*) (cq + p.cq_off.tail);
+	cqMask_ = (unsigned*) (cq + p.cq_off.ring_mask);
+	cqes_   = (struct io_uring_cqe*) (cq + p.cq_off.cqes);
+}
+
+URingLoop::~URingLoop(){
+	munmap(sqes_, sqesSize_);
+	if(cqRing_ != sqRing_){
+		munmap(cqRing_, cqRingSize_);
+	}
+	munmap(sqRing_, sqRingSize_);
+	close(ringFd_);
+}
+
+unsigned URingLoop::getFreeSqes(){
+	unsigned head = __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE);
+	return sqEntries_ - (*sqTail_ - head);
+}
+
+struct io_uring_sqe* URingLoop::getSqe(){
+	unsigned head = __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE);
+	unsigned tail = *sqTail_;
+	if((tail - head) >= sqEntries_){
+		return nullptr;
+	}
+	unsigned idx = tail & *sqMask_;
+	struct io_uring_sqe *sqe = &sqes_[idx];
+	memset(sqe, 0, sizeof(*sqe));
+	sqArray_[idx] = idx;
+	__atomic_store_n(sqTail_, tail + 1, __ATOMIC_RELEASE);
+	toSubmit_++;
+	return sqe;
+}
+
+unsigned URingLoop::submit(unsigned minComplete){
+	if((toSubmit_ == 0) && (minComplete == 0)){
+		return 0;
+	}
+	unsigned flags = (minComplete > 0) ? IORING_ENTER_GETEVENTS : 0;
+	long ret;
+	do{
+		syscalls_++;
+		ret = syscall(__NR_io_uring_enter, ringFd_, toSubmit_, minComplete, flags, NULL, 0);
+	}while((ret < 0) && (errno == EINTR));
+	if(ret < 0){
+		stringstream ss;
+		ss << "URingLoop::submit: io_uring_enter failed (errno " << errno << ").";
+		throw new ExceptionSerialCom(ss.str());
+	}
+	toSubmit_ -= (unsigned) ret;
+	return (unsigned) ret;
+}
+
+unsigned URingLoop::harvest(){
+	unsigned count = 0;
+	unsigned head = *cqHead_;
+	unsigned tail = __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE);
+	while(head != tail){
+		struct io_uring_cqe *cqe = &cqes_[head & *cqMask_];
+		SerialComURING *com = (SerialComURING*) (uintptr_t) (cqe->user_data & ~((__u64) 3));
+		unsigned tag = (unsigned) (cqe->user_data & 3);
+		int res = cqe->res;
+		head++;
+		count++;
+		// release the entry before dispatching, completing may queue new entries
+		__atomic_store_n(cqHead_, head, __ATOMIC_RELEASE);
+		if(com != nullptr){
+			com->complete(tag, res);
+		}
+		tail = __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE);
+	}
+	return count;
+}
+
+
+
+SerialComURING::SerialComURING(const char* portName, unsigned short baudRate, URingLoop *loop)
+	: SerialComLINUX(portName, baudRate){
+	ownsLoop_ = (loop == nullptr);
+	loop_ = ownsLoop_ ? new URingLoop(8) : loop;
+}
+
+SerialComURING::~SerialComURING(){
+	this->closeSerialCom();
+	if(ownsLoop_){
+		delete loop_;
+	}
+	loop_ = nullptr;
+}
+
+bool SerialComURING::openSerialCom(){
+	SerialComLINUX::openSerialCom();
+
+	// A read shall wait for at least one byte. Together with O_NONBLOCK
+	// the kernel arms a poll instead of blocking a worker thread.
+	struct termios options;
+	if(tcgetattr(port_, &options) == 0){
+		options.c_cc[VMIN]  = 1;
+		options.c_cc[VTIME] = 0;
+		tcsetattr(port_, TCSANOW, &options);
+	}
+	int flags = fcntl(port_, F_GETFL);
+	if((flags == -1) || (fcntl(port_, F_SETFL, flags | O_NONBLOCK) == -1)){
+		SerialComLINUX::closeSerialCom();
+		string msg("SerialComURING::openSerialCom: cannot switch '");
+		msg += string(portName_) + string("' to non-blocking mode. Port closed again.");
+		throw new ExceptionSerialCom(msg);
+	}
+	return true;
+}
+
+bool SerialComURING::closeSerialCom(){
+	// an outstanding request refers to the port, let it run out first
+	while(isSerialComOpen_ && (pending_ > 0)){
+		loop_->submit(1);
+		loop_->harvest();
+	}
+	return SerialComLINUX::closeSerialCom();
+}
+
+void SerialComURING::submitQuery(const unsigned char command[], unsigned short sizeCommand, unsigned char *response, unsigned short sizeResponse){
+	if(!isSerialComOpen_){
+		string msg("submitQuery:: port is not open yet, open port first before write/reading.");
+		throw new ExceptionSerialCom(msg);
+	}
+	if(pending_ > 0){
+		string msg("submitQuery:: a request is still outstanding on port '");
+		msg += string(portName_) + string("'.");
+		throw new ExceptionSerialCom(msg);
+	}
+	if((sizeCommand == 0) || (sizeCommand > sizeof(cmd_)) || (sizeResponse > 3)){
+		string msg("SerialComURING::submitQuery: wrong parameter sizeCommand or sizeRes.");
+		throw new ExceptionSerialCom(msg);
+	}
+
+	// bytes queued by sendSerialCom(...) go first
+	if((tx_.available() > 0) && !this->flushOutput(this->estimateTimeToWireUs(0) + replyLatencyUs_)){
+		string msg("submitQuery:: output queue of port '");
+		msg += string(portName_) + string("' does not drain.");
+		throw new ExceptionSerialCom(msg);
+	}
+
+	memcpy(cmd_, command, sizeCommand);
+	sizeCmd_  = sizeCommand;
+	res_      = response;
+	sizeRes_  = sizeResponse;
+	received_ = 0;
+	error_    = 0;
+	timedOut_ = false;
+
+	// a chain must not be split over two submissions
+	if(loop_->getFreeSqes() < 3){
+		loop_->submit();
+	}
+	struct io_uring_sqe *sqe = loop_->getSqe();
+	sqe->opcode    = IORING_OP_WRITE;
+	sqe->fd        = port_;
+	sqe->addr      = (__u64) (uintptr_t) cmd_;
+	sqe->len       = sizeCmd_;
+	sqe->off       = (__u64) -1;
+	sqe->user_data = ((__u64) (uintptr_t) this) | TAG_WRITE;
+	pending_ = 1;
+	stats_.transfers++;
+
+	if(sizeRes_ > 0){
+		sqe->flags |= IOSQE_IO_LINK;
+		deadlineUs_ = steadyNowUs() + (long long) this->replyDeadlineUs(sizeCmd_, sizeRes_);
+		this->prepareRead();
+	}
+}
+
+void SerialComURING::prepareRead(){
+	long long remainingUs = deadlineUs_ - steadyNowUs();
+	if(remainingUs < 0){
+		remainingUs = 0;
+	}
+
+	// never split a read from its timeout
+	if(loop_->getFreeSqes() < 2){
+		loop_->submit();
+	}
+	struct io_uring_sqe *sqe = loop_->getSqe();
+	sqe->opcode    = IORING_OP_READ;
+	sqe->fd        = port_;
+	sqe->addr      = (__u64) (uintptr_t) (res_ + received_);
+	sqe->len       = sizeRes_ - received_;
+	sqe->off       = (__u64) -1;
+	sqe->flags     = IOSQE_IO_LINK;
+	sqe->user_data = ((__u64) (uintptr_t) this) | TAG_READ;
+
+	ts_.tv_sec  = remainingUs / 1000000;
+	ts_.tv_nsec = (remainingUs % 1000000) * 1000;
+	struct io_uring_sqe *tsqe = loop_->getSqe();
+	tsqe->opcode    = IORING_OP_LINK_TIMEOUT;
+	tsqe->fd        = -1;
+	tsqe->addr      = (__u64) (uintptr_t) &ts_;
+	tsqe->len       = 1;
+	tsqe->user_data = ((__u64) (uintptr_t) this) | TAG_TIMEOUT;
+	pending_ += 2;
+}
+
+void SerialComURING::complete(unsigned tag, int res){
+	pending_--;
+	switch(tag){
+	case TAG_WRITE:
+		if(res == (int) sizeCmd_){
+			stats_.bytesWritten += res;
+		}else if(error_ == 0){
+			error_ = (res < 0) ? -res : EIO;
+		}
+		break;
+	case TAG_READ:
+		if(res > 0){
+			received_ += res;
+			stats_.bytesRead += res;
+			if((received_ < sizeRes_) && (error_ == 0)){
+				// partial reply, wait for the rest within the same deadline
+				this->prepareRead();
+			}
+		}else if(res == -ECANCELED){
+			timedOut_ = true;
+		}else if(error_ == 0){
+			error_ = (res < 0) ? -res : EIO;
+		}
+		break;
+	case TAG_TIMEOUT:
+		if(res == -ETIME){
+			timedOut_ = true;
+		}
+		break;
+	}
+}
+
+void SerialComURING::finishQuery(){
+	if(pending_ > 0){
+		string msg("finishQuery:: request on port '");
+		msg += string(portName_) + string("' is still outstanding.");
+		throw new ExceptionSerialCom(msg);
+	}
+	if(error_ != 0){
+		stringstream ss;
+		ss << "SerialComURING::finishQuery: transfer on port '" << portName_;
+		ss << "' failed (errno " << error_ << ").";
+		throw new ExceptionSerialCom(ss.str());
+	}
+	if(received_ != sizeRes_){
+		stats_.timeouts++;
+		stringstream ss;
+		ss << "SerialComURING::finishQuery: Failed while reading from port '";
+		ss << portName_ << "'.";
+		ss << "size of data (byte) received = " << received_ << " unequal to expected";
+		ss << " data size to be received = " << sizeRes_ << ". ";
+		throw new ExceptionSerialCom(ss.str());
+	}
+}
+
+bool SerialComURING::writeSerialCom(unsigned char command[], unsigned short sizeCommand, unsigned char *response, unsigned short sizeResponse){
+	if(!isSerialComOpen_){
+		string msg("writeSerialCom:: port is not open yet, open port first before write/reading.");
+		throw new ExceptionSerialCom(msg);
+	}
+	if (sizeResponse > 0){
+		this->discardInput();
+	}
+
+	this->submitQuery(command, sizeCommand, response, sizeResponse);
+	while(pending_ > 0){
+		loop_->submit(1);
+		loop_->harvest();
+	}
+	this->finishQuery();
+	return true;
+}
+
+#endif // _WIN32
@@ -0,0 +1,193 @@
+//============================================================================
+// Name        : SerialComURING.hpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : SerialComURING header file. It contains a serial connection
+//               that submits requests as linked write -> read -> timeout
+//               chains via io_uring, and the ring shared by many
+//               connections.
+//============================================================================
+#ifndef SERIALCOMURING_HPP_INCLUDED
+#define SERIALCOMURING_HPP_INCLUDED
+
+#include "SerialCom.hpp"
+
+#ifndef _WIN32
+
+#include <linux/io_uring.h>
+#include <linux/time_types.h>
+
+
+class SerialComURING;
+
+
+/**
+ *
+ * \class URingLoop
+ *
+ * \brief Submission and completion queue of io_uring shared by
+ * several serial connections. The requests of all connections are
+ * collected and submitted with a single system call (submit(...)),
+ * completions are harvested without blocking (harvest()).
+ *
+ * The ring is set up with the raw system calls, no additional
+ * library is required.
+ *
+ */
+class URingLoop {
+public:
+
+	/**
+	 *
+	 * \brief Creates a ring with the given number of submission entries.
+	 * If io_uring is not available an exception (IException) is thrown.
+	 *
+	 */
+	URingLoop(unsigned entries = 256);
+	~URingLoop();
+
+	/**
+	 *
+	 * \brief Delivers a cleared submission entry, or NULL if the
+	 * submission queue is full (call submit() first).
+	 *
+	 */
+	struct io_uring_sqe* getSqe();
+
+	/**
+	 *
+	 * \brief Submits all prepared entries with one system call.
+	 *
+	 * \param minComplete unsigned. Number of completions to wait for,
+	 *                    0 returns immediately.
+	 *
+	 * \return unsigned. Number of entries consumed by the kernel.
+	 */
+	unsigned submit(unsigned minComplete = 0);
+
+	/**
+	 *
+	 * \brief Dispatches all available completions to their connections
+	 * without blocking.
+	 *
+	 * \return unsigned. Number of completions processed.
+	 */
+	unsigned harvest();
+
+	unsigned getPendingSubmissions(){return toSubmit_;};
+
+	/**
+	 *
+	 * \brief Number of submission entries that can be prepared
+	 * before submit() has to be called.
+	 *
+	 */
+	unsigned getFreeSqes();
+
+	unsigned long getSyscallCount(){return syscalls_;};
+
+protected:
+	int       ringFd_ = -1;
+	void     *sqRing_ = nullptr;
+	void     *cqRing_ = nullptr;
+	struct io_uring_sqe *sqes_ = nullptr;
+	size_t    sqRingSize_ = 0;
+	size_t    cqRingSize_ = 0;
+	size_t    sqesSize_   = 0;
+
+	unsigned *sqHead_;
+	unsigned *sqTail_;
+	unsigned *sqMask_;
+	unsigned *sqArray_;
+	unsigned  sqEntries_;
+	unsigned *cqHead_;
+	unsigned *cqTail_;
+	unsigned *cqMask_;
+	struct io_uring_cqe *cqes_;
+
+	unsigned  toSubmit_ = 0;
+	unsigned long syscalls_ = 0;
+};
+
+
+/**
+ *
+ * \class SerialComURING
+ *
+ * \brief Serial connection that uses io_uring for the transfers.
+ *
+ * A request is submitted as linked chain write -> read -> link timeout,
+ * so the controller is addressed and the reply is awaited with a single
+ * system call. Several connections can share one URingLoop: the requests
+ * are queued with submitQuery(...), submitted together with
+ * URingLoop::submit() and collected with URingLoop::harvest().
+ * writeSerialCom(...) provides the usual synchronous behaviour.
+ *
+ */
+class SerialComURING : public SerialComLINUX {
+	friend class URingLoop;
+public:
+
+	/**
+	 *
+	 * \param loop URingLoop*. Ring to be used; if NULL the connection
+	 *             creates and owns a ring.
+	 *
+	 */
+	SerialComURING(const char* portName="/dev/ttyACM0", unsigned short baudRate=9600, URingLoop *loop = nullptr);
+	~SerialComURING();
+
+	bool openSerialCom();
+	bool closeSerialCom();
+	bool writeSerialCom(unsigned char command[], unsigned short sizeCommand, unsigned char *response, unsigned short sizeResponse);
+
+	/**
+	 *
+	 * \brief Queues a request in the ring without any system call.
+	 * The command is copied, the response buffer has to stay valid until
+	 * the request is done. Only one request per connection can be
+	 * outstanding, otherwise an exception (IException) is thrown.
+	 *
+	 */
+	void submitQuery(const unsigned char command[], unsigned short sizeCommand, unsigned char *response, unsigned short sizeResponse);
+
+	/**
+	 *
+	 * \brief Returns true if the outstanding request has completed.
+	 *
+	 */
+	bool isQueryDone(){return (pending_ == 0);};
+
+	/**
+	 *
+	 * \brief Completes the outstanding request. If the request failed,
+	 * an exception (IException) is thrown like in writeSerialCom(...).
+	 *
+	 */
+	void finishQuery();
+
+	URingLoop* getLoop(){return loop_;};
+
+protected:
+	enum { TAG_WRITE = 1, TAG_READ = 2, TAG_TIMEOUT = 3 };
+
+	void prepareRead();
+	void complete(unsigned tag, int res);
+
+	URingLoop     *loop_;
+	bool           ownsLoop_;
+	unsigned char  cmd_[16];
+	unsigned short sizeCmd_  = 0;
+	unsigned char *res_      = nullptr;
+	unsigned short sizeRes_  = 0;
+	unsigned short received_ = 0;
+	unsigned       pending_  = 0;
+	int            error_    = 0;
+	bool           timedOut_ = false;
+	long long      deadlineUs_ = 0; // steady clock, micro seconds
+	struct __kernel_timespec ts_;
+};
+
+#endif // _WIN32
+
+#endif // SERIALCOMURING_HPP_INCLUDED
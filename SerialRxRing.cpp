@@ -0,0 +1,115 @@
+//============================================================================
+// Name        : SerialRxRing.cpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : SerialRxRing source file. It contains the definition of the
+//               functions of the SerialRxRing class.
+//============================================================================
+#include "SerialRxRing.hpp"
+#include <string.h>
+
+#ifndef _WIN32
+	#include <errno.h>
+	#include <sys/uio.h>
+#endif
+
+
+SerialRxRing::SerialRxRing(unsigned capacity){
+	unsigned size = 16;
+	while(size < capacity){
+		size <<= 1;
+	}
+	buffer_ = new unsigned char[size];
+	mask_   = size - 1;
+}
+
+SerialRxRing::~SerialRxRing(){
+	delete [] buffer_;
+}
+
+void SerialRxRing::consume(unsigned n){
+	if(n > this->available()){
+		n = this->available();
+	}
+	head_ += n;
+}
+
+unsigned SerialRxRing::readSpans(const unsigned char *span[2], unsigned size[2]) const {
+	unsigned n = this->available();
+	if(n == 0){
+		return 0;
+	}
+	unsigned start = head_ & mask_;
+	unsigned first = this->getCapacity() - start;
+	span[0] = buffer_ + start;
+	if(n <= first){
+		size[0] = n;
+		return 1;
+	}
+	size[0] = first;
+	span[1] = buffer_;
+	size[1] = n - first;
+	return 2;
+}
+
+unsigned SerialRxRing::freeSpans(unsigned char *span[2], unsigned size[2]){
+	unsigned n = this->getFree();
+	if(n == 0){
+		return 0;
+	}
+	unsigned start = tail_ & mask_;
+	unsigned first = this->getCapacity() - start;
+	span[0] = buffer_ + start;
+	if(n <= first){
+		size[0] = n;
+		return 1;
+	}
+	size[0] = first;
+	span[1] = buffer_;
+	size[1] = n - first;
+	return 2;
+}
+
+void SerialRxRing::commit(unsigned n){
+	if(n > this->getFree()){
+		n = this->getFree();
+	}
+	tail_ += n;
+}
+
+unsigned SerialRxRing::copyOut(unsigned char *dst, unsigned n){
+	const unsigned char *span[2];
+	unsigned size[2];
+	unsigned spans = this->readSpans(span, size);
+	unsigned copied = 0;
+	for(unsigned i = 0; (i < spans) && (copied < n); i++){
+		unsigned chunk = (size[i] < (n - copied)) ? size[i] : (n - copied);
+		memcpy(dst + copied, span[i], chunk);
+		copied += chunk;
+	}
+	head_ += copied;
+	return copied;
+}
+
+#ifndef _WIN32
+long SerialRxRing::fill(int fd){
+	unsigned char *span[2];
+	unsigned size[2];
+	unsigned spans = this->freeSpans(span, size);
+	if(spans == 0){
+		return 0;
+	}
+	struct iovec iov[2];
+	for(unsigned i = 0; i < spans; i++){
+		iov[i].iov_base = span[i];
+		iov[i].iov_len  = size[i];
+	}
+	fills_++;
+	ssize_t n = readv(fd, iov, spans);
+	if(n < 0){
+		return ((errno == EAGAIN) || (errno == EINTR)) ? 0 : -1;
+	}
+	tail_ += n;
+	return n;
+}
+#endif
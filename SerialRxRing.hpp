@@ -0,0 +1,115 @@
+//============================================================================
+// Name        : SerialRxRing.hpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : SerialRxRing header file. It contains the receive ring
+//               buffer of a serial connection.
+//============================================================================
+#ifndef SERIALRXRING_HPP_INCLUDED
+#define SERIALRXRING_HPP_INCLUDED
+
+
+/**
+ *
+ * \class SerialRxRing
+ *
+ * \brief Persistent receive buffer of a serial port.
+ *
+ * The buffer is filled by reads that take as many bytes as are free
+ * (fill(...)), so several replies can be received with one system call.
+ * The bytes are read in place via peek(...) / peekWord(...) or the
+ * readable spans and released with consume(...).
+ *
+ * The capacity is rounded up to a power of two, head and tail are free
+ * running counters.
+ *
+ */
+class SerialRxRing {
+public:
+
+	static const unsigned DEFAULT_CAPACITY = 256;
+
+	SerialRxRing(unsigned capacity = DEFAULT_CAPACITY);
+	~SerialRxRing();
+
+	unsigned getCapacity() const {return mask_ + 1;};
+
+	/**
+	 * \brief Number of bytes received but not consumed yet.
+	 */
+	unsigned available() const {return tail_ - head_;};
+
+	unsigned getFree() const {return this->getCapacity() - this->available();};
+
+	/**
+	 * \brief Byte at the given offset from the oldest byte, no range check.
+	 */
+	unsigned char peek(unsigned offset) const {return buffer_[(head_ + offset) & mask_];};
+
+	/**
+	 * \brief Little endian 16 bit value (low byte first) at the given offset.
+	 */
+	unsigned short peekWord(unsigned offset) const {
+		return this->peek(offset) + 256 * this->peek(offset + 1);
+	};
+
+	/**
+	 * \brief Releases the given number of bytes (at most available()).
+	 */
+	void consume(unsigned n);
+
+	void clear(){head_ = tail_;};
+
+	/**
+	 *
+	 * \brief Delivers the readable bytes as at most two contiguous spans
+	 * (the second one is used if the data wraps around).
+	 *
+	 * \return unsigned. Number of spans (0, 1 or 2).
+	 */
+	unsigned readSpans(const unsigned char *span[2], unsigned size[2]) const;
+
+	/**
+	 *
+	 * \brief Delivers the free space as at most two contiguous spans.
+	 * Bytes written there become readable with commit(...).
+	 *
+	 * \return unsigned. Number of spans (0, 1 or 2).
+	 */
+	unsigned freeSpans(unsigned char *span[2], unsigned size[2]);
+
+	void commit(unsigned n);
+
+	/**
+	 * \brief Copies n bytes (at most available()) to dst and consumes them.
+	 * \return unsigned. Number of bytes copied.
+	 */
+	unsigned copyOut(unsigned char *dst, unsigned n);
+
+#ifndef _WIN32
+	/**
+	 *
+	 * \brief Reads all bytes that fit into the free space from the file
+	 * descriptor with a single readv(...). It does not wait for data if the
+	 * descriptor is non blocking or VMIN/VTIME are 0.
+	 *
+	 * \return long. Number of bytes received, 0 if the ring is full or no
+	 * data was available, -1 on a read error.
+	 */
+	long fill(int fd);
+#endif
+
+	unsigned long getFillCount() const {return fills_;};
+
+private:
+	SerialRxRing(const SerialRxRing&);
+	SerialRxRing& operator=(const SerialRxRing&);
+
+	unsigned char *buffer_;
+	unsigned       mask_;
+	unsigned       head_  = 0;
+	unsigned       tail_  = 0;
+	unsigned long  fills_ = 0;
+};
+
+#endif // SERIALRXRING_HPP_INCLUDED
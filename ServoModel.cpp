@@ -0,0 +1,375 @@
+//============================================================================
+// Name        : ServoModel.cpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : ServoModel source file. It contains the definition of the
+//               functions of the ServoModel, ServoEstimator, ServoModelFile,
+//               ServoTraceReader and ServoModelFitter classes.
+//============================================================================
+#include "ServoModel.hpp"
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
+// update period of the Maestro
+#define SERVOMODEL_STEP_US 10000ULL
+
+
+void ServoModel::step(float &position, float &velocity, unsigned short target,
+					  unsigned short speed, unsigned short acceleration) const {
+	if(target == 0){
+		return;
+	}
+	float dist = ((float) target) - position;
+	float adist = fabs(dist);
+	if(adist < 0.5){
+		position = target;
+		velocity = 0.0;
+		return;
+	}
+
+	float vmax;
+	if(speed == 0){
+		// speed 0 means unlimited, without a fitted limit the servo jumps
+		if(params_.unlimitedSpeed <= 0.0){
+			position = target;
+			velocity = 0.0;
+			return;
+		}
+		vmax = params_.unlimitedSpeed;
+	}else{
+		vmax = speed * ((dist > 0) ? params_.speedScaleUp : params_.speedScaleDown);
+	}
+
+	float v = velocity;
+	if(acceleration == 0){
+		v = vmax;
+	}else{
+		// acceleration is given per 80 ms, i.e. per 8 steps of 10 ms
+		float a = ((float) acceleration) * params_.accelScale / 8.0;
+		v += a;
+		if(v > vmax){
+			v = vmax;
+		}
+		// decelerate in time to stop at the target
+		float vbrake = sqrt(2.0 * a * adist);
+		if(v > vbrake){
+			v = (vbrake < a) ? a : vbrake;
+		}
+	}
+
+	if(v >= adist){
+		position = target;
+		velocity = 0.0;
+	}else{
+		position += (dist > 0) ? v : -v;
+		velocity = v;
+	}
+}
+
+
+
+ServoEstimator::ServoEstimator(const ServoModelParams &params, unsigned short position, unsigned long long timeUs) : model_(params){
+	timeUs_   = timeUs - (timeUs % SERVOMODEL_STEP_US);
+	position_ = position;
+	target_   = position;
+}
+
+void ServoEstimator::advance(unsigned long long timeUs){
+	while(timeUs_ + SERVOMODEL_STEP_US <= timeUs){
+		timeUs_ += SERVOMODEL_STEP_US;
+		if(pending_ && (timeUs_ >= pendingAtUs_)){
+			target_ = pendingTarget_;
+			pending_ = false;
+		}
+		model_.step(position_, velocity_, target_, speed_, acceleration_);
+	}
+}
+
+void ServoEstimator::setTarget(unsigned long long timeUs, unsigned short target){
+	this->advance(timeUs);
+	if(model_.getParams().deadTimeUs == 0){
+		target_ = target;
+		if(target == 0){
+			velocity_ = 0.0;
+		}
+		return;
+	}
+	pending_ = true;
+	pendingTarget_ = target;
+	pendingAtUs_ = timeUs + model_.getParams().deadTimeUs;
+}
+
+void ServoEstimator::setSpeed(unsigned long long timeUs, unsigned short speed){
+	this->advance(timeUs);
+	speed_ = speed;
+}
+
+void ServoEstimator::setAcceleration(unsigned long long timeUs, unsigned short acceleration){
+	this->advance(timeUs);
+	acceleration_ = acceleration;
+}
+
+float ServoEstimator::estimate(unsigned long long timeUs){
+	this->advance(timeUs);
+	return position_;
+}
+
+bool ServoEstimator::isMoving(){
+	return pending_ || ((target_ != 0) && (fabs(((float) target_) - position_) >= 0.5));
+}
+
+
+
+vector<ServoModelParams> ServoModelFile::load(const string &filename){
+	ifstream in(filename.c_str());
+	if(!in){
+		throw new ExceptionServoModel(string("ServoModelFile::load: cannot open '") + filename + string("'."));
+	}
+	vector<ServoModelParams> result;
+	string line;
+	unsigned lineNumber = 0;
+	while(getline(in, line)){
+		lineNumber++;
+		if(line.empty() || (line[0] == '#')){
+			continue;
+		}
+		istringstream ls(line);
+		ServoModelParams p;
+		if(!(ls >> p.servo >> p.deadTimeUs >> p.speedScaleUp >> p.speedScaleDown
+				>> p.accelScale >> p.unlimitedSpeed >> p.rmsError >> p.samples)){
+			stringstream ss;
+			ss << "ServoModelFile::load: malformed line " << lineNumber << " in '" << filename << "'.";
+			throw new ExceptionServoModel(ss.str());
+		}
+		result.push_back(p);
+	}
+	return result;
+}
+
+void ServoModelFile::save(const string &filename, const vector<ServoModelParams> &params){
+	ofstream out(filename.c_str());
+	if(!out){
+		throw new ExceptionServoModel(string("ServoModelFile::save: cannot write '") + filename + string("'."));
+	}
+	out << "# servo deadTimeUs speedScaleUp speedScaleDown accelScale unlimitedSpeed rmsError samples" << endl;
+	for(unsigned i = 0; i < params.size(); i++){
+		const ServoModelParams &p = params[i];
+		out << p.servo << " " << p.deadTimeUs << " " << p.speedScaleUp << " " << p.speedScaleDown << " "
+			<< p.accelScale << " " << p.unlimitedSpeed << " " << p.rmsError << " " << p.samples << endl;
+	}
+}
+
+
+
+map<unsigned, ServoTrace> ServoTraceReader::read(istream &in){
+	map<unsigned, ServoTrace> traces;
+	string line;
+	unsigned lineNumber = 0;
+	while(getline(in, line)){
+		lineNumber++;
+		if(line.empty() || (line[0] == '#')){
+			continue;
+		}
+		std::replace(line.begin(), line.end(), ',', ' ');
+		istringstream ls(line);
+		unsigned long long timeUs;
+		unsigned servo;
+		char kind;
+		unsigned value;
+		if(!(ls >> timeUs >> servo >> kind >> value) || (value > 0xFFFF)){
+			stringstream ss;
+			ss << "ServoTraceReader::read: malformed line " << lineNumber << ".";
+			throw new ExceptionServoModel(ss.str());
+		}
+		ServoTrace &t = traces[servo];
+		t.servo = servo;
+		if(kind == 'P'){
+			t.sampleTimeUs.push_back(timeUs);
+			t.samplePosition.push_back(value);
+		}else if((kind == 'T') || (kind == 'S') || (kind == 'A')){
+			t.commandTimeUs.push_back(timeUs);
+			t.commandKind.push_back(kind);
+			t.commandValue.push_back(value);
+		}
+	}
+	return traces;
+}
+
+map<unsigned, ServoTrace> ServoTraceReader::read(const string &filename){
+	ifstream in(filename.c_str());
+	if(!in){
+		throw new ExceptionServoModel(string("ServoTraceReader::read: cannot open '") + filename + string("'."));
+	}
+	return ServoTraceReader::read(in);
+}
+
+
+
+double ServoModelFitter::cost(const ServoTrace &trace, const ServoModelParams &params){
+	const size_t samples  = trace.sampleTimeUs.size();
+	const size_t commands = trace.commandTimeUs.size();
+	if(samples == 0){
+		return 0.0;
+	}
+	unsigned long long start = trace.sampleTimeUs[0];
+	if((commands > 0) && (trace.commandTimeUs[0] < start)){
+		start = trace.commandTimeUs[0];
+	}
+	ServoEstimator estimator(params, (unsigned short) trace.samplePosition[0], start);
+
+	double sum = 0.0;
+	size_t c = 0;
+	for(size_t s = 0; s < samples; s++){
+		const unsigned long long t = trace.sampleTimeUs[s];
+		for(; (c < commands) && (trace.commandTimeUs[c] <= t); c++){
+			switch(trace.commandKind[c]){
+			case 'T': estimator.setTarget(trace.commandTimeUs[c], trace.commandValue[c]); break;
+			case 'S': estimator.setSpeed(trace.commandTimeUs[c], trace.commandValue[c]); break;
+			case 'A': estimator.setAcceleration(trace.commandTimeUs[c], trace.commandValue[c]); break;
+			}
+		}
+		double r = estimator.estimate(t) - trace.samplePosition[s];
+		sum += r * r;
+	}
+	return sum;
+}
+
+/*
+ * Which parameters the trace can tell something about.
+ */
+static void observable(const ServoTrace &trace, bool &up, bool &down, bool &accel, bool &unlimited){
+	up = down = accel = unlimited = false;
+	unsigned short speed = 0;
+	float last = trace.samplePosition.empty() ? 0.0 : trace.samplePosition[0];
+	for(size_t c = 0; c < trace.commandTimeUs.size(); c++){
+		unsigned short v = trace.commandValue[c];
+		switch(trace.commandKind[c]){
+		case 'S':
+			speed = v;
+			break;
+		case 'A':
+			accel = accel || (v > 0);
+			break;
+		case 'T':
+			if(v == 0){
+				break;
+			}
+			if(speed == 0){
+				unlimited = true;
+			}else if(v > last){
+				up = true;
+			}else if(v < last){
+				down = true;
+			}
+			last = v;
+			break;
+		}
+	}
+}
+
+/*
+ * Continuous parameters of the coordinate descent.
+ */
+static float& fitParameter(ServoModelParams &p, unsigned i){
+	switch(i){
+	case 0:  return p.speedScaleUp;
+	case 1:  return p.speedScaleDown;
+	case 2:  return p.accelScale;
+	default: return p.unlimitedSpeed;
+	}
+}
+
+ServoModelParams ServoModelFitter::fit(const ServoTrace &trace){
+	if(trace.sampleTimeUs.empty()){
+		stringstream ss;
+		ss << "ServoModelFitter::fit: no position readbacks of servo " << trace.servo << ".";
+		throw new ExceptionServoModel(ss.str());
+	}
+	bool up, down, accel, unlimited;
+	observable(trace, up, down, accel, unlimited);
+
+	ServoModelParams best;
+	best.servo = trace.servo;
+	double bestCost = ServoModelFitter::cost(trace, best);
+
+	// the dead time is a multiple of the update period, scan it first
+	for(unsigned long d = SERVOMODEL_STEP_US; d <= 30 * SERVOMODEL_STEP_US; d += SERVOMODEL_STEP_US){
+		ServoModelParams p = best;
+		p.deadTimeUs = d;
+		double c = ServoModelFitter::cost(trace, p);
+		if(c < bestCost){
+			bestCost = c;
+			best.deadTimeUs = d;
+		}
+	}
+	if(unlimited){
+		// coarse scan of the speed of unlimited moves, 0 = jump
+		for(float v = 8.0; v <= 1024.0; v *= 2.0){
+			ServoModelParams p = best;
+			p.unlimitedSpeed = v;
+			double c = ServoModelFitter::cost(trace, p);
+			if(c < bestCost){
+				bestCost = c;
+				best.unlimitedSpeed = v;
+			}
+		}
+	}
+
+	// coordinate descent over the continuous parameters
+	bool  active[4] = {up, down, accel, unlimited && (best.unlimitedSpeed > 0.0)};
+	float step[4]   = {0.2, 0.2, 0.2, best.unlimitedSpeed * 0.2f};
+	float minStep[4] = {1.0e-4, 1.0e-4, 1.0e-4, best.unlimitedSpeed * 1.0e-4f};
+	for(unsigned round = 0; round < 200; round++){
+		bool improved = false;
+		bool open = false;
+		for(unsigned i = 0; i < 4; i++){
+			if(!active[i] || (step[i] < minStep[i])){
+				continue;
+			}
+			open = true;
+			bool moved = false;
+			for(int sign = -1; (sign <= 1) && !moved; sign += 2){
+				ServoModelParams p = best;
+				float &value = fitParameter(p, i);
+				value += sign * step[i];
+				if(value <= 0.0){
+					continue;
+				}
+				double c = ServoModelFitter::cost(trace, p);
+				if(c < bestCost){
+					bestCost = c;
+					best = p;
+					moved = true;
+				}
+			}
+			if(moved){
+				improved = true;
+			}else{
+				step[i] *= 0.5;
+			}
+		}
+		// the dead time may shift once the speeds are known
+		for(int sign = -1; sign <= 1; sign += 2){
+			if((sign < 0) && (best.deadTimeUs < SERVOMODEL_STEP_US)){
+				continue;
+			}
+			ServoModelParams p = best;
+			p.deadTimeUs = best.deadTimeUs + sign * (long) SERVOMODEL_STEP_US;
+			double c = ServoModelFitter::cost(trace, p);
+			if(c < bestCost){
+				bestCost = c;
+				best = p;
+				improved = true;
+			}
+		}
+		if(!improved && !open){
+			break;
+		}
+	}
+
+	best.samples  = trace.sampleTimeUs.size();
+	best.rmsError = sqrt(bestCost / best.samples);
+	return best;
+}
@@ -0,0 +1,224 @@
+//============================================================================
+// Name        : ServoModel.hpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : ServoModel header file. It contains the dynamics model of a
+//               servo channel shared by the MaestroSimulator and the
+//               ServoEstimator, the parameter file, the recorded traces and
+//               the fitting of the model parameters to the traces.
+//============================================================================
+#ifndef SERVOMODEL_HPP_INCLUDED
+#define SERVOMODEL_HPP_INCLUDED
+
+#include "SerialCom.hpp"
+#include <string>
+#include <vector>
+#include <map>
+#include <istream>
+
+using namespace std;
+
+
+/**
+ *
+ * \brief Parameters of the dynamics of one servo. Positions are given in
+ * 1/4 micro seconds, speeds in units per 10 ms, like the Maestro settings.
+ * The default values describe an ideal servo that follows the limits of
+ * the controller exactly.
+ *
+ */
+struct ServoModelParams {
+	unsigned      servo          = 0;
+	unsigned long deadTimeUs     = 0;   /**< time from the command to the start of the motion */
+	float         speedScaleUp   = 1.0; /**< effective / commanded speed, increasing positions */
+	float         speedScaleDown = 1.0; /**< effective / commanded speed, decreasing positions (load dependent lag) */
+	float         accelScale     = 1.0; /**< effective / commanded acceleration */
+	float         unlimitedSpeed = 0.0; /**< speed of the servo if the speed is not limited (0), 0 jumps */
+	float         rmsError       = 0.0; /**< residual of the fit in 1/4 micro seconds */
+	unsigned long samples        = 0;   /**< number of readbacks the parameters were fitted to */
+};
+
+
+/**
+ *
+ * \class ServoModel
+ *
+ * \brief Motion of a servo channel in steps of 10 ms (the update period
+ * of the Maestro) under the speed and acceleration limits, scaled by the
+ * fitted parameters.
+ *
+ */
+class ServoModel {
+public:
+	ServoModel(){};
+	ServoModel(const ServoModelParams &params) : params_(params){};
+
+	/**
+	 *
+	 * \brief Advances position and velocity (units per 10 ms) by one
+	 * step of 10 ms towards the target. A target of 0 means the pulses
+	 * are off and the servo does not move.
+	 *
+	 */
+	void step(float &position, float &velocity, unsigned short target,
+			  unsigned short speed, unsigned short acceleration) const;
+
+	const ServoModelParams& getParams() const {return params_;};
+	void setParams(const ServoModelParams &params){params_ = params;};
+
+protected:
+	ServoModelParams params_;
+};
+
+
+/**
+ *
+ * \class ServoEstimator
+ *
+ * \brief Predicts the position of a servo from the commands sent to it,
+ * so readbacks can be replaced by predictions. The uncertainty of a
+ * prediction is the residual of the fit (ServoModelParams::rmsError).
+ *
+ * Commands and estimates have to be given in the order of time. The
+ * model steps on the 10 ms grid of the controller (multiples of 10 ms).
+ *
+ */
+class ServoEstimator {
+public:
+	ServoEstimator(const ServoModelParams &params, unsigned short position, unsigned long long timeUs = 0);
+
+	void setTarget(unsigned long long timeUs, unsigned short target);
+	void setSpeed(unsigned long long timeUs, unsigned short speed);
+	void setAcceleration(unsigned long long timeUs, unsigned short acceleration);
+
+	/**
+	 *
+	 * \brief Estimated position at the given time.
+	 *
+	 */
+	float estimate(unsigned long long timeUs);
+
+	float getUncertainty() const {return model_.getParams().rmsError;};
+
+	bool isMoving();
+
+protected:
+	void advance(unsigned long long timeUs);
+
+	ServoModel         model_;
+	unsigned long long timeUs_;     // last grid point
+	float              position_;
+	float              velocity_ = 0.0;
+	unsigned short     target_;
+	unsigned short     speed_ = 0;
+	unsigned short     acceleration_ = 0;
+	bool               pending_ = false;
+	unsigned short     pendingTarget_ = 0;
+	unsigned long long pendingAtUs_ = 0;
+};
+
+
+/**
+ *
+ * \class ServoModelFile
+ *
+ * \brief Text file with one line of parameters per servo:
+ *
+ *    servo deadTimeUs speedScaleUp speedScaleDown accelScale unlimitedSpeed rmsError samples
+ *
+ * Lines starting with '#' are comments.
+ *
+ */
+class ServoModelFile {
+public:
+	/**
+	 * \brief Reads the file. If it cannot be read or a line is malformed
+	 * an exception (IException) is thrown.
+	 */
+	static vector<ServoModelParams> load(const string &filename);
+
+	static void save(const string &filename, const vector<ServoModelParams> &params);
+};
+
+
+/**
+ *
+ * \brief Recorded traffic of one servo. Commands and readbacks are kept
+ * in separate arrays of equal length (structure of arrays), each sorted
+ * by time.
+ *
+ */
+struct ServoTrace {
+	unsigned servo = 0;
+	vector<unsigned long long> commandTimeUs;
+	vector<char>               commandKind;   /**< 'T' target, 'S' speed, 'A' acceleration */
+	vector<unsigned short>     commandValue;
+	vector<unsigned long long> sampleTimeUs;
+	vector<float>              samplePosition;
+};
+
+
+/**
+ *
+ * \class ServoTraceReader
+ *
+ * \brief Reads traces written by SerialComRecorder, lines of the form
+ *
+ *    timeUs,servo,kind,value
+ *
+ * with the kinds T (target), S (speed), A (acceleration) and P
+ * (position read back). Lines starting with '#' are comments.
+ *
+ */
+class ServoTraceReader {
+public:
+	static map<unsigned, ServoTrace> read(istream &in);
+	static map<unsigned, ServoTrace> read(const string &filename);
+};
+
+
+/**
+ *
+ * \class ServoModelFitter
+ *
+ * \brief Fits the parameters of a servo to a trace by minimizing the
+ * squared difference between the readbacks and the positions the model
+ * predicts from the commands (coordinate descent, the dead time on the
+ * 10 ms grid of the controller).
+ *
+ */
+class ServoModelFitter {
+public:
+	/**
+	 * \brief Fitted parameters. If the trace has no readbacks an
+	 * exception (IException) is thrown.
+	 */
+	static ServoModelParams fit(const ServoTrace &trace);
+
+	/**
+	 * \brief Sum of the squared residuals of the parameters over the trace.
+	 */
+	static double cost(const ServoTrace &trace, const ServoModelParams &params);
+};
+
+
+/**
+ *
+ * \class ExceptionServoModel
+ *
+ * \brief Exception class of the servo model classes.
+ *
+ */
+class ExceptionServoModel : public IException{
+	public:
+		ExceptionServoModel(string msg){
+			msg_ = string("ExceptionServoModel::") + msg;
+		};
+		string getMsg(){return msg_;};
+	protected:
+		string msg_;
+	private:
+		ExceptionServoModel(){};
+};
+
+#endif // SERVOMODEL_HPP_INCLUDED
@@ -7,9 +7,12 @@
 //============================================================================
 #include "ServoMotor.hpp"
 #include "Pololu.hpp"
+#include "Trace.hpp"
+#include "Instrument.hpp"
 #include <iostream>
 #include <sstream>
 #include <cmath>
+#include <cstdlib>
 
 
 
@@ -88,6 +91,8 @@ unsigned short ServoMotorPololuBase::getMidPosInAbs(){return  neutralPosition_;}
 unsigned short ServoMotorPololuBase::getMaxPosInAbs(){return (neutralPosition_ + delta_);};
 
 unsigned short ServoMotorPololuBase::setPositionInAbs(unsigned short newPosition){
+	MEX_TRACE_SPAN_ARG("ServoMotor::setPositionInAbs", servoNmb_);
+	MEX_INSTRUMENT_CALL("ServoMotor::setPositionInAbs");
 	if((newPosition < this->getMinPosInAbs()) ||
 			(newPosition > this->getMaxPosInAbs())){
 		string msg("setPositionInDeg:: position value is out of range.");
@@ -96,7 +101,14 @@ unsigned short ServoMotorPololuBase::setPositionInAbs(unsigned short newPosition
 
 
 	try{
-		pololuCtrl_->setPosition(servoNmb_,newPosition);
+		// the cheapest encoding that meets the requested precision
+		unsigned char target = this->mapPosValue2MiniSsc(newPosition);
+		int deviation = ((int) this->mapMiniSsc2PosValue(target)) - ((int) newPosition);
+		if((precision_ > 0) && (abs(deviation) <= precision_)){
+			pololuCtrl_->setPositionMiniSsc(servoNmb_, target);
+		}else{
+			pololuCtrl_->setPosition(servoNmb_,newPosition);
+		}
 	}catch(IException *e){
 		string msg("setPositionInAbs:: error while trying to set a new position:");
 		msg += e->getMsg();
@@ -119,7 +131,25 @@ unsigned short ServoMotorPololuBase::setPositionInAbs(unsigned short newPosition
 
 };
 
+unsigned char ServoMotorPololuBase::mapPosValue2MiniSsc(unsigned short p){
+	float v = 127.0 + ((((float) p) - ((float) neutralPosition_)) * 127.0) / ((float) delta_);
+	if(v < 0.0){
+		return 0;
+	}
+	if(v > 254.0){
+		return 254;
+	}
+	return (unsigned char) (v + 0.5);
+};
+
+unsigned short ServoMotorPololuBase::mapMiniSsc2PosValue(unsigned char v){
+	int p = ((int) neutralPosition_) + ((((int) v) - 127) * ((int) delta_)) / 127;
+	return (p < 0) ? 0 : p;
+};
+
 unsigned short ServoMotorPololuBase::getPositionInAbs(){
+	MEX_TRACE_SPAN_ARG("ServoMotor::getPositionInAbs", servoNmb_);
+	MEX_INSTRUMENT_CALL("ServoMotor::getPositionInAbs");
 	try{
 		return (pololuCtrl_->getPosition(servoNmb_));
 	}catch(IException *e){
@@ -157,6 +187,8 @@ unsigned short ServoMotorPololuBase::getPositionInAbs(){
  *
  */
 unsigned short ServoMotorPololuBaseAdv::setSpeed(unsigned short newSpeed){
+	MEX_TRACE_SPAN_ARG("ServoMotor::setSpeed", servoNmb_);
+	MEX_INSTRUMENT_CALL("ServoMotor::setSpeed");
 	if(newSpeed > 255){
 		newSpeed = 255;
 	}
@@ -184,6 +216,8 @@ unsigned short ServoMotorPololuBaseAdv::setSpeed(unsigned short newSpeed){
  *
  */
 unsigned short ServoMotorPololuBaseAdv::setAcceleration(unsigned short newAcceleration){
+	MEX_TRACE_SPAN_ARG("ServoMotor::setAcceleration", servoNmb_);
+	MEX_INSTRUMENT_CALL("ServoMotor::setAcceleration");
 	if(newAcceleration > 255){
 		newAcceleration = 255;
 	}
@@ -243,6 +277,8 @@ void  ServoMotor::setMinMaxRadian(float minRadian, float maxRadian){
 }
 
 short ServoMotor::setPositionInDeg(short newPosition){
+	MEX_TRACE_SPAN_ARG("ServoMotor::setPositionInDeg", servoNmb_);
+	MEX_INSTRUMENT_CALL("ServoMotor::setPositionInDeg");
 	short actPos = newPosition;
 	if((actPos < minDeg_) || (actPos > maxDeg_)){
 		string msg("setPositionInDeg:: degree /radiant value is out of range.");
@@ -264,6 +300,8 @@ short ServoMotor::setPositionInDeg(short newPosition){
 };
 
 float ServoMotor::setPositionInRad(float newPosition){
+	MEX_TRACE_SPAN_ARG("ServoMotor::setPositionInRad", servoNmb_);
+	MEX_INSTRUMENT_CALL("ServoMotor::setPositionInRad");
 	short deg;
 	try{
 		deg = this->setPositionInDeg(this->rad2deg(newPosition));
@@ -279,6 +317,8 @@ float ServoMotor::setPositionInRad(float newPosition){
 };
 
 short ServoMotor::getPositionInDeg(){
+	MEX_TRACE_SPAN_ARG("ServoMotor::getPositionInDeg", servoNmb_);
+	MEX_INSTRUMENT_CALL("ServoMotor::getPositionInDeg");
 	short deg;
 	unsigned short pos;
 	try{
@@ -297,6 +337,8 @@ short ServoMotor::getPositionInDeg(){
 };
 
 float ServoMotor::getPositionInRad(){
+	MEX_TRACE_SPAN_ARG("ServoMotor::getPositionInRad", servoNmb_);
+	MEX_INSTRUMENT_CALL("ServoMotor::getPositionInRad");
 	float rad;
 	short deg;
 	unsigned short pos;
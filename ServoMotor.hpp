@@ -275,6 +275,37 @@ public:
 	unsigned short getMaxPosInAbs();
 	unsigned short setPositionInAbs(unsigned short newPosition);
 	unsigned short getPositionInAbs();
+
+	/**
+	 *
+	 * \brief Maps a position value to the 8 bit scale of the Mini SSC
+	 * protocol: 127 is the neutral position, 0 and 254 are the neutral
+	 * position -/+ delta. The controller channel has to be configured
+	 * with the same neutral and range settings (see showPololuValues(...)).
+	 *
+	 */
+	unsigned char  mapPosValue2MiniSsc(unsigned short p);
+
+	/**
+	 *
+	 * \brief Position value the controller moves to for the given
+	 * 8 bit Mini SSC target.
+	 *
+	 */
+	unsigned short mapMiniSsc2PosValue(unsigned char v);
+
+	/**
+	 *
+	 * \brief Sets the deviation (in position units) that is acceptable
+	 * for setPositionInAbs(...). If the 8 bit Mini SSC target meets the
+	 * precision, the position is sent as 3 byte Mini SSC command,
+	 * otherwise as 4 byte Maestro command. With a precision of 0
+	 * (default) positions are always sent exactly.
+	 *
+	 */
+	void setPositionPrecision(unsigned short precision){precision_ = precision;};
+
+	unsigned short getPositionPrecision(){return precision_;};
 protected:
 	/**
 	 *
@@ -325,6 +356,16 @@ protected:
 	 */
 	unsigned short delta_;
 
+	/**
+	 *
+	 * \var precision_
+	 *
+	 * \brief Acceptable deviation of a position set, see
+	 * setPositionPrecision(...).
+	 *
+	 */
+	unsigned short precision_ = 0;
+
 	ServoMotorPololuBase(){pololuCtrl_ = NULL;};
 };
 
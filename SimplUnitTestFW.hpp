@@ -11,6 +11,29 @@
 #include <iostream>
 #include <string>
 #include <fstream>
+#include <vector>
+#include <map>
+#include <functional>
+#include <regex>
+#include <cstdlib>
+#include <cstdio>
+#include <cstdint>
+#include <cerrno>
+#include <cstring>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <fnmatch.h>
+#include <unistd.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <fcntl.h>
+
+#ifdef MEX_INSTRUMENT
+	#include "Instrument.hpp"
+#endif
 
 using namespace std;
 
@@ -389,6 +412,746 @@ public:
 	virtual void   addTestItem(ITestItem *item) = 0;
 };
 
+/**
+ *
+ * \brief Outcome of a test case.
+ *
+ */
+enum TestStatus {
+	TEST_PASSED,
+	TEST_FAILED,
+	TEST_TIMEOUT, /**< time limit of the case or budget of a suite exceeded */
+	TEST_SKIPPED  /**< a required resource is not available, not a failure */
+};
+
+/**
+ *
+ * \brief Probe of a resource: true if it is available, otherwise the
+ * reason is set.
+ *
+ */
+typedef std::function<bool(string &reason)> TestProbe;
+
+typedef std::chrono::steady_clock testClock;
+
+/**
+ *
+ * \class TestRun
+ * \brief Selection of the test cases of a run. A test case is addressed
+ * by its path "unit/suite/case" and is executed if
+ *  - its unit, suite and case name match one of the respective glob
+ *    patterns (no patterns: all match),
+ *  - the path contains a match of the regular expression (if given) and
+ *  - it belongs to the shard of this process: shards are taken by a
+ *    hash of the path, so each case runs in exactly one of n processes
+ *    independently of the order and the machine.
+ * In list mode the selected paths are printed instead of executed and
+ * no result files are written.
+ *
+ * Test items executed within a test case (tests of the framework) are
+ * not subject to the selection.
+ *
+ * A test case exceeding its time limit (see TestItem::setTimeoutMs(...)
+ * and --timeout) is handled in one of two ways:
+ *  - per default a watchdog thread aborts the run: the cases of the
+ *    current unit finished so far and the case timed out (TIMEOUT) are
+ *    written to prefix + "UT_" + unit + ".xml", the name used by the
+ *    execUnitTests(...) functions, and the process exits with
+ *    timeoutExitCode,
+ *  - with isolation each test case runs in a child process, a child
+ *    exceeding the limit is killed, the case is marked TIMEOUT and the
+ *    run continues. Changes a test case makes to the state of the
+ *    process (fixtures, instrument counts) are lost with the child.
+ *
+ * With more than one job the test cases of a unit are executed by a pool
+ * of worker processes, see TestPool.
+ *
+ * Test cases and suites requiring a resource (TestItem::requireResource)
+ * are SKIPPED if it is not available. Each resource is probed once per
+ * unit, when the unit starts: device paths ("/dev/...") by opening them,
+ * other resources by the probe set for them.
+ *
+ */
+class TestRun{
+public:
+
+	/**
+	 *
+	 * \brief The selection of the process (or the one set by setInstance(...)).
+	 *
+	 */
+	static TestRun& instance(){
+		static TestRun global;
+		return (current() != nullptr) ? *current() : global;
+	}
+
+	/**
+	 *
+	 * \brief Uses the given selection instead of the one of the process,
+	 * NULL restores it.
+	 *
+	 */
+	static void setInstance(TestRun *run){current() = run;};
+
+	/**
+	 *
+	 * \brief Exit code of a run aborted by the watchdog.
+	 *
+	 */
+	static const int timeoutExitCode = 124;
+
+	TestRun(){};
+
+	~TestRun(){
+		if(watchdog_ != nullptr){
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				stop_ = true;
+			}
+			wake_.notify_all();
+			watchdog_->join();
+			delete watchdog_;
+		}
+	}
+
+	/**
+	 *
+	 * \brief Takes the options of the command line:
+	 *   --unit=GLOB --suite=GLOB --case=GLOB (repeatable)
+	 *   --filter=REGEX   searched in the path unit/suite/case
+	 *   --shard=I/N      shard I of N (0 <= I < N)
+	 *   --list           prints the selected paths
+	 *   --xml-prefix=P   prefix of the result files (e.g. a directory)
+	 *   --timeout=S      time limit of test cases without their own, in
+	 *                    seconds (0: none)
+	 *   --isolate        runs each test case in a child process
+	 *   --jobs=N         runs the test cases on N worker processes
+	 *   --no-skip        runs the test cases requiring a missing resource
+	 * Returns false and writes the usage to err on an unknown or malformed
+	 * option.
+	 *
+	 */
+	bool parse(int argc, char* argv[], ostream &err){
+		for(int i = 1; i < argc; i++){
+			string arg(argv[i]);
+			string value = (arg.find('=') != string::npos) ? arg.substr(arg.find('=') + 1) : string("");
+			unsigned index, count;
+			char rest;
+			if(arg.compare(0, 7, "--unit=") == 0){
+				units_.push_back(value);
+			}else if(arg.compare(0, 8, "--suite=") == 0){
+				suites_.push_back(value);
+			}else if(arg.compare(0, 7, "--case=") == 0){
+				cases_.push_back(value);
+			}else if(arg.compare(0, 9, "--filter=") == 0){
+				if(!setFilter(value)){
+					err << "invalid regular expression: " << value << endl;
+					return false;
+				}
+			}else if(arg.compare(0, 8, "--shard=") == 0){
+				if((sscanf(value.c_str(), "%u/%u%c", &index, &count, &rest) != 2) || !setShard(index, count)){
+					err << "invalid shard: " << value << " (expected I/N, 0 <= I < N)" << endl;
+					return false;
+				}
+			}else if(arg == "--list"){
+				listOnly_ = true;
+			}else if(arg.compare(0, 13, "--xml-prefix=") == 0){
+				xmlPrefix_ = value;
+			}else if(arg.compare(0, 10, "--timeout=") == 0){
+				char *end = nullptr;
+				double seconds = strtod(value.c_str(), &end);
+				if(value.empty() || (*end != '\0') || (seconds < 0.0) || (seconds > 86400.0)){
+					err << "invalid timeout: " << value << " (expected seconds)" << endl;
+					return false;
+				}
+				timeoutMs_ = (unsigned) (seconds * 1000.0 + 0.5);
+			}else if(arg == "--isolate"){
+				isolate_ = true;
+			}else if(arg == "--no-skip"){
+				probing_ = false;
+			}else if(arg.compare(0, 7, "--jobs=") == 0){
+				if((sscanf(value.c_str(), "%u%c", &count, &rest) != 1) || !setJobs(count)){
+					err << "invalid jobs: " << value << " (expected 1 ... 256)" << endl;
+					return false;
+				}
+			}else{
+				err << "usage: " << argv[0] << " [--unit=GLOB] [--suite=GLOB] [--case=GLOB] [--filter=REGEX]" << endl
+					<< "       [--shard=I/N] [--list] [--xml-prefix=PREFIX] [--timeout=SECONDS] [--isolate]" << endl
+					<< "       [--jobs=N] [--no-skip]" << endl;
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void addUnit(const string &glob) {units_.push_back(glob);};
+	void addSuite(const string &glob){suites_.push_back(glob);};
+	void addCase(const string &glob) {cases_.push_back(glob);};
+
+	/**
+	 *
+	 * \brief Sets the regular expression (ECMAScript), an empty one selects
+	 * all. Returns false if it is malformed.
+	 *
+	 */
+	bool setFilter(const string &expression){
+		try{
+			filter_ = std::regex(expression);
+			hasFilter_ = !expression.empty();
+			return true;
+		}catch(std::regex_error &e){
+			return false;
+		}
+	}
+
+	bool setShard(unsigned index, unsigned count){
+		if((count == 0) || (index >= count)){
+			return false;
+		}
+		shardIndex_ = index;
+		shardCount_ = count;
+		return true;
+	}
+
+	void setListOnly(bool listOnly)         {listOnly_ = listOnly;};
+	void setXmlPrefix(const string &prefix) {xmlPrefix_ = prefix;};
+	string getXmlPrefix()                   {return xmlPrefix_;};
+
+	/**
+	 *
+	 * \brief Time limit of the test cases without their own, 0 for none.
+	 *
+	 */
+	void setTimeoutMs(unsigned ms)          {timeoutMs_ = ms;};
+	unsigned getTimeoutMs()                 {return timeoutMs_;};
+
+	void setIsolate(bool isolate)           {isolate_ = isolate;};
+	bool isIsolating()                      {return isolate_;};
+
+	/**
+	 *
+	 * \brief Number of worker processes (1: the cases run in this one).
+	 *
+	 */
+	bool setJobs(unsigned jobs){
+		if((jobs == 0) || (jobs > 256)){
+			return false;
+		}
+		jobs_ = jobs;
+		return true;
+	}
+	unsigned getJobs(){return jobs_;};
+
+	/**
+	 *
+	 * \brief Makes this process a worker of a TestPool: the cases run in
+	 * this process and their results are sent to the given descriptor.
+	 *
+	 */
+	void setWorker(int resultFd){
+		jobs_     = 1;
+		isolate_  = false;
+		resultFd_ = resultFd;
+	}
+
+	bool isWorker(){return resultFd_ >= 0;};
+
+	/**
+	 *
+	 * \brief Sets the probe of a resource (instead of opening it).
+	 *
+	 */
+	void setProbe(const string &resource, TestProbe probe){
+		probes_[resource] = probe;
+		probed_.erase(resource);
+	}
+
+	/**
+	 *
+	 * \brief False: resources are not probed and all test cases executed.
+	 *
+	 */
+	void setProbing(bool probing){probing_ = probing;};
+
+	/**
+	 *
+	 * \brief Number of the test cases skipped by the run.
+	 *
+	 */
+	unsigned getSkipped(){return skipped_;};
+
+	void addSkipped(){
+		if(isTopLevel()){
+			skipped_++;
+		}
+	}
+
+	/**
+	 *
+	 * \brief Forgets the outcome of the probes, done when a unit starts.
+	 *
+	 */
+	void clearProbes(){probed_.clear();};
+
+	/**
+	 *
+	 * \brief Why the resource is not available, empty if it is. The
+	 * resource is probed only once (until clearProbes()).
+	 *
+	 */
+	string unavailable(const string &resource){
+		if(!probing_){
+			return string("");
+		}
+		map<string, string>::iterator i = probed_.find(resource);
+		if(i != probed_.end()){
+			return i->second;
+		}
+		string reason;
+		map<string, TestProbe>::iterator p = probes_.find(resource);
+		if(p != probes_.end()){
+			if(p->second(reason)){
+				reason.clear();
+			}else if(reason.empty()){
+				reason = "not available";
+			}
+		}else if(resource.compare(0, 5, "/dev/") == 0){
+			int fd = open(resource.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK);
+			if(fd < 0){
+				reason = strerror(errno);
+			}else{
+				close(fd);
+			}
+		}else{
+			reason = "no probe";
+		}
+		if(!reason.empty()){
+			reason = resource + ": " + reason;
+		}
+		probed_[resource] = reason;
+		return reason;
+	}
+
+	/**
+	 *
+	 * \brief Sends a result of a worker (see TestPool), nothing is sent
+	 * by other processes.
+	 *
+	 */
+	void sendResult(char kind, int index, TestStatus status, const string &payload){
+		if(!isWorker() || !isTopLevel()){
+			return;
+		}
+		std::lock_guard<std::mutex> lock(mutex_);
+		writeResult(kind, index, status, payload);
+	}
+
+	/**
+	 *
+	 * \brief fork() which leaves the watchdog in a usable state in the
+	 * child (the thread of the parent does not exist there).
+	 *
+	 */
+	pid_t fork(){
+		cout.flush();
+		cerr.flush();
+		std::unique_lock<std::mutex> lock(mutex_);
+		pid_t pid = ::fork();
+		if(pid == 0){
+			watchdog_ = nullptr; // not joinable in the child, left behind
+			armed_    = false;
+		}
+		return pid;
+	}
+
+	/**
+	 *
+	 * \brief True if paths are printed instead of executed.
+	 *
+	 */
+	bool isListing(){return listOnly_ && (depth_ == 0);};
+
+	bool isSelected(const string &unit, const string &suite, const string &testCase){
+		if(depth_ > 0){
+			return true;
+		}
+		string path = unit + "/" + suite + "/" + testCase;
+		return matches(units_, unit) && matches(suites_, suite) && matches(cases_, testCase) &&
+			   (!hasFilter_ || std::regex_search(path, filter_)) &&
+			   ((shardCount_ <= 1) || (shardOf(path, shardCount_) == shardIndex_));
+	}
+
+	/**
+	 *
+	 * \brief Shard of a path (FNV-1a hash), the same on every machine.
+	 *
+	 */
+	static unsigned shardOf(const string &path, unsigned count){
+		uint32_t h = 2166136261u;
+		for(size_t i = 0; i < path.size(); i++){
+			h = (h ^ (unsigned char) path[i]) * 16777619u;
+		}
+		return h % count;
+	}
+
+	/**
+	 *
+	 * \brief Marks the execution of a test case, see isSelected(...).
+	 *
+	 */
+	void enterCase(){depth_++;};
+	void leaveCase(){depth_--;};
+
+	/**
+	 *
+	 * \brief True outside of the execution of a test case: the time limits
+	 * and the isolation apply to these test cases only.
+	 *
+	 */
+	bool isTopLevel(){return depth_ == 0;};
+
+	/**
+	 *
+	 * \brief Executes the test f() of the case with the given path within
+	 * the time limit (0: none), see the handling of timeouts above.
+	 *
+	 */
+	template<typename F>
+	TestStatus execute(const string &path, unsigned timeoutMs, F f, int index = -1){
+		if(isolate_ && isTopLevel()){
+			return executeIsolated(timeoutMs, f);
+		}
+		bool result;
+		arm(path, timeoutMs, index);
+		enterCase();
+		try{
+			result = f();
+		}catch(...){
+			leaveCase();
+			disarm();
+			throw;
+		}
+		leaveCase();
+		disarm();
+		return result ? TEST_PASSED : TEST_FAILED;
+	}
+
+	/**
+	 *
+	 * \brief Starts the unit the results written on abort belong to.
+	 *
+	 */
+	void beginUnit(const string &unit){
+		std::lock_guard<std::mutex> lock(mutex_);
+		unit_ = unit;
+		finished_.clear();
+	}
+
+	/**
+	 *
+	 * \brief Keeps the result of a finished case of the current unit.
+	 *
+	 */
+	void finishCase(const string &suite, const string &xml, bool passed){
+		std::lock_guard<std::mutex> lock(mutex_);
+		finished_.push_back(FinishedCase{suite, xml, passed});
+	}
+
+protected:
+	struct FinishedCase {
+		string suite;
+		string xml;
+		bool   passed;
+	};
+
+	template<typename F>
+	TestStatus executeIsolated(unsigned timeoutMs, F f){
+		int fds[2];
+		if(pipe(fds) != 0){
+			return TEST_FAILED;
+		}
+		pid_t pid = fork();
+		if(pid < 0){
+			close(fds[0]);
+			close(fds[1]);
+			return TEST_FAILED;
+		}
+		if(pid == 0){
+			close(fds[0]);
+			char c = 'F';
+			enterCase();
+			try{
+				c = f() ? 'P' : 'F';
+			}catch(...){
+			}
+			cout.flush();
+			cerr.flush();
+			ssize_t n = write(fds[1], &c, 1);
+			_exit((n == 1) ? 0 : 1);
+		}
+		close(fds[1]);
+
+		// the child writes its result and exits, a crash closes the pipe
+		TestStatus status = TEST_FAILED;
+		testClock::time_point deadline = testClock::now() + std::chrono::milliseconds(timeoutMs);
+		struct pollfd p;
+		p.fd = fds[0];
+		p.events = POLLIN;
+		while(true){
+			int wait = -1;
+			if(timeoutMs > 0){
+				long long left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - testClock::now()).count();
+				wait = (left > 0) ? (int) left : 0;
+			}
+			int r = poll(&p, 1, wait);
+			if((r < 0) && (errno == EINTR)){
+				continue;
+			}
+			if(r == 0){
+				kill(pid, SIGKILL);
+				status = TEST_TIMEOUT;
+			}else if(r > 0){
+				char c;
+				if((read(fds[0], &c, 1) == 1) && (c == 'P')){
+					status = TEST_PASSED;
+				}
+			}
+			break;
+		}
+		close(fds[0]);
+		int childStatus;
+		while((waitpid(pid, &childStatus, 0) < 0) && (errno == EINTR)){
+		}
+		return status;
+	}
+
+	void arm(const string &path, unsigned timeoutMs, int index){
+		if((timeoutMs == 0) || !isTopLevel()){
+			return;
+		}
+		std::lock_guard<std::mutex> lock(mutex_);
+		if(watchdog_ == nullptr){
+			watchdog_ = new std::thread(&TestRun::watch, this);
+		}
+		armed_      = true;
+		armedPath_  = path;
+		armedMs_    = timeoutMs;
+		armedIndex_ = index;
+		deadline_  = testClock::now() + std::chrono::milliseconds(timeoutMs);
+		wake_.notify_all();
+	}
+
+	void disarm(){
+		if(!isTopLevel() || (watchdog_ == nullptr)){
+			return;
+		}
+		std::lock_guard<std::mutex> lock(mutex_);
+		armed_ = false;
+		wake_.notify_all();
+	}
+
+	void watch(){
+		std::unique_lock<std::mutex> lock(mutex_);
+		while(!stop_){
+			if(!armed_){
+				wake_.wait(lock);
+			}else if((wake_.wait_until(lock, deadline_) == std::cv_status::timeout) && armed_ &&
+					 (testClock::now() >= deadline_)){
+				abortRun();
+			}
+		}
+	}
+
+	/**
+	 *
+	 * \brief Writes the results of the current unit and ends the process,
+	 * called by the watchdog with the lock held.
+	 *
+	 */
+	void abortRun(){
+		string path = armedPath_;
+		size_t first = path.find('/');
+		size_t last  = path.rfind('/');
+		string suite = ((first != string::npos) && (last > first)) ? path.substr(first + 1, last - first - 1) : string("");
+		if(suite.rfind('/') != string::npos){
+			suite = suite.substr(suite.rfind('/') + 1);
+		}
+		string name = (last != string::npos) ? path.substr(last + 1) : path;
+		string xml = "<TestCase name=\"" + name + "\">TIMEOUT</TestCase>";
+		if(isWorker()){
+			// the pool replaces the worker
+			writeResult('C', armedIndex_, TEST_TIMEOUT, xml);
+			cout.flush();
+			_exit(timeoutExitCode);
+		}
+		finished_.push_back(FinishedCase{suite, xml, false});
+
+		string filename = xmlPrefix_ + "UT_" + unit_ + ".xml";
+		cerr << endl << "TIMEOUT: " << path << " exceeded " << armedMs_ << " ms, run aborted, results in "
+			 << filename << endl;
+		cout.flush();
+
+		// the finished cases grouped by their suites
+		string s = "<UnitTest name=\"" + unit_ + "\" status=\"FAILED\">";
+		size_t i = 0;
+		while(i < finished_.size()){
+			size_t j = i;
+			bool passed = true;
+			while((j < finished_.size()) && (finished_[j].suite == finished_[i].suite)){
+				passed = passed && finished_[j].passed;
+				j++;
+			}
+			bool inSuite = !finished_[i].suite.empty();
+			if(inSuite){
+				s += "<TestSuite name=\"" + finished_[i].suite + "\" status=\"" + (passed ? "PASSED" : "FAILED") + "\">";
+			}
+			for(; i < j; i++){
+				s += finished_[i].xml;
+			}
+			if(inSuite){
+				s += "</TestSuite>";
+			}
+		}
+		s += "</UnitTest>";
+		std::ofstream file(filename);
+		file << s;
+		file.close();
+		_exit(timeoutExitCode);
+	}
+
+	/**
+	 *
+	 * \brief Message of a worker: kind, status, index and the length of
+	 * the payload following it.
+	 *
+	 */
+	void writeResult(char kind, int index, TestStatus status, const string &payload){
+		char header[10];
+		int32_t  i = index;
+		uint32_t n = payload.size();
+		header[0] = kind;
+		header[1] = (char) status;
+		memcpy(header + 2, &i, 4);
+		memcpy(header + 6, &n, 4);
+		string message = string(header, 10) + payload;
+		size_t done = 0;
+		while(done < message.size()){
+			ssize_t w = write(resultFd_, message.data() + done, message.size() - done);
+			if(w < 0){
+				if(errno == EINTR){
+					continue;
+				}
+				return;
+			}
+			done += w;
+		}
+	}
+
+	static TestRun*& current(){
+		static TestRun *run = nullptr;
+		return run;
+	}
+
+	static bool matches(const vector<string> &globs, const string &name){
+		for(size_t i = 0; i < globs.size(); i++){
+			if(fnmatch(globs[i].c_str(), name.c_str(), 0) == 0){
+				return true;
+			}
+		}
+		return globs.empty();
+	}
+
+	vector<string> units_;
+	vector<string> suites_;
+	vector<string> cases_;
+	std::regex     filter_;
+	bool           hasFilter_  = false;
+	unsigned       shardIndex_ = 0;
+	unsigned       shardCount_ = 1;
+	bool           listOnly_   = false;
+	string         xmlPrefix_;
+	unsigned       depth_      = 0;
+	unsigned       timeoutMs_  = 0;
+	bool           isolate_    = false;
+	unsigned       jobs_       = 1;
+	int            resultFd_   = -1;
+	bool           probing_    = true;
+	unsigned       skipped_    = 0;
+
+	map<string, TestProbe> probes_;
+	map<string, string>    probed_; // resource, reason (empty: available)
+
+	// watchdog, the members below are guarded by mutex_
+	std::thread            *watchdog_ = nullptr;
+	std::mutex              mutex_;
+	std::condition_variable wake_;
+	bool                    stop_    = false;
+	bool                    armed_   = false;
+	testClock::time_point   deadline_;
+	string                  armedPath_;
+	unsigned                armedMs_    = 0;
+	int                     armedIndex_ = -1;
+	string                  unit_;
+	vector<FinishedCase>    finished_;
+};
+
+/**
+ *
+ * \class TestFixture
+ * \brief Shared resources of a test suite or unit test, e.g. an open
+ * connection. The suite calls setUp() once before its first test item
+ * and tearDown() once after its last one, reset() is called before each
+ * test case below the suite. A fixture catches its own exceptions and
+ * reports a failure by returning false (see getError()).
+ *
+ * Fixtures nest: a test case gets the fixture of its innermost suite,
+ * the fixtures of the enclosing suites are reached by find().
+ *
+ */
+class TestFixture{
+public:
+	virtual ~TestFixture(){};
+
+	virtual bool setUp()   {return true;};
+	virtual bool tearDown(){return true;};
+
+	/**
+	 *
+	 * \brief Brings the shared state back to the state a test case
+	 * expects. The fixtures are reset from the outermost to the innermost.
+	 *
+	 */
+	virtual bool reset()   {return true;};
+
+	virtual string getError(){return error_;};
+
+	TestFixture* getParent(){return parent_;};
+
+	/**
+	 *
+	 * \brief Returns this fixture or the nearest enclosing one of type T,
+	 * NULL if there is none.
+	 *
+	 */
+	template<class T>
+	T* find(){
+		for(TestFixture *f = this; f != nullptr; f = f->parent_){
+			T *t = dynamic_cast<T*>(f);
+			if(t != nullptr){
+				return t;
+			}
+		}
+		return nullptr;
+	}
+
+protected:
+	string error_;
+
+private:
+	TestFixture *parent_ = nullptr;
+	friend class TestSuite;
+};
+
 /**
  *
  * \brief Implementation of the core functions for all derived classes
@@ -401,17 +1164,188 @@ public:
 
 	/**
 	 *
-	 * \brief Constructor
+	 * \brief Constructor
+	 *
+	 * \param s string contains the name of the test item.
+	 */
+	TestItem(string s = string("undefined test item")){name_ = s; result_ = false;};
+	virtual string getName(){ return name_;};
+	virtual bool   getResult(){return result_;};
+	virtual void   addTestItem(ITestItem *) {throw "TestItem cannot add TestItem\n";};
+
+	/**
+	 *
+	 * \brief Sets the fixture of the enclosing suite, done by the suite
+	 * before the item is executed.
+	 *
+	 */
+	void setEnclosingFixture(TestFixture *fixture){enclosing_ = fixture;};
+
+	/**
+	 *
+	 * \brief Sets the unit, the innermost suite and the path of the item,
+	 * done by the enclosing suite.
+	 *
+	 */
+	void setScope(const string &unit, const string &suite, const string &path){
+		unit_  = unit;
+		suite_ = suite;
+		path_  = path;
+	};
+
+	/**
+	 *
+	 * \brief Number of test cases selected by the TestRun.
+	 *
+	 */
+	virtual unsigned countSelected(){return 0;};
+
+	/**
+	 *
+	 * \brief False if the item was not selected (or only listed) by the
+	 * last execution. Such items are left out of the results.
+	 *
+	 */
+	virtual bool wasExecuted(){return executed_;};
+
+	/**
+	 *
+	 * \brief Marks the selected test cases as failed without executing
+	 * them, e.g. if the fixture of the enclosing suite cannot be set up.
+	 *
+	 */
+	virtual void markFailed(){};
+
+	/**
+	 *
+	 * \brief Declares a resource the item requires, e.g. a device path.
+	 * Without it the item is SKIPPED, see TestRun::unavailable(...).
+	 *
+	 */
+	void requireResource(const string &resource){required_.push_back(resource);};
+
+	/**
+	 *
+	 * \brief Appends the resources required by the selected items.
+	 *
+	 */
+	virtual void collectResources(vector<string> &resources){
+		resources.insert(resources.end(), required_.begin(), required_.end());
+	}
+
+	/**
+	 *
+	 * \brief Marks the selected test cases as skipped for the given reason
+	 * without executing them.
+	 *
+	 */
+	virtual void markSkipped(const string &){};
+
+	/**
+	 *
+	 * \brief Time limit in milli seconds, 0 for none: of the test case
+	 * (instead of the one of the TestRun) or of all test items of a suite.
+	 *
+	 */
+	void setTimeoutMs(unsigned ms){timeoutMs_ = ms;};
+
+	/**
+	 *
+	 * \brief Sets the end of the budget of the enclosing suites, done by
+	 * the enclosing suite.
+	 *
+	 */
+	void setDeadline(testClock::time_point deadline){deadline_ = deadline;};
+
+	/**
+	 *
+	 * \brief Appends the item and the items below it in the order of
+	 * their execution (their index) and clears their results, done by a
+	 * TestPool.
+	 *
+	 */
+	virtual void collectItems(vector<TestItem*> &items){
+		index_     = items.size();
+		lastIndex_ = index_;
+		executed_  = false;
+		result_    = false;
+		items.push_back(this);
+	}
+
+	/**
+	 *
+	 * \brief Index of the item and of the last item below it, see
+	 * collectItems(...).
+	 *
+	 */
+	int getIndex()    {return index_;};
+	int getLastIndex(){return lastIndex_;};
+
+	/**
+	 *
+	 * \brief Appends the parts of the item a worker of a TestPool executes
+	 * as a whole: selected test cases and suites whose items have to run
+	 * in one process.
+	 *
+	 */
+	virtual void collectJobs(vector<TestItem*> &){};
+
+	/**
+	 *
+	 * \brief Takes the result a worker of a TestPool sent for the item.
+	 *
+	 */
+	virtual void takeResult(TestStatus, const string &){};
+
+	/**
+	 *
+	 * \brief Derives the results of the suites not executed as a whole
+	 * from their items, done by a TestPool.
 	 *
-	 * \param s string contains the name of the test item.
 	 */
-	TestItem(string s = string("undefined test item")){name_ = s; result_ = false;};
-	virtual string getName(){ return name_;};
-	virtual bool   getResult(){return result_;};
-	virtual void   addTestItem(ITestItem *item) {throw "TestItem cannot add TestItem\n";};
+	virtual void gatherResults(){};
 protected:
 	string name_;
 	bool   result_ = false;
+	TestFixture *enclosing_ = nullptr;
+	string unit_;
+	string suite_;
+	string path_;
+	bool   executed_ = false;
+	unsigned timeoutMs_ = 0;
+	testClock::time_point deadline_; // epoch: no budget
+	int      index_     = -1;        // within a TestPool
+	int      lastIndex_ = -1;
+	vector<string> required_;
+
+	/**
+	 *
+	 * \brief Why a required resource is missing, empty if all are available.
+	 *
+	 */
+	string missingResource(){
+		for(size_t i = 0; i < required_.size(); i++){
+			string reason = TestRun::instance().unavailable(required_[i]);
+			if(!reason.empty()){
+				return reason;
+			}
+		}
+		return string("");
+	}
+
+	static string xmlEscape(const string &in){
+		string out;
+		for(size_t i = 0; i < in.size(); i++){
+			switch(in[i]){
+			case '&':  out += "&amp;";  break;
+			case '<':  out += "&lt;";   break;
+			case '>':  out += "&gt;";   break;
+			case '"':  out += "&quot;"; break;
+			default:   out += in[i];    break;
+			}
+		}
+		return out;
+	}
 };
 
 /**
@@ -439,15 +1373,134 @@ public:
 	 *
 	 */
 	void testExecution(){
-		result_ = testRun();
+		TestRun &run = TestRun::instance();
+		executed_ = false;
+		if(!selected_){
+			return;
+		}
+		if(run.isListing()){
+			cout << (path_.empty() ? name_ : path_) << endl;
+			return;
+		}
+		executed_ = true;
+		status_   = TEST_FAILED;
+		remoteXml_.clear();
+		skipReason_ = missingResource();
+		if(!skipReason_.empty()){
+			status_ = TEST_SKIPPED;
+			run.addSkipped();
+		}else if(reset(enclosing_)){
+			unsigned ms = (timeoutMs_ > 0) ? timeoutMs_ : run.getTimeoutMs();
+			long long left = 1;
+			if(deadline_ != testClock::time_point()){
+				left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline_ - testClock::now()).count();
+				if((left > 0) && ((ms == 0) || (left < ms))){
+					ms = (unsigned) left;
+				}
+			}
+			if(left <= 0){
+				// the budget of the suite is used up
+				status_ = TEST_TIMEOUT;
+			}else{
+#ifdef MEX_INSTRUMENT
+				counts_ = InstrumentCounts();
+				status_ = run.execute(path_.empty() ? name_ : path_, ms, [&](){
+					InstrumentCounts start = Instrument::current();
+					bool result = testRun(enclosing_);
+					counts_ = Instrument::current() - start;
+					return result;
+				}, index_);
+#else
+				status_ = run.execute(path_.empty() ? name_ : path_, ms, [&](){return testRun(enclosing_);}, index_);
+#endif
+			}
+		}
+		result_ = (status_ == TEST_PASSED) || (status_ == TEST_SKIPPED);
+		if(run.isTopLevel()){
+			string xml = toXmlStr();
+			run.finishCase(suite_, xml, result_);
+			run.sendResult('C', index_, status_, xml);
+		}
+	}
+
+	TestStatus getStatus(){return status_;};
+
+	virtual unsigned countSelected(){
+		selected_ = TestRun::instance().isSelected(unit_, suite_, name_);
+		return selected_ ? 1 : 0;
+	}
+
+	virtual void markFailed(){
+		if(selected_){
+			executed_ = true;
+			result_   = false;
+			status_   = TEST_FAILED;
+			remoteXml_.clear();
+			TestRun::instance().sendResult('C', index_, status_, toXmlStr());
+		}
+	}
+
+	virtual void markSkipped(const string &reason){
+		if(selected_){
+			executed_   = true;
+			result_     = true;
+			status_     = TEST_SKIPPED;
+			skipReason_ = reason;
+			remoteXml_.clear();
+			TestRun::instance().addSkipped();
+			TestRun::instance().sendResult('C', index_, status_, toXmlStr());
+		}
+	}
+
+	virtual void collectResources(vector<string> &resources){
+		if(selected_){
+			TestItem::collectResources(resources);
+		}
+	}
+
+	virtual void collectItems(vector<TestItem*> &items){
+		TestItem::collectItems(items);
+		status_ = TEST_FAILED;
+		remoteXml_.clear();
+	}
+
+	virtual void collectJobs(vector<TestItem*> &jobs){
+		if(selected_){
+			jobs.push_back(this);
+		}
+	}
+
+	virtual void takeResult(TestStatus status, const string &payload){
+		executed_  = true;
+		status_    = status;
+		result_    = (status == TEST_PASSED) || (status == TEST_SKIPPED);
+		remoteXml_ = payload;
 	}
 
 
 	string toXmlStr(){
 		string s("");
-		s += "<TestCase name=\"" + getName() + "\">";
-		if(result_){
+		if(!executed_){
+			return s;
+		}
+		if(!remoteXml_.empty()){
+			return remoteXml_;
+		}
+#ifdef MEX_INSTRUMENT
+		s += "<TestCase name=\"" + getName() + "\" " + counts_.toXmlAttributes();
+#else
+		s += "<TestCase name=\"" + getName() + "\"";
+#endif
+		if(status_ == TEST_SKIPPED){
+			s += " skipped=\"" + xmlEscape(skipReason_) + "\"";
+		}
+		s += ">";
+		if(status_ == TEST_PASSED){
 			s += "PASSED";
+		}else if(status_ == TEST_TIMEOUT){
+			s += "TIMEOUT";
+		}else if(status_ == TEST_SKIPPED){
+			s += "SKIPPED";
 		}else{
 			s += "FAILED";
 		};
@@ -468,6 +1521,43 @@ protected:
 		return false;
 	}
 
+	/**
+	 *
+	 * \brief Test with the fixture of the innermost suite (NULL if no
+	 * suite has one). Overridden by test cases using shared resources,
+	 * per default testRun() is called.
+	 *
+	 */
+	virtual bool testRun(TestFixture *){
+		return testRun();
+	}
+
+	/**
+	 *
+	 * \brief Resets the given fixture and its enclosing ones, outermost first.
+	 *
+	 */
+	static bool reset(TestFixture *fixture){
+		if(fixture == nullptr){
+			return true;
+		}
+		return reset(fixture->getParent()) && fixture->reset();
+	}
+
+	bool selected_ = true;
+	TestStatus status_ = TEST_FAILED;
+	string remoteXml_; // as written by a worker of a TestPool
+	string skipReason_;
+
+#ifdef MEX_INSTRUMENT
+	/**
+	 *
+	 * \brief Allocations and system calls of the thread during testRun()
+	 * (none if the case ran isolated).
+	 *
+	 */
+	InstrumentCounts counts_;
+#endif
 };
 
 
@@ -496,12 +1586,58 @@ public:
 	 */
 	virtual void testExecution(){
 		result_ = true;
+		executed_ = false;
+		fixtureError_.clear();
+		// neither fixtures nor test cases of a suite without selected cases
+		if(countSelected() == 0){
+			return;
+		}
+		if(TestRun::instance().isListing()){
+			forEachItem([](TestItem *item){item->testExecution();});
+			return;
+		}
+		executed_ = true;
+
+		// neither the fixture nor the test items without the resources
+		string missing = missingResource();
+		if(!missing.empty()){
+			markSkipped(missing);
+			TestRun::instance().sendResult('S', index_, TEST_PASSED, fixtureError_);
+			return;
+		}
+
+		TestFixture *fixture = enclosing_;
+		if(fixture_ != nullptr){
+			fixture_->parent_ = enclosing_;
+			fixture = fixture_;
+			if(!fixture_->setUp()){
+				// the test items are not executed
+				markFailed();
+				fixtureError_ = string("setUp: ") + fixture_->getError();
+				TestRun::instance().sendResult('S', index_, TEST_FAILED, fixtureError_);
+				return;
+			}
+		}
+
+		// the budget of the suite within the one of the enclosing suites
+		testClock::time_point deadline = deadline_;
+		if(timeoutMs_ > 0){
+			testClock::time_point own = testClock::now() + std::chrono::milliseconds(timeoutMs_);
+			if((deadline == testClock::time_point()) || (own < deadline)){
+				deadline = own;
+			}
+		}
+
 		TestItem *ptrTC;
 		Queue<TestItem*> tmpTC;
 		while(!testItems_.isEmpty()){
 			ptrTC = testItems_.dequeue();
+			ptrTC->setEnclosingFixture(fixture);
+			ptrTC->setDeadline(deadline);
 			ptrTC->testExecution();
-			result_ = result_ && ptrTC->getResult();
+			if(ptrTC->wasExecuted()){
+				result_ = result_ && ptrTC->getResult();
+			}
 			tmpTC.enqueue(ptrTC);
 		}
 
@@ -509,10 +1645,95 @@ public:
 			ptrTC = tmpTC.dequeue();
 			testItems_.enqueue(ptrTC);
 		}
+
+		if((fixture_ != nullptr) && !fixture_->tearDown()){
+			result_ = false;
+			fixtureError_ = string("tearDown: ") + fixture_->getError();
+		}
+		TestRun::instance().sendResult('S', index_, result_ ? TEST_PASSED : TEST_FAILED, fixtureError_);
 	};
 
+	virtual unsigned countSelected(){
+		// the unit and the path of the outermost item is its name
+		bool isUnit = (testType_ == "UnitTest");
+		string unit = isUnit ? name_ : unit_;
+		string suite = isUnit ? string("") : name_;
+		string path = path_.empty() ? name_ : path_;
+		unsigned n = 0;
+		forEachItem([&](TestItem *item){
+			item->setScope(unit, suite, path + "/" + item->getName());
+			n += item->countSelected();
+		});
+		selectedCount_ = n;
+		return n;
+	}
+
+	virtual void collectItems(vector<TestItem*> &items){
+		TestItem::collectItems(items);
+		fixtureError_.clear();
+		reported_ = false;
+		forEachItem([&](TestItem *item){item->collectItems(items);});
+		lastIndex_ = items.size() - 1;
+	}
+
+	virtual void collectJobs(vector<TestItem*> &jobs){
+		if(selectedCount_ == 0){
+			return;
+		}
+		if((fixture_ != nullptr) || (timeoutMs_ > 0) || sequential_){
+			jobs.push_back(this);
+		}else{
+			forEachItem([&](TestItem *item){item->collectJobs(jobs);});
+		}
+	}
+
+	virtual void takeResult(TestStatus status, const string &payload){
+		executed_     = true;
+		result_       = (status == TEST_PASSED);
+		fixtureError_ = payload;
+		reported_     = true;
+	}
+
+	virtual void gatherResults(){
+		bool executed = false;
+		bool result   = true;
+		forEachItem([&](TestItem *item){
+			item->gatherResults();
+			if(item->wasExecuted()){
+				executed = true;
+				result   = result && item->getResult();
+			}
+		});
+		if(!reported_){
+			executed_ = executed;
+			result_   = result && fixtureError_.empty();
+		}
+	}
+
+	virtual void markFailed(){
+		executed_ = true;
+		result_   = false;
+		forEachItem([](TestItem *item){item->markFailed();});
+	}
+
+	virtual void markSkipped(const string &reason){
+		executed_ = true;
+		result_   = true;
+		forEachItem([&](TestItem *item){item->markSkipped(reason);});
+	}
+
+	virtual void collectResources(vector<string> &resources){
+		if(selectedCount_ > 0){
+			TestItem::collectResources(resources);
+			forEachItem([&](TestItem *item){item->collectResources(resources);});
+		}
+	}
+
 	virtual string  toXmlStr(){
 		string s("");
+		if(!executed_){
+			return s;
+		}
 		s += "<" + this->testType_ + " name=\"" + this->name_   + "\" status=\"";
 		if(getResult()){
 			s += "PASSED\"";
@@ -528,6 +1749,9 @@ public:
 			s += asctime(curtime);
 			s += "\"";
 		}
+		if(!fixtureError_.empty()){
+			s += " fixtureError=\"" + xmlEscape(fixtureError_) + "\"";
+		}
 		s += ">";
 
 
@@ -544,6 +1768,7 @@ public:
 			testItems_.enqueue(ptrTC);
 		}
 
+		s += toXmlTail();
 		s += "</" + testType_ + ">";
 
 		return s;
@@ -553,11 +1778,375 @@ public:
 		testItems_.enqueue(tc);
 	};
 
+	/**
+	 *
+	 * \brief Sets the fixture shared by the test items of the suite. The
+	 * fixture is not owned and has to outlive the test execution.
+	 *
+	 */
+	void setFixture(TestFixture *fixture){fixture_ = fixture;};
+
+	/**
+	 *
+	 * \brief The test items of a sequential suite are executed by one
+	 * worker of a TestPool in their order, e.g. if they share a device
+	 * (like the items of a suite with a fixture or a time budget).
+	 *
+	 */
+	void setSequential(bool sequential){sequential_ = sequential;};
+
 protected:
+
+	/**
+	 *
+	 * \brief Calls f for each test item in the order they were added.
+	 *
+	 */
+	template<typename F>
+	void forEachItem(F f){
+		Queue<TestItem*> tmp;
+		while(!testItems_.isEmpty()){
+			TestItem *item = testItems_.dequeue();
+			f(item);
+			tmp.enqueue(item);
+		}
+		while(!tmp.isEmpty()){
+			testItems_.enqueue(tmp.dequeue());
+		}
+	}
+
+	TestFixture *fixture_ = nullptr;
+	string       fixtureError_;
+	unsigned     selectedCount_ = 0;
+	bool         sequential_    = false;
+	bool         reported_      = false; // result sent by a worker
+
+	/**
+	 *
+	 * \brief Additional elements written after the test items.
+	 *
+	 */
+	virtual string toXmlTail(){return string("");};
+
 	Queue<TestItem *> testItems_;
 	string testType_ = "TestSuite";
 };
 
+/**
+ *
+ * \class TestPool
+ * \brief Executes the selected test cases of a suite (usually a unit) on
+ * a pool of worker processes forked from this one, so they run in
+ * parallel and a crashing or hanging test case cannot take the run down:
+ *  - the jobs are the selected test cases and the suites whose items run
+ *    in one process (with a fixture, a time budget or sequential),
+ *  - an idle worker gets the index of the next job through its pipe,
+ *    executes the job like the suite would and sends the result of each
+ *    test case and suite back through its result pipe,
+ *  - a worker ending within a job (crash, exception, timeout) is replaced,
+ *    the test cases of the job it did not report are FAILED.
+ * The results of the suites are derived from their items as in this
+ * process, so the results are the same as the ones of the in-process
+ * execution. Counts of instrumented API calls (<ApiCall .../>) stay with
+ * the workers.
+ *
+ */
+class TestPool{
+public:
+	TestPool(TestRun &run) : run_(run){};
+
+	/**
+	 *
+	 * \brief Executes the selected test cases below root with
+	 * run.getJobs() workers and collects their results.
+	 *
+	 */
+	void execute(TestSuite &root){
+		items_.clear();
+		jobs_.clear();
+		root.countSelected();
+		root.collectItems(items_);
+		root.collectJobs(jobs_);
+		reported_.assign(items_.size(), false);
+		if(jobs_.empty()){
+			return;
+		}
+
+		// a worker lost while its command is written must not end this process
+		void (*previous)(int) = signal(SIGPIPE, SIG_IGN);
+		size_t count = (run_.getJobs() < jobs_.size()) ? run_.getJobs() : jobs_.size();
+		workers_.assign(count, Worker());
+		size_t next = 0;
+		while(true){
+			vector<struct pollfd> fds;
+			vector<Worker*>       busy;
+			for(size_t i = 0; i < workers_.size(); i++){
+				Worker &w = workers_[i];
+				if((w.pid < 0) && (next < jobs_.size()) && !spawn(w)){
+					// nothing to run the job on
+					if(busy.empty() && (alive() == 0)){
+						lose(next++, "no worker process");
+					}
+					continue;
+				}
+				if((w.pid >= 0) && (w.job < 0) && (next < jobs_.size())){
+					dispatch(w, next++);
+				}
+				if((w.pid >= 0) && (w.job >= 0)){
+					struct pollfd p;
+					p.fd      = w.result;
+					p.events  = POLLIN;
+					p.revents = 0;
+					fds.push_back(p);
+					busy.push_back(&w);
+				}
+			}
+			if(busy.empty()){
+				if(next >= jobs_.size()){
+					break;
+				}
+				continue;
+			}
+			if((poll(fds.data(), fds.size(), -1) < 0) && (errno != EINTR)){
+				break;
+			}
+			for(size_t i = 0; i < busy.size(); i++){
+				if((fds[i].revents != 0) && !receive(*busy[i])){
+					lost(*busy[i]);
+				}
+			}
+		}
+
+		for(size_t i = 0; i < workers_.size(); i++){
+			stop(workers_[i]);
+		}
+		signal(SIGPIPE, previous);
+		root.gatherResults();
+	}
+
+	/**
+	 *
+	 * \brief Number of worker processes started by the last execution,
+	 * including the replacements.
+	 *
+	 */
+	unsigned getSpawned(){return spawned_;};
+
+	/**
+	 *
+	 * \brief Number of workers that ended within a job.
+	 *
+	 */
+	unsigned getLost(){return lost_;};
+
+protected:
+	struct Worker {
+		pid_t  pid     = -1;
+		int    command = -1; // job indices to the worker
+		int    result  = -1; // results from the worker
+		int    job     = -1; // executed job, -1 if idle
+		string buffer;       // a result received partly
+	};
+
+	unsigned alive(){
+		unsigned n = 0;
+		for(size_t i = 0; i < workers_.size(); i++){
+			n += (workers_[i].pid >= 0) ? 1 : 0;
+		}
+		return n;
+	}
+
+	bool spawn(Worker &w){
+		int command[2], result[2];
+		if(pipe(command) != 0){
+			return false;
+		}
+		if(pipe(result) != 0){
+			close(command[0]);
+			close(command[1]);
+			return false;
+		}
+		pid_t pid = run_.fork();
+		if(pid < 0){
+			close(command[0]);
+			close(command[1]);
+			close(result[0]);
+			close(result[1]);
+			return false;
+		}
+		if(pid == 0){
+			// a worker keeps the pipes of the others open otherwise
+			for(size_t i = 0; i < workers_.size(); i++){
+				if(workers_[i].pid >= 0){
+					close(workers_[i].command);
+					close(workers_[i].result);
+				}
+			}
+			close(command[1]);
+			close(result[0]);
+			serve(command[0], result[1]);
+		}
+		close(command[0]);
+		close(result[1]);
+		w         = Worker();
+		w.pid     = pid;
+		w.command = command[1];
+		w.result  = result[0];
+		spawned_++;
+		return true;
+	}
+
+	/**
+	 *
+	 * \brief Loop of a worker, it never returns.
+	 *
+	 */
+	void serve(int command, int result){
+		run_.setWorker(result);
+		uint32_t job;
+		while(readAll(command, &job, sizeof(job)) && (job < jobs_.size())){
+			TestItem *item = jobs_[job];
+			item->setEnclosingFixture(nullptr);
+			item->setDeadline(testClock::time_point());
+			try{
+				item->testExecution();
+			}catch(...){
+				// the state of the suites is lost with the exception
+				cout.flush();
+				_exit(1);
+			}
+			cout.flush();
+			run_.sendResult('J', job, TEST_PASSED, string(""));
+		}
+		cout.flush();
+		_exit(0);
+	}
+
+	void dispatch(Worker &w, size_t job){
+		uint32_t j = job;
+		w.job = job;
+		ssize_t n;
+		while(((n = write(w.command, &j, sizeof(j))) < 0) && (errno == EINTR)){
+		}
+		if(n != sizeof(j)){
+			lost(w);
+		}
+	}
+
+	/**
+	 *
+	 * \brief Reads the results available, false if the worker has ended.
+	 *
+	 */
+	bool receive(Worker &w){
+		char data[4096];
+		ssize_t n = read(w.result, data, sizeof(data));
+		if(n < 0){
+			return (errno == EINTR) || (errno == EAGAIN);
+		}
+		if(n == 0){
+			return false;
+		}
+		w.buffer.append(data, n);
+		while(w.buffer.size() >= 10){
+			int32_t  index;
+			uint32_t length;
+			memcpy(&index, w.buffer.data() + 2, 4);
+			memcpy(&length, w.buffer.data() + 6, 4);
+			if(w.buffer.size() < 10 + length){
+				break;
+			}
+			char kind = w.buffer[0];
+			TestStatus status = (TestStatus) w.buffer[1];
+			if(kind == 'J'){
+				w.job = -1;
+			}else if((index >= 0) && ((size_t) index < items_.size())){
+				items_[index]->takeResult(status, w.buffer.substr(10, length));
+				reported_[index] = true;
+				if((kind == 'C') && (status == TEST_SKIPPED)){
+					run_.addSkipped();
+				}
+			}
+			w.buffer.erase(0, 10 + length);
+		}
+		return true;
+	}
+
+	/**
+	 *
+	 * \brief The worker ended within its job: the job is given up and the
+	 * worker is replaced when the next job is dispatched.
+	 *
+	 */
+	void lost(Worker &w){
+		int status = 0;
+		close(w.command);
+		close(w.result);
+		while((waitpid(w.pid, &status, 0) < 0) && (errno == EINTR)){
+		}
+		if(w.job >= 0){
+			string reason = WIFSIGNALED(status) ? (string("signal ") + to_string(WTERMSIG(status))) :
+							(string("exit status ") + to_string(WEXITSTATUS(status)));
+			lose(w.job, string("worker ended with ") + reason);
+			lost_++;
+		}
+		w = Worker();
+	}
+
+	/**
+	 *
+	 * \brief The selected test cases of the job without result failed.
+	 *
+	 */
+	void lose(size_t job, const string &reason){
+		TestItem *item = jobs_[job];
+		cerr << endl << "TestPool: " << item->getName() << ": " << reason << endl;
+		for(int i = item->getIndex(); i <= item->getLastIndex(); i++){
+			TestCase *tc = dynamic_cast<TestCase*>(items_[i]);
+			if((tc != nullptr) && !reported_[i]){
+				tc->markFailed();
+			}
+		}
+	}
+
+	void stop(Worker &w){
+		if(w.pid < 0){
+			return;
+		}
+		close(w.command);
+		close(w.result);
+		while((waitpid(w.pid, nullptr, 0) < 0) && (errno == EINTR)){
+		}
+		w = Worker();
+	}
+
+	static bool readAll(int fd, void *data, size_t size){
+		size_t done = 0;
+		while(done < size){
+			ssize_t n = read(fd, (char*) data + done, size - done);
+			if(n < 0){
+				if(errno == EINTR){
+					continue;
+				}
+				return false;
+			}
+			if(n == 0){
+				return false;
+			}
+			done += n;
+		}
+		return true;
+	}
+
+	TestRun           &run_;
+	vector<TestItem*>  items_;
+	vector<TestItem*>  jobs_;
+	vector<bool>       reported_;
+	vector<Worker>     workers_;
+	unsigned           spawned_ = 0;
+	unsigned           lost_    = 0;
+};
+
 /**
  *
  * \brief Implements the unit test class.
@@ -578,17 +2167,79 @@ public:
 	 *
 	 *
 	 * \param fileName string represents the file name where the summary of all tests in the
-	 * unit test is stored in xml-format.
+	 * unit test is stored in xml-format (behind the prefix of the TestRun).
+	 * Nothing is written if no test case has been executed.
 	 *
 	 *
 	 */
 	void writeResultsToFile(string fileName){
-		std::ofstream file(fileName);
+		// nothing selected or listed only
+		if(!executed_){
+			return;
+		}
+		std::ofstream file(TestRun::instance().getXmlPrefix() + fileName);
 		file <<  toXmlStr();
 		file.close();
 		return;
 	}
 
+	/**
+	 *
+	 * \brief Executes the test suites (on a TestPool with more than one job
+	 * of the TestRun). Instrumented builds keep the counts of the
+	 * instrumented API calls made by them (<ApiCall .../> elements).
+	 *
+	 */
+	virtual void testExecution(){
+		TestRun &run = TestRun::instance();
+		if(run.isTopLevel()){
+			run.beginUnit(name_);
+			probe(run);
+			if((run.getJobs() > 1) && !run.isListing()){
+#ifdef MEX_INSTRUMENT
+				apiCalls_.clear();
+#endif
+				TestPool pool(run);
+				pool.execute(*this);
+				return;
+			}
+		}
+#ifdef MEX_INSTRUMENT
+		Instrument::resetSites();
+		TestSuite::testExecution();
+		apiCalls_ = Instrument::sitesToXml();
+#else
+		TestSuite::testExecution();
+#endif
+	};
+
+protected:
+
+	/**
+	 *
+	 * \brief Probes the resources of the selected test items once before
+	 * they are executed (workers of a TestPool keep the outcome of the
+	 * probes of the unit).
+	 *
+	 */
+	void probe(TestRun &run){
+		if(run.isWorker() || run.isListing()){
+			return;
+		}
+		run.clearProbes();
+		vector<string> resources;
+		countSelected();
+		collectResources(resources);
+		for(size_t i = 0; i < resources.size(); i++){
+			run.unavailable(resources[i]);
+		}
+	}
+
+#ifdef MEX_INSTRUMENT
+	virtual string toXmlTail(){return apiCalls_;};
+
+	string apiCalls_;
+#endif
 };
 
 
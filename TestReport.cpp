@@ -0,0 +1,371 @@
+//============================================================================
+// Name        : TestReport.cpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : TestReport source file. It contains the definition of the
+//               functions of the TestReport class and the reader of the XML
+//               written by the SimplUnitTestFW.
+//============================================================================
+#include "TestReport.hpp"
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+
+
+/*
+ * A tag of the results: name, attributes in their order, the text up to
+ * the next tag.
+ */
+struct TestReportTag {
+	string                         name;
+	vector<pair<string, string> >  attributes;
+	bool                           closing     = false;
+	bool                           selfClosing = false;
+	string                         text;
+
+	string get(const string &key) const {
+		for(size_t i = 0; i < attributes.size(); i++){
+			if(attributes[i].first == key){
+				return attributes[i].second;
+			}
+		}
+		return string("");
+	}
+};
+
+static vector<TestReportTag> readTags(const string &xml){
+	vector<TestReportTag> tags;
+	size_t pos = xml.find('<');
+	while(pos != string::npos){
+		size_t end = pos + 1;
+		// '>' within quoted values does not end the tag
+		bool quoted = false;
+		while((end < xml.size()) && (quoted || (xml[end] != '>'))){
+			if(xml[end] == '"'){
+				quoted = !quoted;
+			}
+			end++;
+		}
+		if(end >= xml.size()){
+			throw new ExceptionTestReport(string("readTags:: unterminated tag at ") + to_string(pos));
+		}
+
+		string body = xml.substr(pos + 1, end - pos - 1);
+		TestReportTag tag;
+		if(!body.empty() && (body[0] == '/')){
+			tag.closing = true;
+			body = body.substr(1);
+		}
+		if(!body.empty() && (body[body.size() - 1] == '/')){
+			tag.selfClosing = true;
+			body = body.substr(0, body.size() - 1);
+		}
+		size_t i = body.find_first_of(" \t\r\n");
+		tag.name = body.substr(0, i);
+		while(i != string::npos){
+			i = body.find_first_not_of(" \t\r\n", i);
+			if(i == string::npos){
+				break;
+			}
+			size_t eq = body.find('=', i);
+			if((eq == string::npos) || (eq + 1 >= body.size()) || (body[eq + 1] != '"')){
+				throw new ExceptionTestReport(string("readTags:: malformed attribute in <") + tag.name + ">");
+			}
+			size_t close = body.find('"', eq + 2);
+			if(close == string::npos){
+				throw new ExceptionTestReport(string("readTags:: unterminated value in <") + tag.name + ">");
+			}
+			tag.attributes.push_back(make_pair(body.substr(i, eq - i), body.substr(eq + 2, close - eq - 2)));
+			i = close + 1;
+		}
+
+		size_t next = xml.find('<', end + 1);
+		tag.text = xml.substr(end + 1, ((next == string::npos) ? xml.size() : next) - end - 1);
+		tags.push_back(tag);
+		pos = next;
+	}
+	return tags;
+}
+
+
+/*
+ * A suite of the input being read and the names of its items seen so
+ * far, the occurrence tells apart items of the same name.
+ */
+struct TestReportOpen {
+	TestReportSuite          *suite;
+	map<string, unsigned>     cases;
+	map<string, unsigned>     suites;
+};
+
+void TestReport::addXml(const string &xml){
+	vector<TestReportTag> tags = readTags(xml);
+	TestReportUnit         *u = nullptr;
+	vector<TestReportOpen>  open;
+	for(size_t i = 0; i < tags.size(); i++){
+		const TestReportTag &t = tags[i];
+		if(t.name == "UnitTest"){
+			if(t.closing){
+				if((u == nullptr) || (open.size() != 1)){
+					throw new ExceptionTestReport(string("addXml:: unbalanced UnitTest."));
+				}
+				u = nullptr;
+				open.clear();
+			}else{
+				if(u != nullptr){
+					throw new ExceptionTestReport(string("addXml:: UnitTest within a UnitTest."));
+				}
+				u = &unit(t.get("name"));
+				if(u->executionTime.empty()){
+					u->executionTime = t.get("executionTime");
+				}
+				if(u->root.fixtureError.empty()){
+					u->root.fixtureError = t.get("fixtureError");
+				}
+				open.push_back(TestReportOpen());
+				open.back().suite = &u->root;
+			}
+		}else if(t.name == "TestSuite"){
+			if(u == nullptr){
+				throw new ExceptionTestReport(string("addXml:: TestSuite outside of a UnitTest."));
+			}
+			if(t.closing){
+				if(open.size() < 2){
+					throw new ExceptionTestReport(string("addXml:: unbalanced TestSuite."));
+				}
+				open.pop_back();
+			}else{
+				string name = t.get("name");
+				TestReportSuite &s = suite(*open.back().suite, name, open.back().suites[name]++);
+				if(s.fixtureError.empty()){
+					s.fixtureError = t.get("fixtureError");
+				}
+				if(!t.selfClosing){
+					open.push_back(TestReportOpen());
+					open.back().suite = &s;
+				}
+			}
+		}else if((t.name == "TestCase") && !t.closing){
+			if(u == nullptr){
+				throw new ExceptionTestReport(string("addXml:: TestCase outside of a UnitTest."));
+			}
+			if((t.text != "PASSED") && (t.text != "FAILED") && (t.text != "TIMEOUT") &&
+					(t.text != "SKIPPED")){
+				throw new ExceptionTestReport(string("addXml:: TestCase ") + t.get("name") + " without result.");
+			}
+			TestReportCase c;
+			c.name   = t.get("name");
+			c.passed   = (t.text == "PASSED") || (t.text == "SKIPPED");
+			c.timedOut = (t.text == "TIMEOUT");
+			c.skipped  = (t.text == "SKIPPED");
+			for(size_t a = 0; a < t.attributes.size(); a++){
+				if(t.attributes[a].first != "name"){
+					c.attributes += " " + t.attributes[a].first + "=\"" + t.attributes[a].second + "\"";
+				}
+			}
+			addCase(*open.back().suite, c, open.back().cases[c.name]++);
+		}else if((t.name == "ApiCall") && (u != nullptr)){
+			TestReportApiCall *call = nullptr;
+			for(size_t a = 0; a < u->apiCalls.size(); a++){
+				if(u->apiCalls[a].name == t.get("name")){
+					call = &u->apiCalls[a];
+				}
+			}
+			if(call == nullptr){
+				u->apiCalls.push_back(TestReportApiCall());
+				call = &u->apiCalls.back();
+				call->name = t.get("name");
+			}
+			call->calls      += strtoull(t.get("calls").c_str(), nullptr, 10);
+			call->allocs     += strtoull(t.get("allocs").c_str(), nullptr, 10);
+			call->allocBytes += strtoull(t.get("allocBytes").c_str(), nullptr, 10);
+			call->syscalls   += strtoull(t.get("syscalls").c_str(), nullptr, 10);
+		}
+	}
+	if(u != nullptr){
+		throw new ExceptionTestReport(string("addXml:: truncated results."));
+	}
+}
+
+void TestReport::addFile(const string &filename){
+	ifstream in(filename.c_str());
+	if(!in.is_open()){
+		throw new ExceptionTestReport(string("addFile:: cannot read ") + filename);
+	}
+	stringstream ss;
+	ss << in.rdbuf();
+	try{
+		addXml(ss.str());
+	}catch(IException *e){
+		string msg = filename + ": " + e->getMsg();
+		delete e;
+		throw new ExceptionTestReport(string("addFile:: ") + msg);
+	}
+}
+
+TestReportUnit& TestReport::unit(const string &name){
+	for(size_t i = 0; i < units_.size(); i++){
+		if(units_[i].name == name){
+			return units_[i];
+		}
+	}
+	units_.push_back(TestReportUnit());
+	units_.back().name = name;
+	return units_.back();
+}
+
+TestReportSuite& TestReport::suite(TestReportSuite &parent, const string &name, unsigned occurrence){
+	for(size_t i = 0; i < parent.suites.size(); i++){
+		if((parent.suites[i].name == name) && (occurrence-- == 0)){
+			return parent.suites[i];
+		}
+	}
+	parent.items.push_back(make_pair('S', parent.suites.size()));
+	parent.suites.push_back(TestReportSuite());
+	parent.suites.back().name = name;
+	return parent.suites.back();
+}
+
+void TestReport::addCase(TestReportSuite &s, const TestReportCase &c, unsigned occurrence){
+	for(size_t i = 0; i < s.cases.size(); i++){
+		if((s.cases[i].name == c.name) && (occurrence-- == 0)){
+			if(rank(c) > rank(s.cases[i])){
+				s.cases[i] = c;
+			}
+			return;
+		}
+	}
+	s.items.push_back(make_pair('C', s.cases.size()));
+	s.cases.push_back(c);
+}
+
+int TestReport::rank(const TestReportCase &c){
+	if(c.timedOut){
+		return 3;
+	}
+	if(!c.passed){
+		return 2;
+	}
+	return c.skipped ? 0 : 1;
+}
+
+void TestReport::count(const TestReportSuite &s, unsigned &cases, unsigned &failed, unsigned &timeouts,
+					   unsigned &skipped){
+	for(size_t c = 0; c < s.cases.size(); c++){
+		cases++;
+		failed   += s.cases[c].passed ? 0 : 1;
+		timeouts += s.cases[c].timedOut ? 1 : 0;
+		skipped  += s.cases[c].skipped ? 1 : 0;
+	}
+	for(size_t i = 0; i < s.suites.size(); i++){
+		count(s.suites[i], cases, failed, timeouts, skipped);
+	}
+}
+
+unsigned TestReport::getCaseCount(){
+	unsigned cases = 0, failed = 0, timeouts = 0, skipped = 0;
+	for(size_t u = 0; u < units_.size(); u++){
+		count(units_[u].root, cases, failed, timeouts, skipped);
+	}
+	return cases;
+}
+
+unsigned TestReport::getFailedCount(){
+	unsigned cases = 0, failed = 0, timeouts = 0, skipped = 0;
+	for(size_t u = 0; u < units_.size(); u++){
+		count(units_[u].root, cases, failed, timeouts, skipped);
+	}
+	return failed;
+}
+
+unsigned TestReport::getTimeoutCount(){
+	unsigned cases = 0, failed = 0, timeouts = 0, skipped = 0;
+	for(size_t u = 0; u < units_.size(); u++){
+		count(units_[u].root, cases, failed, timeouts, skipped);
+	}
+	return timeouts;
+}
+
+unsigned TestReport::getSkippedCount(){
+	unsigned cases = 0, failed = 0, timeouts = 0, skipped = 0;
+	for(size_t u = 0; u < units_.size(); u++){
+		count(units_[u].root, cases, failed, timeouts, skipped);
+	}
+	return skipped;
+}
+
+bool TestReport::suitePassed(const TestReportSuite &s){
+	if(!s.fixtureError.empty()){
+		return false;
+	}
+	for(size_t c = 0; c < s.cases.size(); c++){
+		if(!s.cases[c].passed){
+			return false;
+		}
+	}
+	for(size_t i = 0; i < s.suites.size(); i++){
+		if(!suitePassed(s.suites[i])){
+			return false;
+		}
+	}
+	return true;
+}
+
+string TestReport::itemsToXml(const TestReportSuite &s){
+	stringstream ss;
+	for(size_t i = 0; i < s.items.size(); i++){
+		if(s.items[i].first == 'C'){
+			const TestReportCase &c = s.cases[s.items[i].second];
+			ss << "<TestCase name=\"" << c.name << "\"" << c.attributes << ">"
+			   << (c.skipped ? "SKIPPED" : (c.passed ? "PASSED" : (c.timedOut ? "TIMEOUT" : "FAILED"))) << "</TestCase>";
+		}else{
+			const TestReportSuite &suite = s.suites[s.items[i].second];
+			ss << "<TestSuite name=\"" << suite.name << "\" status=\"" << (suitePassed(suite) ? "PASSED" : "FAILED") << "\"";
+			if(!suite.fixtureError.empty()){
+				ss << " fixtureError=\"" << suite.fixtureError << "\"";
+			}
+			ss << ">" << itemsToXml(suite) << "</TestSuite>";
+		}
+	}
+	return ss.str();
+}
+
+string TestReport::unitToXml(const TestReportUnit &u){
+	stringstream ss;
+	ss << "<UnitTest name=\"" << u.name << "\" status=\"" << (suitePassed(u.root) ? "PASSED" : "FAILED") << "\"";
+	if(!u.executionTime.empty()){
+		ss << " executionTime=\"" << u.executionTime << "\"";
+	}
+	if(!u.root.fixtureError.empty()){
+		ss << " fixtureError=\"" << u.root.fixtureError << "\"";
+	}
+	ss << ">" << itemsToXml(u.root);
+	for(size_t a = 0; a < u.apiCalls.size(); a++){
+		const TestReportApiCall &call = u.apiCalls[a];
+		ss << "<ApiCall name=\"" << call.name << "\" calls=\"" << call.calls << "\" allocs=\"" << call.allocs
+		   << "\" allocBytes=\"" << call.allocBytes << "\" syscalls=\"" << call.syscalls << "\"/>";
+	}
+	ss << "</UnitTest>";
+	return ss.str();
+}
+
+string TestReport::toXml(){
+	if(units_.size() == 1){
+		return unitToXml(units_[0]);
+	}
+	stringstream ss;
+	ss << "<TestReport status=\"" << (getResult() ? "PASSED" : "FAILED") << "\" units=\"" << units_.size()
+	   << "\" cases=\"" << getCaseCount() << "\" failed=\"" << getFailedCount() << "\"";
+	if(getTimeoutCount() > 0){
+		ss << " timeouts=\"" << getTimeoutCount() << "\"";
+	}
+	if(getSkippedCount() > 0){
+		ss << " skipped=\"" << getSkippedCount() << "\"";
+	}
+	ss << ">";
+	for(size_t u = 0; u < units_.size(); u++){
+		ss << unitToXml(units_[u]);
+	}
+	ss << "</TestReport>";
+	return ss.str();
+}
@@ -0,0 +1,140 @@
+//============================================================================
+// Name        : TestReport.hpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : TestReport header file. It contains the merge of the XML
+//               results of the SimplUnitTestFW, e.g. of the shards of a
+//               run (unitTest --shard=I/N) on several processes or
+//               machines, into one report.
+//============================================================================
+#ifndef TESTREPORT_HPP_INCLUDED
+#define TESTREPORT_HPP_INCLUDED
+
+#include "SerialCom.hpp"
+#include <string>
+#include <vector>
+#include <map>
+
+using namespace std;
+
+
+struct TestReportCase {
+	string name;
+	string attributes; /**< further attributes, e.g. the counts of instrumented builds */
+	bool   passed   = false;
+	bool   timedOut = false; /**< TIMEOUT, counted as failed */
+	bool   skipped  = false; /**< SKIPPED, counted as passed */
+};
+
+struct TestReportSuite {
+	string                  name;
+	string                  fixtureError;
+	vector<TestReportCase>  cases;
+	vector<TestReportSuite> suites; /**< nested suites */
+	vector<pair<char, size_t> > items; /**< 'C' case or 'S' suite and its index, in order */
+};
+
+/**
+ * \brief Counts of an instrumented API call, summed over the inputs.
+ */
+struct TestReportApiCall {
+	string             name;
+	unsigned long long calls      = 0;
+	unsigned long long allocs     = 0;
+	unsigned long long allocBytes = 0;
+	unsigned long long syscalls   = 0;
+};
+
+struct TestReportUnit {
+	string                    name;
+	string                    executionTime; /**< of the first input */
+	TestReportSuite           root;          /**< suites and test cases of the unit */
+	vector<TestReportApiCall> apiCalls;
+};
+
+
+/**
+ *
+ * \class TestReport
+ *
+ * \brief Units, suites and test cases are merged by their path in the
+ * order they appear first; items of the same name under one suite are
+ * told apart by their occurrence. A test case found in several inputs counts once;
+ * it passed only if it passed in all of them (a timeout outweighs a
+ * failure) and is skipped only if it was skipped in all of them. The status of the suites
+ * and units is derived from the merged test cases.
+ *
+ */
+class TestReport {
+public:
+
+	/**
+	 *
+	 * \brief Adds the content of a result file (UnitTest elements, also
+	 * within a TestReport element). If the content is malformed an
+	 * exception (IException) is thrown.
+	 *
+	 */
+	void addXml(const string &xml);
+
+	/**
+	 *
+	 * \brief Adds a result file. If it cannot be read or is malformed an
+	 * exception (IException) is thrown.
+	 *
+	 */
+	void addFile(const string &filename);
+
+	/**
+	 *
+	 * \brief One UnitTest element if the report contains a single unit,
+	 * otherwise a TestReport element with the units and the counts.
+	 *
+	 */
+	string toXml();
+
+	unsigned getUnitCount(){return units_.size();};
+	unsigned getCaseCount();
+	unsigned getFailedCount();
+	unsigned getTimeoutCount();
+	unsigned getSkippedCount();
+	bool     getResult(){return getFailedCount() == 0;};
+
+	const vector<TestReportUnit>& getUnits(){return units_;};
+
+protected:
+	TestReportUnit&  unit(const string &name);
+	TestReportSuite& suite(TestReportSuite &parent, const string &name, unsigned occurrence);
+	void             addCase(TestReportSuite &s, const TestReportCase &c, unsigned occurrence);
+
+	static int    rank(const TestReportCase &c);
+	static void   count(const TestReportSuite &s, unsigned &cases, unsigned &failed, unsigned &timeouts,
+						unsigned &skipped);
+	static bool   suitePassed(const TestReportSuite &s);
+	static string itemsToXml(const TestReportSuite &s);
+	static string unitToXml(const TestReportUnit &u);
+
+	vector<TestReportUnit> units_;
+};
+
+
+/**
+ *
+ * \class ExceptionTestReport
+ *
+ * \brief Exception class of TestReport.
+ *
+ */
+class ExceptionTestReport : public IException{
+	public:
+		ExceptionTestReport(string msg){
+			msg_ = string("ExceptionTestReport::") + msg;
+		};
+		string getMsg(){return msg_;};
+	protected:
+		string msg_;
+	private:
+		ExceptionTestReport(){};
+};
+
+#endif // TESTREPORT_HPP_INCLUDED
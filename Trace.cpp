@@ -0,0 +1,163 @@
+//============================================================================
+// Name        : Trace.cpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : Trace source file. It contains the definition of the
+//               functions of the Tracer and TraceSpan classes.
+//============================================================================
+#include "Trace.hpp"
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <unistd.h>
+
+
+std::atomic<bool> Tracer::enabled_{false};
+
+// all buffers ever created, a thread registers its buffer once
+static std::mutex                 traceMutex;
+static std::vector<TraceBuffer*>  traceBuffers;
+static thread_local TraceBuffer  *traceLocal = nullptr;
+static thread_local unsigned long long traceCurrentId = 0;
+static std::atomic<unsigned long long> traceNextId{0};
+
+
+unsigned long long Tracer::nowNs(){
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+TraceBuffer* Tracer::local(){
+	if(traceLocal == nullptr){
+		std::lock_guard<std::mutex> lock(traceMutex);
+		traceLocal = new TraceBuffer(traceBuffers.size() + 1);
+		traceBuffers.push_back(traceLocal);
+	}
+	return traceLocal;
+}
+
+void Tracer::record(const TraceEvent &e){
+	local()->push(e);
+}
+
+unsigned long long Tracer::currentId(){
+	return traceCurrentId;
+}
+
+void Tracer::clear(){
+	std::lock_guard<std::mutex> lock(traceMutex);
+	for(size_t i = 0; i < traceBuffers.size(); i++){
+		traceBuffers[i]->clear();
+	}
+}
+
+unsigned long Tracer::getEventCount(){
+	std::lock_guard<std::mutex> lock(traceMutex);
+	unsigned long n = 0;
+	for(size_t i = 0; i < traceBuffers.size(); i++){
+		n += traceBuffers[i]->getCount();
+	}
+	return n;
+}
+
+unsigned long Tracer::getDropped(){
+	std::lock_guard<std::mutex> lock(traceMutex);
+	unsigned long n = 0;
+	for(size_t i = 0; i < traceBuffers.size(); i++){
+		n += traceBuffers[i]->getDropped();
+	}
+	return n;
+}
+
+vector<TraceEvent> Tracer::snapshot(){
+	std::lock_guard<std::mutex> lock(traceMutex);
+	vector<TraceEvent> events;
+	for(size_t b = 0; b < traceBuffers.size(); b++){
+		unsigned n = traceBuffers[b]->getCount();
+		for(unsigned i = 0; i < n; i++){
+			events.push_back(traceBuffers[b]->get(i));
+		}
+	}
+	return events;
+}
+
+void Tracer::writeChromeJson(ostream &out){
+	std::lock_guard<std::mutex> lock(traceMutex);
+
+	// times relative to the first span keep the numbers short
+	unsigned long long epochNs = ~0ULL;
+	for(size_t b = 0; b < traceBuffers.size(); b++){
+		unsigned n = traceBuffers[b]->getCount();
+		for(unsigned i = 0; i < n; i++){
+			if(traceBuffers[b]->get(i).startNs < epochNs){
+				epochNs = traceBuffers[b]->get(i).startNs;
+			}
+		}
+	}
+
+	int pid = getpid();
+	bool first = true;
+	out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+	out << fixed << setprecision(3);
+	for(size_t b = 0; b < traceBuffers.size(); b++){
+		const TraceBuffer &buffer = *traceBuffers[b];
+		unsigned n = buffer.getCount();
+		for(unsigned i = 0; i < n; i++){
+			const TraceEvent &e = buffer.get(i);
+			out << (first ? "\n" : ",\n");
+			first = false;
+			out << "{\"name\":\"" << e.name << "\",\"cat\":\"mex\",\"ph\":\"X\""
+				<< ",\"ts\":" << ((e.startNs - epochNs) / 1000.0)
+				<< ",\"dur\":" << (e.durNs / 1000.0)
+				<< ",\"pid\":" << pid << ",\"tid\":" << e.tid
+				<< ",\"args\":{\"id\":" << e.id << ",\"arg\":" << e.arg << "}}";
+		}
+	}
+	out << "\n]}" << endl;
+}
+
+void Tracer::writeChromeJson(const string &filename){
+	ofstream out(filename.c_str());
+	if(!out){
+		throw new ExceptionTrace(string("writeChromeJson: cannot open '") + filename + string("'."));
+	}
+	writeChromeJson(out);
+	if(!out){
+		throw new ExceptionTrace(string("writeChromeJson: cannot write '") + filename + string("'."));
+	}
+}
+
+
+
+TraceSpan::TraceSpan(const char *name, long arg){
+	name_ = name;
+	arg_  = arg;
+	if(!Tracer::isEnabled()){
+		return;
+	}
+	active_ = true;
+	if(traceCurrentId == 0){
+		traceCurrentId = ++traceNextId;
+		root_ = true;
+	}
+	id_ = traceCurrentId;
+	startNs_ = Tracer::nowNs();
+}
+
+TraceSpan::~TraceSpan(){
+	if(!active_){
+		return;
+	}
+	TraceEvent e;
+	e.name    = name_;
+	e.startNs = startNs_;
+	e.durNs   = Tracer::nowNs() - startNs_;
+	e.id      = id_;
+	e.arg     = arg_;
+	Tracer::record(e);
+	if(root_){
+		traceCurrentId = 0;
+	}
+}
@@ -0,0 +1,207 @@
+//============================================================================
+// Name        : Trace.hpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : Trace header file. It contains scoped trace spans with
+//               correlation ids, recorded into per thread buffers and
+//               exported as Chrome trace JSON (chrome://tracing, Perfetto).
+//============================================================================
+#ifndef TRACE_HPP_INCLUDED
+#define TRACE_HPP_INCLUDED
+
+#include "SerialCom.hpp"
+#include <string>
+#include <ostream>
+#include <atomic>
+#include <vector>
+
+using namespace std;
+
+
+/**
+ * \brief Number of spans a thread can record until Tracer::clear().
+ * Further spans are dropped and counted.
+ */
+#define MEX_TRACE_CAPACITY 16384
+
+
+/**
+ * \brief One finished span, times in nano seconds of the steady clock.
+ */
+struct TraceEvent {
+	const char        *name;    /**< static string, e.g. "Pololu::setPosition" */
+	unsigned long long startNs;
+	unsigned long long durNs;
+	unsigned long long id;      /**< correlation id of the outermost span */
+	long               arg;     /**< e.g. servo or number of bytes */
+	unsigned           tid;     /**< thread, set by the buffer */
+};
+
+
+/**
+ *
+ * \class TraceBuffer
+ *
+ * \brief Spans of one thread. Only the owning thread writes, an event is
+ * published by the release store of the count, so readers (export) need
+ * no lock.
+ *
+ */
+class TraceBuffer {
+public:
+	TraceBuffer(unsigned tid) : tid_(tid){};
+
+	void push(const TraceEvent &e){
+		unsigned n = count_.load(std::memory_order_relaxed);
+		if(n >= MEX_TRACE_CAPACITY){
+			dropped_.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		events_[n] = e;
+		events_[n].tid = tid_;
+		count_.store(n + 1, std::memory_order_release);
+	}
+
+	unsigned getCount() const {return count_.load(std::memory_order_acquire);};
+	const TraceEvent& get(unsigned i) const {return events_[i];};
+	unsigned getTid() const {return tid_;};
+	unsigned long getDropped() const {return dropped_.load(std::memory_order_relaxed);};
+	void clear(){count_.store(0, std::memory_order_release); dropped_.store(0, std::memory_order_relaxed);};
+
+protected:
+	TraceEvent                 events_[MEX_TRACE_CAPACITY];
+	std::atomic<unsigned>      count_{0};
+	std::atomic<unsigned long> dropped_{0};
+	unsigned                   tid_;
+};
+
+
+/**
+ *
+ * \class Tracer
+ *
+ * \brief Collects the spans of all threads. Recording is off until
+ * setEnabled(true); each thread gets its buffer with its first span.
+ * The buffers are kept after the thread ended, so the export covers
+ * all threads.
+ *
+ */
+class Tracer {
+public:
+
+	static void setEnabled(bool enabled){enabled_.store(enabled, std::memory_order_relaxed);};
+	static bool isEnabled(){return enabled_.load(std::memory_order_relaxed);};
+
+	/**
+	 * \brief Nano seconds of the steady clock.
+	 */
+	static unsigned long long nowNs();
+
+	/**
+	 * \brief Records a finished span in the buffer of the calling thread.
+	 */
+	static void record(const TraceEvent &e);
+
+	/**
+	 * \brief Correlation id of the span the calling thread is in, 0 if none.
+	 */
+	static unsigned long long currentId();
+
+	/**
+	 *
+	 * \brief Writes the spans of all threads as Chrome trace JSON
+	 * ("X" events, times in micro seconds since the first span). The
+	 * correlation id and the argument are given in "args".
+	 *
+	 */
+	static void writeChromeJson(ostream &out);
+
+	/**
+	 *
+	 * \brief Writes the Chrome trace JSON to a file. If the file cannot
+	 * be written an exception (IException) is thrown.
+	 *
+	 */
+	static void writeChromeJson(const string &filename);
+
+	/**
+	 * \brief Discards all spans. No thread may record at the same time.
+	 */
+	static void clear();
+
+	/**
+	 * \brief Copies the spans of all threads, e.g. for tests.
+	 */
+	static vector<TraceEvent> snapshot();
+
+	static unsigned long getEventCount();
+	static unsigned long getDropped();
+
+protected:
+	friend class TraceSpan;
+
+	static TraceBuffer* local();
+
+	static std::atomic<bool> enabled_;
+};
+
+
+/**
+ *
+ * \class TraceSpan
+ *
+ * \brief Scoped span: measures from construction to destruction. The
+ * outermost span of a thread draws a new correlation id, nested spans
+ * (e.g. Pololu and SerialCom calls below a ServoMotor call) inherit it.
+ * Use the MEX_TRACE_SPAN macros, they vanish unless MEX_TRACE is defined.
+ *
+ */
+class TraceSpan {
+public:
+	TraceSpan(const char *name, long arg = 0);
+	~TraceSpan();
+
+	unsigned long long getId(){return id_;};
+
+protected:
+	const char        *name_;
+	long               arg_;
+	unsigned long long startNs_ = 0;
+	unsigned long long id_      = 0;
+	bool               root_    = false;
+	bool               active_  = false;
+};
+
+
+/**
+ *
+ * \class ExceptionTrace
+ *
+ * \brief Exception class of the Tracer.
+ *
+ */
+class ExceptionTrace : public IException{
+	public:
+		ExceptionTrace(string msg){
+			msg_ = string("ExceptionTrace::") + msg;
+		};
+		string getMsg(){return msg_;};
+	protected:
+		string msg_;
+	private:
+		ExceptionTrace(){};
+};
+
+
+#define MEX_TRACE_CONCAT2(a, b) a##b
+#define MEX_TRACE_CONCAT(a, b) MEX_TRACE_CONCAT2(a, b)
+
+#ifdef MEX_TRACE
+	#define MEX_TRACE_SPAN(name)          TraceSpan MEX_TRACE_CONCAT(mexTraceSpan, __LINE__)(name)
+	#define MEX_TRACE_SPAN_ARG(name, arg) TraceSpan MEX_TRACE_CONCAT(mexTraceSpan, __LINE__)(name, (long) (arg))
+#else
+	#define MEX_TRACE_SPAN(name)
+	#define MEX_TRACE_SPAN_ARG(name, arg)
+#endif
+
+#endif // TRACE_HPP_INCLUDED
@@ -0,0 +1,72 @@
+//============================================================================
+// Name        : Crc7Bench.cpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : Benchmark of the CRC-7 of the Maestro commands. It compares
+//               the lookup table with the bit wise reference and measures
+//               the cost of encoding commands with and without CRC byte.
+//
+//               usage: crc7Bench [megabytes]
+//============================================================================
+#include "../PololuFrames.hpp"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+
+using namespace std;
+
+typedef std::chrono::steady_clock benchClock;
+
+
+static double elapsedS(benchClock::time_point start){
+	return std::chrono::duration_cast<std::chrono::duration<double> >(benchClock::now() - start).count();
+}
+
+int main(int argc, char* argv[]){
+	unsigned megabytes = (argc > 1) ? atoi(argv[1]) : 16;
+	unsigned long size = megabytes * 1024UL * 1024UL;
+
+	vector<unsigned char> data(size);
+	for(unsigned long i = 0; i < size; i++){
+		data[i] = (unsigned char) (i * 131 + 7);
+	}
+
+	cout << fixed << setprecision(1);
+
+	// throughput over a large buffer
+	benchClock::time_point start = benchClock::now();
+	unsigned char crcTable = pololuCrc7(&data[0], size);
+	double tTable = elapsedS(start);
+
+	start = benchClock::now();
+	unsigned char crcBitwise = pololuCrc7Bitwise(&data[0], size);
+	double tBitwise = elapsedS(start);
+
+	if(crcTable != crcBitwise){
+		cout << "CRC mismatch: " << (int) crcTable << " != " << (int) crcBitwise << endl;
+		return 1;
+	}
+	cout << setw(24) << left << "table" << setw(12) << right << (megabytes / tTable) << " MB/s" << endl;
+	cout << setw(24) << left << "bit wise" << setw(12) << right << (megabytes / tBitwise) << " MB/s" << endl;
+
+	// encoding of set target commands
+	const unsigned frames = 10000000;
+	unsigned char frame[POLOLU_MAX_FRAME];
+	unsigned long bytes[2] = {0, 0};
+	unsigned checksum = 0;
+	double t[2];
+	for(unsigned crc = 0; crc < 2; crc++){
+		start = benchClock::now();
+		for(unsigned i = 0; i < frames; i++){
+			bytes[crc] += PololuFrames::setTarget(frame, i % 24, 4000 + (i % 4000), crc == 1);
+			checksum += frame[3];
+		}
+		t[crc] = elapsedS(start);
+	}
+	cout << setw(24) << left << "setTarget without CRC" << setw(12) << right << (frames / t[0] / 1.0e6) << " M frames/s" << endl;
+	cout << setw(24) << left << "setTarget with CRC" << setw(12) << right << (frames / t[1] / 1.0e6) << " M frames/s" << endl;
+	cout << "(" << bytes[0] << " / " << bytes[1] << " bytes, " << checksum << ")" << endl;
+	return 0;
+}
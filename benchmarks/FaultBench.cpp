@@ -0,0 +1,120 @@
+//============================================================================
+// Name        : FaultBench.cpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : Benchmark of the recovery paths. Positions are read from a
+//               simulated controller (MaestroPty) through a
+//               SerialComFaultInjector, once without faults and once per
+//               fault class. For each class the throughput loss against
+//               the fault free run and the latency of the requests that
+//               hit a fault (recovery latency) are reported.
+//
+//               usage: faultBench [requests] [probability] [seed]
+//============================================================================
+#include "../SerialCom.hpp"
+#include "../SerialComFaultInjector.hpp"
+#include "../Pololu.hpp"
+#include "../MaestroSimulator.hpp"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+
+using namespace std;
+
+typedef std::chrono::steady_clock benchClock;
+
+
+static double elapsedUs(benchClock::time_point start){
+	return std::chrono::duration_cast<std::chrono::duration<double, std::micro> >(benchClock::now() - start).count();
+}
+
+struct FaultRun {
+	double        us        = 0.0; /**< duration of the run */
+	unsigned long faulted   = 0;   /**< requests that hit at least one fault */
+	unsigned long failed    = 0;   /**< requests that failed despite the retries */
+	double        faultedUs = 0.0; /**< summed latency of the faulted requests */
+	double        maxUs     = 0.0; /**< largest latency of a faulted request */
+};
+
+static FaultRun run(Pololu &pololu, SerialComFaultInjector &injector, unsigned requests){
+	IPololu &controller = pololu;
+	FaultRun r;
+	benchClock::time_point start = benchClock::now();
+	for(unsigned i = 0; i < requests; i++){
+		unsigned long before = injector.getInjected();
+		benchClock::time_point t = benchClock::now();
+		try{
+			controller.getPosition(i % 6);
+		}catch(IException *e){
+			delete e;
+			r.failed++;
+		}
+		if(injector.getInjected() != before){
+			double us = elapsedUs(t);
+			r.faulted++;
+			r.faultedUs += us;
+			if(us > r.maxUs){
+				r.maxUs = us;
+			}
+		}
+	}
+	r.us = elapsedUs(start);
+	return r;
+}
+
+static void report(const char* name, unsigned requests, const FaultRun &r, const FaultRun &base){
+	double loss = 100.0 * (1.0 - (base.us / r.us));
+	cout << setw(14) << left << name
+		 << setw(10) << right << (unsigned long) (requests * 1.0e6 / r.us)
+		 << setw(10) << fixed << setprecision(1) << ((r.us == base.us) ? 0.0 : loss)
+		 << setw(10) << r.faulted
+		 << setw(8)  << r.failed
+		 << setw(14) << setprecision(0) << ((r.faulted > 0) ? (r.faultedUs / r.faulted) : 0.0)
+		 << setw(14) << r.maxUs << endl;
+}
+
+int main(int argc, char* argv[]){
+	unsigned requests    = (argc > 1) ? atoi(argv[1]) : 400;
+	double   probability = (argc > 2) ? atof(argv[2]) : 0.05;
+	unsigned long seed   = (argc > 3) ? atol(argv[3]) : 1;
+
+	static const char* names[SERIALCOM_FAULT_COUNT] = {"drop byte", "delay", "partial read", "write error"};
+
+	try{
+		MaestroSimulator sim(6);
+		MaestroPty pty(&sim);
+		pty.start();
+
+		SerialCom com(pty.getPortName(), 9600);
+		SerialComFaultInjector injector(&com, seed);
+		Pololu pololu(&injector);
+		// the recovery is done by the retries of the request
+		pololu.setRetryPolicy(POLOLU_CMD_GET_POSITION, RetryPolicy(3, 0, 1000, 4000));
+		pololu.openConnection();
+
+		cout << "requests: " << requests << ", fault probability: " << probability << ", seed: " << seed << endl;
+		cout << setw(14) << left << "fault" << setw(10) << right << "req/s" << setw(10) << "loss %"
+			 << setw(10) << "faulted" << setw(8) << "failed"
+			 << setw(14) << "recovery us" << setw(14) << "max us" << endl;
+
+		FaultRun base = run(pololu, injector, requests);
+		report("none", requests, base, base);
+
+		for(unsigned f = 0; f < SERIALCOM_FAULT_COUNT; f++){
+			injector.clearFaults();
+			injector.setSeed(seed);
+			// a delay of 20 ms is in the range of a USB hiccup
+			injector.setFault((SerialComFault) f, probability, 20000);
+			FaultRun r = run(pololu, injector, requests);
+			report(names[f], requests, r, base);
+		}
+
+		pololu.closeConnection();
+		pty.stop();
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		return 1;
+	}
+	return 0;
+}
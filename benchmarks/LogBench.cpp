@@ -0,0 +1,83 @@
+//============================================================================
+// Name        : LogBench.cpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : Benchmark of the cost of a log statement in the calling
+//               thread: MEX_LOG disabled, MEX_LOG with the text and the
+//               binary sink (the background thread writes to /dev/null)
+//               and the formatted stream output it replaces.
+//
+//               usage: logBench [records]
+//============================================================================
+#include "../BinLog.hpp"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+
+using namespace std;
+
+typedef std::chrono::steady_clock benchClock;
+
+// records between two flushes, below the capacity of a ring
+#define LOG_BENCH_BATCH 256
+
+
+static double elapsedNs(benchClock::time_point start){
+	return std::chrono::duration_cast<std::chrono::duration<double, std::nano> >(benchClock::now() - start).count();
+}
+
+/*
+ * Times the log statements only, the background thread takes the records
+ * between the batches.
+ */
+static double logNs(unsigned long records, const string &msg){
+	double ns = 0.0;
+	for(unsigned long i = 0; i < records; i += LOG_BENCH_BATCH){
+		benchClock::time_point start = benchClock::now();
+		for(unsigned j = 0; j < LOG_BENCH_BATCH; j++){
+			MEX_LOG_WARN("transfer:: retry {} of command 0x{} after {} us: {}", j, 0x90, 2.5, msg);
+		}
+		ns += elapsedNs(start);
+		BinLog::flush();
+	}
+	return ns / records;
+}
+
+int main(int argc, char* argv[]){
+	unsigned long records = (argc > 1) ? atol(argv[1]) : 200000;
+	records = ((records + LOG_BENCH_BATCH - 1) / LOG_BENCH_BATCH) * LOG_BENCH_BATCH;
+	string msg("ExceptionSerialCom::read:: timeout");
+
+	cout << fixed << setprecision(1);
+	cout << "records " << records << ", 4 arguments per record" << endl;
+
+	// disabled: one relaxed load per statement
+	double disabled = logNs(records, msg);
+	cout << "MEX_LOG disabled      " << setw(8) << disabled << " ns/record" << endl;
+
+	ofstream devNull("/dev/null");
+	BinLog::startText(devNull);
+	double text = logNs(records, msg);
+	BinLog::stop();
+	cout << "MEX_LOG text sink     " << setw(8) << text << " ns/record" << endl;
+
+	BinLog::startFile("/dev/null");
+	double binary = logNs(records, msg);
+	BinLog::stop();
+	cout << "MEX_LOG binary sink   " << setw(8) << binary << " ns/record" << endl;
+
+	// the formatted output in the calling thread
+	benchClock::time_point start = benchClock::now();
+	for(unsigned long i = 0; i < records; i++){
+		devNull << "transfer:: retry " << (i % LOG_BENCH_BATCH) << " of command 0x" << 0x90 << " after " << 2.5
+				<< " us: " << msg << endl;
+	}
+	double stream = elapsedNs(start) / records;
+	cout << "ostream << endl       " << setw(8) << stream << " ns/record" << endl;
+
+	cout << "dropped " << BinLog::getDropped() << ", written " << BinLog::getWritten() << endl;
+	return 0;
+}
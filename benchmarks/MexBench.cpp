@@ -0,0 +1,167 @@
+//============================================================================
+// Name        : MexBench.cpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : Benchmark of the MEX pick-and-place cycles. The production
+//               motions testMEXMovementSetting1/2 drive the complete stack
+//               (ServoMotor, Pololu, serial connection) against a simulated
+//               controller. Per cycle the cycle time, the bytes on the wire,
+//               the round trips and the CPU time of the host thread are
+//               reported.
+//
+//               Per default the controller is a SerialComSim on a virtual
+//               clock: the cycle time is the time the motion takes on a
+//               real controller at the given baud rate and the run is not
+//               bound to the wall clock. With "pty" the stack talks to a
+//               MaestroPty through SerialCom in real time.
+//
+//               usage: mexBench [cycles] [baudRate] [sim|pty]
+//============================================================================
+#include "../SerialCom.hpp"
+#include "../SerialComSim.hpp"
+#include "../Pololu.hpp"
+#include "../MaestroSimulator.hpp"
+#include "../Clock.hpp"
+#include "../unitTests/TestUnits.hpp"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <time.h>
+
+using namespace std;
+
+typedef std::chrono::steady_clock benchClock;
+
+
+static double threadCpuUs(){
+	struct timespec ts;
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+	return ts.tv_sec * 1.0e6 + ts.tv_nsec / 1.0e3;
+}
+
+struct MexCycle {
+	double        cycleUs    = 0.0; /**< duration of the motion */
+	double        cpuUs      = 0.0; /**< CPU time of the host thread */
+	unsigned long bytesOut   = 0;   /**< host -> controller */
+	unsigned long bytesIn    = 0;   /**< controller -> host */
+	unsigned long roundTrips = 0;   /**< commands answered by the controller */
+	unsigned long commands   = 0;
+};
+
+typedef void (*MexMotion)(Pololu &conn);
+
+/**
+ * \brief Parking positions of the channels 1..4 as set up in the Maestro
+ * Control Center (see the comments of the motions).
+ */
+static void park(MaestroSimulator &sim, unsigned setting){
+	static const unsigned short parking[2][4] = {{5680, 2840, 5880, 3808},
+												 {6240, 6560, 6040, 1984}};
+	for(unsigned i = 0; i < 4; i++){
+		sim.setPosition(i + 1, parking[setting - 1][i]);
+	}
+}
+
+static void account(MexCycle &c, MaestroSimulator &sim){
+	c.bytesOut   = sim.getBytesIn();
+	c.bytesIn    = sim.getBytesOut();
+	c.roundTrips = sim.getReplyCount();
+	c.commands   = sim.getCommandCount();
+}
+
+static MexCycle runSim(MexMotion motion, unsigned setting, unsigned short baudRate){
+	MexCycle c;
+	VirtualClock clock;
+	MaestroSimulator sim(6);
+	park(sim, setting);
+	SerialComSim com(&sim, &clock, baudRate);
+	Pololu pololu(&com);
+	pololu.setClock(&clock);
+	setTestClock(&clock);
+	pololu.openConnection();
+
+	unsigned long long start = clock.nowUs();
+	double cpu = threadCpuUs();
+	motion(pololu);
+	c.cpuUs   = threadCpuUs() - cpu;
+	c.cycleUs = clock.nowUs() - start;
+
+	pololu.closeConnection();
+	setTestClock(nullptr);
+	account(c, sim);
+	return c;
+}
+
+static MexCycle runPty(MexMotion motion, unsigned setting, unsigned short baudRate){
+	MexCycle c;
+	MaestroSimulator sim(6);
+	park(sim, setting);
+	MaestroPty pty(&sim);
+	pty.start();
+	Pololu pololu(pty.getPortName(), baudRate);
+	pololu.openConnection();
+
+	benchClock::time_point start = benchClock::now();
+	double cpu = threadCpuUs();
+	motion(pololu);
+	c.cpuUs   = threadCpuUs() - cpu;
+	c.cycleUs = std::chrono::duration_cast<std::chrono::duration<double, std::micro> >(benchClock::now() - start).count();
+
+	pololu.closeConnection();
+	pty.stop();
+	account(c, sim);
+	return c;
+}
+
+static void report(unsigned setting, unsigned cycles, const MexCycle &sum){
+	cout << setw(10) << left << setting
+		 << setw(8)  << right << cycles
+		 << setw(12) << fixed << setprecision(3) << (sum.cycleUs / cycles / 1.0e6)
+		 << setw(12) << (sum.roundTrips / cycles)
+		 << setw(12) << (sum.bytesOut / cycles)
+		 << setw(12) << (sum.bytesIn / cycles)
+		 << setw(14) << setprecision(0) << (sum.cpuUs / cycles)
+		 << setw(12) << setprecision(2) << ((sum.roundTrips > 0) ? (sum.cpuUs / sum.roundTrips) : 0.0) << endl;
+}
+
+int main(int argc, char* argv[]){
+	unsigned cycles          = (argc > 1) ? atoi(argv[1]) : 3;
+	unsigned short baudRate  = (argc > 2) ? atoi(argv[2]) : 9600;
+	bool pty                 = (argc > 3) && (strcmp(argv[3], "pty") == 0);
+
+	static const MexMotion motions[2] = {testMEXMovementSetting1, testMEXMovementSetting2};
+
+	if(cycles == 0){
+		cycles = 1;
+	}
+
+	try{
+		cout << "cycles: " << cycles << ", baud rate: " << baudRate
+			 << ", controller: " << (pty ? "MaestroPty (wall clock)" : "SerialComSim (virtual clock)") << endl;
+		cout << setw(10) << left << "setting" << setw(8) << right << "cycles"
+			 << setw(12) << "cycle s" << setw(12) << "round trips"
+			 << setw(12) << "bytes out" << setw(12) << "bytes in"
+			 << setw(14) << "cpu us/cycle" << setw(12) << "cpu us/rt" << endl;
+
+		for(unsigned s = 1; s <= 2; s++){
+			MexCycle sum;
+			for(unsigned i = 0; i < cycles; i++){
+				MexCycle c = pty ? runPty(motions[s - 1], s, baudRate) : runSim(motions[s - 1], s, baudRate);
+				sum.cycleUs    += c.cycleUs;
+				sum.cpuUs      += c.cpuUs;
+				sum.bytesOut   += c.bytesOut;
+				sum.bytesIn    += c.bytesIn;
+				sum.roundTrips += c.roundTrips;
+				sum.commands   += c.commands;
+			}
+			report(s, cycles, sum);
+		}
+	}catch(IException *e){
+		setTestClock(nullptr);
+		cout << e->getMsg() << endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,135 @@
+//============================================================================
+// Name        : PerfBench.cpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : Hardware counters per operation of the hot paths: the
+//               Pololu frame builders, the degree conversion of ServoMotor
+//               (setPositionInDeg against a simulated controller on a
+//               virtual clock) and the traversal of the SimplUnitTestFW.
+//               Events the host does not count (no PMU in a virtual
+//               machine, perf_event_paranoid) are shown as n/a.
+//
+//               usage: perfBench [operations]
+//============================================================================
+#include "../PerfCounters.hpp"
+#include "../PololuFrames.hpp"
+#include "../SerialComSim.hpp"
+#include "../Pololu.hpp"
+#include "../ServoMotor.hpp"
+#include "../MaestroSimulator.hpp"
+#include "../Clock.hpp"
+#include "../SimplUnitTestFW.hpp"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cstdlib>
+
+using namespace std;
+
+
+static void report(const char *name, const PerfSample &s){
+	cout << setw(28) << left << name << right << s.toString() << endl;
+}
+
+class NopCase : public TestCase{
+public:
+	NopCase() : TestCase(string("nop")){};
+protected:
+	virtual bool testRun(){return true;};
+};
+
+int main(int argc, char* argv[]){
+	unsigned long ops = (argc > 1) ? atol(argv[1]) : 1000000;
+	PerfCounters counters;
+
+	if(!counters.getUnavailableReason().empty()){
+		cout << "not counted: " << counters.getUnavailableReason() << endl;
+	}
+	cout << setw(28) << left << "operation" << right << perfHeader() << endl;
+
+	// frame builders
+	unsigned char frame[POLOLU_MAX_FRAME];
+	unsigned checksum = 0;
+	for(unsigned crc = 0; crc < 2; crc++){
+		PerfSample s;
+		{
+			PerfScope scope(counters, s, ops);
+			for(unsigned long i = 0; i < ops; i++){
+				checksum += PololuFrames::setTarget(frame, i % 24, 4000 + (i % 4000), crc == 1);
+				checksum += frame[3];
+			}
+		}
+		report(crc ? "setTarget frame with CRC" : "setTarget frame", s);
+	}
+	{
+		PerfSample s;
+		{
+			PerfScope scope(counters, s, ops);
+			for(unsigned long i = 0; i < ops; i++){
+				checksum += PololuFrames::getPosition(frame, i % 24, false);
+				checksum += frame[1];
+			}
+		}
+		report("getPosition frame", s);
+	}
+
+	// degree conversion, frame and the simulated round trip
+	try{
+		VirtualClock clock;
+		MaestroSimulator sim(6);
+		SerialComSim com(&sim, &clock, 57600);
+		Pololu pololu(&com);
+		pololu.setClock(&clock);
+		pololu.openConnection();
+		ServoMotor servo(0, 7500, 1500, &pololu);
+		servo.setMinMaxDegree(-90, 90);
+		unsigned long moves = ops / 10;
+		PerfSample s;
+		{
+			PerfScope scope(counters, s, moves);
+			for(unsigned long i = 0; i < moves; i++){
+				servo.setPositionInDeg((short) ((i % 180) - 90));
+			}
+		}
+		report("ServoMotor::setPositionInDeg", s);
+		pololu.closeConnection();
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		delete e;
+		return 1;
+	}
+
+	// traversal of a unit with 10 suites of 100 test cases
+	{
+		vector<NopCase> cases(1000);
+		vector<TestSuite> suites(10);
+		UnitTest unit("perf");
+		for(unsigned i = 0; i < suites.size(); i++){
+			unit.addTestItem(&suites[i]);
+			for(unsigned j = 0; j < 100; j++){
+				suites[i].addTestItem(&cases[i * 100 + j]);
+			}
+		}
+		unsigned long runs = ops / 10000 + 1;
+		PerfSample s;
+		{
+			PerfScope scope(counters, s, runs * cases.size());
+			for(unsigned long i = 0; i < runs; i++){
+				unit.testExecution();
+			}
+		}
+		report("UnitTest::testExecution/case", s);
+
+		PerfSample x;
+		{
+			PerfScope scope(counters, x, runs * cases.size());
+			for(unsigned long i = 0; i < runs; i++){
+				checksum += unit.toXmlStr().size();
+			}
+		}
+		report("UnitTest::toXmlStr/case", x);
+	}
+
+	cout << "(" << checksum << ")" << endl;
+	return 0;
+}
@@ -0,0 +1,130 @@
+//============================================================================
+// Name        : SerialComBench.cpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : Benchmark of the serial connection backends. A number of
+//               simulated controllers (MaestroPty) is queried for servo
+//               positions, once with SerialComLINUX (one request after the
+//               other) and once with SerialComURING (all requests of a
+//               round batched into one submission).
+//
+//               usage: serialComBench [controllers] [rounds]
+//============================================================================
+#include "../SerialCom.hpp"
+#include "../SerialComURING.hpp"
+#include "../MaestroSimulator.hpp"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+
+using namespace std;
+
+typedef std::chrono::steady_clock benchClock;
+
+
+static double elapsedUs(benchClock::time_point start){
+	return std::chrono::duration_cast<std::chrono::duration<double, std::micro> >(benchClock::now() - start).count();
+}
+
+static void report(const char* name, unsigned queries, double us, unsigned long syscalls){
+	cout << setw(16) << left << name
+		 << setw(10) << right << queries
+		 << setw(16) << fixed << setprecision(1) << (us / queries)
+		 << setw(16) << setprecision(0) << (queries * 1.0e6 / us)
+		 << setw(16) << setprecision(2) << (((double) syscalls) / queries) << endl;
+}
+
+int main(int argc, char* argv[]){
+	unsigned controllers = (argc > 1) ? atoi(argv[1]) : 8;
+	unsigned rounds      = (argc > 2) ? atoi(argv[2]) : 200;
+
+	try{
+		vector<MaestroSimulator*> sims;
+		vector<MaestroPty*> ptys;
+		for(unsigned i = 0; i < controllers; i++){
+			sims.push_back(new MaestroSimulator(6));
+			ptys.push_back(new MaestroPty(sims.back()));
+			ptys.back()->start();
+		}
+
+		cout << "controllers: " << controllers << ", rounds: " << rounds << endl;
+		cout << setw(16) << left << "backend" << setw(10) << right << "queries"
+			 << setw(16) << "us/query" << setw(16) << "queries/s" << setw(16) << "syscalls/query" << endl;
+
+		unsigned char command[] = {0x90, 0x01};
+
+		// one request after the other
+		{
+			vector<SerialCom*> coms;
+			for(unsigned i = 0; i < controllers; i++){
+				coms.push_back(new SerialCom(ptys[i]->getPortName(), 9600));
+				coms.back()->openSerialCom();
+			}
+			unsigned char response[2];
+			benchClock::time_point start = benchClock::now();
+			for(unsigned r = 0; r < rounds; r++){
+				for(unsigned i = 0; i < controllers; i++){
+					coms[i]->writeSerialCom(command, 2, response, 2);
+				}
+			}
+			double us = elapsedUs(start);
+			// discardInput (poll), write, poll and read per request
+			report("SerialComLINUX", rounds * controllers, us, 4UL * rounds * controllers);
+			for(unsigned i = 0; i < controllers; i++){
+				delete coms[i];
+			}
+		}
+
+		// linked chains, one submission per round
+		{
+			URingLoop loop(256);
+			vector<SerialComURING*> coms;
+			vector<unsigned char> responses(2 * controllers);
+			for(unsigned i = 0; i < controllers; i++){
+				coms.push_back(new SerialComURING(ptys[i]->getPortName(), 9600, &loop));
+				coms.back()->openSerialCom();
+			}
+			unsigned long syscallsBefore = loop.getSyscallCount();
+			benchClock::time_point start = benchClock::now();
+			for(unsigned r = 0; r < rounds; r++){
+				for(unsigned i = 0; i < controllers; i++){
+					coms[i]->submitQuery(command, 2, &responses[2 * i], 2);
+				}
+				loop.submit();
+				unsigned done = 0;
+				while(done < controllers){
+					loop.harvest();
+					done = 0;
+					for(unsigned i = 0; i < controllers; i++){
+						if(coms[i]->isQueryDone()){
+							done++;
+						}
+					}
+					if(done < controllers){
+						loop.submit(1);
+					}
+				}
+				for(unsigned i = 0; i < controllers; i++){
+					coms[i]->finishQuery();
+				}
+			}
+			double us = elapsedUs(start);
+			report("SerialComURING", rounds * controllers, us, loop.getSyscallCount() - syscallsBefore);
+			for(unsigned i = 0; i < controllers; i++){
+				delete coms[i];
+			}
+		}
+
+		for(unsigned i = 0; i < controllers; i++){
+			ptys[i]->stop();
+			delete ptys[i];
+			delete sims[i];
+		}
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		return 1;
+	}
+	return 0;
+}
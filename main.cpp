@@ -10,6 +10,7 @@
 #include "SerialCom.hpp"
 #include "Pololu.hpp"
 #include "ServoMotor.hpp"
+#include "BinLog.hpp"
 #include <iostream>
 #include <string>
 
@@ -17,6 +18,8 @@ using namespace std;
 
 int main()
 {
+	// diagnostics are formatted by the background thread of the log
+	BinLog::startText(cout);
 	try{
 		const char* portName = "/dev/ttyACM0";  // Linux
 		Pololu conn(portName, 9600);
@@ -24,18 +27,19 @@ int main()
 		conn.openConnection();
 		conn.getErrors();
 
+		BinLog::stop();
 		return 0;
 
 
 		// Define the servos of the robot manipulator
 		ServoMotor arm_0(0, 7500, 1500	, &conn);
-		cout << "max. pos.: " << arm_0.getMaxPosInAbs() << endl;
-		cout << "min. pos.: " << arm_0.getMinPosInAbs() << endl;
-		cout << "get current pos.: "  << arm_0.getPositionInAbs() << endl;
+		MEX_LOG_INFO("max. pos.: {}", arm_0.getMaxPosInAbs());
+		MEX_LOG_INFO("min. pos.: {}", arm_0.getMinPosInAbs());
+		MEX_LOG_INFO("get current pos.: {}", arm_0.getPositionInAbs());
 
 		unsigned short pMin, pMid, pMax;
 		arm_0.showPololuValues(pMin,pMid,pMax);
-		cout << pMin	<< " " << pMid << " " << pMax << endl;
+		MEX_LOG_INFO("{} {} {}", pMin, pMid, pMax);
 
 		arm_0.setMinMaxDegree(-45,45);
 		arm_0.setPositionInDeg(0);
@@ -43,12 +47,18 @@ int main()
 
 		conn.closeConnection();
 	}catch(IException *e){
-		cout << e->getMsg() << endl;
+		// the message chain of the exception does not fit a log record
+		BinLog::stop();
+		cerr << e->getMsg() << endl;
+		delete e;
 	}catch(string e){
-		cout << "string Error: " << e << endl;
+		BinLog::stop();
+		cerr << "string Error: " << e << endl;
 	}catch(...){
-		cout << "unknown error\n";
+		BinLog::stop();
+		cerr << "unknown error\n";
 	}
 
+	BinLog::stop();
 	return 0;
 }
@@ -0,0 +1,204 @@
+//============================================================================
+// Name        : LoadGen.cpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : Load generator for the serial link. A mix of set target
+//               and get position commands is issued through Pololu at
+//               increasing rates (open loop, every command has its planned
+//               start time). For each rate the achieved commands/s and
+//               bytes/s, the queueing delay (start behind the plan) and the
+//               latency percentiles (planned start to completion) are
+//               reported together with the theoretical ceiling of the
+//               configured baud rate. The rows are meant to be plotted
+//               (rate offered vs. achieved/latency) to find the knee.
+//
+//               With port "pty" a MaestroSimulator is served on a pseudo
+//               terminal that emulates the byte rate of the baud rate.
+//               With "rawpty" the byte rate is not limited, so rates above
+//               the ceiling show the limit of the host side stack.
+//
+//               The statistics are published for mexTop while it runs.
+//
+//               usage: loadGen [port|pty|rawpty] [baudRate] [query %] [step ms]
+//                              [start rate] [steps] [factor]
+//============================================================================
+#include "../Pololu.hpp"
+#include "../MaestroSimulator.hpp"
+#include "../PololuStats.hpp"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <cstdlib>
+
+using namespace std;
+
+typedef std::chrono::steady_clock loadClock;
+
+// bytes of the compact protocol
+#define LOADGEN_SET_BYTES   4 // 0x84 channel low high
+#define LOADGEN_QUERY_BYTES 2 // 0x90 channel
+#define LOADGEN_REPLY_BYTES 2 // position low high
+
+
+struct LoadStep {
+	double        offered   = 0.0; /**< commands/s */
+	double        achieved  = 0.0; /**< commands/s */
+	double        bytesPerS = 0.0; /**< both directions */
+	unsigned long commands  = 0;
+	unsigned long failed    = 0;
+	double        queueUs   = 0.0; /**< mean queueing delay */
+	double        p50Us     = 0.0;
+	double        p90Us     = 0.0;
+	double        p99Us     = 0.0;
+	double        maxUs     = 0.0;
+};
+
+static double toUs(loadClock::duration d){
+	return std::chrono::duration_cast<std::chrono::duration<double, std::micro> >(d).count();
+}
+
+static double percentile(vector<double> &sorted, double p){
+	if(sorted.empty()){
+		return 0.0;
+	}
+	size_t i = (size_t) (p * (sorted.size() - 1) + 0.5);
+	return sorted[i];
+}
+
+/**
+ * \brief Commands per second the link can carry at most. Every command
+ * occupies the host -> controller line with its bytes; a query blocks
+ * the host until the reply arrived, so the reply bytes are not hidden
+ * behind the next command. Each byte is 10 bits on the wire (8N1).
+ */
+static double ceiling(unsigned baudRate, double queryShare){
+	double bytes = (1.0 - queryShare) * LOADGEN_SET_BYTES
+				 + queryShare * (LOADGEN_QUERY_BYTES + LOADGEN_REPLY_BYTES);
+	return (baudRate / 10.0) / bytes;
+}
+
+static LoadStep run(IPololu &controller, double rate, double queryShare, unsigned stepMs){
+	LoadStep s;
+	s.offered = rate;
+	unsigned long planned = (unsigned long) (rate * stepMs / 1000.0);
+	if(planned == 0){
+		planned = 1;
+	}
+	vector<double> latency;
+	latency.reserve(planned);
+	double queueSum = 0.0;
+	unsigned long bytes = 0;
+	double queryCredit = 0.0;
+
+	loadClock::time_point start = loadClock::now();
+	loadClock::time_point end = start;
+	for(unsigned long i = 0; i < planned; i++){
+		loadClock::time_point plan = start + std::chrono::duration_cast<loadClock::duration>(
+				std::chrono::duration<double>(i / rate));
+		std::this_thread::sleep_until(plan);
+		loadClock::time_point begin = loadClock::now();
+
+		// spreads the queries evenly over the commands
+		queryCredit += queryShare;
+		bool query = (queryCredit >= 1.0);
+		unsigned short servo = i % 6;
+		try{
+			if(query){
+				queryCredit -= 1.0;
+				controller.getPosition(servo);
+				bytes += LOADGEN_QUERY_BYTES + LOADGEN_REPLY_BYTES;
+			}else{
+				controller.setPosition(servo, ((i / 6) % 2 == 0) ? 5000 : 7000);
+				bytes += LOADGEN_SET_BYTES;
+			}
+		}catch(IException *e){
+			delete e;
+			s.failed++;
+		}
+		end = loadClock::now();
+		queueSum += toUs(begin - plan);
+		latency.push_back(toUs(end - plan));
+	}
+
+	double us = toUs(end - start);
+	s.commands  = planned;
+	s.achieved  = (us > 0.0) ? (planned * 1.0e6 / us) : 0.0;
+	s.bytesPerS = (us > 0.0) ? (bytes * 1.0e6 / us) : 0.0;
+	s.queueUs   = queueSum / planned;
+	std::sort(latency.begin(), latency.end());
+	s.p50Us = percentile(latency, 0.50);
+	s.p90Us = percentile(latency, 0.90);
+	s.p99Us = percentile(latency, 0.99);
+	s.maxUs = latency.back();
+	return s;
+}
+
+static void report(const LoadStep &s, double limit){
+	cout << setw(10) << fixed << setprecision(0) << s.offered
+		 << setw(10) << s.achieved
+		 << setw(8)  << setprecision(1) << (100.0 * s.achieved / limit)
+		 << setw(10) << setprecision(0) << s.bytesPerS
+		 << setw(12) << s.queueUs
+		 << setw(10) << s.p50Us
+		 << setw(10) << s.p90Us
+		 << setw(10) << s.p99Us
+		 << setw(10) << s.maxUs
+		 << setw(8)  << s.failed << endl;
+}
+
+int main(int argc, char* argv[]){
+	string port              = (argc > 1) ? argv[1] : "pty";
+	unsigned short baudRate  = (argc > 2) ? atoi(argv[2]) : 9600;
+	double queryShare        = ((argc > 3) ? atof(argv[3]) : 50.0) / 100.0;
+	unsigned stepMs          = (argc > 4) ? atoi(argv[4]) : 1000;
+	double rate              = (argc > 5) ? atof(argv[5]) : 50.0;
+	unsigned steps           = (argc > 6) ? atoi(argv[6]) : 10;
+	double factor            = (argc > 7) ? atof(argv[7]) : 1.5;
+
+	bool help = (port == "-h") || (port == "--help");
+	if(help || (queryShare < 0.0) || (queryShare > 1.0) || (rate <= 0.0) || (factor <= 1.0) || (baudRate == 0)){
+		cout << "usage: loadGen [port|pty|rawpty] [baudRate] [query %] [step ms] [start rate] [steps] [factor]" << endl;
+		return help ? 0 : 1;
+	}
+
+	MaestroSimulator sim(6);
+	MaestroPty pty(&sim);
+	try{
+		if((port == "pty") || (port == "rawpty")){
+			pty.setBaudRate((port == "pty") ? baudRate : 0);
+			pty.start();
+			port = pty.getPortName();
+		}
+		Pololu pololu(port.c_str(), baudRate);
+		IPololu &controller = pololu;
+		PololuStats stats("", port);
+		pololu.setStats(&stats);
+		pololu.openConnection();
+
+		double limit = ceiling(baudRate, queryShare);
+		cout << "port: " << port << ", baud rate: " << baudRate << ", queries: " << (queryShare * 100.0)
+			 << " %, step: " << stepMs << " ms, ceiling: " << fixed << setprecision(0) << limit << " cmd/s"
+			 << ", statistics: " << stats.getName() << endl;
+		cout << setw(10) << "offered" << setw(10) << "cmd/s" << setw(8) << "% ceil"
+			 << setw(10) << "bytes/s" << setw(12) << "queue us"
+			 << setw(10) << "p50 us" << setw(10) << "p90 us" << setw(10) << "p99 us"
+			 << setw(10) << "max us" << setw(8) << "failed" << endl;
+
+		for(unsigned i = 0; i < steps; i++){
+			report(run(controller, rate, queryShare, stepMs), limit);
+			rate *= factor;
+		}
+
+		pololu.closeConnection();
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		pty.stop();
+		return 1;
+	}
+	pty.stop();
+	return 0;
+}
@@ -0,0 +1,47 @@
+//============================================================================
+// Name        : LogDecode.cpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : Renders a binary log file written by BinLog::startFile(...)
+//               as text lines (time, level, thread, file:line, message).
+//
+//               usage: logDecode file [DEBUG|INFO|WARN|ERROR]
+//============================================================================
+#include "../BinLog.hpp"
+#include <iostream>
+#include <fstream>
+#include <cstring>
+
+using namespace std;
+
+
+int main(int argc, char* argv[]){
+	if(argc < 2){
+		cout << "usage: logDecode file [DEBUG|INFO|WARN|ERROR]" << endl;
+		return 1;
+	}
+	BinLogLevel minLevel = BINLOG_DEBUG;
+	if(argc > 2){
+		for(int l = BINLOG_DEBUG; l < BINLOG_OFF; l++){
+			if(strcmp(argv[2], BinLog::levelName((BinLogLevel) l)) == 0){
+				minLevel = (BinLogLevel) l;
+			}
+		}
+	}
+
+	ifstream in(argv[1], std::ios::binary);
+	if(!in.is_open()){
+		cout << "logDecode: cannot read " << argv[1] << endl;
+		return 1;
+	}
+	try{
+		BinLog::decodeFile(in, cout, minLevel);
+	}catch(IException *e){
+		cout.flush();
+		cerr << "logDecode: " << e->getMsg() << endl;
+		delete e;
+		return 1;
+	}
+	cout.flush();
+	return 0;
+}
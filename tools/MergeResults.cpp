@@ -0,0 +1,53 @@
+//============================================================================
+// Name        : MergeResults.cpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : Merges the XML results of the unit tests, e.g. of the
+//               shards of a run on several processes or machines:
+//
+//                 unitTest --shard=0/2 --xml-prefix=s0_
+//                 unitTest --shard=1/2 --xml-prefix=s1_
+//                 mergeResults UT_all.xml s0_UT_*.xml s1_UT_*.xml
+//
+//               The output is a UnitTest element if the inputs contain one
+//               unit, otherwise a TestReport of all units (see TestReport).
+//
+//               usage: mergeResults output input...
+//
+//               The exit status is 0 only if all test cases passed.
+//============================================================================
+#include "../TestReport.hpp"
+#include <iostream>
+#include <fstream>
+
+using namespace std;
+
+
+int main(int argc, char* argv[]){
+	if(argc < 3){
+		cout << "usage: mergeResults output input..." << endl;
+		return 1;
+	}
+	TestReport report;
+	try{
+		for(int i = 2; i < argc; i++){
+			report.addFile(argv[i]);
+		}
+	}catch(IException *e){
+		cerr << "mergeResults: " << e->getMsg() << endl;
+		delete e;
+		return 1;
+	}
+
+	ofstream out(argv[1]);
+	out << report.toXml();
+	out.close();
+	if(!out){
+		cerr << "mergeResults: cannot write " << argv[1] << endl;
+		return 1;
+	}
+	cout << (argc - 2) << " files, " << report.getUnitCount() << " units, " << report.getCaseCount()
+		 << " test cases, " << report.getFailedCount() << " failed (" << report.getTimeoutCount() << " timeouts), "
+		 << report.getSkippedCount() << " skipped: " << (report.getResult() ? "PASSED" : "FAILED") << endl;
+	return report.getResult() ? 0 : 1;
+}
@@ -0,0 +1,175 @@
+//============================================================================
+// Name        : MexTop.cpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : Live monitor of a controlling process. It attaches read-only
+//               to the statistics segment a Pololu instance publishes (see
+//               PololuStats) and redraws at the given rate: command rates,
+//               bytes/s and link utilization, round trip percentiles of the
+//               last interval, error flags and per channel target vs.
+//               position with the age of the last reading. The controlled
+//               process is not involved in the refresh.
+//
+//               usage: mexTop [segment] [Hz] [baudRate] [frames]
+//
+//               Without segment the first /dev/shm/mex-stats-* is taken,
+//               frames 0 (default) runs until the process ends.
+//============================================================================
+#include "../PololuStats.hpp"
+#include "../PololuErrors.hpp"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+#include <cstring>
+
+using namespace std;
+
+typedef std::chrono::steady_clock topClock;
+
+static const char *commandNames[POLOLU_CMD_COUNT] = {
+		"setPosition", "setSpeed", "setAcceleration", "getPosition", "getMovingState", "getErrors"
+};
+
+static uint64_t nowUs(){
+	return std::chrono::duration_cast<std::chrono::microseconds>(topClock::now().time_since_epoch()).count();
+}
+
+static string age(uint64_t now, uint64_t at){
+	if(at == 0){
+		return string("-");
+	}
+	stringstream ss;
+	uint64_t us = (now > at) ? (now - at) : 0;
+	if(us < 1000000){
+		ss << (us / 1000) << " ms";
+	}else{
+		ss << fixed << setprecision(1) << (us / 1.0e6) << " s";
+	}
+	return ss.str();
+}
+
+static string ms(unsigned long long us){
+	stringstream ss;
+	ss << fixed << setprecision(2) << (us / 1000.0);
+	return ss.str();
+}
+
+static void draw(ostream &out, const string &name, const PololuStatsBlock &cur, const PololuStatsBlock &prev,
+				 double dtS, unsigned baudRate, double hz){
+	uint64_t now = nowUs();
+	out << "\033[H\033[2J";
+	out << "mexTop  " << name << "  pid " << cur.pid << "  port " << (cur.port[0] ? cur.port : "-")
+		<< "  " << hz << " Hz  updated " << age(now, cur.updateUs) << " ago" << endl << endl;
+
+	// link
+	double outPerS = (cur.bytesOut - prev.bytesOut) / dtS;
+	double inPerS  = (cur.bytesIn - prev.bytesIn) / dtS;
+	out << "link     out " << setw(8) << fixed << setprecision(0) << outPerS << " B/s   in "
+		<< setw(8) << inPerS << " B/s";
+	if(baudRate > 0){
+		// 10 bits per byte on the wire (8N1), each direction has its own line
+		double util = 100.0 * 10.0 * ((outPerS > inPerS) ? outPerS : inPerS) / baudRate;
+		out << "   utilization " << setw(5) << setprecision(1) << util << " %" << ((util > 80.0) ? "  SATURATED" : "");
+	}
+	out << endl;
+
+	// round trips of this interval
+	uint64_t window[POLOLU_STATS_RTT_BINS];
+	uint64_t n = 0;
+	for(unsigned i = 0; i < POLOLU_STATS_RTT_BINS; i++){
+		window[i] = cur.rtt[i] - prev.rtt[i];
+		n += window[i];
+	}
+	out << "rtt ms   p50 " << setw(7) << ms(PololuStats::rttPercentile(window, 0.50))
+		<< "  p90 " << setw(7) << ms(PololuStats::rttPercentile(window, 0.90))
+		<< "  p99 " << setw(7) << ms(PololuStats::rttPercentile(window, 0.99))
+		<< "  max(all) " << setw(7) << ms(cur.rttMaxUs) << "  (" << n << " replies)" << endl;
+
+	out << "errors   0x" << hex << setw(4) << setfill('0') << cur.errors << dec << setfill(' ')
+		<< " " << PololuErrorFlags(cur.errors).toString() << "  read " << age(now, cur.errorsUs) << " ago, "
+		<< cur.errorReads << " reads with errors   " << (cur.moving ? "MOVING" : "idle") << endl << endl;
+
+	out << setw(18) << left << "command" << right << setw(12) << "calls" << setw(10) << "/s"
+		<< setw(10) << "failed" << endl;
+	for(unsigned i = 0; i < POLOLU_CMD_COUNT; i++){
+		out << setw(18) << left << commandNames[i] << right << setw(12) << cur.calls[i]
+			<< setw(10) << setprecision(0) << ((cur.calls[i] - prev.calls[i]) / dtS)
+			<< setw(10) << cur.failures[i] << endl;
+	}
+	out << endl;
+
+	out << setw(6) << "servo" << setw(10) << "target" << setw(10) << "position" << setw(10) << "error"
+		<< setw(12) << "set" << setw(12) << "read" << endl;
+	for(unsigned i = 0; i < POLOLU_STATS_SERVOS; i++){
+		const PololuStatsServo &s = cur.servo[i];
+		if((s.targetUs == 0) && (s.positionUs == 0)){
+			continue;
+		}
+		int error = (int) s.target - (int) s.position;
+		// a joint whose reading is older than its target, or far off, lags
+		bool lagging = (s.targetUs != 0) && ((s.positionUs < s.targetUs) || (abs(error) > 400))
+					   && ((now - s.targetUs) > 500000);
+		bool known = (s.targetUs != 0) && (s.positionUs != 0);
+		out << setw(6) << i << setw(10) << s.target << setw(10) << s.position
+			<< setw(10) << (known ? to_string(error) : string("-"))
+			<< setw(12) << age(now, s.targetUs) << setw(12) << age(now, s.positionUs)
+			<< (lagging ? "  LAGGING" : "") << endl;
+	}
+	out.flush();
+}
+
+int main(int argc, char* argv[]){
+	string name        = (argc > 1) ? argv[1] : "";
+	double hz          = (argc > 2) ? atof(argv[2]) : 20.0;
+	unsigned baudRate  = (argc > 3) ? atoi(argv[3]) : 0;
+	unsigned frames    = (argc > 4) ? atoi(argv[4]) : 0;
+
+	if((hz <= 0.0) || (hz > 100.0)){
+		cout << "usage: mexTop [segment] [Hz] [baudRate] [frames]" << endl;
+		return 1;
+	}
+	if(name.empty()){
+		name = PololuStatsView::findFirst();
+		if(name.empty()){
+			cout << "mexTop: no " << POLOLU_STATS_PREFIX << "* segment found." << endl;
+			return 1;
+		}
+	}
+
+	try{
+		PololuStatsView view(name);
+		PololuStatsBlock prev, cur;
+		if(!view.snapshot(prev)){
+			cout << "mexTop: the segment stays busy." << endl;
+			return 1;
+		}
+		topClock::duration period = std::chrono::duration_cast<topClock::duration>(std::chrono::duration<double>(1.0 / hz));
+		topClock::time_point next = topClock::now();
+		topClock::time_point last = next;
+		for(unsigned f = 0; (frames == 0) || (f < frames); f++){
+			next += period;
+			std::this_thread::sleep_until(next);
+			if(!view.snapshot(cur)){
+				continue;
+			}
+			topClock::time_point t = topClock::now();
+			double dtS = std::chrono::duration<double>(t - last).count();
+			last = t;
+			draw(cout, name, cur, prev, dtS, baudRate, hz);
+			memcpy((void*) &prev, (const void*) &cur, sizeof(PololuStatsBlock));
+			if(!view.isAlive()){
+				cout << endl << "mexTop: process " << cur.pid << " has ended." << endl;
+				break;
+			}
+		}
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		delete e;
+		return 1;
+	}
+	return 0;
+}
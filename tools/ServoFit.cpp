@@ -0,0 +1,57 @@
+//============================================================================
+// Name        : ServoFit.cpp
+// Author      : Martin Huelse (martin.huelse@fh-bielefeld.de)
+//
+// Description : Fits the dynamics of the servos (dead time, effective speed
+//               up and down, acceleration, speed of unlimited moves) to a
+//               trace recorded with SerialComRecorder and writes the
+//               parameter file read by MaestroSimulator::loadServoModels
+//               and ServoModelFile.
+//
+//               usage: servoFit <trace.csv> [parameters.txt]
+//============================================================================
+#include "../ServoModel.hpp"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+using namespace std;
+
+
+int main(int argc, char* argv[]){
+	if(argc < 2){
+		cout << "usage: servoFit <trace.csv> [parameters.txt]" << endl;
+		return 1;
+	}
+	string traceFile(argv[1]);
+	string paramFile((argc > 2) ? argv[2] : "servoModel.txt");
+
+	try{
+		map<unsigned, ServoTrace> traces = ServoTraceReader::read(traceFile);
+		vector<ServoModelParams> params;
+
+		cout << setw(6) << "servo" << setw(10) << "samples" << setw(12) << "dead us"
+			 << setw(10) << "up" << setw(10) << "down" << setw(10) << "accel"
+			 << setw(12) << "unlimited" << setw(10) << "rms" << setw(10) << "fit ms" << endl;
+		for(map<unsigned, ServoTrace>::iterator it = traces.begin(); it != traces.end(); it++){
+			if(it->second.sampleTimeUs.empty()){
+				continue;
+			}
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			ServoModelParams p = ServoModelFitter::fit(it->second);
+			double ms = std::chrono::duration_cast<std::chrono::duration<double, std::milli> >(std::chrono::steady_clock::now() - start).count();
+			params.push_back(p);
+			cout << setw(6) << p.servo << setw(10) << p.samples << setw(12) << p.deadTimeUs
+				 << fixed << setprecision(3)
+				 << setw(10) << p.speedScaleUp << setw(10) << p.speedScaleDown << setw(10) << p.accelScale
+				 << setw(12) << setprecision(1) << p.unlimitedSpeed << setw(10) << setprecision(2) << p.rmsError
+				 << setw(10) << setprecision(0) << ms << endl;
+		}
+		ServoModelFile::save(paramFile, params);
+		cout << params.size() << " servo model(s) written to " << paramFile << endl;
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		return 1;
+	}
+	return 0;
+}
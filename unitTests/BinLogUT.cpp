@@ -0,0 +1,332 @@
+/*
+ * BinLogUT.cpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <unistd.h>
+#include "../SimplUnitTestFW.hpp"
+#include "../BinLog.hpp"
+#include "BinLogUT.hpp"
+
+using namespace std;
+
+namespace UT_BinLog{
+
+bool execUnitTests(string xmlFilename){
+
+	// a unit a class
+	UnitTest unit("BinLog");
+
+	// a unit for each method
+	TestSuite TS01("encoding");
+	TestSuite TS02("sinks");
+
+	// add all test suits to the unit
+	unit.addTestItem(&TS01);
+	unit.addTestItem(&TS02);
+
+	//
+	// test cases for test suite TS01
+	//
+	TC11 tc11("BinLogEncoder - arguments, truncation and format");
+	TC12 tc12("BinLogRing - full ring drops without blocking");
+
+	// add specific test cases to test suite TS01
+	TS01.addTestItem(&tc11);
+	TS01.addTestItem(&tc12);
+
+	//
+	// test cases for test suite TS02
+	//
+	TC21 tc21("startText - lines of several threads in time order");
+	TC22 tc22("startFile - binary file and decodeFile");
+	TC23 tc23("MEX_LOG - nothing recorded below the level or without sink");
+	TC24 tc24("local - the ring of an ended thread is reused");
+
+	// add specific test cases to test suite TS02
+	TS02.addTestItem(&tc21);
+	TS02.addTestItem(&tc22);
+	TS02.addTestItem(&tc23);
+	TS02.addTestItem(&tc24);
+
+	// execute unit tests
+	unit.testExecution();
+	unit.writeResultsToFile(xmlFilename);
+
+	return unit.getResult();
+}
+
+
+static vector<string> lines(const string &text){
+	vector<string> result;
+	stringstream ss(text);
+	string l;
+	while(getline(ss, l)){
+		result.push_back(l);
+	}
+	return result;
+}
+
+static bool contains(const string &s, const string &part){
+	return s.find(part) != string::npos;
+}
+
+
+bool TC11::testRun(){ // BinLogEncoder - arguments, truncation and format
+	cout << ".";
+	bool result = true;
+	BinLogRecord r;
+
+	{
+		BinLogEncoder e(r);
+		e.add(-3);
+		e.add(40000u);
+		e.add(2.5);
+		e.add('x');
+		e.add(true);
+		e.add("literal");
+	}
+	vector<BinLogArg> args = BinLog::decode(r);
+	string s = BinLog::format("{} {} {} {} {} {} {}", args);
+	if((r.nargs != 6) || (r.used != 8 + 8 + 8 + 1 + 1 + 8) || (s != "-3 40000 2.5 x true literal {?}")){
+		result = false;
+	}
+
+	// a long string keeps its end, a full record leaves arguments out
+	string longMsg = string(60, 'a') + "innermost cause";
+	{
+		BinLogEncoder e(r);
+		e.add(7);
+		e.add(longMsg);
+		e.add(8);
+	}
+	args = BinLog::decode(r);
+	s = BinLog::format("{}|{}|{}", args);
+	if((r.nargs != 2) || (r.used != BINLOG_PAYLOAD) || (args[1].s.size() != BINLOG_PAYLOAD - 8 - 1) ||
+			(args[1].s.compare(0, 3, "...") != 0) || !contains(s, "aaa" "innermost cause|{?}") ||
+			(s.compare(0, 5, "7|...") != 0)){
+		result = false;
+	}
+
+	// the text line: seconds, level, thread, base name of the file, line
+	s = BinLog::line(1500000000ULL, 3, BINLOG_WARN, "/src/Pololu.cpp", 42, "msg");
+	if(s != "1.500000 WARN  T3 Pololu.cpp:42 msg"){
+		result = false;
+	}
+	return result;
+}
+
+
+bool TC12::testRun(){ // BinLogRing - full ring drops without blocking
+	cout << ".";
+	bool result = true;
+	BinLogRing *ring = new BinLogRing(9);
+
+	for(unsigned i = 0; i < BINLOG_RING_RECORDS; i++){
+		BinLogRecord *r = ring->claim();
+		if(r == nullptr){
+			result = false;
+			break;
+		}
+		r->tsNs = i;
+		ring->publish();
+	}
+	if((ring->claim() != nullptr) || (ring->claim() != nullptr) || (ring->getDropped() != 2)){
+		result = false;
+	}
+
+	// the consumer frees a slot, records come out in order
+	BinLogRecord r;
+	BinLogRecord *slot;
+	if(!ring->pop(r) || (r.tsNs != 0) || ((slot = ring->claim()) == nullptr)){
+		delete ring;
+		return false;
+	}
+	slot->tsNs = BINLOG_RING_RECORDS;
+	ring->publish();
+	unsigned long n = 0;
+	uint64_t last = 0;
+	while(ring->pop(r)){
+		if(r.tsNs < last){
+			result = false;
+		}
+		last = r.tsNs;
+		n++;
+	}
+	if((n != BINLOG_RING_RECORDS) || (ring->getTid() != 9)){
+		result = false;
+	}
+	delete ring;
+	return result;
+}
+
+
+bool TC21::testRun(){ // startText - lines of several threads in time order
+	cout << ".";
+	bool result = true;
+	stringstream out;
+	BinLog::setLevel(BINLOG_INFO);
+	BinLog::startText(out);
+
+	vector<thread> threads;
+	for(unsigned t = 0; t < 3; t++){
+		threads.push_back(thread([t](){
+			for(unsigned i = 0; i < 100; i++){
+				MEX_LOG_INFO("thread {} record {}", t, i);
+				MEX_LOG_DEBUG("not recorded {}", i);
+			}
+		}));
+	}
+	for(size_t t = 0; t < threads.size(); t++){
+		threads[t].join();
+	}
+	BinLog::flush();
+	vector<string> text = lines(out.str());
+	BinLog::stop();
+
+	if(text.size() != 300){
+		return false;
+	}
+	double last = 0.0;
+	unsigned perThread[3] = {0, 0, 0};
+	for(size_t i = 0; i < text.size(); i++){
+		double ts = stod(text[i]);
+		unsigned t, n;
+		size_t at = text[i].find("thread ");
+		if((ts < last) || !contains(text[i], " INFO  T") || !contains(text[i], "BinLogUT.cpp:") ||
+				(at == string::npos) || (sscanf(text[i].c_str() + at, "thread %u record %u", &t, &n) != 2) ||
+				(t >= 3) || (n != perThread[t])){
+			result = false;
+			break;
+		}
+		perThread[t]++;
+		last = ts;
+	}
+	return result;
+}
+
+
+bool TC22::testRun(){ // startFile - binary file and decodeFile
+	cout << ".";
+	bool result = true;
+	string filename = string("/tmp/ut-binlog-") + to_string(getpid()) + ".mexlog";
+	try{
+		BinLog::setLevel(BINLOG_INFO);
+		BinLog::startFile(filename);
+		string cause = string(80, 'x') + "ExceptionSerialCom::read:: timeout";
+		MEX_LOG_WARN("retry {} after {} us", 2, 1500u);
+		MEX_LOG_ERROR("{}: {}", "transfer", cause);
+		BinLog::stop();
+
+		// literals are resolved, the process that logged is not needed
+		ifstream in(filename.c_str(), std::ios::binary);
+		stringstream out;
+		unsigned long records = BinLog::decodeFile(in, out);
+		vector<string> text = lines(out.str());
+		if((records != 2) || (text.size() != 2) || !contains(text[0], "WARN  T") ||
+				!contains(text[0], "retry 2 after 1500 us") || !contains(text[1], "ERROR T") ||
+				!contains(text[1], "transfer: ...") || !contains(text[1], "read:: timeout")){
+			result = false;
+		}
+
+		// filtered by level
+		ifstream in2(filename.c_str(), std::ios::binary);
+		stringstream out2;
+		BinLog::decodeFile(in2, out2, BINLOG_ERROR);
+		if(lines(out2.str()).size() != 1){
+			result = false;
+		}
+
+		// a truncated file is reported
+		string bytes;
+		{
+			ifstream in3(filename.c_str(), std::ios::binary);
+			bytes.assign(std::istreambuf_iterator<char>(in3), std::istreambuf_iterator<char>());
+		}
+		stringstream cut(bytes.substr(0, bytes.size() - 12));
+		stringstream out3;
+		try{
+			BinLog::decodeFile(cut, out3);
+			result = false;
+		}catch(IException *e){
+			delete e;
+		}
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		delete e;
+		result = false;
+	}
+	remove(filename.c_str());
+	return result;
+}
+
+
+bool TC23::testRun(){ // MEX_LOG - nothing recorded below the level or without sink
+	cout << ".";
+	bool result = true;
+
+	// without sink
+	BinLog::stop();
+	if(BinLog::isEnabled(BINLOG_ERROR)){
+		result = false;
+	}
+	MEX_LOG_ERROR("not recorded {}", 1);
+
+	stringstream out;
+	BinLog::setLevel(BINLOG_ERROR);
+	BinLog::startText(out);
+	unsigned long written = BinLog::getWritten();
+	if(BinLog::isEnabled(BINLOG_WARN) || !BinLog::isEnabled(BINLOG_ERROR)){
+		result = false;
+	}
+	MEX_LOG_WARN("not recorded {}", 2);
+	MEX_LOG_ERROR("recorded {}", 3);
+	BinLog::flush();
+	BinLog::stop();
+	BinLog::setLevel(BINLOG_INFO);
+
+	if((out.str().find("recorded 3") == string::npos) || (lines(out.str()).size() != 1) ||
+			(BinLog::getWritten() != written + 1)){
+		result = false;
+	}
+	return result;
+}
+
+bool TC24::testRun(){ // local - the ring of an ended thread is reused
+	cout << ".";
+	bool result = true;
+	stringstream out;
+	BinLog::setLevel(BINLOG_INFO);
+	BinLog::startText(out);
+
+	// one thread after another, each ring is drained before the next starts
+	unsigned rings = 0;
+	for(unsigned t = 0; t < 20; t++){
+		thread worker([t](){
+			MEX_LOG_INFO("short thread {}", t);
+		});
+		worker.join();
+		BinLog::flush();
+		if(t == 0){
+			rings = BinLog::getRings();
+		}
+	}
+	vector<string> text = lines(out.str());
+	BinLog::stop();
+
+	if((text.size() != 20) || (BinLog::getRings() != rings)){
+		result = false;
+	}
+	return result;
+}
+
+} // ende namespace UT_BinLog
@@ -0,0 +1,65 @@
+/*
+ * BinLogUT.hpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+#ifndef UNITTESTS_BINLOGUT_HPP_
+#define UNITTESTS_BINLOGUT_HPP_
+
+
+#include "../SimplUnitTestFW.hpp"
+
+namespace UT_BinLog{
+
+bool execUnitTests(string xmlFilename);
+
+
+class TC11 : public TestCase{
+	TC11() : TestCase(){};
+public:
+	TC11(string s = string("BinLogEncoder - arguments, truncation and format")) : TestCase(s){};
+	virtual bool testRun(); // BinLogEncoder - arguments, truncation and format
+};
+
+class TC12 : public TestCase{
+	TC12() : TestCase(){};
+public:
+	TC12(string s = string("BinLogRing - full ring drops without blocking")) : TestCase(s){};
+	virtual bool testRun(); // BinLogRing - full ring drops without blocking
+};
+
+
+class TC21 : public TestCase{
+	TC21() : TestCase(){};
+public:
+	TC21(string s = string("startText - lines of several threads in time order")) : TestCase(s){};
+	virtual bool testRun(); // startText - lines of several threads in time order
+};
+
+class TC22 : public TestCase{
+	TC22() : TestCase(){};
+public:
+	TC22(string s = string("startFile - binary file and decodeFile")) : TestCase(s){};
+	virtual bool testRun(); // startFile - binary file and decodeFile
+};
+
+class TC23 : public TestCase{
+	TC23() : TestCase(){};
+public:
+	TC23(string s = string("MEX_LOG - nothing recorded below the level or without sink")) : TestCase(s){};
+	virtual bool testRun(); // MEX_LOG - nothing recorded below the level or without sink
+};
+
+class TC24 : public TestCase{
+	TC24() : TestCase(){};
+public:
+	TC24(string s = string("local - the ring of an ended thread is reused")) : TestCase(s){};
+	virtual bool testRun(); // local - the ring of an ended thread is reused
+};
+
+} // ende namespace UT_BinLog
+
+
+#endif /* UNITTESTS_BINLOGUT_HPP_ */
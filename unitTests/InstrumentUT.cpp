@@ -0,0 +1,290 @@
+/*
+ * InstrumentUT.cpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <cstring>
+#include <unistd.h>
+#include <poll.h>
+#include <termios.h>
+#include "../SimplUnitTestFW.hpp"
+#include "../Instrument.hpp"
+#include "../ServoMotor.hpp"
+#include "../Pololu.hpp"
+#include "../MaestroSimulator.hpp"
+#include "InstrumentUT.hpp"
+
+using namespace std;
+
+namespace UT_Instrument{
+
+bool execUnitTests(string xmlFilename){
+
+	// a unit a class
+	UnitTest unit("Instrument");
+
+	// a unit for each method
+	TestSuite TS01("Instrument");
+	TestSuite TS02("instrumentation");
+
+	// add all test suits to the unit
+	unit.addTestItem(&TS01);
+	unit.addTestItem(&TS02);
+
+	//
+	// test cases for test suite TS01
+	//
+	TC11 tc11("Instrument - allocations per thread");
+	TC12 tc12("Instrument - system calls");
+	TC13 tc13("TestCase - counts in the XML result");
+
+	// add specific test cases to test suite TS01
+	TS01.addTestItem(&tc11);
+	TS01.addTestItem(&tc12);
+	TS01.addTestItem(&tc13);
+
+	//
+	// test cases for test suite TS02
+	//
+	TC21 tc21("MEX_INSTRUMENT_CALL - counts per Pololu and ServoMotor call");
+	TC22 tc22("MEX_INSTRUMENT_CALL - steady state control path");
+
+	// add specific test cases to test suite TS02
+	TS02.addTestItem(&tc21);
+	TS02.addTestItem(&tc22);
+
+	// execute unit tests
+	unit.testExecution();
+	unit.writeResultsToFile(xmlFilename);
+
+	return unit.getResult();
+}
+
+
+static InstrumentSite* findSite(const char *name){
+	vector<InstrumentSite*> sites = Instrument::getSites();
+	for(size_t i = 0; i < sites.size(); i++){
+		if(strcmp(sites[i]->getName(), name) == 0){
+			return sites[i];
+		}
+	}
+	return nullptr;
+}
+
+
+bool TC11::testRun(){ // Instrument - allocations per thread
+	cout << ".";
+	bool result = true;
+
+	InstrumentCounts start = Instrument::current();
+	int *p = new int[10];
+	delete [] p;
+	{
+		vector<char> v(100);
+	}
+	InstrumentCounts d = Instrument::current() - start;
+
+	// the allocations of another thread are not counted here
+	InstrumentCounts other;
+	std::thread t([&other](){
+		InstrumentCounts s = Instrument::current();
+		char *q = new char[64];
+		delete [] q;
+		other = Instrument::current() - s;
+	});
+	t.join();
+
+	if(Instrument::isCompiledIn()){
+		if((d.allocs != 2) || (d.allocBytes != (10 * sizeof(int) + 100)) || (d.frees != 2)){
+			result = false;
+		}
+		if((other.allocs != 1) || (other.allocBytes != 64) || (other.frees != 1)){
+			result = false;
+		}
+	}else{
+		if((d.allocs != 0) || (d.allocBytes != 0) || (d.frees != 0) || (other.allocs != 0)){
+			result = false;
+		}
+	}
+	return result;
+}
+
+
+bool TC12::testRun(){ // Instrument - system calls
+	cout << ".";
+	bool result = true;
+	int fds[2];
+	if(pipe(fds) != 0){
+		return false;
+	}
+
+	InstrumentCounts start = Instrument::current();
+	char c = 'x';
+	if(write(fds[1], &c, 1) != 1){
+		result = false;
+	}
+	struct pollfd pfd = {fds[0], POLLIN, 0};
+	if(poll(&pfd, 1, 100) != 1){
+		result = false;
+	}
+	if(read(fds[0], &c, 1) != 1){
+		result = false;
+	}
+	tcflush(fds[0], TCIFLUSH); // fails on a pipe, but is a system call
+	close(fds[0]);
+	close(fds[1]);
+	InstrumentCounts d = Instrument::current() - start;
+
+	unsigned long expected[MEX_SYS_COUNT] = {1, 1, 1, 1, 0, 2};
+	for(unsigned i = 0; i < MEX_SYS_COUNT; i++){
+		if(d.syscalls[i] != (Instrument::isCompiledIn() ? expected[i] : 0)){
+			result = false;
+		}
+	}
+	if(d.getSyscalls() != (Instrument::isCompiledIn() ? 6u : 0u)){
+		result = false;
+	}
+	return result;
+}
+
+
+bool TC13::testRun(){ // TestCase - counts in the XML result
+	cout << ".";
+	bool result = true;
+
+	class Allocating : public TestCase{
+	public:
+		Allocating() : TestCase("allocating"){};
+	protected:
+		virtual bool testRun(){
+			char *p = new char[32];
+			delete [] p;
+			return true;
+		}
+	};
+
+	Allocating tc;
+	tc.testExecution();
+	string s = tc.toXmlStr();
+	if(s.find(">PASSED</TestCase>") == string::npos){
+		result = false;
+	}
+#ifdef MEX_INSTRUMENT
+	if(s.find("<TestCase name=\"allocating\" allocs=\"1\" allocBytes=\"32\" frees=\"1\" syscalls=\"0\"") != 0){
+		result = false;
+	}
+#else
+	if(s != string("<TestCase name=\"allocating\">PASSED</TestCase>")){
+		result = false;
+	}
+#endif
+	return result;
+}
+
+
+bool TC21::testRun(){ // MEX_INSTRUMENT_CALL - counts per Pololu and ServoMotor call
+	cout << ".";
+	bool result = true;
+	try{
+		MaestroSimulator sim(6);
+		MaestroPty pty(&sim);
+		pty.start();
+		Pololu pololu(pty.getPortName(), 9600);
+		pololu.openConnection();
+		ServoMotor servo(1, 6000, 3600, &pololu);
+
+		Instrument::resetSites();
+		servo.setPositionInDeg(10);
+		servo.setPositionInDeg(20);
+		servo.getPositionInAbs();
+
+		InstrumentSite *setDeg = findSite("ServoMotor::setPositionInDeg");
+		InstrumentSite *getAbs = findSite("ServoMotor::getPositionInAbs");
+		InstrumentSite *setPos = findSite("Pololu::setPosition");
+		InstrumentSite *getPos = findSite("Pololu::getPosition");
+#ifdef MEX_INSTRUMENT
+		if((setDeg == nullptr) || (getAbs == nullptr) || (setPos == nullptr) || (getPos == nullptr)){
+			result = false;
+		}else{
+			if((setDeg->calls != 2) || (getAbs->calls != 1) || (setPos->calls != 2) || (getPos->calls != 1)){
+				result = false;
+			}
+			// a command is at least one write, a query a write and a read
+			if((setPos->syscalls < 2) || (getPos->syscalls < 3)){
+				result = false;
+			}
+			// the counts of a servo call include the Pololu call below
+			if((setDeg->syscalls < setPos->syscalls) || (getAbs->syscalls < getPos->syscalls)){
+				result = false;
+			}
+		}
+		string xml = Instrument::sitesToXml();
+		if(xml.find("<ApiCall name=\"Pololu::setPosition\" calls=\"2\"") == string::npos){
+			result = false;
+		}
+#else
+		// compiled out: the sites do not exist
+		if((setDeg != nullptr) || (getPos != nullptr) || !Instrument::sitesToXml().empty()){
+			result = false;
+		}
+#endif
+
+		pololu.closeConnection();
+		pty.stop();
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		delete e;
+		return false;
+	}
+	return result;
+}
+
+
+bool TC22::testRun(){ // MEX_INSTRUMENT_CALL - steady state control path
+	cout << ".";
+	bool result = true;
+	try{
+		MaestroSimulator sim(6);
+		MaestroPty pty(&sim);
+		pty.start();
+		Pololu pololu(pty.getPortName(), 9600);
+		pololu.openConnection();
+		ServoMotor servo(1, 6000, 3600, &pololu);
+
+		// warm up, then the control path must not touch the heap
+		servo.setPositionInDeg(0);
+		servo.getPositionInAbs();
+
+		Instrument::resetSites();
+		for(unsigned i = 0; i < 10; i++){
+			servo.setPositionInDeg(i);
+			servo.getPositionInAbs();
+		}
+		const char *path[] = {"ServoMotor::setPositionInDeg", "ServoMotor::getPositionInAbs",
+							  "Pololu::setPosition", "Pololu::getPosition"};
+		for(unsigned i = 0; i < 4; i++){
+			InstrumentSite *site = findSite(path[i]);
+			if(Instrument::isCompiledIn()){
+				if((site == nullptr) || (site->calls != 10) || (site->allocs != 0)){
+					result = false;
+				}
+			}
+		}
+
+		pololu.closeConnection();
+		pty.stop();
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		delete e;
+		return false;
+	}
+	return result;
+}
+
+} // ende namespace UT_Instrument
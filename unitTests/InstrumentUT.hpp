@@ -0,0 +1,58 @@
+/*
+ * InstrumentUT.hpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+#ifndef UNITTESTS_INSTRUMENTUT_HPP_
+#define UNITTESTS_INSTRUMENTUT_HPP_
+
+
+#include "../SimplUnitTestFW.hpp"
+
+namespace UT_Instrument{
+
+bool execUnitTests(string xmlFilename);
+
+
+class TC11 : public TestCase{
+	TC11() : TestCase(){};
+public:
+	TC11(string s = string("Instrument - allocations per thread")) : TestCase(s){};
+	virtual bool testRun(); // Instrument - allocations per thread
+};
+
+class TC12 : public TestCase{
+	TC12() : TestCase(){};
+public:
+	TC12(string s = string("Instrument - system calls")) : TestCase(s){};
+	virtual bool testRun(); // Instrument - system calls
+};
+
+class TC13 : public TestCase{
+	TC13() : TestCase(){};
+public:
+	TC13(string s = string("TestCase - counts in the XML result")) : TestCase(s){};
+	virtual bool testRun(); // TestCase - counts in the XML result
+};
+
+
+class TC21 : public TestCase{
+	TC21() : TestCase(){};
+public:
+	TC21(string s = string("MEX_INSTRUMENT_CALL - counts per Pololu and ServoMotor call")) : TestCase(s){};
+	virtual bool testRun(); // MEX_INSTRUMENT_CALL - counts per Pololu and ServoMotor call
+};
+
+class TC22 : public TestCase{
+	TC22() : TestCase(){};
+public:
+	TC22(string s = string("MEX_INSTRUMENT_CALL - steady state control path")) : TestCase(s){};
+	virtual bool testRun(); // MEX_INSTRUMENT_CALL - steady state control path
+};
+
+} // ende namespace UT_Instrument
+
+
+#endif /* UNITTESTS_INSTRUMENTUT_HPP_ */
@@ -0,0 +1,189 @@
+/*
+ * MiniSscUT.cpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+
+#include <string>
+#include <cstdlib>
+#include "../SimplUnitTestFW.hpp"
+#include "../PololuFrames.hpp"
+#include "../Pololu.hpp"
+#include "../ServoMotor.hpp"
+#include "../MaestroSimulator.hpp"
+#include "MiniSscUT.hpp"
+
+using namespace std;
+
+namespace UT_MiniSsc{
+
+bool execUnitTests(string xmlFilename){
+
+	// a unit a class
+	UnitTest unit("MiniSsc");
+
+	// a unit for each method
+	TestSuite TS01("encoder");
+	TestSuite TS02("mapping");
+	TestSuite TS03("encoding selection");
+
+	// add all test suits to the unit
+	unit.addTestItem(&TS01);
+	unit.addTestItem(&TS02);
+	unit.addTestItem(&TS03);
+
+	//
+	// test cases for test suite TS01
+	//
+	TC11 tc11("miniSscTarget - 3 byte frame with and without CRC");
+
+	// add specific test cases to test suite TS01
+	TS01.addTestItem(&tc11);
+
+	//
+	// test cases for test suite TS02
+	//
+	TC21 tc21("mapPosValue2MiniSsc - neutral, limits and round trip");
+
+	// add specific test cases to test suite TS02
+	TS02.addTestItem(&tc21);
+
+	//
+	// test cases for test suite TS03
+	//
+	TC31 tc31("setPositionInAbs - exact positions use the Maestro command");
+	TC32 tc32("setPositionInAbs - coarse positions use the Mini SSC command");
+
+	// add specific test cases to test suite TS03
+	TS03.addTestItem(&tc31);
+	TS03.addTestItem(&tc32);
+
+	// execute unit tests
+	unit.testExecution();
+	unit.writeResultsToFile(xmlFilename);
+
+	return unit.getResult();
+}
+
+
+
+bool TC11::testRun(){ // miniSscTarget - 3 byte frame with and without CRC
+	cout << ".";
+	unsigned char frame[POLOLU_MAX_FRAME];
+	if(PololuFrames::miniSscTarget(frame, 2, 200) != 3){
+		return false;
+	}
+	if((frame[0] != 0xFF) || (frame[1] != 2) || (frame[2] != 200)){
+		return false;
+	}
+	if(PololuFrames::miniSscTarget(frame, 2, 200, true) != 4){
+		return false;
+	}
+	return (pololuCrc7(frame, 4) == 0);
+}
+
+
+bool TC21::testRun(){ // mapPosValue2MiniSsc - neutral, limits and round trip
+	cout << ".";
+	bool result = true;
+	MaestroSimulator sim(6);
+	MaestroPty pty(&sim);
+	try{
+		pty.start();
+		Pololu pololu(pty.getPortName(), 9600);
+		pololu.openConnection();
+		ServoMotorPololuBase servo(0, 6000, 2000, &pololu);
+
+		if((servo.mapPosValue2MiniSsc(6000) != 127) ||
+				(servo.mapPosValue2MiniSsc(4000) != 0) ||
+				(servo.mapPosValue2MiniSsc(8000) != 254)){
+			result = false;
+		}
+		if((servo.mapMiniSsc2PosValue(127) != 6000) ||
+				(servo.mapMiniSsc2PosValue(0) != 4000) ||
+				(servo.mapMiniSsc2PosValue(254) != 8000)){
+			result = false;
+		}
+		// one step of the 8 bit scale is delta / 127 (about 16 units)
+		for(unsigned short p = 4000; p <= 8000; p += 7){
+			int back = servo.mapMiniSsc2PosValue(servo.mapPosValue2MiniSsc(p));
+			if(abs(back - p) > 9){
+				result = false;
+			}
+		}
+		pololu.closeConnection();
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		result = false;
+	}
+	pty.stop();
+	return result;
+}
+
+
+bool TC31::testRun(){ // setPositionInAbs - exact positions use the Maestro command
+	cout << ".";
+	bool result = true;
+	MaestroSimulator sim(6);
+	MaestroPty pty(&sim);
+	try{
+		pty.start();
+		Pololu pololu(pty.getPortName(), 9600);
+		pololu.openConnection();
+		ServoMotorPololuBase servo(1, 6000, 2000, &pololu);
+
+		unsigned long bytes = sim.getBytesIn();
+		servo.setPositionInAbs(6123);
+		// set target (4 bytes) and read back (2 bytes)
+		if(sim.getBytesIn() - bytes != 6){
+			result = false;
+		}
+		if(sim.getTarget(1) != 6123){
+			result = false;
+		}
+		pololu.closeConnection();
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		result = false;
+	}
+	pty.stop();
+	return result;
+}
+
+
+bool TC32::testRun(){ // setPositionInAbs - coarse positions use the Mini SSC command
+	cout << ".";
+	bool result = true;
+	MaestroSimulator sim(6);
+	MaestroPty pty(&sim);
+	try{
+		sim.setMiniSscRange(1, 6000, 2000);
+		pty.start();
+		Pololu pololu(pty.getPortName(), 9600);
+		pololu.openConnection();
+		ServoMotorPololuBase servo(1, 6000, 2000, &pololu);
+		servo.setPositionPrecision(10);
+
+		for(unsigned short p = 4100; p < 8000; p += 500){
+			unsigned long bytes = sim.getBytesIn();
+			servo.setPositionInAbs(p);
+			// Mini SSC target (3 bytes) and read back (2 bytes)
+			if(sim.getBytesIn() - bytes != 5){
+				result = false;
+			}
+			if(abs(((int) sim.getTarget(1)) - p) > 10){
+				result = false;
+			}
+		}
+		pololu.closeConnection();
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		result = false;
+	}
+	pty.stop();
+	return result;
+}
+
+} // ende namespace UT_MiniSsc
@@ -0,0 +1,52 @@
+/*
+ * MiniSscUT.hpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+#ifndef UNITTESTS_MINISSCUT_HPP_
+#define UNITTESTS_MINISSCUT_HPP_
+
+
+#include "../SimplUnitTestFW.hpp"
+
+namespace UT_MiniSsc{
+
+bool execUnitTests(string xmlFilename);
+
+
+class TC11 : public TestCase{
+	TC11() : TestCase(){};
+public:
+	TC11(string s = string("miniSscTarget - 3 byte frame with and without CRC")) : TestCase(s){};
+	virtual bool testRun(); // miniSscTarget - 3 byte frame with and without CRC
+};
+
+
+class TC21 : public TestCase{
+	TC21() : TestCase(){};
+public:
+	TC21(string s = string("mapPosValue2MiniSsc - neutral, limits and round trip")) : TestCase(s){};
+	virtual bool testRun(); // mapPosValue2MiniSsc - neutral, limits and round trip
+};
+
+
+class TC31 : public TestCase{
+	TC31() : TestCase(){};
+public:
+	TC31(string s = string("setPositionInAbs - exact positions use the Maestro command")) : TestCase(s){};
+	virtual bool testRun(); // setPositionInAbs - exact positions use the Maestro command
+};
+
+class TC32 : public TestCase{
+	TC32() : TestCase(){};
+public:
+	TC32(string s = string("setPositionInAbs - coarse positions use the Mini SSC command")) : TestCase(s){};
+	virtual bool testRun(); // setPositionInAbs - coarse positions use the Mini SSC command
+};
+
+} // ende namespace UT_MiniSsc
+
+
+#endif /* UNITTESTS_MINISSCUT_HPP_ */
@@ -0,0 +1,146 @@
+/*
+ * PerfCountersUT.cpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+
+#include <string>
+#include <cstdlib>
+#include "../SimplUnitTestFW.hpp"
+#include "../PerfCounters.hpp"
+#include "PerfCountersUT.hpp"
+
+using namespace std;
+
+namespace UT_PerfCounters{
+
+bool execUnitTests(string xmlFilename){
+
+	// a unit a class
+	UnitTest unit("PerfCounters");
+
+	// a unit for each method
+	TestSuite TS01("PerfCounters");
+
+	// add all test suits to the unit
+	unit.addTestItem(&TS01);
+
+	//
+	// test cases for test suite TS01
+	//
+	TC11 tc11("PerfCounters - events counted or left out");
+	TC12 tc12("PerfScope - differences and operations");
+	TC13 tc13("PerfSample - per operation and n/a");
+
+	// add specific test cases to test suite TS01
+	TS01.addTestItem(&tc11);
+	TS01.addTestItem(&tc12);
+	TS01.addTestItem(&tc13);
+
+	// execute unit tests
+	unit.testExecution();
+	unit.writeResultsToFile(xmlFilename);
+
+	return unit.getResult();
+}
+
+
+static volatile unsigned long sink;
+
+static void spin(unsigned long n){
+	for(unsigned long i = 0; i < n; i++){
+		sink = sink + i;
+	}
+}
+
+
+bool TC11::testRun(){ // PerfCounters - events counted or left out
+	cout << ".";
+	bool result = true;
+
+	// whatever the host allows: no exception, the task clock is valid
+	PerfCounters counters;
+	PerfSample s = counters.read();
+	if(!s.valid[PERF_TASK_CLOCK]){
+		result = false;
+	}
+	for(unsigned e = 0; e < PERF_EVENT_COUNT; e++){
+		if((e != PERF_TASK_CLOCK) && (s.valid[e] != counters.isCounted((PerfEvent) e))){
+			result = false;
+		}
+		if(!counters.isCounted((PerfEvent) e) && counters.getUnavailableReason().empty()){
+			result = false;
+		}
+	}
+
+	// turned off
+	setenv("MEX_PERF", "0", 1);
+	PerfCounters off;
+	unsetenv("MEX_PERF");
+	s = off.read();
+	if(off.hasHardware() || off.isCounted(PERF_TASK_CLOCK) || (off.getUnavailableReason() != "MEX_PERF=0") ||
+			!s.valid[PERF_TASK_CLOCK] || s.valid[PERF_CYCLES]){
+		result = false;
+	}
+	return result;
+}
+
+
+bool TC12::testRun(){ // PerfScope - differences and operations
+	cout << ".";
+	bool result = true;
+	PerfCounters counters;
+	PerfSample s;
+
+	{
+		PerfScope scope(counters, s, 1000);
+		spin(2000000);
+	}
+	{
+		PerfScope scope(counters, s, 1000);
+		spin(2000000);
+	}
+	if((s.ops != 2000) || !s.valid[PERF_TASK_CLOCK] || (s.value[PERF_TASK_CLOCK] == 0)){
+		result = false;
+	}
+	// a loop of 4 million iterations takes more instructions than that
+	if(counters.isCounted(PERF_INSTRUCTIONS) && (s.value[PERF_INSTRUCTIONS] < 4000000)){
+		result = false;
+	}
+	if(counters.isCounted(PERF_CYCLES) && (s.value[PERF_CYCLES] == 0)){
+		result = false;
+	}
+	return result;
+}
+
+
+bool TC13::testRun(){ // PerfSample - per operation and n/a
+	cout << ".";
+	bool result = true;
+	PerfSample s;
+
+	if((s.perOp(PERF_CYCLES) != 0.0) || (s.ipc() != 0.0)){
+		result = false;
+	}
+	s.ops = 4;
+	s.value[PERF_CYCLES] = 400;        s.valid[PERF_CYCLES] = true;
+	s.value[PERF_INSTRUCTIONS] = 800;  s.valid[PERF_INSTRUCTIONS] = true;
+	s.value[PERF_TASK_CLOCK] = 100;    s.valid[PERF_TASK_CLOCK] = true;
+	if((s.perOp(PERF_CYCLES) != 100.0) || (s.ipc() != 2.0)){
+		result = false;
+	}
+	string line = s.toString();
+	if((line.find("100.00") == string::npos) || (line.find("200.00") == string::npos) ||
+			(line.find("2.00") == string::npos) || (line.find("n/a") == string::npos)){
+		result = false;
+	}
+	s.valid[PERF_CYCLES] = false;
+	if((s.ipc() != 0.0) || (s.toString().find("n/a", line.find("n/a") + 1) == string::npos)){
+		result = false;
+	}
+	return result;
+}
+
+} // ende namespace UT_PerfCounters
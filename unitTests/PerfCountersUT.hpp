@@ -0,0 +1,43 @@
+/*
+ * PerfCountersUT.hpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+#ifndef UNITTESTS_PERFCOUNTERSUT_HPP_
+#define UNITTESTS_PERFCOUNTERSUT_HPP_
+
+
+#include "../SimplUnitTestFW.hpp"
+
+namespace UT_PerfCounters{
+
+bool execUnitTests(string xmlFilename);
+
+
+class TC11 : public TestCase{
+	TC11() : TestCase(){};
+public:
+	TC11(string s = string("PerfCounters - events counted or left out")) : TestCase(s){};
+	virtual bool testRun(); // PerfCounters - events counted or left out
+};
+
+class TC12 : public TestCase{
+	TC12() : TestCase(){};
+public:
+	TC12(string s = string("PerfScope - differences and operations")) : TestCase(s){};
+	virtual bool testRun(); // PerfScope - differences and operations
+};
+
+class TC13 : public TestCase{
+	TC13() : TestCase(){};
+public:
+	TC13(string s = string("PerfSample - per operation and n/a")) : TestCase(s){};
+	virtual bool testRun(); // PerfSample - per operation and n/a
+};
+
+} // ende namespace UT_PerfCounters
+
+
+#endif /* UNITTESTS_PERFCOUNTERSUT_HPP_ */
@@ -0,0 +1,210 @@
+/*
+ * PololuErrorsUT.cpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+
+#include <string>
+#include "../SimplUnitTestFW.hpp"
+#include "../Pololu.hpp"
+#include "../PololuErrors.hpp"
+#include "PololuErrorsUT.hpp"
+
+using namespace std;
+
+namespace UT_PololuErrors{
+
+/**
+ *
+ * \brief Listener that records the last event delivered by the monitor.
+ *
+ */
+class RecordingListener : public IPololuErrorListener{
+public:
+	void errorFlagsChanged(const PololuErrorEvent &event){
+		last_ = event;
+		count_++;
+	}
+	PololuErrorEvent last_;
+	unsigned count_ = 0;
+};
+
+
+bool execUnitTests(string xmlFilename){
+
+	// a unit a class
+	UnitTest unit("PololuErrors");
+
+	// a unit for each method
+	TestSuite TS01("PololuErrorFlags");
+	TestSuite TS02("PololuErrorMonitor");
+	TestSuite TS03("getErrorFlags");
+
+	// add all test suits to the unit
+	unit.addTestItem(&TS01);
+	unit.addTestItem(&TS02);
+	unit.addTestItem(&TS03);
+
+	//
+	// test cases for test suite TS01
+	//
+	TC11 tc11("PololuErrorFlags - decode single bits");
+	TC12 tc12("PololuErrorFlags - serial and script groups");
+	TC13 tc13("PololuErrorFlags - undefined bits");
+
+	// add specific test cases to test suite TS01
+	TS01.addTestItem(&tc11);
+	TS01.addTestItem(&tc12);
+	TS01.addTestItem(&tc13);
+
+	//
+	// test cases for test suite TS02
+	//
+	TC21 tc21("PololuErrorMonitor - poll interval");
+	TC22 tc22("PololuErrorMonitor - events only on transitions");
+	TC23 tc23("PololuErrorMonitor - raised and cleared bits");
+
+	// add specific test cases to test suite TS02
+	TS02.addTestItem(&tc21);
+	TS02.addTestItem(&tc22);
+	TS02.addTestItem(&tc23);
+
+	//
+	// test cases for test suite TS03
+	//
+	TC31 tc31("getErrorFlags - call with closed communication channel");
+
+	// add specific test cases to test suite TS03
+	TS03.addTestItem(&tc31);
+
+	// execute unit tests
+	unit.testExecution();
+	unit.writeResultsToFile(xmlFilename);
+
+	return unit.getResult();
+}
+
+
+
+bool TC11::testRun(){ // PololuErrorFlags - decode single bits
+	cout << ".";
+	PololuErrorFlags none(0);
+	if(none.any() || (none.toString() != "none")){
+		return false;
+	}
+
+	PololuErrorFlags overrun(POLOLU_ERR_SERIAL_OVERRUN);
+	if(!overrun.serialOverrunError() || overrun.serialSignalError() || overrun.serialCrcError()){
+		return false;
+	}
+
+	PololuErrorFlags f(POLOLU_ERR_SERIAL_SIGNAL | POLOLU_ERR_SERIAL_CRC | POLOLU_ERR_SCRIPT_PROGRAM_COUNTER);
+	if(!f.serialSignalError() || !f.serialCrcError() || !f.scriptProgramCounterError()){
+		return false;
+	}
+	if(f.serialProtocolError() || f.serialTimeoutError() || f.scriptStackError()){
+		return false;
+	}
+	return (f.toString() == "SerialSignal|SerialCRC|ScriptProgramCounter");
+}
+
+bool TC12::testRun(){ // PololuErrorFlags - serial and script groups
+	cout << ".";
+	PololuErrorFlags serial(POLOLU_ERR_SERIAL_PROTOCOL);
+	PololuErrorFlags script(POLOLU_ERR_SCRIPT_CALL_STACK);
+	if(!serial.hasSerialErrors() || serial.hasScriptErrors()){
+		return false;
+	}
+	if(script.hasSerialErrors() || !script.hasScriptErrors()){
+		return false;
+	}
+	return true;
+}
+
+bool TC13::testRun(){ // PololuErrorFlags - undefined bits
+	cout << ".";
+	if(!PololuErrorFlags::isValid(0x01FF)){
+		return false;
+	}
+	if(PololuErrorFlags::isValid(0x0200) || PololuErrorFlags::isValid(0xFFFF)){
+		return false;
+	}
+	return (PololuErrorFlags(0x0201).toString() == "SerialSignal|Undefined");
+}
+
+
+bool TC21::testRun(){ // PololuErrorMonitor - poll interval
+	cout << ".";
+	PololuErrorMonitor m(NULL, 3);
+	unsigned due = 0;
+	for(int i = 0; i < 9; i++){
+		if(m.isPollDue()){
+			due++;
+		}
+	}
+	if(due != 3){
+		return false;
+	}
+
+	m.setPollInterval(0); // treated as every slot
+	return (m.isPollDue() && m.isPollDue());
+}
+
+bool TC22::testRun(){ // PololuErrorMonitor - events only on transitions
+	cout << ".";
+	RecordingListener l;
+	PololuErrorMonitor m(&l, 1);
+	m.update(0);
+	m.update(0);
+	if(l.count_ != 0){
+		return false;
+	}
+	m.update(POLOLU_ERR_SERIAL_OVERRUN);
+	m.update(POLOLU_ERR_SERIAL_OVERRUN);
+	if(l.count_ != 1){
+		return false;
+	}
+	m.update(0);
+	if(l.count_ != 2){
+		return false;
+	}
+	return ((m.getPollCount() == 5) && (m.getEventCount() == 2) &&
+			(m.getAccumulatedFlags().getRaw() == POLOLU_ERR_SERIAL_OVERRUN));
+}
+
+bool TC23::testRun(){ // PololuErrorMonitor - raised and cleared bits
+	cout << ".";
+	RecordingListener l;
+	PololuErrorMonitor m(&l, 1);
+	m.update(POLOLU_ERR_SERIAL_SIGNAL | POLOLU_ERR_SERIAL_CRC);
+	m.update(POLOLU_ERR_SERIAL_CRC | POLOLU_ERR_SCRIPT_STACK);
+	if(l.last_.raised != POLOLU_ERR_SCRIPT_STACK){
+		return false;
+	}
+	if(l.last_.cleared != POLOLU_ERR_SERIAL_SIGNAL){
+		return false;
+	}
+	if(l.last_.previous.getRaw() != (POLOLU_ERR_SERIAL_SIGNAL | POLOLU_ERR_SERIAL_CRC)){
+		return false;
+	}
+	return (m.getLastFlags() == l.last_.current);
+}
+
+
+bool TC31::testRun(){// getErrorFlags - call with closed communication channel
+	cout << ".";
+	try{
+		Pololu p("/dev/ttyACM0",9600);
+		p.getErrorFlags();
+		return false;
+	}catch(IException *e){
+		return true;
+	}catch(...){
+		return false;
+	}
+	return false;
+}
+
+}// ende namespace UT_PololuErrors
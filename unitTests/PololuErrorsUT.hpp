@@ -0,0 +1,73 @@
+/*
+ * PololuErrorsUT.hpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+#ifndef UNITTESTS_POLOLUERRORSUT_HPP_
+#define UNITTESTS_POLOLUERRORSUT_HPP_
+
+
+#include "../SimplUnitTestFW.hpp"
+
+namespace UT_PololuErrors{
+
+bool execUnitTests(string xmlFilename);
+
+
+class TC11 : public TestCase{
+	TC11() : TestCase(){};
+public:
+	TC11(string s = string("PololuErrorFlags - decode single bits")) : TestCase(s){};
+	virtual bool testRun(); // PololuErrorFlags - decode single bits
+};
+
+class TC12 : public TestCase{
+	TC12() : TestCase(){};
+public:
+	TC12(string s = string("PololuErrorFlags - serial and script groups")) : TestCase(s){};
+	virtual bool testRun(); // PololuErrorFlags - serial and script groups
+};
+
+class TC13 : public TestCase{
+	TC13() : TestCase(){};
+public:
+	TC13(string s = string("PololuErrorFlags - undefined bits")) : TestCase(s){};
+	virtual bool testRun(); // PololuErrorFlags - undefined bits
+};
+
+
+class TC21 : public TestCase{
+	TC21() : TestCase(){};
+public:
+	TC21(string s = string("PololuErrorMonitor - poll interval")) : TestCase(s){};
+	virtual bool testRun(); // PololuErrorMonitor - poll interval
+};
+
+class TC22 : public TestCase{
+	TC22() : TestCase(){};
+public:
+	TC22(string s = string("PololuErrorMonitor - events only on transitions")) : TestCase(s){};
+	virtual bool testRun(); // PololuErrorMonitor - events only on transitions
+};
+
+class TC23 : public TestCase{
+	TC23() : TestCase(){};
+public:
+	TC23(string s = string("PololuErrorMonitor - raised and cleared bits")) : TestCase(s){};
+	virtual bool testRun(); // PololuErrorMonitor - raised and cleared bits
+};
+
+
+class TC31 : public TestCase{
+	TC31() : TestCase(){};
+public:
+	TC31(string s = string("getErrorFlags - call with closed communication channel")) : TestCase(s){};
+	virtual bool testRun(); // getErrorFlags - call with closed communication channel
+};
+
+} // ende namespace UT_PololuErrors
+
+
+#endif /* UNITTESTS_POLOLUERRORSUT_HPP_ */
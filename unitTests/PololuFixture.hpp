@@ -0,0 +1,106 @@
+/*
+ * PololuFixture.hpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+#ifndef UNITTESTS_POLOLUFIXTURE_HPP_
+#define UNITTESTS_POLOLUFIXTURE_HPP_
+
+
+#include "../SimplUnitTestFW.hpp"
+#include "../Pololu.hpp"
+
+
+/**
+ *
+ * \brief One controller connection shared by the test cases of a suite.
+ * The connection is opened by the first test case asking for it and
+ * stays open for the following ones; a test case that closed it gets it
+ * reopened. Without controller open() throws like openConnection(), so
+ * the test cases behave as if they had opened their own connection.
+ *
+ */
+class PololuFixture : public TestFixture{
+public:
+	PololuFixture(const char *portName = "/dev/ttyACM0", unsigned short baudRate = 9600)
+		: portName_(portName), baudRate_(baudRate){};
+	virtual ~PololuFixture(){tearDown();};
+
+	virtual bool setUp(){
+		try{
+			pololu_ = new Pololu(portName_, baudRate_);
+			return true;
+		}catch(IException *e){
+			error_ = e->getMsg();
+			delete e;
+			return false;
+		}
+	}
+
+	virtual bool tearDown(){
+		if(pololu_ != nullptr){
+			delete pololu_; // closes the connection
+			pololu_ = nullptr;
+		}
+		return true;
+	}
+
+	/**
+	 *
+	 * \brief Clears the error register left by the previous test case.
+	 * A connection that does not answer is closed and opened again by
+	 * the next open().
+	 *
+	 */
+	virtual bool reset(){
+		if((pololu_ != nullptr) && pololu_->isConnectionOpen()){
+			try{
+				pololu_->getErrors();
+			}catch(IException *e){
+				delete e;
+				try{
+					pololu_->closeConnection();
+				}catch(IException *e2){
+					delete e2;
+				}
+			}
+		}
+		return true;
+	}
+
+	/**
+	 *
+	 * \brief Returns the open connection. If it cannot be opened an
+	 * exception (IException) is thrown.
+	 *
+	 */
+	Pololu& open(){
+		if(!pololu_->isConnectionOpen()){
+			pololu_->openConnection();
+		}
+		return *pololu_;
+	}
+
+	/**
+	 *
+	 * \brief The fixture of the test case or of an enclosing suite.
+	 *
+	 */
+	static PololuFixture& of(TestFixture *fixture){
+		PololuFixture *f = (fixture != nullptr) ? fixture->find<PololuFixture>() : nullptr;
+		if(f == nullptr){
+			throw new ExceptionPololu(string("PololuFixture:: the suite has no Pololu fixture."));
+		}
+		return *f;
+	}
+
+protected:
+	const char     *portName_;
+	unsigned short  baudRate_;
+	Pololu         *pololu_ = nullptr;
+};
+
+
+#endif /* UNITTESTS_POLOLUFIXTURE_HPP_ */
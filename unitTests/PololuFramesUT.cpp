@@ -0,0 +1,218 @@
+/*
+ * PololuFramesUT.cpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+
+#include <string>
+#include <random>
+#include <unistd.h>
+#include "../SimplUnitTestFW.hpp"
+#include "../PololuFrames.hpp"
+#include "../Pololu.hpp"
+#include "../MaestroSimulator.hpp"
+#include "PololuFramesUT.hpp"
+
+using namespace std;
+
+namespace UT_PololuFrames{
+
+bool execUnitTests(string xmlFilename){
+
+	// a unit a class
+	UnitTest unit("PololuFrames");
+
+	// a unit for each method
+	TestSuite TS01("CRC-7");
+	TestSuite TS02("encoders");
+	TestSuite TS03("Pololu CRC mode");
+
+	// add all test suits to the unit
+	unit.addTestItem(&TS01);
+	unit.addTestItem(&TS02);
+	unit.addTestItem(&TS03);
+
+	//
+	// test cases for test suite TS01
+	//
+	TC11 tc11("pololuCrc7 - example of the Maestro documentation");
+	TC12 tc12("pololuCrc7 - lookup table equals bit wise reference");
+
+	// add specific test cases to test suite TS01
+	TS01.addTestItem(&tc11);
+	TS01.addTestItem(&tc12);
+
+	//
+	// test cases for test suite TS02
+	//
+	TC21 tc21("PololuFrames - encoders with and without CRC byte");
+
+	// add specific test cases to test suite TS02
+	TS02.addTestItem(&tc21);
+
+	//
+	// test cases for test suite TS03
+	//
+	TC31 tc31("setCrcMode - commands accepted by controller with CRC enabled");
+	TC32 tc32("setCrcMode - commands without CRC are rejected");
+
+	// add specific test cases to test suite TS03
+	TS03.addTestItem(&tc31);
+	TS03.addTestItem(&tc32);
+
+	// execute unit tests
+	unit.testExecution();
+	unit.writeResultsToFile(xmlFilename);
+
+	return unit.getResult();
+}
+
+
+
+bool TC11::testRun(){ // pololuCrc7 - example of the Maestro documentation
+	cout << ".";
+	// https://www.pololu.com/docs/0J40/5.d: 0x83, 0x01 has the CRC 0x17
+	unsigned char message[] = {0x83, 0x01, 0x00};
+	if(pololuCrc7(message, 2) != 0x17){
+		return false;
+	}
+	if(pololuCrc7Bitwise(message, 2) != 0x17){
+		return false;
+	}
+	// a frame including its CRC byte checks to 0
+	message[2] = 0x17;
+	return (pololuCrc7(message, 3) == 0);
+}
+
+
+bool TC12::testRun(){ // pololuCrc7 - lookup table equals bit wise reference
+	cout << ".";
+	std::minstd_rand rnd(7);
+	unsigned char message[64];
+	for(unsigned round = 0; round < 200; round++){
+		unsigned length = rnd() % sizeof(message);
+		for(unsigned i = 0; i < length; i++){
+			message[i] = rnd() & 0xFF;
+		}
+		if(pololuCrc7(message, length) != pololuCrc7Bitwise(message, length)){
+			return false;
+		}
+	}
+	return true;
+}
+
+
+bool TC21::testRun(){ // PololuFrames - encoders with and without CRC byte
+	cout << ".";
+	unsigned char frame[POLOLU_MAX_FRAME];
+
+	// example of the Maestro documentation: channel 0 to 1500 us
+	if(PololuFrames::setTarget(frame, 0, 6000) != 4){
+		return false;
+	}
+	if((frame[0] != 0x84) || (frame[1] != 0x00) || (frame[2] != 0x70) || (frame[3] != 0x2E)){
+		return false;
+	}
+	if(PololuFrames::setTarget(frame, 0, 6000, true) != 5){
+		return false;
+	}
+	if(frame[4] != pololuCrc7Bitwise(frame, 4)){
+		return false;
+	}
+
+	if((PololuFrames::getPosition(frame, 3) != 2) || (frame[0] != 0x90) || (frame[1] != 3)){
+		return false;
+	}
+	if((PololuFrames::getPosition(frame, 3, true) != 3) || (pololuCrc7(frame, 3) != 0)){
+		return false;
+	}
+	if((PololuFrames::getErrors(frame, true) != 2) || (frame[0] != 0xA1) || (pololuCrc7(frame, 2) != 0)){
+		return false;
+	}
+	if((PololuFrames::setSpeed(frame, 1, 140) != 4) || (frame[0] != 0x87) || (frame[2] != (140 & 0x7F)) || (frame[3] != 1)){
+		return false;
+	}
+	return true;
+}
+
+
+bool TC31::testRun(){ // setCrcMode - commands accepted by controller with CRC enabled
+	cout << ".";
+	bool result = true;
+	MaestroSimulator sim(6);
+	MaestroPty pty(&sim);
+	try{
+		sim.setCrcEnabled(true);
+		sim.setPosition(1, 5000);
+		pty.start();
+		Pololu pololu(pty.getPortName(), 9600);
+		pololu.setCrcMode(true);
+		pololu.openConnection();
+
+		IPololu &controller = pololu;
+		controller.setSpeed(1, 0);
+		controller.setAcceleration(1, 0);
+		controller.setPosition(1, 7000);
+		// the controller updates the pulses every 10 ms
+		for(unsigned i = 0; (i < 20) && pololu.getMovingState(); i++){
+			usleep(5000);
+		}
+		if(controller.getPosition(1) != 7000){
+			result = false;
+		}
+		if(pololu.getErrors() != 0){
+			result = false;
+		}
+		unsigned short servos[] = {0, 1};
+		unsigned short positions[2];
+		pololu.getPositions(servos, 2, positions);
+		if((positions[0] != 6000) || (positions[1] != 7000)){
+			result = false;
+		}
+		pololu.closeConnection();
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		result = false;
+	}
+	pty.stop();
+	return result;
+}
+
+
+bool TC32::testRun(){ // setCrcMode - commands without CRC are rejected
+	cout << ".";
+	bool result = false;
+	MaestroSimulator sim(6);
+	MaestroPty pty(&sim);
+	try{
+		sim.setCrcEnabled(true);
+		pty.start();
+		Pololu pololu(pty.getPortName(), 9600);
+		pololu.openConnection();
+		IPololu &controller = pololu;
+		controller.setPosition(1, 7000);
+		try{
+			controller.getPosition(1);
+		}catch(IException *e){
+			delete e;
+			result = true;
+		}
+		pololu.closeConnection();
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		result = false;
+	}
+	pty.stop();
+	if(sim.getTarget(1) != 6000){
+		result = false;
+	}
+	// the next command byte cuts the frame short before its CRC byte
+	if((sim.peekErrors() & (POLOLU_ERR_SERIAL_CRC | POLOLU_ERR_SERIAL_PROTOCOL)) == 0){
+		result = false;
+	}
+	return result;
+}
+
+} // ende namespace UT_PololuFrames
@@ -0,0 +1,59 @@
+/*
+ * PololuFramesUT.hpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+#ifndef UNITTESTS_POLOLUFRAMESUT_HPP_
+#define UNITTESTS_POLOLUFRAMESUT_HPP_
+
+
+#include "../SimplUnitTestFW.hpp"
+
+namespace UT_PololuFrames{
+
+bool execUnitTests(string xmlFilename);
+
+
+class TC11 : public TestCase{
+	TC11() : TestCase(){};
+public:
+	TC11(string s = string("pololuCrc7 - example of the Maestro documentation")) : TestCase(s){};
+	virtual bool testRun(); // pololuCrc7 - example of the Maestro documentation
+};
+
+class TC12 : public TestCase{
+	TC12() : TestCase(){};
+public:
+	TC12(string s = string("pololuCrc7 - lookup table equals bit wise reference")) : TestCase(s){};
+	virtual bool testRun(); // pololuCrc7 - lookup table equals bit wise reference
+};
+
+
+class TC21 : public TestCase{
+	TC21() : TestCase(){};
+public:
+	TC21(string s = string("PololuFrames - encoders with and without CRC byte")) : TestCase(s){};
+	virtual bool testRun(); // PololuFrames - encoders with and without CRC byte
+};
+
+
+class TC31 : public TestCase{
+	TC31() : TestCase(){};
+public:
+	TC31(string s = string("setCrcMode - commands accepted by controller with CRC enabled")) : TestCase(s){};
+	virtual bool testRun(); // setCrcMode - commands accepted by controller with CRC enabled
+};
+
+class TC32 : public TestCase{
+	TC32() : TestCase(){};
+public:
+	TC32(string s = string("setCrcMode - commands without CRC are rejected")) : TestCase(s){};
+	virtual bool testRun(); // setCrcMode - commands without CRC are rejected
+};
+
+} // ende namespace UT_PololuFrames
+
+
+#endif /* UNITTESTS_POLOLUFRAMESUT_HPP_ */
@@ -0,0 +1,258 @@
+/*
+ * PololuStatsUT.cpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+
+#include <string>
+#include <thread>
+#include <atomic>
+#include <unistd.h>
+#include "../SimplUnitTestFW.hpp"
+#include "../PololuStats.hpp"
+#include "../Pololu.hpp"
+#include "../MaestroSimulator.hpp"
+#include "PololuStatsUT.hpp"
+
+using namespace std;
+
+namespace UT_PololuStats{
+
+bool execUnitTests(string xmlFilename){
+
+	// a unit a class
+	UnitTest unit("PololuStats");
+
+	// a unit for each method
+	TestSuite TS01("PololuStats");
+	TestSuite TS02("Pololu");
+
+	// add all test suits to the unit
+	unit.addTestItem(&TS01);
+	unit.addTestItem(&TS02);
+
+	//
+	// test cases for test suite TS01
+	//
+	TC11 tc11("PololuStats - publish and attach read-only");
+	TC12 tc12("PololuStats - round trip histogram");
+	TC13 tc13("PololuStatsView - consistent snapshots while writing");
+
+	// add specific test cases to test suite TS01
+	TS01.addTestItem(&tc11);
+	TS01.addTestItem(&tc12);
+	TS01.addTestItem(&tc13);
+
+	//
+	// test cases for test suite TS02
+	//
+	TC21 tc21("Pololu::setStats - targets, positions, round trips and errors");
+
+	// add specific test cases to test suite TS02
+	TS02.addTestItem(&tc21);
+
+	// execute unit tests
+	unit.testExecution();
+	unit.writeResultsToFile(xmlFilename);
+
+	return unit.getResult();
+}
+
+
+static string segmentName(const char *test){
+	return string(POLOLU_STATS_PREFIX) + "ut-" + test + "-" + to_string(getpid());
+}
+
+
+bool TC11::testRun(){ // PololuStats - publish and attach read-only
+	cout << ".";
+	bool result = true;
+	string name = segmentName("tc11");
+	try{
+		{
+			PololuStats stats(name, "/dev/ttyACM0");
+			stats.recordTarget(2, 6000);
+			stats.recordPosition(2, 5800);
+			stats.recordTarget(POLOLU_STATS_SERVOS, 1); // ignored
+			stats.recordTransfer(POLOLU_CMD_GET_POSITION, 2, 2, 1500);
+			stats.recordFailure(POLOLU_CMD_SET_SPEED);
+			stats.recordErrors(0x0010);
+			stats.recordMoving(true);
+
+			PololuStatsView view(name);
+			PololuStatsBlock b;
+			if(!view.snapshot(b) || !view.isAlive()){
+				return false;
+			}
+			if((b.pid != getpid()) || (string(b.port) != "/dev/ttyACM0") ||
+					(b.servo[2].target != 6000) || (b.servo[2].position != 5800) ||
+					(b.servo[2].targetUs == 0) || (b.servo[2].positionUs < b.servo[2].targetUs) ||
+					(b.servo[1].targetUs != 0)){
+				result = false;
+			}
+			if((b.calls[POLOLU_CMD_GET_POSITION] != 1) || (b.failures[POLOLU_CMD_SET_SPEED] != 1) ||
+					(b.bytesOut != 2) || (b.bytesIn != 2) || (b.rttMaxUs != 1500) ||
+					(b.rtt[PololuStats::rttBin(1500)] != 1) || (b.errors != 0x0010) ||
+					(b.errorReads != 1) || (b.moving != 1) || ((b.seq.load() & 1) != 0)){
+				result = false;
+			}
+		}
+		// the segment is removed with the publisher
+		try{
+			PololuStatsView gone(name);
+			result = false;
+		}catch(IException *e){
+			delete e;
+		}
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		delete e;
+		return false;
+	}
+	return result;
+}
+
+
+bool TC12::testRun(){ // PololuStats - round trip histogram
+	cout << ".";
+	bool result = true;
+
+	for(unsigned long long us = 0; us < 8; us++){
+		if((PololuStats::rttBin(us) != us) || (PololuStats::rttBinUs(us) != us)){
+			result = false;
+		}
+	}
+	// the lower bound of the bin is at most 12.5 % below the value
+	unsigned long long samples[] = {8, 9, 15, 16, 17, 100, 999, 1000, 1500, 4096, 123456, 9000000};
+	for(unsigned i = 0; i < sizeof(samples) / sizeof(samples[0]); i++){
+		unsigned bin = PololuStats::rttBin(samples[i]);
+		unsigned long long low = PololuStats::rttBinUs(bin);
+		if((bin >= POLOLU_STATS_RTT_BINS) || (low > samples[i]) || (low * 8 < samples[i] * 7) ||
+				(PololuStats::rttBinUs(bin + 1) <= samples[i])){
+			result = false;
+		}
+	}
+	if(PololuStats::rttBin(1ULL << 40) != POLOLU_STATS_RTT_BINS - 1){
+		result = false;
+	}
+
+	// 90 round trips of 1 ms, 9 of 4 ms, 1 of 20 ms
+	uint64_t rtt[POLOLU_STATS_RTT_BINS] = {0};
+	rtt[PololuStats::rttBin(1000)]  = 90;
+	rtt[PololuStats::rttBin(4000)]  = 9;
+	rtt[PololuStats::rttBin(20000)] = 1;
+	if((PololuStats::rttPercentile(rtt, 0.50) != PololuStats::rttBinUs(PololuStats::rttBin(1000))) ||
+			(PololuStats::rttPercentile(rtt, 0.95) != PololuStats::rttBinUs(PololuStats::rttBin(4000))) ||
+			(PololuStats::rttPercentile(rtt, 1.00) != PololuStats::rttBinUs(PololuStats::rttBin(20000)))){
+		result = false;
+	}
+	uint64_t empty[POLOLU_STATS_RTT_BINS] = {0};
+	if(PololuStats::rttPercentile(empty, 0.5) != 0){
+		result = false;
+	}
+	return result;
+}
+
+
+bool TC13::testRun(){ // PololuStatsView - consistent snapshots while writing
+	cout << ".";
+	bool result = true;
+	string name = segmentName("tc13");
+	try{
+		PololuStats stats(name);
+		PololuStatsView view(name);
+		std::atomic<bool> stop(false);
+
+		// every transfer adds 4 bytes out and 2 in, a torn copy breaks the ratio
+		std::thread writer([&stats, &stop](){
+			while(!stop){
+				stats.recordTransfer(POLOLU_CMD_GET_POSITION, 4, 2, 100);
+			}
+		});
+		PololuStatsBlock b;
+		unsigned ok = 0;
+		for(unsigned i = 0; i < 20000; i++){
+			if(view.snapshot(b)){
+				ok++;
+				uint64_t n = b.calls[POLOLU_CMD_GET_POSITION];
+				if((b.bytesOut != 4 * n) || (b.bytesIn != 2 * n) || (b.rtt[PololuStats::rttBin(100)] != n)){
+					result = false;
+				}
+			}
+		}
+		stop = true;
+		writer.join();
+		if(ok == 0){
+			result = false;
+		}
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		delete e;
+		return false;
+	}
+	return result;
+}
+
+
+bool TC21::testRun(){ // Pololu::setStats - targets, positions, round trips and errors
+	cout << ".";
+	bool result = true;
+	string name = segmentName("tc21");
+	try{
+		MaestroSimulator sim(6);
+		MaestroPty pty(&sim);
+		pty.start();
+		Pololu pololu(pty.getPortName(), 9600);
+		IPololu &controller = pololu;
+		PololuStats stats(name, pty.getPortName());
+		pololu.setStats(&stats);
+		pololu.openConnection();
+
+		controller.setPosition(1, 6000);
+		unsigned short position = controller.getPosition(1);
+		unsigned short servos[2] = {2, 3};
+		unsigned short positions[2];
+		pololu.getPositions(servos, 2, positions);
+		pololu.getErrors();
+		pololu.getMovingState();
+
+		PololuStatsView view(name);
+		PololuStatsBlock b;
+		if(!view.snapshot(b)){
+			result = false;
+		}else{
+			if((b.servo[1].target != 6000) || (b.servo[1].position != position) ||
+					(b.servo[2].positionUs == 0) || (b.servo[3].position != positions[1])){
+				result = false;
+			}
+			if((b.calls[POLOLU_CMD_SET_POSITION] != 1) || (b.calls[POLOLU_CMD_GET_POSITION] != 2) ||
+					(b.calls[POLOLU_CMD_GET_ERRORS] != 1) || (b.calls[POLOLU_CMD_GET_MOVING_STATE] != 1)){
+				result = false;
+			}
+			// set 4 + get 2 + pipelined 4 + errors 1 + moving 1 bytes out,
+			// get 2 + pipelined 4 + errors 2 + moving 1 bytes in
+			if((b.bytesOut != 12) || (b.bytesIn != 9) || (PololuStats::rttPercentile(b.rtt, 1.0) == 0)){
+				result = false;
+			}
+		}
+
+		pololu.setStats(nullptr);
+		controller.setPosition(1, 7000);
+		view.snapshot(b);
+		if(b.servo[1].target != 6000){
+			result = false;
+		}
+
+		pololu.closeConnection();
+		pty.stop();
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		delete e;
+		return false;
+	}
+	return result;
+}
+
+} // ende namespace UT_PololuStats
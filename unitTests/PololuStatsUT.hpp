@@ -0,0 +1,51 @@
+/*
+ * PololuStatsUT.hpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+#ifndef UNITTESTS_POLOLUSTATSUT_HPP_
+#define UNITTESTS_POLOLUSTATSUT_HPP_
+
+
+#include "../SimplUnitTestFW.hpp"
+
+namespace UT_PololuStats{
+
+bool execUnitTests(string xmlFilename);
+
+
+class TC11 : public TestCase{
+	TC11() : TestCase(){};
+public:
+	TC11(string s = string("PololuStats - publish and attach read-only")) : TestCase(s){};
+	virtual bool testRun(); // PololuStats - publish and attach read-only
+};
+
+class TC12 : public TestCase{
+	TC12() : TestCase(){};
+public:
+	TC12(string s = string("PololuStats - round trip histogram")) : TestCase(s){};
+	virtual bool testRun(); // PololuStats - round trip histogram
+};
+
+class TC13 : public TestCase{
+	TC13() : TestCase(){};
+public:
+	TC13(string s = string("PololuStatsView - consistent snapshots while writing")) : TestCase(s){};
+	virtual bool testRun(); // PololuStatsView - consistent snapshots while writing
+};
+
+
+class TC21 : public TestCase{
+	TC21() : TestCase(){};
+public:
+	TC21(string s = string("Pololu::setStats - targets, positions, round trips and errors")) : TestCase(s){};
+	virtual bool testRun(); // Pololu::setStats - targets, positions, round trips and errors
+};
+
+} // ende namespace UT_PololuStats
+
+
+#endif /* UNITTESTS_POLOLUSTATSUT_HPP_ */
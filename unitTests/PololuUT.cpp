@@ -9,6 +9,7 @@
 #include <string>
 #include "../SimplUnitTestFW.hpp"
 #include "../Pololu.hpp"
+#include "PololuFixture.hpp"
 #include "PololuUT.hpp"
 
 using namespace std;
@@ -20,6 +21,9 @@ bool execUnitTests(string xmlFilename){
 	// a unit a class
 	UnitTest unit("Pololu");
 
+	// the test cases share the device, one worker of a TestPool executes them
+	unit.setSequential(true);
+
 	// a unit for each method
 	TestSuite TS01("initConnection");
 	TestSuite TS02("openConnection");
@@ -95,6 +99,10 @@ bool execUnitTests(string xmlFilename){
 	TS04.addTestItem(&tc43);
 	TS04.addTestItem(&tc44);
 
+	// the test cases of an open connection share it
+	PololuFixture pololu;
+	TS04.setFixture(&pololu);
+
 
 	//
 	// test cases for test suite TS05
@@ -118,6 +126,15 @@ bool execUnitTests(string xmlFilename){
 
 
 
+	// the test cases using the controller are skipped without it
+	tc12.requireResource("/dev/ttyACM0");
+	tc13.requireResource("/dev/ttyACM0");
+	tc22.requireResource("/dev/ttyACM0");
+	tc23.requireResource("/dev/ttyACM0");
+	tc31.requireResource("/dev/ttyACM0");
+	tc42.requireResource("/dev/ttyACM0");
+	tc44.requireResource("/dev/ttyACM0");
+
 	// execute unit tests
 	unit.testExecution();
 	unit.writeResultsToFile(xmlFilename);
@@ -172,11 +189,10 @@ bool TC41::testRun(){// getMovingState - request after init and before open
 	return false;
 }
 
-bool TC42::testRun(){// getMovingState - request after open
+bool TC42::testRun(TestFixture *fixture){// getMovingState - request after open
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		p.getMovingState();
 		return true;
 	}catch(IException *e){
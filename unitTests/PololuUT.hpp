@@ -114,7 +114,7 @@ class TC42 : public TestCase{
 	TC42() : TestCase(){};
 public:
 	TC42(string s = string("getMovingState - request after open")) : TestCase(s){};
-	virtual bool testRun(); // getMovingState - request after open
+	virtual bool testRun(TestFixture *fixture); // getMovingState - request after open
 };
 
 
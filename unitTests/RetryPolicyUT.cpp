@@ -0,0 +1,175 @@
+/*
+ * RetryPolicyUT.cpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+
+#include <string>
+#include "../SimplUnitTestFW.hpp"
+#include "../Pololu.hpp"
+#include "../RetryPolicy.hpp"
+#include "RetryPolicyUT.hpp"
+
+using namespace std;
+
+namespace UT_RetryPolicy{
+
+bool execUnitTests(string xmlFilename){
+
+	// a unit a class
+	UnitTest unit("RetryPolicy");
+
+	// a unit for each method
+	TestSuite TS01("timeouts");
+	TestSuite TS02("RetryBackoff");
+	TestSuite TS03("Pololu retry policy");
+
+	// add all test suits to the unit
+	unit.addTestItem(&TS01);
+	unit.addTestItem(&TS02);
+	unit.addTestItem(&TS03);
+
+	//
+	// test cases for test suite TS01
+	//
+	TC11 tc11("serialWireTimeUs - 10 bits per byte");
+	TC12 tc12("serialReplyTimeoutUs - command, reply and latency");
+
+	// add specific test cases to test suite TS01
+	TS01.addTestItem(&tc11);
+	TS01.addTestItem(&tc12);
+
+	//
+	// test cases for test suite TS02
+	//
+	TC21 tc21("RetryBackoff - exponential growth without jitter");
+	TC22 tc22("RetryBackoff - jitter stays within bounds");
+	TC23 tc23("RetryBackoff - same seed same delays");
+
+	// add specific test cases to test suite TS02
+	TS02.addTestItem(&tc21);
+	TS02.addTestItem(&tc22);
+	TS02.addTestItem(&tc23);
+
+	//
+	// test cases for test suite TS03
+	//
+	TC31 tc31("setRetryPolicy - default and custom policies");
+	TC32 tc32("getRetryStats - no attempts with closed communication channel");
+
+	// add specific test cases to test suite TS03
+	TS03.addTestItem(&tc31);
+	TS03.addTestItem(&tc32);
+
+	// execute unit tests
+	unit.testExecution();
+	unit.writeResultsToFile(xmlFilename);
+
+	return unit.getResult();
+}
+
+
+
+bool TC11::testRun(){ // serialWireTimeUs - 10 bits per byte
+	cout << ".";
+	if(serialWireTimeUs(9600, 0) != 0){
+		return false;
+	}
+	if(serialWireTimeUs(10000, 1) != 1000){
+		return false;
+	}
+	if(serialWireTimeUs(115200, 4) != 348){ // 347.2 rounded up
+		return false;
+	}
+	return (serialWireTimeUs(0, 4) == 0);
+}
+
+bool TC12::testRun(){ // serialReplyTimeoutUs - command, reply and latency
+	cout << ".";
+	// get position at 10000 baud: 2 bytes command + 2 bytes reply = 4 ms
+	return (serialReplyTimeoutUs(10000, 2, 2, 500) == 4500);
+}
+
+
+bool TC21::testRun(){ // RetryBackoff - exponential growth without jitter
+	cout << ".";
+	RetryPolicy p(5, 0, 1000, 5000, 0.0);
+	RetryBackoff b;
+	if(b.delayUs(p, 0) != 0){
+		return false;
+	}
+	if((b.delayUs(p, 1) != 1000) || (b.delayUs(p, 2) != 2000) || (b.delayUs(p, 3) != 4000)){
+		return false;
+	}
+	return ((b.delayUs(p, 4) == 5000) && (b.delayUs(p, 40) == 5000));
+}
+
+bool TC22::testRun(){ // RetryBackoff - jitter stays within bounds
+	cout << ".";
+	RetryPolicy p(5, 0, 1000, 1000, 0.5);
+	RetryBackoff b(17);
+	for(int i = 0; i < 1000; i++){
+		unsigned long d = b.delayUs(p, 1);
+		if((d < 500) || (d > 1500)){
+			return false;
+		}
+	}
+	return true;
+}
+
+bool TC23::testRun(){ // RetryBackoff - same seed same delays
+	cout << ".";
+	RetryPolicy p(5, 0, 1000, 20000, 0.25);
+	RetryBackoff b1(42), b2(42);
+	for(unsigned i = 1; i < 10; i++){
+		if(b1.delayUs(p, i) != b2.delayUs(p, i)){
+			return false;
+		}
+	}
+	return true;
+}
+
+
+bool TC31::testRun(){ // setRetryPolicy - default and custom policies
+	cout << ".";
+	try{
+		Pololu p("/dev/ttyACM0",9600);
+		if(p.getRetryPolicy(POLOLU_CMD_SET_POSITION).maxAttempts != 1){
+			return false;
+		}
+		if(p.getRetryPolicy(POLOLU_CMD_GET_ERRORS).maxAttempts != 5){
+			return false;
+		}
+		p.setRetryPolicy(POLOLU_CMD_GET_POSITION, RetryPolicy(3, 2000, 500, 4000, 0.1, 10000));
+		RetryPolicy r = p.getRetryPolicy(POLOLU_CMD_GET_POSITION);
+		return ((r.maxAttempts == 3) && (r.attemptTimeoutUs == 2000) && (r.totalBudgetUs == 10000));
+	}catch(IException *e){
+		return false;
+	}catch(...){
+		return false;
+	}
+	return false;
+}
+
+bool TC32::testRun(){ // getRetryStats - no attempts with closed communication channel
+	cout << ".";
+	try{
+		Pololu p("/dev/ttyACM0",9600);
+		try{
+			p.getErrors();
+			return false;
+		}catch(IException *e){
+			RetryStats st = p.getRetryStats(POLOLU_CMD_GET_ERRORS);
+			return ((st.calls == 0) && (st.attempts == 0));
+		}
+	}catch(IException *e){
+		return false;
+	}catch(...){
+		return false;
+	}
+	return false;
+}
+
+}// ende namespace UT_RetryPolicy
@@ -0,0 +1,73 @@
+/*
+ * RetryPolicyUT.hpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+#ifndef UNITTESTS_RETRYPOLICYUT_HPP_
+#define UNITTESTS_RETRYPOLICYUT_HPP_
+
+
+#include "../SimplUnitTestFW.hpp"
+
+namespace UT_RetryPolicy{
+
+bool execUnitTests(string xmlFilename);
+
+
+class TC11 : public TestCase{
+	TC11() : TestCase(){};
+public:
+	TC11(string s = string("serialWireTimeUs - 10 bits per byte")) : TestCase(s){};
+	virtual bool testRun(); // serialWireTimeUs - 10 bits per byte
+};
+
+class TC12 : public TestCase{
+	TC12() : TestCase(){};
+public:
+	TC12(string s = string("serialReplyTimeoutUs - command, reply and latency")) : TestCase(s){};
+	virtual bool testRun(); // serialReplyTimeoutUs - command, reply and latency
+};
+
+
+class TC21 : public TestCase{
+	TC21() : TestCase(){};
+public:
+	TC21(string s = string("RetryBackoff - exponential growth without jitter")) : TestCase(s){};
+	virtual bool testRun(); // RetryBackoff - exponential growth without jitter
+};
+
+class TC22 : public TestCase{
+	TC22() : TestCase(){};
+public:
+	TC22(string s = string("RetryBackoff - jitter stays within bounds")) : TestCase(s){};
+	virtual bool testRun(); // RetryBackoff - jitter stays within bounds
+};
+
+class TC23 : public TestCase{
+	TC23() : TestCase(){};
+public:
+	TC23(string s = string("RetryBackoff - same seed same delays")) : TestCase(s){};
+	virtual bool testRun(); // RetryBackoff - same seed same delays
+};
+
+
+class TC31 : public TestCase{
+	TC31() : TestCase(){};
+public:
+	TC31(string s = string("setRetryPolicy - default and custom policies")) : TestCase(s){};
+	virtual bool testRun(); // setRetryPolicy - default and custom policies
+};
+
+class TC32 : public TestCase{
+	TC32() : TestCase(){};
+public:
+	TC32(string s = string("getRetryStats - no attempts with closed communication channel")) : TestCase(s){};
+	virtual bool testRun(); // getRetryStats - no attempts with closed communication channel
+};
+
+} // ende namespace UT_RetryPolicy
+
+
+#endif /* UNITTESTS_RETRYPOLICYUT_HPP_ */
@@ -0,0 +1,263 @@
+/*
+ * SerialComFaultInjectorUT.cpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+
+#include <string>
+#include <chrono>
+#include <unistd.h>
+#include "../SimplUnitTestFW.hpp"
+#include "../SerialComFaultInjector.hpp"
+#include "../Pololu.hpp"
+#include "../MaestroSimulator.hpp"
+#include "SerialComFaultInjectorUT.hpp"
+
+using namespace std;
+
+namespace UT_SerialComFaultInjector{
+
+bool execUnitTests(string xmlFilename){
+
+	// a unit a class
+	UnitTest unit("SerialComFaultInjector");
+
+	// a unit for each method
+	TestSuite TS01("setFault");
+	TestSuite TS02("recovery");
+
+	// add all test suits to the unit
+	unit.addTestItem(&TS01);
+	unit.addTestItem(&TS02);
+
+	//
+	// test cases for test suite TS01
+	//
+	TC11 tc11("setSeed - same seed gives the same faults");
+	TC12 tc12("setFault - probability 0 and 1");
+
+	// add specific test cases to test suite TS01
+	TS01.addTestItem(&tc11);
+	TS01.addTestItem(&tc12);
+
+	//
+	// test cases for test suite TS02
+	//
+	TC21 tc21("drop byte - Pololu recovers with its retries");
+	TC22 tc22("partial read - stale bytes do not corrupt the next reply");
+	TC23 tc23("delay - the reply arrives later");
+
+	// add specific test cases to test suite TS02
+	TS02.addTestItem(&tc21);
+	TS02.addTestItem(&tc22);
+	TS02.addTestItem(&tc23);
+
+	// execute unit tests
+	unit.testExecution();
+	unit.writeResultsToFile(xmlFilename);
+
+	return unit.getResult();
+}
+
+
+
+/*
+ * Sends 64 commands and records which of them failed.
+ */
+static unsigned long long writeErrorPattern(SerialComFaultInjector &injector){
+	unsigned long long pattern = 0;
+	unsigned char command[] = {0x87, 0x00, 0x00, 0x00}; // set speed
+	for(unsigned i = 0; i < 64; i++){
+		try{
+			injector.sendSerialCom(command, 4);
+		}catch(IException *e){
+			delete e;
+			pattern |= (1ULL << i);
+		}
+	}
+	return pattern;
+}
+
+bool TC11::testRun(){ // setSeed - same seed gives the same faults
+	cout << ".";
+	bool result = true;
+	MaestroSimulator sim(6);
+	MaestroPty pty(&sim);
+	try{
+		pty.start();
+		SerialCom com(pty.getPortName(), 9600);
+		com.openSerialCom();
+		SerialComFaultInjector a(&com, 42);
+		SerialComFaultInjector b(&com, 42);
+		a.setFault(SERIALCOM_FAULT_WRITE_ERROR, 0.5);
+		b.setFault(SERIALCOM_FAULT_WRITE_ERROR, 0.5);
+		unsigned long long patternA = writeErrorPattern(a);
+		unsigned long long patternB = writeErrorPattern(b);
+		if((patternA != patternB) || (patternA == 0) || (patternA == ~0ULL)){
+			result = false;
+		}
+		if(a.getInjected(SERIALCOM_FAULT_WRITE_ERROR) != (unsigned long) __builtin_popcountll(patternA)){
+			result = false;
+		}
+		// restarting the sequence repeats the faults
+		a.setSeed(42);
+		if(writeErrorPattern(a) != patternA){
+			result = false;
+		}
+		// another seed gives other faults
+		a.setSeed(43);
+		if(writeErrorPattern(a) == patternA){
+			result = false;
+		}
+		com.closeSerialCom();
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		result = false;
+	}
+	pty.stop();
+	return result;
+}
+
+
+bool TC12::testRun(){ // setFault - probability 0 and 1
+	cout << ".";
+	bool result = true;
+	MaestroSimulator sim(6);
+	MaestroPty pty(&sim);
+	try{
+		pty.start();
+		SerialCom com(pty.getPortName(), 9600);
+		com.openSerialCom();
+		SerialComFaultInjector injector(&com);
+		if(writeErrorPattern(injector) != 0){
+			result = false;
+		}
+		injector.setFault(SERIALCOM_FAULT_WRITE_ERROR, 1.0);
+		if(writeErrorPattern(injector) != ~0ULL){
+			result = false;
+		}
+		// values out of range are limited
+		injector.setFault(SERIALCOM_FAULT_WRITE_ERROR, 2.0);
+		if(injector.getFault(SERIALCOM_FAULT_WRITE_ERROR).probability != 1.0){
+			result = false;
+		}
+		injector.clearFaults();
+		if((writeErrorPattern(injector) != 0) || (injector.getInjected() != 64)){
+			result = false;
+		}
+		com.closeSerialCom();
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		result = false;
+	}
+	pty.stop();
+	return result;
+}
+
+
+bool TC21::testRun(){ // drop byte - Pololu recovers with its retries
+	cout << ".";
+	bool result = true;
+	MaestroSimulator sim(6);
+	sim.setPosition(3, 6400);
+	MaestroPty pty(&sim);
+	try{
+		pty.start();
+		SerialCom com(pty.getPortName(), 9600);
+		SerialComFaultInjector injector(&com, 7);
+		Pololu pololu(&injector);
+		IPololu &controller = pololu;
+		pololu.setRetryPolicy(POLOLU_CMD_GET_POSITION, RetryPolicy(4, 0, 1000, 4000));
+		pololu.openConnection();
+		injector.setFault(SERIALCOM_FAULT_DROP_BYTE, 0.3);
+		for(unsigned i = 0; i < 20; i++){
+			if(controller.getPosition(3) != 6400){
+				result = false;
+			}
+		}
+		if(injector.getInjected(SERIALCOM_FAULT_DROP_BYTE) == 0){
+			result = false;
+		}
+		if(pololu.getRetryStats(POLOLU_CMD_GET_POSITION).attempts <= 20){
+			result = false;
+		}
+		pololu.closeConnection();
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		result = false;
+	}
+	pty.stop();
+	return result;
+}
+
+
+bool TC22::testRun(){ // partial read - stale bytes do not corrupt the next reply
+	cout << ".";
+	bool result = true;
+	MaestroSimulator sim(6);
+	sim.setPosition(0, 5000);
+	sim.setPosition(1, 7000);
+	MaestroPty pty(&sim);
+	try{
+		pty.start();
+		SerialCom com(pty.getPortName(), 9600);
+		com.openSerialCom();
+		SerialComFaultInjector injector(&com);
+		unsigned char command[] = {0x90, 0x00};
+		unsigned char response[2];
+		injector.setFault(SERIALCOM_FAULT_PARTIAL_READ, 1.0);
+		try{
+			injector.writeSerialCom(command, 2, response, 2);
+			result = false;
+		}catch(IException *e){
+			delete e;
+		}
+		injector.clearFaults();
+		// the second byte of the first reply arrives meanwhile
+		usleep(20000);
+		command[1] = 1;
+		injector.writeSerialCom(command, 2, response, 2);
+		if((response[0] + 256 * response[1]) != 7000){
+			result = false;
+		}
+		com.closeSerialCom();
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		result = false;
+	}
+	pty.stop();
+	return result;
+}
+
+
+bool TC23::testRun(){ // delay - the reply arrives later
+	cout << ".";
+	bool result = true;
+	MaestroSimulator sim(6);
+	MaestroPty pty(&sim);
+	try{
+		pty.start();
+		SerialCom com(pty.getPortName(), 9600);
+		com.openSerialCom();
+		SerialComFaultInjector injector(&com);
+		injector.setFault(SERIALCOM_FAULT_DELAY, 1.0, 30000);
+		unsigned char command[] = {0x90, 0x02};
+		unsigned char response[2];
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		injector.writeSerialCom(command, 2, response, 2);
+		long us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+		if((us < 30000) || ((response[0] + 256 * response[1]) != 6000)){
+			result = false;
+		}
+		com.closeSerialCom();
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		result = false;
+	}
+	pty.stop();
+	return result;
+}
+
+} // ende namespace UT_SerialComFaultInjector
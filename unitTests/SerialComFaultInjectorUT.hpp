@@ -0,0 +1,58 @@
+/*
+ * SerialComFaultInjectorUT.hpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+#ifndef UNITTESTS_SERIALCOMFAULTINJECTORUT_HPP_
+#define UNITTESTS_SERIALCOMFAULTINJECTORUT_HPP_
+
+
+#include "../SimplUnitTestFW.hpp"
+
+namespace UT_SerialComFaultInjector{
+
+bool execUnitTests(string xmlFilename);
+
+
+class TC11 : public TestCase{
+	TC11() : TestCase(){};
+public:
+	TC11(string s = string("setSeed - same seed gives the same faults")) : TestCase(s){};
+	virtual bool testRun(); // setSeed - same seed gives the same faults
+};
+
+class TC12 : public TestCase{
+	TC12() : TestCase(){};
+public:
+	TC12(string s = string("setFault - probability 0 and 1")) : TestCase(s){};
+	virtual bool testRun(); // setFault - probability 0 and 1
+};
+
+
+class TC21 : public TestCase{
+	TC21() : TestCase(){};
+public:
+	TC21(string s = string("drop byte - Pololu recovers with its retries")) : TestCase(s){};
+	virtual bool testRun(); // drop byte - Pololu recovers with its retries
+};
+
+class TC22 : public TestCase{
+	TC22() : TestCase(){};
+public:
+	TC22(string s = string("partial read - stale bytes do not corrupt the next reply")) : TestCase(s){};
+	virtual bool testRun(); // partial read - stale bytes do not corrupt the next reply
+};
+
+class TC23 : public TestCase{
+	TC23() : TestCase(){};
+public:
+	TC23(string s = string("delay - the reply arrives later")) : TestCase(s){};
+	virtual bool testRun(); // delay - the reply arrives later
+};
+
+} // ende namespace UT_SerialComFaultInjector
+
+
+#endif /* UNITTESTS_SERIALCOMFAULTINJECTORUT_HPP_ */
@@ -0,0 +1,242 @@
+/*
+ * SerialComRegistryUT.cpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+
+#include <string>
+#include <thread>
+#include "../SimplUnitTestFW.hpp"
+#include "../SerialComRegistry.hpp"
+#include "../Pololu.hpp"
+#include "../MaestroSimulator.hpp"
+#include "SerialComRegistryUT.hpp"
+
+using namespace std;
+
+namespace UT_SerialComRegistry{
+
+bool execUnitTests(string xmlFilename){
+
+	// a unit a class
+	UnitTest unit("SerialComRegistry");
+
+	// a unit for each method
+	TestSuite TS01("registry");
+	TestSuite TS02("shared connection");
+
+	// add all test suits to the unit
+	unit.addTestItem(&TS01);
+	unit.addTestItem(&TS02);
+
+	//
+	// test cases for test suite TS01
+	//
+	TC11 tc11("acquire - handles of a device share one entry");
+	TC12 tc12("openSerialCom - device opened once for all handles");
+	TC13 tc13("setKeepIdle - reopening is a lookup");
+
+	// add specific test cases to test suite TS01
+	TS01.addTestItem(&tc11);
+	TS01.addTestItem(&tc12);
+	TS01.addTestItem(&tc13);
+
+	//
+	// test cases for test suite TS02
+	//
+	TC21 tc21("Pololu - instances in two threads share one connection");
+
+	// add specific test cases to test suite TS02
+	TS02.addTestItem(&tc21);
+
+	// execute unit tests
+	unit.testExecution();
+	unit.writeResultsToFile(xmlFilename);
+
+	return unit.getResult();
+}
+
+
+
+bool TC11::testRun(){ // acquire - handles of a device share one entry
+	cout << ".";
+	SerialComRegistry &registry = SerialComRegistry::instance();
+	const char* port = "/dev/ttyRegistryUT11";
+	bool result = true;
+	SharedSerialCom *a = registry.acquire(port, 9600);
+	SharedSerialCom *b = registry.acquire(port, 9600);
+	if(registry.getUserCount(port) != 2){
+		result = false;
+	}
+	// another baud rate cannot be used while the device is in use
+	try{
+		SharedSerialCom *c = registry.acquire(port, 19200);
+		delete c;
+		result = false;
+	}catch(IException *e){
+		delete e;
+	}
+	try{
+		b->initSerialCom(port, 19200);
+		result = false;
+	}catch(IException *e){
+		delete e;
+	}
+	delete a;
+	if(registry.getUserCount(port) != 1){
+		result = false;
+	}
+	// the only handle of the device changes the baud rate
+	try{
+		b->initSerialCom(port, 19200);
+	}catch(IException *e){
+		delete e;
+		result = false;
+	}
+	if(registry.getUserCount(port) != 1){
+		result = false;
+	}
+	delete b;
+	// unused entries are removed
+	if(registry.getUserCount(port) != 0){
+		result = false;
+	}
+	return result;
+}
+
+
+bool TC12::testRun(){ // openSerialCom - device opened once for all handles
+	cout << ".";
+	SerialComRegistry &registry = SerialComRegistry::instance();
+	bool keepIdle = registry.getKeepIdle();
+	registry.setKeepIdle(false);
+	bool result = true;
+	MaestroSimulator sim(6);
+	MaestroPty pty(&sim);
+	try{
+		pty.start();
+		const char* port = pty.getPortName();
+		SharedSerialCom *a = registry.acquire(port, 9600);
+		SharedSerialCom *b = registry.acquire(port, 9600);
+		a->openSerialCom();
+		b->openSerialCom();
+		if(registry.getOpenCount(port) != 1){
+			result = false;
+		}
+		a->closeSerialCom();
+		// still usable by the other handle
+		unsigned char command[] = {0x90, 0x00};
+		unsigned char response[2];
+		b->writeSerialCom(command, 2, response, 2);
+		if((response[0] + 256 * response[1]) != 6000){
+			result = false;
+		}
+		// a closed handle cannot transfer
+		try{
+			a->writeSerialCom(command, 2, response, 2);
+			result = false;
+		}catch(IException *e){
+			delete e;
+		}
+		b->closeSerialCom();
+		a->openSerialCom();
+		if(registry.getOpenCount(port) != 2){
+			result = false;
+		}
+		delete a;
+		delete b;
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		result = false;
+	}
+	pty.stop();
+	registry.setKeepIdle(keepIdle);
+	return result;
+}
+
+
+bool TC13::testRun(){ // setKeepIdle - reopening is a lookup
+	cout << ".";
+	SerialComRegistry &registry = SerialComRegistry::instance();
+	bool keepIdle = registry.getKeepIdle();
+	registry.setKeepIdle(true);
+	bool result = true;
+	MaestroSimulator sim(6);
+	MaestroPty pty(&sim);
+	try{
+		pty.start();
+		const char* port = pty.getPortName();
+		for(unsigned i = 0; i < 5; i++){
+			Pololu pololu(port, 9600);
+			pololu.openConnection();
+			pololu.closeConnection();
+		}
+		if(registry.getOpenCount(port) != 1){
+			result = false;
+		}
+		if(registry.closeIdle() < 1){
+			result = false;
+		}
+		if(registry.getUserCount(port) != 0){
+			result = false;
+		}
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		result = false;
+	}
+	pty.stop();
+	registry.setKeepIdle(keepIdle);
+	return result;
+}
+
+
+bool TC21::testRun(){ // Pololu - instances in two threads share one connection
+	cout << ".";
+	bool result = true;
+	MaestroSimulator sim(6);
+	MaestroPty pty(&sim);
+	try{
+		sim.setPosition(0, 5000);
+		sim.setPosition(1, 7000);
+		pty.start();
+		const char* port = pty.getPortName();
+
+		bool ok[2] = {true, true};
+		std::thread *workers[2];
+		for(unsigned w = 0; w < 2; w++){
+			workers[w] = new std::thread([port, w, &ok](){
+				try{
+					Pololu pololu(port, 9600);
+					pololu.openConnection();
+					unsigned short servo = w;
+					unsigned short positions[1];
+					for(unsigned i = 0; i < 50; i++){
+						pololu.getPositions(&servo, 1, positions);
+						if(positions[0] != ((w == 0) ? 5000 : 7000)){
+							ok[w] = false;
+						}
+					}
+					pololu.closeConnection();
+				}catch(IException *e){
+					cout << e->getMsg() << endl;
+					ok[w] = false;
+				}
+			});
+		}
+		for(unsigned w = 0; w < 2; w++){
+			workers[w]->join();
+			delete workers[w];
+		}
+		result = ok[0] && ok[1];
+		SerialComRegistry::instance().closeIdle();
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		result = false;
+	}
+	pty.stop();
+	return result;
+}
+
+} // ende namespace UT_SerialComRegistry
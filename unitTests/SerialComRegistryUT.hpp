@@ -0,0 +1,51 @@
+/*
+ * SerialComRegistryUT.hpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+#ifndef UNITTESTS_SERIALCOMREGISTRYUT_HPP_
+#define UNITTESTS_SERIALCOMREGISTRYUT_HPP_
+
+
+#include "../SimplUnitTestFW.hpp"
+
+namespace UT_SerialComRegistry{
+
+bool execUnitTests(string xmlFilename);
+
+
+class TC11 : public TestCase{
+	TC11() : TestCase(){};
+public:
+	TC11(string s = string("acquire - handles of a device share one entry")) : TestCase(s){};
+	virtual bool testRun(); // acquire - handles of a device share one entry
+};
+
+class TC12 : public TestCase{
+	TC12() : TestCase(){};
+public:
+	TC12(string s = string("openSerialCom - device opened once for all handles")) : TestCase(s){};
+	virtual bool testRun(); // openSerialCom - device opened once for all handles
+};
+
+class TC13 : public TestCase{
+	TC13() : TestCase(){};
+public:
+	TC13(string s = string("setKeepIdle - reopening is a lookup")) : TestCase(s){};
+	virtual bool testRun(); // setKeepIdle - reopening is a lookup
+};
+
+
+class TC21 : public TestCase{
+	TC21() : TestCase(){};
+public:
+	TC21(string s = string("Pololu - instances in two threads share one connection")) : TestCase(s){};
+	virtual bool testRun(); // Pololu - instances in two threads share one connection
+};
+
+} // ende namespace UT_SerialComRegistry
+
+
+#endif /* UNITTESTS_SERIALCOMREGISTRYUT_HPP_ */
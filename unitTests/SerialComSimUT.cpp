@@ -0,0 +1,380 @@
+/*
+ * SerialComSimUT.cpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+
+#include <string>
+#include <vector>
+#include "../SimplUnitTestFW.hpp"
+#include "../SerialComSim.hpp"
+#include "../SerialComFaultInjector.hpp"
+#include "../Clock.hpp"
+#include "../Pololu.hpp"
+#include "../RetryPolicy.hpp"
+#include "../PololuErrors.hpp"
+#include "TestUnits.hpp"
+#include "SerialComSimUT.hpp"
+
+using namespace std;
+
+namespace UT_SerialComSim{
+
+/**
+ *
+ * \brief Simulated connection that keeps the command of the last request.
+ *
+ */
+class LastCommandSim : public SerialComSim{
+public:
+	LastCommandSim(MaestroSimulator *sim, IClock *clock) : SerialComSim(sim, clock, 9600){};
+	bool writeSerialCom(unsigned char command[], unsigned short sizeCommand, unsigned char *response, unsigned short sizeResponse){
+		last_.assign(command, command + sizeCommand);
+		return SerialComSim::writeSerialCom(command, sizeCommand, response, sizeResponse);
+	}
+	vector<unsigned char> last_;
+};
+
+/**
+ *
+ * \brief Simulated connection that loses the replies of the first
+ * pipelined request.
+ *
+ */
+class LostReplySim : public SerialComSim{
+public:
+	LostReplySim(MaestroSimulator *sim, IClock *clock) : SerialComSim(sim, clock, 9600){};
+	bool receiveSerialCom(unsigned short minBytes, unsigned short sizeCommand = 0){
+		if(lose_){
+			lose_ = false;
+			return false;
+		}
+		return SerialComSim::receiveSerialCom(minBytes, sizeCommand);
+	}
+	bool lose_ = true;
+};
+
+/**
+ *
+ * \brief Listener that counts the events and keeps the last one.
+ *
+ */
+class CountingListener : public IPololuErrorListener{
+public:
+	void errorFlagsChanged(const PololuErrorEvent &event){
+		last_ = event;
+		count_++;
+	}
+	PololuErrorEvent last_;
+	unsigned count_ = 0;
+};
+
+bool execUnitTests(string xmlFilename){
+
+	// a unit a class
+	UnitTest unit("SerialComSim");
+
+	// a unit for each method
+	TestSuite TS01("clock");
+	TestSuite TS02("simulated connection");
+
+	// add all test suits to the unit
+	unit.addTestItem(&TS01);
+	unit.addTestItem(&TS02);
+
+	//
+	// test cases for test suite TS01
+	//
+	TC11 tc11("VirtualClock - sleeps advance the time at once");
+	TC12 tc12("wait - milliseconds on the test clock");
+
+	// add specific test cases to test suite TS01
+	TS01.addTestItem(&tc11);
+	TS01.addTestItem(&tc12);
+
+	//
+	// test cases for test suite TS02
+	//
+	TC21 tc21("writeSerialCom - reply after the wire time");
+	TC22 tc22("writeSerialCom - timeout costs virtual time only");
+	TC23 tc23("Pololu - retry backoff on the virtual clock");
+	TC24 tc24("Pololu - motion program of an hour");
+	TC25 tc25("Pololu - error poll within the moving state request");
+	TC26 tc26("Pololu - lost pipelined replies counted as timeout");
+
+	// add specific test cases to test suite TS02
+	TS02.addTestItem(&tc21);
+	TS02.addTestItem(&tc22);
+	TS02.addTestItem(&tc23);
+	TS02.addTestItem(&tc24);
+	TS02.addTestItem(&tc25);
+	TS02.addTestItem(&tc26);
+
+	// execute unit tests
+	unit.testExecution();
+	unit.writeResultsToFile(xmlFilename);
+
+	return unit.getResult();
+}
+
+
+
+bool TC11::testRun(){ // VirtualClock - sleeps advance the time at once
+	cout << ".";
+	bool result = true;
+	VirtualClock clock(1000);
+	unsigned long long wallStart = SystemClock::instance().nowUs();
+	clock.sleepUs(3600ULL * 1000000ULL);
+	if(clock.nowUs() != 1000 + 3600ULL * 1000000ULL){
+		result = false;
+	}
+	// earlier times are ignored
+	clock.advanceTo(5);
+	if(clock.nowUs() != 1000 + 3600ULL * 1000000ULL){
+		result = false;
+	}
+	clock.advanceTo(4000ULL * 1000000ULL);
+	if((clock.nowUs() != 4000ULL * 1000000ULL) || (clock.getSleeps() != 1)){
+		result = false;
+	}
+	if(SystemClock::instance().nowUs() - wallStart > 100000){
+		result = false;
+	}
+	return result;
+}
+
+
+bool TC12::testRun(){ // wait - milliseconds on the test clock
+	cout << ".";
+	VirtualClock clock;
+	setTestClock(&clock);
+	wait(1500);
+	setTestClock(nullptr);
+	return (clock.nowUs() == 1500000ULL);
+}
+
+
+bool TC21::testRun(){ // writeSerialCom - reply after the wire time
+	cout << ".";
+	bool result = true;
+	try{
+		VirtualClock clock;
+		MaestroSimulator sim(6);
+		sim.setPosition(4, 7200);
+		SerialComSim com(&sim, &clock, 9600);
+		com.openSerialCom();
+		unsigned char command[] = {0x90, 0x04};
+		unsigned char response[2];
+		com.writeSerialCom(command, 2, response, 2);
+		if((response[0] + 256 * response[1]) != 7200){
+			result = false;
+		}
+		// 2 bytes command, 2 bytes reply at 9600 baud
+		if(clock.nowUs() != serialWireTimeUs(9600, 2) + serialWireTimeUs(9600, 2)){
+			result = false;
+		}
+		com.closeSerialCom();
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		result = false;
+	}
+	return result;
+}
+
+
+bool TC22::testRun(){ // writeSerialCom - timeout costs virtual time only
+	cout << ".";
+	bool result = true;
+	try{
+		VirtualClock clock;
+		MaestroSimulator sim(6);
+		SerialComSim com(&sim, &clock, 9600);
+		com.setReplyTimeout(2000000);
+		com.openSerialCom();
+		unsigned long long wallStart = SystemClock::instance().nowUs();
+		// channel 9 does not exist, the controller does not answer
+		unsigned char command[] = {0x90, 0x09};
+		unsigned char response[2];
+		try{
+			com.writeSerialCom(command, 2, response, 2);
+			result = false;
+		}catch(IException *e){
+			delete e;
+		}
+		if((clock.nowUs() < 2000000) || (com.getStats().timeouts != 1)){
+			result = false;
+		}
+		if(SystemClock::instance().nowUs() - wallStart > 100000){
+			result = false;
+		}
+		com.closeSerialCom();
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		result = false;
+	}
+	return result;
+}
+
+
+bool TC23::testRun(){ // Pololu - retry backoff on the virtual clock
+	cout << ".";
+	bool result = true;
+	try{
+		VirtualClock clock;
+		MaestroSimulator sim(6);
+		SerialComSim com(&sim, &clock, 9600);
+		SerialComFaultInjector injector(&com);
+		injector.setFault(SERIALCOM_FAULT_WRITE_ERROR, 1.0);
+		Pololu pololu(&injector);
+		IPololu &controller = pololu;
+		pololu.setClock(&clock);
+		// backoff of 1 s and 2 s without jitter
+		pololu.setRetryPolicy(POLOLU_CMD_GET_POSITION, RetryPolicy(3, 0, 1000000, 4000000, 0.0));
+		pololu.openConnection();
+		unsigned long long wallStart = SystemClock::instance().nowUs();
+		try{
+			controller.getPosition(0);
+			result = false;
+		}catch(IException *e){
+			delete e;
+		}
+		if(clock.nowUs() != 3000000ULL){
+			result = false;
+		}
+		if(SystemClock::instance().nowUs() - wallStart > 100000){
+			result = false;
+		}
+		pololu.closeConnection();
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		result = false;
+	}
+	return result;
+}
+
+
+bool TC24::testRun(){ // Pololu - motion program of an hour
+	cout << ".";
+	bool result = true;
+	try{
+		VirtualClock clock;
+		MaestroSimulator sim(6);
+		sim.setPosition(0, 4000);
+		SerialComSim com(&sim, &clock, 9600);
+		Pololu pololu(&com);
+		IPololu &controller = pololu;
+		pololu.setClock(&clock);
+		setTestClock(&clock);
+		pololu.openConnection();
+
+		// speed 1 moves 0.25 us per 10 ms, 4000 units take 40 s
+		controller.setSpeed(0, 1);
+		unsigned long long wallStart = SystemClock::instance().nowUs();
+		for(unsigned move = 0; move < 90; move++){
+			unsigned short target = (move % 2 == 0) ? 8000 : 4000;
+			controller.setPosition(0, target);
+			while(pololu.getMovingState()){
+				wait(100);
+			}
+			if(controller.getPosition(0) != target){
+				result = false;
+			}
+		}
+		setTestClock(nullptr);
+		if(clock.nowUs() < 3600ULL * 1000000ULL){
+			result = false;
+		}
+		// an hour of motion in a few seconds
+		if(SystemClock::instance().nowUs() - wallStart > 20000000ULL){
+			result = false;
+		}
+		pololu.closeConnection();
+	}catch(IException *e){
+		setTestClock(nullptr);
+		cout << e->getMsg() << endl;
+		result = false;
+	}
+	return result;
+}
+
+bool TC25::testRun(){ // Pololu - error poll within the moving state request
+	cout << ".";
+	bool result = true;
+	try{
+		VirtualClock clock;
+		MaestroSimulator sim(6);
+		sim.setPosition(0, 4000);
+		LastCommandSim com(&sim, &clock);
+		Pololu pololu(&com);
+		IPololu &controller = pololu;
+		pololu.setClock(&clock);
+		CountingListener listener;
+		PololuErrorMonitor monitor(&listener, 1);
+		pololu.setErrorMonitor(&monitor);
+		pololu.openConnection();
+
+		controller.setSpeed(0, 1);
+		controller.setPosition(0, 8000);
+		sim.injectErrors(POLOLU_ERR_SERIAL_OVERRUN);
+
+		// one request for both, the moving state is not disturbed
+		unsigned long transfers = com.getStats().transfers;
+		bool moving = pololu.getMovingState();
+		if(!moving || (com.getStats().transfers != transfers + 1) || (com.last_.size() != 2) ||
+				(com.last_[0] != 0x93) || (com.last_[1] != 0xA1)){
+			result = false;
+		}
+		if((listener.count_ != 1) || (listener.last_.raised != POLOLU_ERR_SERIAL_OVERRUN) ||
+				(monitor.getLastFlags().getRaw() != POLOLU_ERR_SERIAL_OVERRUN) || (monitor.getPollCount() != 1)){
+			result = false;
+		}
+
+		// reading the errors cleared them on the controller
+		moving = pololu.getMovingState();
+		if(!moving || (listener.count_ != 2) || (listener.last_.cleared != POLOLU_ERR_SERIAL_OVERRUN) ||
+				monitor.getLastFlags().any()){
+			result = false;
+		}
+		pololu.closeConnection();
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		delete e;
+		result = false;
+	}
+	return result;
+}
+
+bool TC26::testRun(){ // Pololu - lost pipelined replies counted as timeout
+	cout << ".";
+	bool result = true;
+	try{
+		VirtualClock clock;
+		MaestroSimulator sim(6);
+		sim.setPosition(0, 5000);
+		sim.setPosition(1, 7000);
+		LostReplySim com(&sim, &clock);
+		Pololu pololu(&com);
+		pololu.setClock(&clock);
+		pololu.openConnection();
+
+		// the single requests of the fallback deliver the positions
+		unsigned short servos[] = {0, 1};
+		unsigned short positions[2];
+		pololu.getPositions(servos, 2, positions);
+		RetryStats stats = pololu.getRetryStats(POLOLU_CMD_GET_POSITION);
+		if((positions[0] != 5000) || (positions[1] != 7000) || (stats.timeouts != 1) ||
+				(stats.impossibleReplies != 0) || (stats.resyncs != 1)){
+			result = false;
+		}
+		pololu.closeConnection();
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		delete e;
+		result = false;
+	}
+	return result;
+}
+
+} // ende namespace UT_SerialComSim
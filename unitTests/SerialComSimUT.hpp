@@ -0,0 +1,79 @@
+/*
+ * SerialComSimUT.hpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+#ifndef UNITTESTS_SERIALCOMSIMUT_HPP_
+#define UNITTESTS_SERIALCOMSIMUT_HPP_
+
+
+#include "../SimplUnitTestFW.hpp"
+
+namespace UT_SerialComSim{
+
+bool execUnitTests(string xmlFilename);
+
+
+class TC11 : public TestCase{
+	TC11() : TestCase(){};
+public:
+	TC11(string s = string("VirtualClock - sleeps advance the time at once")) : TestCase(s){};
+	virtual bool testRun(); // VirtualClock - sleeps advance the time at once
+};
+
+class TC12 : public TestCase{
+	TC12() : TestCase(){};
+public:
+	TC12(string s = string("wait - milliseconds on the test clock")) : TestCase(s){};
+	virtual bool testRun(); // wait - milliseconds on the test clock
+};
+
+
+class TC21 : public TestCase{
+	TC21() : TestCase(){};
+public:
+	TC21(string s = string("writeSerialCom - reply after the wire time")) : TestCase(s){};
+	virtual bool testRun(); // writeSerialCom - reply after the wire time
+};
+
+class TC22 : public TestCase{
+	TC22() : TestCase(){};
+public:
+	TC22(string s = string("writeSerialCom - timeout costs virtual time only")) : TestCase(s){};
+	virtual bool testRun(); // writeSerialCom - timeout costs virtual time only
+};
+
+class TC23 : public TestCase{
+	TC23() : TestCase(){};
+public:
+	TC23(string s = string("Pololu - retry backoff on the virtual clock")) : TestCase(s){};
+	virtual bool testRun(); // Pololu - retry backoff on the virtual clock
+};
+
+class TC24 : public TestCase{
+	TC24() : TestCase(){};
+public:
+	TC24(string s = string("Pololu - motion program of an hour")) : TestCase(s){};
+	virtual bool testRun(); // Pololu - motion program of an hour
+};
+
+class TC25 : public TestCase{
+	TC25() : TestCase(){};
+public:
+	TC25(string s = string("Pololu - error poll within the moving state request")) : TestCase(s){};
+	virtual bool testRun(); // Pololu - error poll within the moving state request
+};
+
+class TC26 : public TestCase{
+	TC26() : TestCase(){};
+public:
+	TC26(string s = string("Pololu - lost pipelined replies counted as timeout")) : TestCase(s){};
+	virtual bool testRun(); // Pololu - lost pipelined replies counted as timeout
+};
+
+} // ende namespace UT_SerialComSim
+
+
+#endif /* UNITTESTS_SERIALCOMSIMUT_HPP_ */
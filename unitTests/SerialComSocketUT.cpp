@@ -0,0 +1,252 @@
+/*
+ * SerialComSocketUT.cpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+
+#include <string>
+#include <sstream>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include "../SimplUnitTestFW.hpp"
+#include "../SerialComSocket.hpp"
+#include "../Pololu.hpp"
+#include "../PololuFrames.hpp"
+#include "../MaestroSimulator.hpp"
+#include "SerialComSocketUT.hpp"
+
+using namespace std;
+
+namespace UT_SerialComSocket{
+
+bool execUnitTests(string xmlFilename){
+
+	// a unit a class
+	UnitTest unit("SerialComSocket");
+
+	// a unit for each method
+	TestSuite TS01("openSerialCom");
+	TestSuite TS02("transfers");
+
+	// add all test suits to the unit
+	unit.addTestItem(&TS01);
+	unit.addTestItem(&TS02);
+
+	//
+	// test cases for test suite TS01
+	//
+	TC11 tc11("openSerialCom - invalid or unreachable addresses");
+	TC12 tc12("openSerialCom - TCP_NODELAY is set");
+
+	// add specific test cases to test suite TS01
+	TS01.addTestItem(&tc11);
+	TS01.addTestItem(&tc12);
+
+	//
+	// test cases for test suite TS02
+	//
+	TC21 tc21("Pololu - set and get position via tcp");
+	TC22 tc22("Pololu - pipelined positions via unix socket");
+	TC23 tc23("lock - held commands leave with one write");
+
+	// add specific test cases to test suite TS02
+	TS02.addTestItem(&tc21);
+	TS02.addTestItem(&tc22);
+	TS02.addTestItem(&tc23);
+
+	// execute unit tests
+	unit.testExecution();
+	unit.writeResultsToFile(xmlFilename);
+
+	return unit.getResult();
+}
+
+
+
+bool TC11::testRun(){ // openSerialCom - invalid or unreachable addresses
+	cout << ".";
+	bool result = SerialComSocket::isSocketName("tcp:localhost:4001") &&
+			SerialComSocket::isSocketName("unix:/tmp/maestro.sock") &&
+			!SerialComSocket::isSocketName("/dev/ttyACM0");
+
+	const char* names[] = {"tcp:localhost", "tcp::4001", "unix:", "/dev/ttyACM0",
+			"unix:/nonexisting/maestro.sock"};
+	for(unsigned i = 0; i < sizeof(names) / sizeof(names[0]); i++){
+		SerialComSocket com(names[i], 9600);
+		try{
+			com.openSerialCom();
+			result = false;
+		}catch(IException *e){
+			delete e;
+		}
+	}
+
+	// nobody listens on the port of a stopped server
+	MaestroSimulator sim(6);
+	MaestroSocketServer server(&sim);
+	string portName;
+	try{
+		server.start();
+		portName = server.getPortName();
+		server.stop();
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		return false;
+	}
+	SerialComSocket com(portName.c_str(), 9600);
+	try{
+		com.openSerialCom();
+		result = false;
+	}catch(IException *e){
+		delete e;
+	}
+	return result;
+}
+
+
+bool TC12::testRun(){ // openSerialCom - TCP_NODELAY is set
+	cout << ".";
+	bool result = true;
+	MaestroSimulator sim(6);
+	MaestroSocketServer server(&sim);
+	try{
+		server.start();
+		SerialComSocket com(server.getPortName(), 9600);
+		com.openSerialCom();
+		int flag = 0;
+		socklen_t len = sizeof(flag);
+		if((getsockopt(com.getPort(), IPPROTO_TCP, TCP_NODELAY, &flag, &len) != 0) || (flag == 0)){
+			result = false;
+		}
+		com.closeSerialCom();
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		result = false;
+	}
+	server.stop();
+	return result;
+}
+
+
+bool TC21::testRun(){ // Pololu - set and get position via tcp
+	cout << ".";
+	bool result = true;
+	MaestroSimulator sim(6);
+	MaestroSocketServer server(&sim);
+	try{
+		server.start();
+		Pololu pololu(server.getPortName(), 9600);
+		IPololu &controller = pololu;
+		pololu.openConnection();
+		controller.setSpeed(2, 0);
+		controller.setPosition(2, 7000);
+		// speed 0 jumps to the target with the next step of the model
+		unsigned short position = 0;
+		for(unsigned i = 0; (i < 50) && (position != 7000); i++){
+			usleep(5000);
+			position = controller.getPosition(2);
+		}
+		if(position != 7000){
+			result = false;
+		}
+		if(server.getConnections() != 1){
+			result = false;
+		}
+		pololu.closeConnection();
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		result = false;
+	}
+	server.stop();
+	return result;
+}
+
+
+bool TC22::testRun(){ // Pololu - pipelined positions via unix socket
+	cout << ".";
+	bool result = true;
+	MaestroSimulator sim(6);
+	for(unsigned i = 0; i < 6; i++){
+		sim.setPosition(i, 4000 + 500 * i);
+	}
+	MaestroSocketServer server(&sim);
+	stringstream ss;
+	ss << "unix:/tmp/maestroSocketUT." << getpid() << ".sock";
+	try{
+		server.start(ss.str());
+		Pololu pololu(server.getPortName(), 9600);
+		pololu.openConnection();
+		unsigned short servos[] = {0, 1, 2, 3, 4, 5};
+		unsigned short positions[6];
+		pololu.getPositions(servos, 6, positions);
+		for(unsigned i = 0; i < 6; i++){
+			if(positions[i] != 4000 + 500 * i){
+				result = false;
+			}
+		}
+		pololu.closeConnection();
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		result = false;
+	}
+	server.stop();
+	return result;
+}
+
+
+bool TC23::testRun(){ // lock - held commands leave with one write
+	cout << ".";
+	bool result = true;
+	MaestroSimulator sim(6);
+	MaestroSocketServer server(&sim);
+	try{
+		server.start();
+		SerialComSocket com(server.getPortName(), 9600);
+		com.openSerialCom();
+
+		unsigned char command[POLOLU_MAX_FRAME];
+		com.lock();
+		for(unsigned char ch = 0; ch < 3; ch++){
+			unsigned short size = PololuFrames::setTarget(command, ch, 5000 + ch, false);
+			com.sendSerialCom(command, size);
+		}
+		// nothing is sent while the connection is locked
+		if(com.getOutputQueued() != 12){
+			result = false;
+		}
+		com.unlock();
+		if(!com.flushOutput(100000)){
+			result = false;
+		}
+		for(unsigned i = 0; (i < 100) && (server.getReads() == 0); i++){
+			usleep(1000);
+		}
+		usleep(20000);
+		// the three targets arrived with one read
+		if(server.getReads() != 1){
+			result = false;
+		}
+
+		// the reply proves that the targets have been processed
+		unsigned char response[2];
+		unsigned short size = PololuFrames::getPosition(command, 0, false);
+		com.writeSerialCom(command, size, response, 2);
+		for(unsigned ch = 0; ch < 3; ch++){
+			if(sim.getTarget(ch) != 5000 + ch){
+				result = false;
+			}
+		}
+		com.closeSerialCom();
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		result = false;
+	}
+	server.stop();
+	return result;
+}
+
+} // ende namespace UT_SerialComSocket
@@ -0,0 +1,58 @@
+/*
+ * SerialComSocketUT.hpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+#ifndef UNITTESTS_SERIALCOMSOCKETUT_HPP_
+#define UNITTESTS_SERIALCOMSOCKETUT_HPP_
+
+
+#include "../SimplUnitTestFW.hpp"
+
+namespace UT_SerialComSocket{
+
+bool execUnitTests(string xmlFilename);
+
+
+class TC11 : public TestCase{
+	TC11() : TestCase(){};
+public:
+	TC11(string s = string("openSerialCom - invalid or unreachable addresses")) : TestCase(s){};
+	virtual bool testRun(); // openSerialCom - invalid or unreachable addresses
+};
+
+class TC12 : public TestCase{
+	TC12() : TestCase(){};
+public:
+	TC12(string s = string("openSerialCom - TCP_NODELAY is set")) : TestCase(s){};
+	virtual bool testRun(); // openSerialCom - TCP_NODELAY is set
+};
+
+
+class TC21 : public TestCase{
+	TC21() : TestCase(){};
+public:
+	TC21(string s = string("Pololu - set and get position via tcp")) : TestCase(s){};
+	virtual bool testRun(); // Pololu - set and get position via tcp
+};
+
+class TC22 : public TestCase{
+	TC22() : TestCase(){};
+public:
+	TC22(string s = string("Pololu - pipelined positions via unix socket")) : TestCase(s){};
+	virtual bool testRun(); // Pololu - pipelined positions via unix socket
+};
+
+class TC23 : public TestCase{
+	TC23() : TestCase(){};
+public:
+	TC23(string s = string("lock - held commands leave with one write")) : TestCase(s){};
+	virtual bool testRun(); // lock - held commands leave with one write
+};
+
+} // ende namespace UT_SerialComSocket
+
+
+#endif /* UNITTESTS_SERIALCOMSOCKETUT_HPP_ */
@@ -0,0 +1,218 @@
+/*
+ * SerialComURINGUT.cpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+
+#include <string>
+#include <vector>
+#include "../SimplUnitTestFW.hpp"
+#include "../SerialComURING.hpp"
+#include "../MaestroSimulator.hpp"
+#include "SerialComURINGUT.hpp"
+
+using namespace std;
+
+namespace UT_SerialComURING{
+
+bool execUnitTests(string xmlFilename){
+
+	// a unit a class
+	UnitTest unit("SerialComURING");
+
+	// a unit for each method
+	TestSuite TS01("URingLoop");
+	TestSuite TS02("transfers");
+
+	// add all test suits to the unit
+	unit.addTestItem(&TS01);
+	unit.addTestItem(&TS02);
+
+	//
+	// test cases for test suite TS01
+	//
+	TC11 tc11("URingLoop - setup and empty submission");
+
+	// add specific test cases to test suite TS01
+	TS01.addTestItem(&tc11);
+
+	//
+	// test cases for test suite TS02
+	//
+	TC21 tc21("writeSerialCom - position request to simulated controller");
+	TC22 tc22("submitQuery - batched requests to several controllers");
+	TC23 tc23("writeSerialCom - missing reply raises timeout");
+
+	// add specific test cases to test suite TS02
+	TS02.addTestItem(&tc21);
+	TS02.addTestItem(&tc22);
+	TS02.addTestItem(&tc23);
+
+	// execute unit tests
+	unit.testExecution();
+	unit.writeResultsToFile(xmlFilename);
+
+	return unit.getResult();
+}
+
+
+
+bool TC11::testRun(){ // URingLoop - setup and empty submission
+	cout << ".";
+	try{
+		URingLoop loop(8);
+		if(loop.getFreeSqes() != 8){
+			return false;
+		}
+		if(loop.getSqe() == NULL){
+			return false;
+		}
+		if(loop.getFreeSqes() != 7){
+			return false;
+		}
+		// nothing to submit, nothing to harvest
+		if(loop.harvest() != 0){
+			return false;
+		}
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		return false;
+	}
+	return true;
+}
+
+
+bool TC21::testRun(){ // writeSerialCom - position request to simulated controller
+	cout << ".";
+	bool result = true;
+	MaestroSimulator sim(6);
+	MaestroPty pty(&sim);
+	try{
+		sim.setPosition(2, 7000);
+		pty.start();
+		SerialComURING com(pty.getPortName(), 9600);
+		com.openSerialCom();
+
+		unsigned char command[] = {0x90, 0x02};
+		unsigned char response[2] = {0, 0};
+		for(unsigned i = 0; i < 10; i++){
+			com.writeSerialCom(command, 2, response, 2);
+			if((response[0] + 256 * response[1]) != 7000){
+				result = false;
+			}
+		}
+		if(com.getStats().transfers != 10){
+			result = false;
+		}
+		com.closeSerialCom();
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		result = false;
+	}
+	pty.stop();
+	return result;
+}
+
+
+bool TC22::testRun(){ // submitQuery - batched requests to several controllers
+	cout << ".";
+	bool result = true;
+	const unsigned n = 3;
+	vector<MaestroSimulator*> sims;
+	vector<MaestroPty*> ptys;
+	vector<SerialComURING*> coms;
+	try{
+		URingLoop loop(32);
+		for(unsigned i = 0; i < n; i++){
+			sims.push_back(new MaestroSimulator(6));
+			sims.back()->setPosition(0, 5000 + 100 * i);
+			ptys.push_back(new MaestroPty(sims.back()));
+			ptys.back()->start();
+			coms.push_back(new SerialComURING(ptys.back()->getPortName(), 9600, &loop));
+			coms.back()->openSerialCom();
+		}
+
+		unsigned char command[] = {0x90, 0x00};
+		unsigned char response[2 * n];
+		for(unsigned i = 0; i < n; i++){
+			coms[i]->submitQuery(command, 2, &response[2 * i], 2);
+		}
+		// all chains go to the kernel with one system call
+		unsigned long syscalls = loop.getSyscallCount();
+		loop.submit();
+		if(loop.getSyscallCount() != syscalls + 1){
+			result = false;
+		}
+
+		unsigned done = 0;
+		while(done < n){
+			loop.harvest();
+			done = 0;
+			for(unsigned i = 0; i < n; i++){
+				done += coms[i]->isQueryDone() ? 1 : 0;
+			}
+			if(done < n){
+				loop.submit(1);
+			}
+		}
+		for(unsigned i = 0; i < n; i++){
+			coms[i]->finishQuery();
+			if((response[2 * i] + 256 * response[2 * i + 1]) != (int) (5000 + 100 * i)){
+				result = false;
+			}
+		}
+		for(unsigned i = 0; i < n; i++){
+			delete coms[i];
+		}
+		coms.clear();
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		result = false;
+	}
+	for(unsigned i = 0; i < coms.size(); i++){
+		delete coms[i];
+	}
+	for(unsigned i = 0; i < ptys.size(); i++){
+		ptys[i]->stop();
+		delete ptys[i];
+		delete sims[i];
+	}
+	return result;
+}
+
+
+bool TC23::testRun(){ // writeSerialCom - missing reply raises timeout
+	cout << ".";
+	bool result = false;
+	MaestroSimulator sim(6);
+	MaestroPty pty(&sim);
+	try{
+		pty.start();
+		SerialComURING com(pty.getPortName(), 9600);
+		com.openSerialCom();
+		com.setReplyTimeout(20000);
+
+		// set target has no reply, the link timeout has to fire
+		unsigned char command[] = {0x84, 0x00, 0x70, 0x2E};
+		unsigned char response[2];
+		try{
+			com.writeSerialCom(command, 4, response, 2);
+		}catch(IException *e){
+			delete e;
+			result = true;
+		}
+		if(com.getStats().timeouts != 1){
+			result = false;
+		}
+		com.closeSerialCom();
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		result = false;
+	}
+	pty.stop();
+	return result;
+}
+
+} // ende namespace UT_SerialComURING
@@ -0,0 +1,51 @@
+/*
+ * SerialComURINGUT.hpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+#ifndef UNITTESTS_SERIALCOMURINGUT_HPP_
+#define UNITTESTS_SERIALCOMURINGUT_HPP_
+
+
+#include "../SimplUnitTestFW.hpp"
+
+namespace UT_SerialComURING{
+
+bool execUnitTests(string xmlFilename);
+
+
+class TC11 : public TestCase{
+	TC11() : TestCase(){};
+public:
+	TC11(string s = string("URingLoop - setup and empty submission")) : TestCase(s){};
+	virtual bool testRun(); // URingLoop - setup and empty submission
+};
+
+
+class TC21 : public TestCase{
+	TC21() : TestCase(){};
+public:
+	TC21(string s = string("writeSerialCom - position request to simulated controller")) : TestCase(s){};
+	virtual bool testRun(); // writeSerialCom - position request to simulated controller
+};
+
+class TC22 : public TestCase{
+	TC22() : TestCase(){};
+public:
+	TC22(string s = string("submitQuery - batched requests to several controllers")) : TestCase(s){};
+	virtual bool testRun(); // submitQuery - batched requests to several controllers
+};
+
+class TC23 : public TestCase{
+	TC23() : TestCase(){};
+public:
+	TC23(string s = string("writeSerialCom - missing reply raises timeout")) : TestCase(s){};
+	virtual bool testRun(); // writeSerialCom - missing reply raises timeout
+};
+
+} // ende namespace UT_SerialComURING
+
+
+#endif /* UNITTESTS_SERIALCOMURINGUT_HPP_ */
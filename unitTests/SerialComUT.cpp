@@ -7,15 +7,48 @@
 
 #include "../SimplUnitTestFW.hpp"
 #include "../SerialCom.hpp"
+#include "../RetryPolicy.hpp"
 #include "SerialComUT.hpp"
+#include <thread>
+#include <chrono>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <termios.h>
+#include <poll.h>
 
 namespace UT_SerialCom{
 
+/**
+ *
+ * \brief Opens a pseudo terminal that stands in for the controller.
+ * The slave side is opened by SerialCom, the returned master side
+ * plays the controller.
+ *
+ * \return file descriptor of the master side, -1 on error.
+ *
+ */
+static int openPty(string &slaveName){
+	int master = posix_openpt(O_RDWR | O_NOCTTY);
+	if(master < 0){
+		return -1;
+	}
+	if((grantpt(master) != 0) || (unlockpt(master) != 0)){
+		close(master);
+		return -1;
+	}
+	slaveName = string(ptsname(master));
+	return master;
+}
+
 bool execUnitTests(string xmlFilename){
 
 	// a unit a class
 	UnitTest unit("SerialCom");
 
+	// the test cases share the device, one worker of a TestPool executes them
+	unit.setSequential(true);
+
 	// a unit for each method
 	TestSuite TS01("initSerialCom");
 	TestSuite TS02("openSerialCom");
@@ -83,6 +116,47 @@ bool execUnitTests(string xmlFilename){
 	TS04.addTestItem(&tc42);
 	TS04.addTestItem(&tc43);
 
+	//
+	// test cases for test suite TS05
+	//
+	// create the defined test cases for the resynchronization to test suite TS05
+	TestSuite TS05("resynchronization");
+	unit.addTestItem(&TS05);
+	TC51 tc51("discardInput - drop stale bytes without blocking");
+	TC52 tc52("resynchronize - quiet line without reopening");
+	TC53 tc53("writeSerialCom - stale byte before request is not taken as reply");
+	TC54 tc54("writeSerialCom - line closed during the request fails at once");
+
+	// add specific test cases to test suite TS05
+	TS05.addTestItem(&tc51);
+	TS05.addTestItem(&tc52);
+	TS05.addTestItem(&tc53);
+	TS05.addTestItem(&tc54);
+
+	//
+	// test cases for test suite TS06
+	//
+	// create the defined test cases for the output queue to test suite TS06
+	TestSuite TS06("output queue");
+	unit.addTestItem(&TS06);
+	TC61 tc61("sendSerialCom - returns without a reader, queue drains later");
+	TC62 tc62("estimateTimeToWireUs - wire time of queued bytes and new frame");
+	TC63 tc63("openSerialCom - line speed of the baud rate");
+
+	// add specific test cases to test suite TS06
+	TS06.addTestItem(&tc61);
+	TS06.addTestItem(&tc62);
+	TS06.addTestItem(&tc63);
+
+	// the test cases using the controller are skipped without it
+	tc21.requireResource("/dev/ttyACM0");
+	tc22.requireResource("/dev/ttyACM0");
+	tc23.requireResource("/dev/ttyACM0");
+	tc32.requireResource("/dev/ttyACM0");
+	tc33.requireResource("/dev/ttyACM0");
+	tc42.requireResource("/dev/ttyACM0");
+	tc43.requireResource("/dev/ttyACM0");
+
 	// execute unit tests
 	unit.testExecution();
 	unit.writeResultsToFile(xmlFilename);
@@ -383,4 +457,288 @@ bool TC21::testRun(){ // "openSerialCom - open first
 };
 
 
+bool TC51::testRun(){ // discardInput - drop stale bytes without blocking
+	cout << ".";
+	string slave;
+	int master = openPty(slave);
+	if(master < 0){
+		return false;
+	}
+	bool ok = false;
+	try{
+		SerialCom b(slave.c_str(), 9600);
+		b.openSerialCom();
+		unsigned char stale[] = {0x12, 0x34, 0x56};
+		if(write(master, stale, 3) == 3){
+			usleep(20000); // let the bytes pass the line discipline
+			ok = (b.discardInput() == 3) && (b.discardInput() == 0) &&
+					(b.getStats().bytesDiscarded == 3);
+		}
+	}catch(IException *e){
+		ok = false;
+	}catch(...){
+		ok = false;
+	}
+	close(master);
+	return ok;
+}
+
+bool TC52::testRun(){ // resynchronize - quiet line without reopening
+	cout << ".";
+	string slave;
+	int master = openPty(slave);
+	if(master < 0){
+		return false;
+	}
+	bool ok = false;
+	try{
+		SerialCom b(slave.c_str(), 9600);
+		b.openSerialCom();
+		int port = b.getPort();
+		unsigned char stray = 0x7F;
+		if(write(master, &stray, 1) == 1){
+			usleep(20000);
+			ok = b.resynchronize() && (b.getPort() == port) &&
+					(b.getStats().resyncs == 1) && (b.getStats().bytesDiscarded == 1);
+		}
+	}catch(IException *e){
+		ok = false;
+	}catch(...){
+		ok = false;
+	}
+	close(master);
+	return ok;
+}
+
+bool TC53::testRun(){ // writeSerialCom - stale byte before request is not taken as reply
+	cout << ".";
+	string slave;
+	int master = openPty(slave);
+	if(master < 0){
+		return false;
+	}
+	bool ok = false;
+	std::thread controller;
+	try{
+		SerialCom b(slave.c_str(), 9600);
+		b.openSerialCom();
+
+		// late byte of a previous reply
+		unsigned char stale = 0x01;
+		if(write(master, &stale, 1) != 1){
+			close(master);
+			return false;
+		}
+		usleep(20000);
+
+		// controller: answer the moving state request with 'not moving'
+		controller = std::thread([master](){
+			struct pollfd pfd = {master, POLLIN, 0};
+			unsigned char cmd;
+			if((poll(&pfd, 1, 1000) == 1) && (read(master, &cmd, 1) == 1)){
+				unsigned char reply = 0x00;
+				if(write(master, &reply, 1) != 1){
+					return;
+				}
+			}
+		});
+		unsigned char command[] = {0x93};
+		unsigned char response[1] = {0xFF};
+		b.writeSerialCom(command, 1, response, 1);
+		ok = (response[0] == 0x00);
+	}catch(IException *e){
+		delete e;
+		ok = false;
+	}catch(...){
+		ok = false;
+	}
+	// joined on every path, also if the request failed
+	if(controller.joinable()){
+		controller.join();
+	}
+	close(master);
+	return ok;
+}
+
+bool TC54::testRun(){ // writeSerialCom - line closed during the request fails at once
+	cout << ".";
+	string slave;
+	int master = openPty(slave);
+	if(master < 0){
+		return false;
+	}
+	bool ok = false;
+	std::thread controller;
+	try{
+		SerialCom b(slave.c_str(), 9600);
+		b.openSerialCom();
+		b.setReplyTimeout(2000000);
+
+		// controller: takes the request and hangs up instead of replying
+		controller = std::thread([master](){
+			struct pollfd pfd = {master, POLLIN, 0};
+			unsigned char cmd;
+			if(poll(&pfd, 1, 1000) == 1){
+				ssize_t n = read(master, &cmd, 1);
+				(void) n;
+			}
+			close(master);
+		});
+		unsigned char command[] = {0x93};
+		unsigned char response[1] = {0xFF};
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		try{
+			b.writeSerialCom(command, 1, response, 1);
+		}catch(IException *e){
+			// reported as a failure, long before the reply deadline
+			ok = (std::chrono::steady_clock::now() - start) < std::chrono::milliseconds(1000);
+			delete e;
+		}
+	}catch(IException *e){
+		delete e;
+		ok = false;
+	}catch(...){
+		ok = false;
+	}
+	if(controller.joinable()){
+		controller.join();
+	}
+	return ok;
+}
+
+
+
+bool TC61::testRun(){ // sendSerialCom - returns without a reader, queue drains later
+	cout << ".";
+	string slave;
+	int master = openPty(slave);
+	if(master < 0){
+		return false;
+	}
+	bool ok = true;
+	const unsigned total = 60000;
+	try{
+		SerialCom b(slave.c_str(), 9600);
+		b.openSerialCom();
+
+		// nobody reads the master side: the driver buffer fills up and the
+		// rest waits in the output queue, the caller is never blocked
+		unsigned char frame[] = {0x84, 0x00, 0x70, 0x2E};
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		unsigned sent = 0;
+		while((sent + 4 <= total) && (b.getOutputQueued() + 4 < SERIALCOM_TX_QUEUE)){
+			b.sendSerialCom(frame, 4);
+			sent += 4;
+		}
+		long elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+		if(elapsedMs > 500){
+			ok = false;
+		}
+		if((b.getStats().writeStalls == 0) || (b.getStats().maxQueued == 0)){
+			ok = false;
+		}
+
+		// the controller starts reading, the queue drains
+		unsigned long received = 0;
+		std::thread controller([master, sent, &received](){
+			unsigned char buffer[512];
+			while(received < sent){
+				ssize_t n = read(master, buffer, sizeof(buffer));
+				if(n <= 0){
+					break;
+				}
+				received += n;
+			}
+		});
+		if(!b.flushOutput(2000000)){
+			ok = false;
+		}
+		controller.join();
+		if((received != sent) || (b.getStats().bytesWritten != sent)){
+			ok = false;
+		}
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		ok = false;
+	}catch(...){
+		ok = false;
+	}
+	close(master);
+	return ok;
+}
+
+bool TC62::testRun(){ // estimateTimeToWireUs - wire time of queued bytes and new frame
+	cout << ".";
+	string slave;
+	int master = openPty(slave);
+	if(master < 0){
+		return false;
+	}
+	bool ok = true;
+	try{
+		SerialCom b(slave.c_str(), 9600);
+		b.openSerialCom();
+		if(b.getOutputQueued() != 0){
+			ok = false;
+		}
+		if(b.estimateTimeToWireUs(4) != serialWireTimeUs(9600, 4)){
+			ok = false;
+		}
+
+		// fill the driver buffer, the estimate grows with the queue
+		unsigned char frame[64] = {0};
+		while(b.getStats().writeStalls == 0){
+			b.sendSerialCom(frame, sizeof(frame));
+		}
+		b.sendSerialCom(frame, sizeof(frame));
+		unsigned long queued = b.getOutputQueued();
+		if((queued < sizeof(frame)) || (b.estimateTimeToWireUs(4) != serialWireTimeUs(9600, queued + 4))){
+			ok = false;
+		}
+		tcflush(master, TCIOFLUSH);
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		ok = false;
+	}catch(...){
+		ok = false;
+	}
+	close(master);
+	return ok;
+}
+
+
+bool TC63::testRun(){ // openSerialCom - line speed of the baud rate
+	cout << ".";
+	string slave;
+	int master = openPty(slave);
+	if(master < 0){
+		return false;
+	}
+	bool ok = false;
+	try{
+		SerialCom b(slave.c_str(), 19200);
+		b.openSerialCom();
+		struct termios options;
+		ok = (tcgetattr(b.getPort(), &options) == 0) && (cfgetospeed(&options) == B19200) &&
+				(cfgetispeed(&options) == B19200);
+		b.closeSerialCom();
+
+		// a rate the line cannot run at is not silently replaced
+		SerialCom c(slave.c_str(), 12345);
+		try{
+			c.openSerialCom();
+			ok = false;
+		}catch(IException *e){
+			delete e;
+		}
+	}catch(IException *e){
+		delete e;
+		ok = false;
+	}catch(...){
+		ok = false;
+	}
+	close(master);
+	return ok;
+}
+
 } // ende namespace UT_SerialCom
@@ -122,6 +122,57 @@ public:
 	virtual bool testRun(); // "openSerialCom - repeated open
 };
 
+
+class TC51 : public TestCase{
+	TC51() : TestCase(){};
+public:
+	TC51(string s = string("discardInput - drop stale bytes without blocking")) : TestCase(s){};
+	virtual bool testRun(); // discardInput - drop stale bytes without blocking
+};
+
+class TC52 : public TestCase{
+	TC52() : TestCase(){};
+public:
+	TC52(string s = string("resynchronize - quiet line without reopening")) : TestCase(s){};
+	virtual bool testRun(); // resynchronize - quiet line without reopening
+};
+
+class TC53 : public TestCase{
+	TC53() : TestCase(){};
+public:
+	TC53(string s = string("writeSerialCom - stale byte before request is not taken as reply")) : TestCase(s){};
+	virtual bool testRun(); // writeSerialCom - stale byte before request is not taken as reply
+};
+
+
+class TC54 : public TestCase{
+	TC54() : TestCase(){};
+public:
+	TC54(string s = string("writeSerialCom - line closed during the request fails at once")) : TestCase(s){};
+	virtual bool testRun(); // writeSerialCom - line closed during the request fails at once
+};
+
+class TC61 : public TestCase{
+	TC61() : TestCase(){};
+public:
+	TC61(string s = string("sendSerialCom - returns without a reader, queue drains later")) : TestCase(s){};
+	virtual bool testRun(); // sendSerialCom - returns without a reader, queue drains later
+};
+
+class TC62 : public TestCase{
+	TC62() : TestCase(){};
+public:
+	TC62(string s = string("estimateTimeToWireUs - wire time of queued bytes and new frame")) : TestCase(s){};
+	virtual bool testRun(); // estimateTimeToWireUs - wire time of queued bytes and new frame
+};
+
+class TC63 : public TestCase{
+	TC63() : TestCase(){};
+public:
+	TC63(string s = string("openSerialCom - line speed of the baud rate")) : TestCase(s){};
+	virtual bool testRun(); // openSerialCom - line speed of the baud rate
+};
+
 } // namespace UT_SerialCom
 
 #endif /* SERIALCOMUT_HPP_ */
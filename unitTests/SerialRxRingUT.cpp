@@ -0,0 +1,296 @@
+/*
+ * SerialRxRingUT.cpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+
+#include <string>
+#include <unistd.h>
+#include <fcntl.h>
+#include "../SimplUnitTestFW.hpp"
+#include "../SerialRxRing.hpp"
+#include "../PololuReplyParser.hpp"
+#include "../Pololu.hpp"
+#include "../MaestroSimulator.hpp"
+#include "SerialRxRingUT.hpp"
+
+using namespace std;
+
+namespace UT_SerialRxRing{
+
+bool execUnitTests(string xmlFilename){
+
+	// a unit a class
+	UnitTest unit("SerialRxRing");
+
+	// a unit for each method
+	TestSuite TS01("SerialRxRing");
+	TestSuite TS02("PololuReplyParser");
+	TestSuite TS03("pipelined requests");
+
+	// add all test suits to the unit
+	unit.addTestItem(&TS01);
+	unit.addTestItem(&TS02);
+	unit.addTestItem(&TS03);
+
+	//
+	// test cases for test suite TS01
+	//
+	TC11 tc11("SerialRxRing - wrap around of spans, peek and consume");
+	TC12 tc12("SerialRxRing - fill takes all available bytes up to the capacity");
+
+	// add specific test cases to test suite TS01
+	TS01.addTestItem(&tc11);
+	TS01.addTestItem(&tc12);
+
+	//
+	// test cases for test suite TS02
+	//
+	TC21 tc21("PololuReplyParser - typed replies in request order");
+	TC22 tc22("PololuReplyParser - incomplete and implausible replies");
+
+	// add specific test cases to test suite TS02
+	TS02.addTestItem(&tc21);
+	TS02.addTestItem(&tc22);
+
+	//
+	// test cases for test suite TS03
+	//
+	TC31 tc31("getPositions - pipelined requests to simulated controller");
+
+	// add specific test cases to test suite TS03
+	TS03.addTestItem(&tc31);
+
+	// execute unit tests
+	unit.testExecution();
+	unit.writeResultsToFile(xmlFilename);
+
+	return unit.getResult();
+}
+
+
+/*
+ * Writes the given bytes into the free space of the ring.
+ */
+static void put(SerialRxRing &ring, const unsigned char *bytes, unsigned n){
+	unsigned char *span[2];
+	unsigned size[2];
+	unsigned spans = ring.freeSpans(span, size);
+	unsigned done = 0;
+	for(unsigned i = 0; (i < spans) && (done < n); i++){
+		for(unsigned j = 0; (j < size[i]) && (done < n); j++){
+			span[i][j] = bytes[done++];
+		}
+	}
+	ring.commit(done);
+}
+
+
+bool TC11::testRun(){ // SerialRxRing - wrap around of spans, peek and consume
+	cout << ".";
+	SerialRxRing ring(10); // rounded up to 16
+	if((ring.getCapacity() != 16) || (ring.available() != 0) || (ring.getFree() != 16)){
+		return false;
+	}
+
+	unsigned char bytes[16];
+	for(unsigned i = 0; i < 16; i++){
+		bytes[i] = i;
+	}
+	put(ring, bytes, 12);
+	ring.consume(10);
+	// 2 bytes left at the end, 10 new bytes wrap around
+	put(ring, bytes, 10);
+	if(ring.available() != 12){
+		return false;
+	}
+	if((ring.peek(0) != 10) || (ring.peek(1) != 11) || (ring.peek(2) != 0)){
+		return false;
+	}
+	if(ring.peekWord(1) != (11 + 256 * 0)){
+		return false;
+	}
+
+	const unsigned char *span[2];
+	unsigned size[2];
+	if(ring.readSpans(span, size) != 2){
+		return false;
+	}
+	if((size[0] != 6) || (size[1] != 6)){
+		return false;
+	}
+
+	unsigned char out[16];
+	if(ring.copyOut(out, 5) != 5){
+		return false;
+	}
+	if((out[0] != 10) || (out[1] != 11) || (out[2] != 0) || (out[4] != 2)){
+		return false;
+	}
+	ring.clear();
+	return (ring.available() == 0);
+}
+
+
+bool TC12::testRun(){ // SerialRxRing - fill takes all available bytes up to the capacity
+	cout << ".";
+	int fds[2];
+	if(pipe(fds) != 0){
+		return false;
+	}
+	fcntl(fds[0], F_SETFL, O_NONBLOCK);
+
+	bool result = true;
+	unsigned char bytes[100];
+	for(unsigned i = 0; i < 100; i++){
+		bytes[i] = i;
+	}
+	SerialRxRing ring(64);
+	if(write(fds[1], bytes, 100) != 100){
+		result = false;
+	}
+	// one read takes everything that fits
+	if(ring.fill(fds[0]) != 64){
+		result = false;
+	}
+	if(ring.fill(fds[0]) != 0){ // ring is full
+		result = false;
+	}
+	ring.consume(40);
+	if(ring.fill(fds[0]) != 36){ // rest of the pipe, wraps around
+		result = false;
+	}
+	if((ring.available() != 60) || (ring.peek(0) != 40) || (ring.peek(59) != 99)){
+		result = false;
+	}
+	if(ring.fill(fds[0]) != 0){ // pipe is empty
+		result = false;
+	}
+	if(ring.getFillCount() != 3){
+		result = false;
+	}
+	close(fds[0]);
+	close(fds[1]);
+	return result;
+}
+
+
+bool TC21::testRun(){ // PololuReplyParser - typed replies in request order
+	cout << ".";
+	SerialRxRing ring;
+	PololuReplyParser parser;
+	parser.expect(POLOLU_REPLY_POSITION);
+	parser.expect(POLOLU_REPLY_MOVING_STATE);
+	parser.expect(POLOLU_REPLY_ERRORS);
+	if((parser.getOutstanding() != 3) || (parser.getBytesExpected() != 5)){
+		return false;
+	}
+
+	// position 6000, moving, error 0x0010
+	const unsigned char bytes[] = {0x70, 0x17, 0x01, 0x10, 0x00};
+	put(ring, bytes, 5);
+
+	PololuReply reply;
+	if(!parser.next(ring, reply) || (reply.type != POLOLU_REPLY_POSITION) || (reply.value != 6000) || !reply.plausible){
+		return false;
+	}
+	if(!parser.next(ring, reply) || (reply.type != POLOLU_REPLY_MOVING_STATE) || (reply.value != 1)){
+		return false;
+	}
+	if(!parser.next(ring, reply) || (reply.type != POLOLU_REPLY_ERRORS) || (reply.value != 0x0010)){
+		return false;
+	}
+	if(parser.next(ring, reply) || (ring.available() != 0) || (parser.getBytesExpected() != 0)){
+		return false;
+	}
+	return true;
+}
+
+
+bool TC22::testRun(){ // PololuReplyParser - incomplete and implausible replies
+	cout << ".";
+	SerialRxRing ring;
+	PololuReplyParser parser;
+	PololuReply reply;
+
+	// nothing expected, stray bytes are not taken
+	const unsigned char stray[] = {0x01};
+	put(ring, stray, 1);
+	if(parser.next(ring, reply) || (ring.available() != 1)){
+		return false;
+	}
+	ring.clear();
+
+	// half a position stays in the ring
+	parser.expect(POLOLU_REPLY_POSITION);
+	const unsigned char low[] = {0x70};
+	put(ring, low, 1);
+	if(parser.next(ring, reply) || (ring.available() != 1)){
+		return false;
+	}
+	const unsigned char high[] = {0x17};
+	put(ring, high, 1);
+	if(!parser.next(ring, reply) || (reply.value != 6000)){
+		return false;
+	}
+
+	// moving state 2 cannot be sent by a Maestro
+	parser.expect(POLOLU_REPLY_MOVING_STATE);
+	const unsigned char moving[] = {0x02};
+	put(ring, moving, 1);
+	if(!parser.next(ring, reply) || reply.plausible){
+		return false;
+	}
+
+	// the queue is bounded
+	parser.reset();
+	for(unsigned i = 0; i < PololuReplyParser::MAX_OUTSTANDING; i++){
+		if(!parser.expect(POLOLU_REPLY_ERRORS)){
+			return false;
+		}
+	}
+	return !parser.expect(POLOLU_REPLY_ERRORS);
+}
+
+
+bool TC31::testRun(){ // getPositions - pipelined requests to simulated controller
+	cout << ".";
+	bool result = true;
+	MaestroSimulator sim(6);
+	MaestroPty pty(&sim);
+	try{
+		for(unsigned i = 0; i < 6; i++){
+			sim.setPosition(i, 5000 + 200 * i);
+		}
+		pty.start();
+		Pololu pololu(pty.getPortName(), 9600);
+		pololu.openConnection();
+
+		unsigned short servos[] = {5, 0, 3, 1};
+		unsigned short positions[4];
+		pololu.getPositions(servos, 4, positions);
+		for(unsigned i = 0; i < 4; i++){
+			if(positions[i] != (5000 + 200 * servos[i])){
+				result = false;
+			}
+		}
+		// one call, no fall back to single requests
+		RetryStats stats = pololu.getRetryStats(POLOLU_CMD_GET_POSITION);
+		if((stats.calls != 1) || (stats.resyncs != 0)){
+			result = false;
+		}
+		if(sim.getCommandCount() != 4){
+			result = false;
+		}
+		pololu.closeConnection();
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		result = false;
+	}
+	pty.stop();
+	return result;
+}
+
+} // ende namespace UT_SerialRxRing
@@ -0,0 +1,59 @@
+/*
+ * SerialRxRingUT.hpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+#ifndef UNITTESTS_SERIALRXRINGUT_HPP_
+#define UNITTESTS_SERIALRXRINGUT_HPP_
+
+
+#include "../SimplUnitTestFW.hpp"
+
+namespace UT_SerialRxRing{
+
+bool execUnitTests(string xmlFilename);
+
+
+class TC11 : public TestCase{
+	TC11() : TestCase(){};
+public:
+	TC11(string s = string("SerialRxRing - wrap around of spans, peek and consume")) : TestCase(s){};
+	virtual bool testRun(); // SerialRxRing - wrap around of spans, peek and consume
+};
+
+class TC12 : public TestCase{
+	TC12() : TestCase(){};
+public:
+	TC12(string s = string("SerialRxRing - fill takes all available bytes up to the capacity")) : TestCase(s){};
+	virtual bool testRun(); // SerialRxRing - fill takes all available bytes up to the capacity
+};
+
+
+class TC21 : public TestCase{
+	TC21() : TestCase(){};
+public:
+	TC21(string s = string("PololuReplyParser - typed replies in request order")) : TestCase(s){};
+	virtual bool testRun(); // PololuReplyParser - typed replies in request order
+};
+
+class TC22 : public TestCase{
+	TC22() : TestCase(){};
+public:
+	TC22(string s = string("PololuReplyParser - incomplete and implausible replies")) : TestCase(s){};
+	virtual bool testRun(); // PololuReplyParser - incomplete and implausible replies
+};
+
+
+class TC31 : public TestCase{
+	TC31() : TestCase(){};
+public:
+	TC31(string s = string("getPositions - pipelined requests to simulated controller")) : TestCase(s){};
+	virtual bool testRun(); // getPositions - pipelined requests to simulated controller
+};
+
+} // ende namespace UT_SerialRxRing
+
+
+#endif /* UNITTESTS_SERIALRXRINGUT_HPP_ */
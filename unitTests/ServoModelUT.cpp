@@ -0,0 +1,308 @@
+/*
+ * ServoModelUT.cpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+
+#include <string>
+#include <sstream>
+#include <cmath>
+#include <unistd.h>
+#include "../SimplUnitTestFW.hpp"
+#include "../ServoModel.hpp"
+#include "../SerialComRecorder.hpp"
+#include "../SerialComSim.hpp"
+#include "../Pololu.hpp"
+#include "TestUnits.hpp"
+#include "ServoModelUT.hpp"
+
+using namespace std;
+
+namespace UT_ServoModel{
+
+bool execUnitTests(string xmlFilename){
+
+	// a unit a class
+	UnitTest unit("ServoModel");
+
+	// a unit for each method
+	TestSuite TS01("model");
+	TestSuite TS02("fitting");
+
+	// add all test suits to the unit
+	unit.addTestItem(&TS01);
+	unit.addTestItem(&TS02);
+
+	//
+	// test cases for test suite TS01
+	//
+	TC11 tc11("ServoModelFile - save and load");
+	TC12 tc12("ServoEstimator - predicts the simulator");
+	TC13 tc13("loadServoModels - dead time delays the motion");
+
+	// add specific test cases to test suite TS01
+	TS01.addTestItem(&tc11);
+	TS01.addTestItem(&tc12);
+	TS01.addTestItem(&tc13);
+
+	//
+	// test cases for test suite TS02
+	//
+	TC21 tc21("SerialComRecorder - commands and readbacks");
+	TC22 tc22("ServoModelFitter - recovers the parameters of a servo");
+
+	// add specific test cases to test suite TS02
+	TS02.addTestItem(&tc21);
+	TS02.addTestItem(&tc22);
+
+	// execute unit tests
+	unit.testExecution();
+	unit.writeResultsToFile(xmlFilename);
+
+	return unit.getResult();
+}
+
+
+static string tempFile(const char* name){
+	stringstream ss;
+	ss << "/tmp/" << name << "." << getpid() << ".txt";
+	return ss.str();
+}
+
+static ServoModelParams slowServo(unsigned servo){
+	ServoModelParams p;
+	p.servo          = servo;
+	p.deadTimeUs     = 50000;
+	p.speedScaleUp   = 0.8;
+	p.speedScaleDown = 1.2;
+	p.accelScale     = 0.5;
+	return p;
+}
+
+
+bool TC11::testRun(){ // ServoModelFile - save and load
+	cout << ".";
+	bool result = true;
+	string filename = tempFile("servoModelUT11");
+	try{
+		vector<ServoModelParams> params;
+		params.push_back(slowServo(0));
+		params.push_back(slowServo(3));
+		params[1].unlimitedSpeed = 250.0;
+		params[1].rmsError = 1.5;
+		params[1].samples = 1234;
+		ServoModelFile::save(filename, params);
+		vector<ServoModelParams> loaded = ServoModelFile::load(filename);
+		if((loaded.size() != 2) || (loaded[1].servo != 3) || (loaded[0].deadTimeUs != 50000) ||
+				(fabs(loaded[0].speedScaleDown - 1.2) > 1.0e-4) || (loaded[1].unlimitedSpeed != 250.0) ||
+				(loaded[1].samples != 1234)){
+			result = false;
+		}
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		result = false;
+	}
+
+	// malformed lines and missing files are reported
+	FILE *f = fopen(filename.c_str(), "w");
+	fprintf(f, "# comment\n0 50000 0.8\n");
+	fclose(f);
+	try{
+		ServoModelFile::load(filename);
+		result = false;
+	}catch(IException *e){
+		delete e;
+	}
+	unlink(filename.c_str());
+	try{
+		ServoModelFile::load(filename);
+		result = false;
+	}catch(IException *e){
+		delete e;
+	}
+	return result;
+}
+
+
+bool TC12::testRun(){ // ServoEstimator - predicts the simulator
+	cout << ".";
+	bool result = true;
+	for(unsigned variant = 0; variant < 2; variant++){
+		ServoModelParams params = (variant == 0) ? ServoModelParams() : slowServo(0);
+		MaestroSimulator sim(1);
+		sim.setServoModel(0, params);
+		ServoEstimator estimator(params, 6000);
+
+		unsigned char reply[8];
+		unsigned char speed[] = {0x87, 0x00, 30, 0};
+		unsigned char accel[] = {0x89, 0x00, 4, 0};
+		unsigned char up[]    = {0x84, 0x00, 0x40, 0x3E}; // 8000
+		unsigned char down[]  = {0x84, 0x00, 0x20, 0x1F}; // 4000
+		sim.setTime(3000);
+		sim.process(speed, 4, reply, sizeof(reply));
+		sim.process(accel, 4, reply, sizeof(reply));
+		sim.process(up, 4, reply, sizeof(reply));
+		estimator.setSpeed(3000, 30);
+		estimator.setAcceleration(3000, 4);
+		estimator.setTarget(3000, 8000);
+		bool sentDown = false;
+		for(unsigned long long t = 7000; t < 6000000; t += 7000){
+			if(!sentDown && (t >= 2500000)){
+				sentDown = true;
+				sim.setTime(t);
+				sim.process(down, 4, reply, sizeof(reply));
+				estimator.setTarget(t, 4000);
+			}
+			sim.setTime(t);
+			if(sim.getPosition(0) != (unsigned short) (estimator.estimate(t) + 0.5)){
+				result = false;
+			}
+		}
+		if(sim.getPosition(0) != 4000){
+			result = false;
+		}
+	}
+	return result;
+}
+
+
+bool TC13::testRun(){ // loadServoModels - dead time delays the motion
+	cout << ".";
+	bool result = true;
+	string filename = tempFile("servoModelUT13");
+	try{
+		vector<ServoModelParams> params;
+		params.push_back(slowServo(1));
+		params.push_back(slowServo(17)); // no such channel
+		ServoModelFile::save(filename, params);
+		MaestroSimulator sim(6);
+		if(sim.loadServoModels(filename) != 1){
+			result = false;
+		}
+		unsigned char reply[8];
+		unsigned char target[] = {0x84, 0x01, 0x40, 0x3E}; // 8000, unlimited speed
+		sim.setTime(0);
+		sim.process(target, 4, reply, sizeof(reply));
+		sim.setTime(40000);
+		if((sim.getPosition(1) != 6000) || !sim.isMoving()){
+			result = false;
+		}
+		sim.setTime(50000);
+		if(sim.getPosition(1) != 8000){
+			result = false;
+		}
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		result = false;
+	}
+	unlink(filename.c_str());
+	return result;
+}
+
+
+bool TC21::testRun(){ // SerialComRecorder - commands and readbacks
+	cout << ".";
+	bool result = true;
+	try{
+		VirtualClock clock;
+		MaestroSimulator sim(6);
+		sim.setPosition(2, 5000);
+		SerialComSim com(&sim, &clock, 9600);
+		stringstream trace;
+		SerialComRecorder recorder(&com, trace, &clock);
+		Pololu pololu(&recorder);
+		IPololu &controller = pololu;
+		pololu.openConnection();
+		controller.setSpeed(1, 25);
+		controller.setAcceleration(1, 3);
+		controller.setPosition(1, 7000);
+		controller.getPosition(2);
+		unsigned short servos[] = {1, 2};
+		unsigned short positions[2];
+		pololu.getPositions(servos, 2, positions);
+		pololu.getMovingState();
+		pololu.closeConnection();
+
+		map<unsigned, ServoTrace> traces = ServoTraceReader::read(trace);
+		ServoTrace &t1 = traces[1];
+		ServoTrace &t2 = traces[2];
+		if((t1.commandKind.size() != 3) || (t1.commandKind[0] != 'S') || (t1.commandValue[0] != 25) ||
+				(t1.commandKind[1] != 'A') || (t1.commandValue[1] != 3) ||
+				(t1.commandKind[2] != 'T') || (t1.commandValue[2] != 7000)){
+			result = false;
+		}
+		if((t1.sampleTimeUs.size() != 1) || (t1.samplePosition[0] != positions[0])){
+			result = false;
+		}
+		if((t2.sampleTimeUs.size() != 2) || (t2.samplePosition[0] != 5000) || (t2.samplePosition[1] != 5000)){
+			result = false;
+		}
+		if(recorder.getRecords() != 6){
+			result = false;
+		}
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		result = false;
+	}
+	return result;
+}
+
+
+bool TC22::testRun(){ // ServoModelFitter - recovers the parameters of a servo
+	cout << ".";
+	bool result = true;
+	try{
+		VirtualClock clock;
+		MaestroSimulator sim(6);
+		sim.setServoModel(1, slowServo(1));
+		SerialComSim com(&sim, &clock, 57600);
+		stringstream trace;
+		SerialComRecorder recorder(&com, trace, &clock);
+		Pololu pololu(&recorder);
+		IPololu &controller = pololu;
+		setTestClock(&clock);
+		pololu.openConnection();
+
+		// moves up and down with and without acceleration limit,
+		// readbacks every 20 ms
+		unsigned short speeds[] = {20, 40, 30, 15};
+		unsigned short accels[] = {0, 0, 8, 4};
+		for(unsigned m = 0; m < 8; m++){
+			controller.setSpeed(1, speeds[m % 4]);
+			controller.setAcceleration(1, accels[m % 4]);
+			controller.setPosition(1, (m % 2 == 0) ? 7600 : 4400);
+			for(unsigned i = 0; i < 150; i++){
+				controller.getPosition(1);
+				wait(20);
+			}
+		}
+		setTestClock(nullptr);
+		pololu.closeConnection();
+
+		map<unsigned, ServoTrace> traces = ServoTraceReader::read(trace);
+		ServoModelParams p = ServoModelFitter::fit(traces[1]);
+		if((p.deadTimeUs < 40000) || (p.deadTimeUs > 60000)){
+			result = false;
+		}
+		if((fabs(p.speedScaleUp - 0.8) > 0.04) || (fabs(p.speedScaleDown - 1.2) > 0.06) ||
+				(fabs(p.accelScale - 0.5) > 0.05)){
+			result = false;
+		}
+		if((p.rmsError > 5.0) || (p.samples != 1200)){
+			result = false;
+		}
+		if(!result){
+			cout << "fit: " << p.deadTimeUs << " " << p.speedScaleUp << " " << p.speedScaleDown << " "
+				 << p.accelScale << " rms " << p.rmsError << endl;
+		}
+	}catch(IException *e){
+		setTestClock(nullptr);
+		cout << e->getMsg() << endl;
+		result = false;
+	}
+	return result;
+}
+
+} // ende namespace UT_ServoModel
@@ -0,0 +1,58 @@
+/*
+ * ServoModelUT.hpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+#ifndef UNITTESTS_SERVOMODELUT_HPP_
+#define UNITTESTS_SERVOMODELUT_HPP_
+
+
+#include "../SimplUnitTestFW.hpp"
+
+namespace UT_ServoModel{
+
+bool execUnitTests(string xmlFilename);
+
+
+class TC11 : public TestCase{
+	TC11() : TestCase(){};
+public:
+	TC11(string s = string("ServoModelFile - save and load")) : TestCase(s){};
+	virtual bool testRun(); // ServoModelFile - save and load
+};
+
+class TC12 : public TestCase{
+	TC12() : TestCase(){};
+public:
+	TC12(string s = string("ServoEstimator - predicts the simulator")) : TestCase(s){};
+	virtual bool testRun(); // ServoEstimator - predicts the simulator
+};
+
+class TC13 : public TestCase{
+	TC13() : TestCase(){};
+public:
+	TC13(string s = string("loadServoModels - dead time delays the motion")) : TestCase(s){};
+	virtual bool testRun(); // loadServoModels - dead time delays the motion
+};
+
+
+class TC21 : public TestCase{
+	TC21() : TestCase(){};
+public:
+	TC21(string s = string("SerialComRecorder - commands and readbacks")) : TestCase(s){};
+	virtual bool testRun(); // SerialComRecorder - commands and readbacks
+};
+
+class TC22 : public TestCase{
+	TC22() : TestCase(){};
+public:
+	TC22(string s = string("ServoModelFitter - recovers the parameters of a servo")) : TestCase(s){};
+	virtual bool testRun(); // ServoModelFitter - recovers the parameters of a servo
+};
+
+} // ende namespace UT_ServoModel
+
+
+#endif /* UNITTESTS_SERVOMODELUT_HPP_ */
@@ -7,6 +7,7 @@
 
 #include "../SimplUnitTestFW.hpp"
 #include "../ServoMotor.hpp"
+#include "PololuFixture.hpp"
 #include "ServoMotorBaseUT.hpp"
 
 
@@ -35,6 +36,10 @@ bool execUnitTests(string xmlFilename){
 	unit.addTestItem(&TS06);
 	unit.addTestItem(&TS07);
 
+	// one controller connection for all test cases
+	PololuFixture pololu;
+	unit.setFixture(&pololu);
+
 	//
 	// test cases for test suite TS01
 	//
@@ -143,6 +148,29 @@ bool execUnitTests(string xmlFilename){
 	TS07.addTestItem(&tc76);
 	TS07.addTestItem(&tc77);
 
+	// the test cases using the controller are skipped without it
+	tc11.requireResource("/dev/ttyACM0");
+	tc13.requireResource("/dev/ttyACM0");
+	tc14.requireResource("/dev/ttyACM0");
+	tc15.requireResource("/dev/ttyACM0");
+	tc16.requireResource("/dev/ttyACM0");
+	tc21.requireResource("/dev/ttyACM0");
+	tc23.requireResource("/dev/ttyACM0");
+	tc31.requireResource("/dev/ttyACM0");
+	tc32.requireResource("/dev/ttyACM0");
+	tc41.requireResource("/dev/ttyACM0");
+	tc42.requireResource("/dev/ttyACM0");
+	tc51.requireResource("/dev/ttyACM0");
+	tc52.requireResource("/dev/ttyACM0");
+	tc61.requireResource("/dev/ttyACM0");
+	tc62.requireResource("/dev/ttyACM0");
+	tc72.requireResource("/dev/ttyACM0");
+	tc73.requireResource("/dev/ttyACM0");
+	tc74.requireResource("/dev/ttyACM0");
+	tc75.requireResource("/dev/ttyACM0");
+	tc76.requireResource("/dev/ttyACM0");
+	tc77.requireResource("/dev/ttyACM0");
+
 	// execute unit tests
 	unit.testExecution();
 	unit.writeResultsToFile(xmlFilename);
@@ -168,11 +196,10 @@ bool TC71::testRun(){ // constructor - with no communication channel
 	}
 };
 
-bool TC72::testRun(){ // constructor - negative servo motor nmb
+bool TC72::testRun(TestFixture *fixture){ // constructor - negative servo motor nmb
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		try{
 			int srvNmb = -1;
 			ServoMotorPololuBase m(srvNmb,6000,3000,&p);
@@ -193,11 +220,10 @@ bool TC72::testRun(){ // constructor - negative servo motor nmb
 	return false;
 };
 
-bool TC73::testRun(){ // constructor - negative neutral position values
+bool TC73::testRun(TestFixture *fixture){ // constructor - negative neutral position values
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		try{
 			int nPos = -1;
 			ServoMotorPololuBase m(0,nPos,3000,&p);
@@ -219,11 +245,10 @@ bool TC73::testRun(){ // constructor - negative neutral position values
 	return false;
 };
 
-bool TC74::testRun(){ // constructor - delta values = 0
+bool TC74::testRun(TestFixture *fixture){ // constructor - delta values = 0
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		try{
 			int delta = 0;
 			ServoMotorPololuBase m(0,delta,3000,&p);
@@ -240,11 +265,10 @@ bool TC74::testRun(){ // constructor - delta values = 0
 	return false;
 };
 
-bool TC75::testRun(){ // constructor - non matching neutral and delta values
+bool TC75::testRun(TestFixture *fixture){ // constructor - non matching neutral and delta values
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		unsigned short delta = 6001;
 		unsigned short nPos = 6000;
 		try{
@@ -264,11 +288,10 @@ bool TC75::testRun(){ // constructor - non matching neutral and delta values
 };
 
 
-bool TC76::testRun(){ // constructor - call with no motor connected
+bool TC76::testRun(TestFixture *fixture){ // constructor - call with no motor connected
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		try{
 			ServoMotorPololuBase m(1,6000,3000,&p); // servo motor board ID must not be
 			                                        // connected to a servo motor
@@ -287,11 +310,10 @@ bool TC76::testRun(){ // constructor - call with no motor connected
 };
 
 
-bool TC77::testRun(){ // constructor - call with non existing servo board ID
+bool TC77::testRun(TestFixture *fixture){ // constructor - call with non existing servo board ID
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		try{
 			ServoMotorPololuBase m(111,6000,3000,&p); // servo motor board ID must not
 													  // be defined for used board
@@ -310,11 +332,10 @@ bool TC77::testRun(){ // constructor - call with non existing servo board ID
 };
 
 
-bool TC61::testRun(){ // getServoNumber - having closed communication channel
+bool TC61::testRun(TestFixture *fixture){ // getServoNumber - having closed communication channel
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		unsigned short sNmb, value;
 		sNmb = 0;
 		ServoMotorPololuBase m(sNmb,6000,3000,&p);
@@ -340,11 +361,10 @@ bool TC61::testRun(){ // getServoNumber - having closed communication channel
 }
 
 
-bool TC62::testRun(){ // getServoNumber - with open communication channel
+bool TC62::testRun(TestFixture *fixture){ // getServoNumber - with open communication channel
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		unsigned short sNmb, value;
 		sNmb = 0;
 		ServoMotorPololuBase m(sNmb,6000,3000,&p);
@@ -376,14 +396,13 @@ bool TC62::testRun(){ // getServoNumber - with open communication channel
 
 
 
-bool TC51::testRun(){ // getMaxPosInAbs - having closed communication channel
+bool TC51::testRun(TestFixture *fixture){ // getMaxPosInAbs - having closed communication channel
 	cout << ".";
 	try{
 		unsigned short mid = 6000;
 		unsigned short delta = 3000;
 		unsigned short pos;
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		ServoMotorPololuBase m(0,mid,delta,&p);
 		p.closeConnection();
 		pos = m.getMaxPosInAbs();
@@ -408,11 +427,10 @@ bool TC51::testRun(){ // getMaxPosInAbs - having closed communication channel
 }
 
 
-bool TC52::testRun(){ // getMaxdPosInAbs - with open communication channel
+bool TC52::testRun(TestFixture *fixture){ // getMaxdPosInAbs - with open communication channel
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		unsigned short mid = 6000;
 		unsigned short delta = 3000;
 		unsigned short pos;
@@ -440,14 +458,13 @@ bool TC52::testRun(){ // getMaxdPosInAbs - with open communication channel
 
 
 
-bool TC41::testRun(){ // getMidPosInAbs - having closed communication channel
+bool TC41::testRun(TestFixture *fixture){ // getMidPosInAbs - having closed communication channel
 	cout << ".";
 	try{
 		unsigned short mid = 6000;
 		unsigned short delta = 3000;
 		unsigned short pos;
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		ServoMotorPololuBase m(0,mid,delta,&p);
 		p.closeConnection();
 		pos = m.getMidPosInAbs();
@@ -472,11 +489,10 @@ bool TC41::testRun(){ // getMidPosInAbs - having closed communication channel
 }
 
 
-bool TC42::testRun(){ // getMidPosInAbs - with open communication channel
+bool TC42::testRun(TestFixture *fixture){ // getMidPosInAbs - with open communication channel
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		unsigned short mid = 6000;
 		unsigned short delta = 3000;
 		unsigned short pos;
@@ -501,14 +517,13 @@ bool TC42::testRun(){ // getMidPosInAbs - with open communication channel
 }
 
 
-bool TC31::testRun(){ // getMinPosInAbs - having closed communication channel
+bool TC31::testRun(TestFixture *fixture){ // getMinPosInAbs - having closed communication channel
 	cout << ".";
 	try{
 		unsigned short mid = 6000;
 		unsigned short delta = 3000;
 		unsigned min;
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		ServoMotorPololuBase m(0,mid,delta,&p);
 		p.closeConnection();
 		min = m.getMinPosInAbs();
@@ -533,11 +548,10 @@ bool TC31::testRun(){ // getMinPosInAbs - having closed communication channel
 }
 
 
-bool TC32::testRun(){ // getMinPosInAbs - with open communication channel
+bool TC32::testRun(TestFixture *fixture){ // getMinPosInAbs - with open communication channel
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		unsigned short mid = 6000;
 		unsigned short delta = 3000;
 		unsigned min;
@@ -567,11 +581,10 @@ bool TC32::testRun(){ // getMinPosInAbs - with open communication channel
 
 
 
-bool TC21::testRun(){ // getPositionInAbs - having closed communication channel
+bool TC21::testRun(TestFixture *fixture){ // getPositionInAbs - having closed communication channel
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		ServoMotorPololuBase m(0,6000,3000,&p);
 		p.closeConnection();
 		try{
@@ -612,11 +625,10 @@ bool TC22::testRun(){ // getPositionInAbs - with no communication channel
 }
 
 
-bool TC23::testRun(){ // getPositionInAbs - with open communication channel
+bool TC23::testRun(TestFixture *fixture){ // getPositionInAbs - with open communication channel
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		ServoMotorPololuBase m(0,6000,3000,&p);
 		try{
 			short pos = m.getPositionInAbs();
@@ -640,11 +652,10 @@ bool TC23::testRun(){ // getPositionInAbs - with open communication channel
 
 
 
-bool TC11::testRun(){ // setPositionInAbs - having closed communication channel
+bool TC11::testRun(TestFixture *fixture){ // setPositionInAbs - having closed communication channel
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		ServoMotorPololuBase m(0,6000,3000,&p);
 		p.closeConnection();
 		try{
@@ -685,11 +696,10 @@ bool TC12::testRun(){ // setPositionInAbs - with no communication channel
 }
 
 
-bool TC13::testRun(){ // setPositionInAbs - with open communication channel
+bool TC13::testRun(TestFixture *fixture){ // setPositionInAbs - with open communication channel
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		ServoMotorPololuBase m(0,6000,3000,&p);
 		try{
 			short pos = m.getPositionInAbs();
@@ -710,11 +720,10 @@ bool TC13::testRun(){ // setPositionInAbs - with open communication channel
 
 
 
-bool TC14::testRun(){ // setPositionInAbs - check the set value within its limits
+bool TC14::testRun(TestFixture *fixture){ // setPositionInAbs - check the set value within its limits
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		ServoMotorPololuBase m(0,6000,3000,&p);
 		unsigned short mid = m.getMidPosInAbs();
 		unsigned short max = m.getMaxPosInAbs();
@@ -746,11 +755,10 @@ bool TC14::testRun(){ // setPositionInAbs - check the set value within its limit
 }
 
 
-bool TC15::testRun(){ // setPositionInAbs - try to set pos value larger then max.
+bool TC15::testRun(TestFixture *fixture){ // setPositionInAbs - try to set pos value larger then max.
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		ServoMotorPololuBase m(0,6000,3000,&p);
 		unsigned short max = m.getMaxPosInAbs();
 		unsigned short posTarget = max + 1;
@@ -770,11 +778,10 @@ bool TC15::testRun(){ // setPositionInAbs - try to set pos value larger then max
 	return false;
 }
 
-bool TC16::testRun(){ // setPositionInAbs - try to set pos value smaller then min.
+bool TC16::testRun(TestFixture *fixture){ // setPositionInAbs - try to set pos value smaller then min.
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		ServoMotorPololuBase m(0,6000,3000,&p);
 		unsigned short min = m.getMinPosInAbs();
 		unsigned short posTarget = min - 1;
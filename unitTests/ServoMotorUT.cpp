@@ -7,6 +7,7 @@
 
 #include "../SimplUnitTestFW.hpp"
 #include "../ServoMotor.hpp"
+#include "PololuFixture.hpp"
 #include "ServoMotorUT.hpp"
 
 
@@ -36,6 +37,10 @@ bool execUnitTests(string xmlFilename){
 	unit.addTestItem(&TS06);
 	unit.addTestItem(&TS07);
 
+	// one controller connection for all test cases
+	PololuFixture pololu;
+	unit.setFixture(&pololu);
+
 	//
 	// test cases for test suite TS01
 	//
@@ -144,6 +149,29 @@ bool execUnitTests(string xmlFilename){
 	TS07.addTestItem(&tc76);
 	TS07.addTestItem(&tc77);
 
+	// the test cases using the controller are skipped without it
+	tc11.requireResource("/dev/ttyACM0");
+	tc13.requireResource("/dev/ttyACM0");
+	tc14.requireResource("/dev/ttyACM0");
+	tc15.requireResource("/dev/ttyACM0");
+	tc16.requireResource("/dev/ttyACM0");
+	tc21.requireResource("/dev/ttyACM0");
+	tc23.requireResource("/dev/ttyACM0");
+	tc31.requireResource("/dev/ttyACM0");
+	tc32.requireResource("/dev/ttyACM0");
+	tc41.requireResource("/dev/ttyACM0");
+	tc42.requireResource("/dev/ttyACM0");
+	tc51.requireResource("/dev/ttyACM0");
+	tc52.requireResource("/dev/ttyACM0");
+	tc61.requireResource("/dev/ttyACM0");
+	tc62.requireResource("/dev/ttyACM0");
+	tc72.requireResource("/dev/ttyACM0");
+	tc73.requireResource("/dev/ttyACM0");
+	tc74.requireResource("/dev/ttyACM0");
+	tc75.requireResource("/dev/ttyACM0");
+	tc76.requireResource("/dev/ttyACM0");
+	tc77.requireResource("/dev/ttyACM0");
+
 	// execute unit tests
 	unit.testExecution();
 	unit.writeResultsToFile(xmlFilename);
@@ -169,11 +197,10 @@ bool TC71::testRun(){ // constructor - with no communication channel
 	}
 };
 
-bool TC72::testRun(){ // constructor - negative servo motor nmb
+bool TC72::testRun(TestFixture *fixture){ // constructor - negative servo motor nmb
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		try{
 			int srvNmb = -1;
 			ServoMotor m(srvNmb,6000,3000,&p);
@@ -194,11 +221,10 @@ bool TC72::testRun(){ // constructor - negative servo motor nmb
 	return false;
 };
 
-bool TC73::testRun(){ // constructor - negative neutral position values
+bool TC73::testRun(TestFixture *fixture){ // constructor - negative neutral position values
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		try{
 			int nPos = -1;
 			ServoMotor m(0,nPos,3000,&p);
@@ -220,11 +246,10 @@ bool TC73::testRun(){ // constructor - negative neutral position values
 	return false;
 };
 
-bool TC74::testRun(){ // constructor - delta values = 0
+bool TC74::testRun(TestFixture *fixture){ // constructor - delta values = 0
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		try{
 			int delta = 0;
 			ServoMotor m(0,delta,3000,&p);
@@ -241,11 +266,10 @@ bool TC74::testRun(){ // constructor - delta values = 0
 	return false;
 };
 
-bool TC75::testRun(){ // constructor - non matching neutral and delta values
+bool TC75::testRun(TestFixture *fixture){ // constructor - non matching neutral and delta values
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		unsigned short delta = 6001;
 		unsigned short nPos = 6000;
 		try{
@@ -265,11 +289,10 @@ bool TC75::testRun(){ // constructor - non matching neutral and delta values
 };
 
 
-bool TC76::testRun(){ // constructor - call with no motor connected
+bool TC76::testRun(TestFixture *fixture){ // constructor - call with no motor connected
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		try{
 			ServoMotor m(1,6000,3000,&p); // servo motor board ID must not be
 			                                        // connected to a servo motor
@@ -288,11 +311,10 @@ bool TC76::testRun(){ // constructor - call with no motor connected
 };
 
 
-bool TC77::testRun(){ // constructor - call with non existing servo board ID
+bool TC77::testRun(TestFixture *fixture){ // constructor - call with non existing servo board ID
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		try{
 			ServoMotor m(111,6000,3000,&p); // servo motor board ID must not
 													  // be defined for used board
@@ -311,11 +333,10 @@ bool TC77::testRun(){ // constructor - call with non existing servo board ID
 };
 
 
-bool TC61::testRun(){ // getServoNumber - having closed communication channel
+bool TC61::testRun(TestFixture *fixture){ // getServoNumber - having closed communication channel
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		unsigned short sNmb, value;
 		sNmb = 0;
 		ServoMotor m(sNmb,6000,3000,&p);
@@ -341,11 +362,10 @@ bool TC61::testRun(){ // getServoNumber - having closed communication channel
 }
 
 
-bool TC62::testRun(){ // getServoNumber - with open communication channel
+bool TC62::testRun(TestFixture *fixture){ // getServoNumber - with open communication channel
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		unsigned short sNmb, value;
 		sNmb = 0;
 		ServoMotor m(sNmb,6000,3000,&p);
@@ -377,14 +397,13 @@ bool TC62::testRun(){ // getServoNumber - with open communication channel
 
 
 
-bool TC51::testRun(){ // getMaxPosInAbs - having closed communication channel
+bool TC51::testRun(TestFixture *fixture){ // getMaxPosInAbs - having closed communication channel
 	cout << ".";
 	try{
 		unsigned short mid = 6000;
 		unsigned short delta = 3000;
 		unsigned short pos;
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		ServoMotor m(0,mid,delta,&p);
 		p.closeConnection();
 		pos = m.getMaxPosInAbs();
@@ -409,11 +428,10 @@ bool TC51::testRun(){ // getMaxPosInAbs - having closed communication channel
 }
 
 
-bool TC52::testRun(){ // getMaxdPosInAbs - with open communication channel
+bool TC52::testRun(TestFixture *fixture){ // getMaxdPosInAbs - with open communication channel
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		unsigned short mid = 6000;
 		unsigned short delta = 3000;
 		unsigned short pos;
@@ -441,14 +459,13 @@ bool TC52::testRun(){ // getMaxdPosInAbs - with open communication channel
 
 
 
-bool TC41::testRun(){ // getMidPosInAbs - having closed communication channel
+bool TC41::testRun(TestFixture *fixture){ // getMidPosInAbs - having closed communication channel
 	cout << ".";
 	try{
 		unsigned short mid = 6000;
 		unsigned short delta = 3000;
 		unsigned short pos;
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		ServoMotor m(0,mid,delta,&p);
 		p.closeConnection();
 		pos = m.getMidPosInAbs();
@@ -473,11 +490,10 @@ bool TC41::testRun(){ // getMidPosInAbs - having closed communication channel
 }
 
 
-bool TC42::testRun(){ // getMidPosInAbs - with open communication channel
+bool TC42::testRun(TestFixture *fixture){ // getMidPosInAbs - with open communication channel
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		unsigned short mid = 6000;
 		unsigned short delta = 3000;
 		unsigned short pos;
@@ -502,14 +518,13 @@ bool TC42::testRun(){ // getMidPosInAbs - with open communication channel
 }
 
 
-bool TC31::testRun(){ // getMinPosInAbs - having closed communication channel
+bool TC31::testRun(TestFixture *fixture){ // getMinPosInAbs - having closed communication channel
 	cout << ".";
 	try{
 		unsigned short mid = 6000;
 		unsigned short delta = 3000;
 		unsigned min;
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		ServoMotor m(0,mid,delta,&p);
 		p.closeConnection();
 		min = m.getMinPosInAbs();
@@ -534,11 +549,10 @@ bool TC31::testRun(){ // getMinPosInAbs - having closed communication channel
 }
 
 
-bool TC32::testRun(){ // getMinPosInAbs - with open communication channel
+bool TC32::testRun(TestFixture *fixture){ // getMinPosInAbs - with open communication channel
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		unsigned short mid = 6000;
 		unsigned short delta = 3000;
 		unsigned min;
@@ -568,11 +582,10 @@ bool TC32::testRun(){ // getMinPosInAbs - with open communication channel
 
 
 
-bool TC21::testRun(){ // getPositionInAbs - having closed communication channel
+bool TC21::testRun(TestFixture *fixture){ // getPositionInAbs - having closed communication channel
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		ServoMotor m(0,6000,3000,&p);
 		p.closeConnection();
 		try{
@@ -613,11 +626,10 @@ bool TC22::testRun(){ // getPositionInAbs - with no communication channel
 }
 
 
-bool TC23::testRun(){ // getPositionInAbs - with open communication channel
+bool TC23::testRun(TestFixture *fixture){ // getPositionInAbs - with open communication channel
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		ServoMotor m(0,6000,3000,&p);
 		try{
 			short pos = m.getPositionInAbs();
@@ -641,11 +653,10 @@ bool TC23::testRun(){ // getPositionInAbs - with open communication channel
 
 
 
-bool TC11::testRun(){ // setPositionInAbs - having closed communication channel
+bool TC11::testRun(TestFixture *fixture){ // setPositionInAbs - having closed communication channel
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		ServoMotor m(0,6000,3000,&p);
 		p.closeConnection();
 		try{
@@ -687,11 +698,10 @@ bool TC12::testRun(){ // setPositionInAbs - with no communication channel
 }
 
 
-bool TC13::testRun(){ // setPositionInAbs - with open communication channel
+bool TC13::testRun(TestFixture *fixture){ // setPositionInAbs - with open communication channel
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		ServoMotor m(0,6000,3000,&p);
 		try{
 			short pos =  m.getPositionInAbs();
@@ -720,11 +730,10 @@ bool TC13::testRun(){ // setPositionInAbs - with open communication channel
 
 
 
-bool TC14::testRun(){ // setPositionInAbs - check the set value within its limits
+bool TC14::testRun(TestFixture *fixture){ // setPositionInAbs - check the set value within its limits
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		ServoMotor m(0,6000,3000,&p);
 		unsigned short mid = m.getMidPosInAbs();
 		unsigned short max = m.getMaxPosInAbs();
@@ -756,11 +765,10 @@ bool TC14::testRun(){ // setPositionInAbs - check the set value within its limit
 }
 
 
-bool TC15::testRun(){ // setPositionInAbs - try to set pos value larger then max.
+bool TC15::testRun(TestFixture *fixture){ // setPositionInAbs - try to set pos value larger then max.
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		ServoMotor m(0,6000,3000,&p);
 		unsigned short max = m.getMaxPosInAbs();
 		unsigned short posTarget = max + 1;
@@ -780,11 +788,10 @@ bool TC15::testRun(){ // setPositionInAbs - try to set pos value larger then max
 	return false;
 }
 
-bool TC16::testRun(){ // setPositionInAbs - try to set pos value smaller then min.
+bool TC16::testRun(TestFixture *fixture){ // setPositionInAbs - try to set pos value smaller then min.
 	cout << ".";
 	try{
-		Pololu p("/dev/ttyACM0",9600);
-		p.openConnection();
+		Pololu &p = PololuFixture::of(fixture).open();
 		ServoMotor m(0,6000,3000,&p);
 		unsigned short min = m.getMinPosInAbs();
 		unsigned short posTarget = min - 1;
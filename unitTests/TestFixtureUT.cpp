@@ -0,0 +1,199 @@
+/*
+ * TestFixtureUT.cpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+
+#include <string>
+#include "../SimplUnitTestFW.hpp"
+#include "TestFixtureUT.hpp"
+
+using namespace std;
+
+namespace UT_TestFixture{
+
+bool execUnitTests(string xmlFilename){
+
+	// a unit a class
+	UnitTest unit("TestFixture");
+
+	// a unit for each method
+	TestSuite TS01("fixtures");
+
+	// add all test suits to the unit
+	unit.addTestItem(&TS01);
+
+	//
+	// test cases for test suite TS01
+	//
+	TC11 tc11("TestSuite - setUp, reset per case and tearDown");
+	TC12 tc12("UnitTest - nested fixtures");
+	TC13 tc13("TestSuite - failing setUp and tearDown");
+	TC14 tc14("TestCase - failing reset");
+
+	// add specific test cases to test suite TS01
+	TS01.addTestItem(&tc11);
+	TS01.addTestItem(&tc12);
+	TS01.addTestItem(&tc13);
+	TS01.addTestItem(&tc14);
+
+	// execute unit tests
+	unit.testExecution();
+	unit.writeResultsToFile(xmlFilename);
+
+	return unit.getResult();
+}
+
+
+/*
+ * Writes its calls into a log, the steps to fail are given.
+ */
+class LogFixture : public TestFixture{
+public:
+	LogFixture(string &log, const string &name, const string &fail = "")
+		: log_(log), name_(name), fail_(fail){};
+	virtual bool setUp()   {return step("setUp");};
+	virtual bool tearDown(){return step("tearDown");};
+	virtual bool reset()   {return step("reset");};
+	string getName(){return name_;};
+protected:
+	bool step(const string &s){
+		log_ += name_ + "." + s + " ";
+		if(fail_ == s){
+			error_ = s + " failed";
+			return false;
+		}
+		return true;
+	}
+	string &log_;
+	string  name_;
+	string  fail_;
+};
+
+/*
+ * Logs its run and the name of the fixture it got.
+ */
+class LogCase : public TestCase{
+public:
+	LogCase(string &log, const string &name) : TestCase(name), log_(log){};
+protected:
+	virtual bool testRun(TestFixture *fixture){
+		LogFixture *f = (fixture != nullptr) ? fixture->find<LogFixture>() : nullptr;
+		log_ += getName() + "(" + ((f != nullptr) ? f->getName() : string("-")) + ") ";
+		return true;
+	}
+	string &log_;
+};
+
+
+bool TC11::testRun(){ // TestSuite - setUp, reset per case and tearDown
+	cout << ".";
+	bool result = true;
+	string log;
+	LogFixture fixture(log, "f");
+	LogCase a(log, "a"), b(log, "b");
+	TestSuite suite("suite");
+	suite.addTestItem(&a);
+	suite.addTestItem(&b);
+	suite.setFixture(&fixture);
+
+	suite.testExecution();
+	if(!suite.getResult() || (log != "f.setUp f.reset a(f) f.reset b(f) f.tearDown ")){
+		result = false;
+	}
+	// each execution sets up again
+	log.clear();
+	suite.testExecution();
+	if(log != "f.setUp f.reset a(f) f.reset b(f) f.tearDown "){
+		result = false;
+	}
+	return result;
+}
+
+
+bool TC12::testRun(){ // UnitTest - nested fixtures
+	cout << ".";
+	bool result = true;
+	string log;
+	LogFixture outer(log, "u"), inner(log, "s");
+	LogCase a(log, "a"), b(log, "b");
+	UnitTest unit("unit");
+	TestSuite withFixture("with"), without("without");
+	unit.addTestItem(&withFixture);
+	unit.addTestItem(&without);
+	withFixture.addTestItem(&a);
+	without.addTestItem(&b);
+	unit.setFixture(&outer);
+	withFixture.setFixture(&inner);
+
+	unit.testExecution();
+	if(!unit.getResult() ||
+			(log != "u.setUp s.setUp u.reset s.reset a(s) s.tearDown u.reset b(u) u.tearDown ")){
+		result = false;
+	}
+	if((inner.getParent() != &outer) || (inner.find<LogFixture>() != &inner) || (outer.getParent() != nullptr)){
+		result = false;
+	}
+
+	// no fixture at all
+	log.clear();
+	TestSuite plain("plain");
+	plain.addTestItem(&a);
+	plain.testExecution();
+	if(log != "a(-) "){
+		result = false;
+	}
+	return result;
+}
+
+
+bool TC13::testRun(){ // TestSuite - failing setUp and tearDown
+	cout << ".";
+	bool result = true;
+	string log;
+	LogFixture broken(log, "f", "setUp");
+	LogCase a(log, "a");
+	TestSuite suite("suite");
+	suite.addTestItem(&a);
+	suite.setFixture(&broken);
+
+	// the test cases are not executed
+	suite.testExecution();
+	string xml = suite.toXmlStr();
+	if(suite.getResult() || (log != "f.setUp ") || (xml.find("fixtureError=\"setUp: setUp failed\"") == string::npos)){
+		result = false;
+	}
+
+	log.clear();
+	LogFixture leaking(log, "f", "tearDown");
+	suite.setFixture(&leaking);
+	suite.testExecution();
+	xml = suite.toXmlStr();
+	if(suite.getResult() || !a.getResult() || (log != "f.setUp f.reset a(f) f.tearDown ") ||
+			(xml.find("fixtureError=\"tearDown: tearDown failed\"") == string::npos)){
+		result = false;
+	}
+	return result;
+}
+
+
+bool TC14::testRun(){ // TestCase - failing reset
+	cout << ".";
+	bool result = true;
+	string log;
+	LogFixture fixture(log, "f", "reset");
+	LogCase a(log, "a");
+	TestSuite suite("suite");
+	suite.addTestItem(&a);
+	suite.setFixture(&fixture);
+
+	suite.testExecution();
+	if(suite.getResult() || a.getResult() || (log != "f.setUp f.reset f.tearDown ")){
+		result = false;
+	}
+	return result;
+}
+
+} // ende namespace UT_TestFixture
@@ -0,0 +1,50 @@
+/*
+ * TestFixtureUT.hpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+#ifndef UNITTESTS_TESTFIXTUREUT_HPP_
+#define UNITTESTS_TESTFIXTUREUT_HPP_
+
+
+#include "../SimplUnitTestFW.hpp"
+
+namespace UT_TestFixture{
+
+bool execUnitTests(string xmlFilename);
+
+
+class TC11 : public TestCase{
+	TC11() : TestCase(){};
+public:
+	TC11(string s = string("TestSuite - setUp, reset per case and tearDown")) : TestCase(s){};
+	virtual bool testRun(); // TestSuite - setUp, reset per case and tearDown
+};
+
+class TC12 : public TestCase{
+	TC12() : TestCase(){};
+public:
+	TC12(string s = string("UnitTest - nested fixtures")) : TestCase(s){};
+	virtual bool testRun(); // UnitTest - nested fixtures
+};
+
+class TC13 : public TestCase{
+	TC13() : TestCase(){};
+public:
+	TC13(string s = string("TestSuite - failing setUp and tearDown")) : TestCase(s){};
+	virtual bool testRun(); // TestSuite - failing setUp and tearDown
+};
+
+class TC14 : public TestCase{
+	TC14() : TestCase(){};
+public:
+	TC14(string s = string("TestCase - failing reset")) : TestCase(s){};
+	virtual bool testRun(); // TestCase - failing reset
+};
+
+} // ende namespace UT_TestFixture
+
+
+#endif /* UNITTESTS_TESTFIXTUREUT_HPP_ */
@@ -0,0 +1,894 @@
+/*
+ * TestRunUT.cpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+
+#include <string>
+#include <sstream>
+#include <vector>
+#include <regex>
+#include <fstream>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "../SimplUnitTestFW.hpp"
+#include "../TestReport.hpp"
+#include "TestRunUT.hpp"
+
+using namespace std;
+
+namespace UT_TestRun{
+
+bool execUnitTests(string xmlFilename){
+
+	// a unit a class
+	UnitTest unit("TestRun");
+
+	// a unit for each method
+	TestSuite TS01("selection");
+	TestSuite TS02("TestReport");
+	TestSuite TS03("timeouts");
+	TestSuite TS04("workers");
+	TestSuite TS05("resources");
+
+	// add all test suits to the unit
+	unit.addTestItem(&TS01);
+	unit.addTestItem(&TS02);
+	unit.addTestItem(&TS03);
+	unit.addTestItem(&TS04);
+	unit.addTestItem(&TS05);
+
+	//
+	// test cases for test suite TS01
+	//
+	TC11 tc11("TestRun - unit, suite and case globs, regular expression");
+	TC12 tc12("TestRun - shards partition the test cases");
+	TC13 tc13("TestRun - command line");
+	TC14 tc14("UnitTest - selected cases, fixtures and results only");
+
+	// add specific test cases to test suite TS01
+	TS01.addTestItem(&tc11);
+	TS01.addTestItem(&tc12);
+	TS01.addTestItem(&tc13);
+	TS01.addTestItem(&tc14);
+
+	//
+	// test cases for test suite TS02
+	//
+	TC21 tc21("TestReport - merge of shards");
+	TC22 tc22("TestReport - malformed results");
+	TC23 tc23("TestReport - nested suites, cases of the unit and equal names");
+
+	// add specific test cases to test suite TS02
+	TS02.addTestItem(&tc21);
+	TS02.addTestItem(&tc22);
+	TS02.addTestItem(&tc23);
+
+	//
+	// test cases for test suite TS03
+	//
+	TC31 tc31("TestCase - timeout of an isolated case, the run continues");
+	TC32 tc32("TestSuite - budget of a suite");
+	TC33 tc33("TestRun - watchdog aborts the run and writes the results");
+	TC34 tc34("TestReport - timeouts and command line");
+
+	// add specific test cases to test suite TS03
+	TS03.addTestItem(&tc31);
+	TS03.addTestItem(&tc32);
+	TS03.addTestItem(&tc33);
+	TS03.addTestItem(&tc34);
+
+	//
+	// test cases for test suite TS04
+	//
+	TC41 tc41("TestPool - results as executed in process");
+	TC42 tc42("TestPool - crashed, throwing and hung workers are replaced");
+	TC43 tc43("TestPool - parallel jobs and sequential suites");
+
+	// add specific test cases to test suite TS04
+	TS04.addTestItem(&tc41);
+	TS04.addTestItem(&tc42);
+	TS04.addTestItem(&tc43);
+
+	//
+	// test cases for test suite TS05
+	//
+	TC51 tc51("TestRun - resources probed once per unit, missing ones skip");
+	TC52 tc52("TestRun - device probes, skipped results and command line");
+
+	// add specific test cases to test suite TS05
+	TS05.addTestItem(&tc51);
+	TS05.addTestItem(&tc52);
+
+	// execute unit tests
+	unit.testExecution();
+	unit.writeResultsToFile(xmlFilename);
+
+	return unit.getResult();
+}
+
+
+class PassCase : public TestCase{
+public:
+	PassCase(const string &name, bool pass = true) : TestCase(name), pass_(pass){};
+	unsigned runs = 0;
+protected:
+	virtual bool testRun(){runs++; return pass_;};
+	bool pass_;
+};
+
+class SleepCase : public TestCase{
+public:
+	SleepCase(const string &name, unsigned ms) : TestCase(name), ms_(ms){};
+protected:
+	virtual bool testRun(){
+		std::this_thread::sleep_for(std::chrono::milliseconds(ms_));
+		return true;
+	};
+	unsigned ms_;
+};
+
+class CrashCase : public TestCase{
+public:
+	CrashCase(const string &name) : TestCase(name){};
+protected:
+	virtual bool testRun(){abort(); return true;};
+};
+
+/*
+ * True if the results contain the case with the given outcome (behind
+ * the counts of instrumented builds).
+ */
+static bool hasCase(const string &xml, const string &name, const string &outcome){
+	size_t pos = xml.find(string("<TestCase name=\"") + name + "\"");
+	if(pos == string::npos){
+		return false;
+	}
+	pos = xml.find('>', pos);
+	return (pos != string::npos) && (xml.compare(pos + 1, outcome.size() + 1, outcome + "<") == 0);
+}
+
+class ThrowCase : public TestCase{
+public:
+	ThrowCase(const string &name) : TestCase(name){};
+protected:
+	virtual bool testRun(){throw new ExceptionTestReport(string("leaked by a test case")); return true;};
+};
+
+class PidCase : public TestCase{
+public:
+	PidCase(const string &name, const string &filename) : TestCase(name), filename_(filename){};
+protected:
+	virtual bool testRun(){
+		ofstream file(filename_.c_str(), std::ios::app);
+		file << getpid() << endl;
+		return true;
+	};
+	string filename_;
+};
+
+class FailFixture : public TestFixture{
+public:
+	virtual bool setUp(){error_ = "no device"; return false;};
+};
+
+/*
+ * The results without the execution time and the counts of instrumented
+ * builds.
+ */
+static string outcomes(const string &xml){
+	string s = std::regex_replace(xml, std::regex(" executionTime=\"[^\"]*\""), string(""));
+	s = std::regex_replace(s, std::regex("(<TestCase name=\"[^\"]*\")[^>]*>"), string("$1>"));
+	return std::regex_replace(s, std::regex("<ApiCall [^>]*/>"), string(""));
+}
+
+static double msSince(testClock::time_point start){
+	return std::chrono::duration<double, std::milli>(testClock::now() - start).count();
+}
+
+class CountFixture : public TestFixture{
+public:
+	unsigned setUps = 0;
+	virtual bool setUp(){setUps++; return true;};
+};
+
+
+bool TC11::testRun(){ // TestRun - unit, suite and case globs, regular expression
+	cout << ".";
+	bool result = true;
+
+	TestRun all;
+	if(!all.isSelected("Pololu", "getErrors", "getErrors - closed channel")){
+		result = false;
+	}
+
+	TestRun run;
+	run.addUnit("Pololu*");
+	run.addSuite("get*");
+	run.addSuite("open*");
+	if(!run.isSelected("PololuErrors", "getMovingState", "x") || !run.isSelected("Pololu", "openConnection", "y") ||
+			run.isSelected("ServoMotor", "getMovingState", "x") || run.isSelected("Pololu", "closeConnection", "y")){
+		result = false;
+	}
+	run.addCase("*closed*");
+	if(run.isSelected("Pololu", "getErrors", "open") || !run.isSelected("Pololu", "getErrors", "with closed channel")){
+		result = false;
+	}
+
+	TestRun regex;
+	if(regex.setFilter("([") || !regex.setFilter("^Servo.*/constructor/.*[0-9]$")){
+		result = false;
+	}
+	if(!regex.isSelected("ServoMotor", "constructor", "delta 0") || regex.isSelected("ServoMotor", "constructor", "delta") ||
+			regex.isSelected("Pololu", "constructor", "delta 0")){
+		result = false;
+	}
+	return result;
+}
+
+
+bool TC12::testRun(){ // TestRun - shards partition the test cases
+	cout << ".";
+	bool result = true;
+	const unsigned n = 3;
+	TestRun shards[n];
+	for(unsigned i = 0; i < n; i++){
+		if(!shards[i].setShard(i, n)){
+			result = false;
+		}
+	}
+	if(shards[0].setShard(3, 3) || shards[0].setShard(0, 0)){
+		result = false;
+	}
+
+	unsigned perShard[n] = {0, 0, 0};
+	for(unsigned c = 0; c < 300; c++){
+		string name = string("case ") + to_string(c);
+		unsigned selected = 0;
+		for(unsigned i = 0; i < n; i++){
+			if(shards[i].isSelected("Unit", "suite", name)){
+				selected++;
+				perShard[i]++;
+				// the shard is a function of the path only
+				if(TestRun::shardOf(string("Unit/suite/") + name, n) != i){
+					result = false;
+				}
+			}
+		}
+		if(selected != 1){
+			result = false;
+		}
+	}
+	for(unsigned i = 0; i < n; i++){
+		if((perShard[i] < 70) || (perShard[i] > 130)){
+			result = false;
+		}
+	}
+	return result;
+}
+
+
+bool TC13::testRun(){ // TestRun - command line
+	cout << ".";
+	bool result = true;
+	stringstream err;
+
+	TestRun run;
+	const char *good[] = {"unitTest", "--unit=Pololu*", "--case=*open*", "--shard=1/4", "--list", "--xml-prefix=out/"};
+	if(!run.parse(6, (char**) good, err) || !err.str().empty() || !run.isListing() || (run.getXmlPrefix() != "out/")){
+		result = false;
+	}
+	string path = "Pololu/openConnection/open first";
+	if(run.isSelected("Pololu", "openConnection", "open first") != (TestRun::shardOf(path, 4) == 1)){
+		result = false;
+	}
+
+	const char *badShard[] = {"unitTest", "--shard=4/4"};
+	const char *badRegex[] = {"unitTest", "--filter=(["};
+	const char *unknown[]  = {"unitTest", "--verbose"};
+	TestRun r1, r2, r3;
+	if(r1.parse(2, (char**) badShard, err) || r2.parse(2, (char**) badRegex, err) || r3.parse(2, (char**) unknown, err) ||
+			(err.str().find("usage:") == string::npos)){
+		result = false;
+	}
+	return result;
+}
+
+
+bool TC14::testRun(){ // UnitTest - selected cases, fixtures and results only
+	cout << ".";
+	bool result = true;
+	PassCase a("open a"), b("close b", false), c("open c");
+	CountFixture used, unused;
+	UnitTest unit("Unit");
+	TestSuite s1("first"), s2("second");
+	unit.addTestItem(&s1);
+	unit.addTestItem(&s2);
+	s1.addTestItem(&a);
+	s1.addTestItem(&b);
+	s2.addTestItem(&c);
+	s1.setFixture(&used);
+	s2.setFixture(&unused);
+
+	// the failing case and the second suite are not selected
+	TestRun run;
+	run.addCase("open*");
+	run.addSuite("first");
+	TestRun::setInstance(&run);
+	unit.testExecution();
+	TestRun::setInstance(nullptr);
+
+	string xml = unit.toXmlStr();
+	if(!unit.getResult() || (a.runs != 1) || (b.runs != 0) || (c.runs != 0) || (used.setUps != 1) ||
+			(unused.setUps != 0) || (xml.find("open a") == string::npos) || (xml.find("close b") != string::npos) ||
+			(xml.find("second") != string::npos)){
+		result = false;
+	}
+
+	// listed only: nothing executed, no results
+	TestRun list;
+	list.setListOnly(true);
+	list.addUnit("nothing");
+	TestRun::setInstance(&list);
+	unit.testExecution();
+	TestRun::setInstance(nullptr);
+	if(unit.wasExecuted() || (unit.toXmlStr() != "") || (a.runs != 1)){
+		result = false;
+	}
+
+	// all
+	unit.testExecution();
+	if(unit.getResult() || (a.runs != 2) || (b.runs != 1) || (c.runs != 1) || (unused.setUps != 1)){
+		result = false;
+	}
+	return result;
+}
+
+
+static const char *shard0 =
+		"<UnitTest name=\"U\" status=\"FAILED\" executionTime=\"Sat Oct 17 10:00:00 2026\n\">"
+		"<TestSuite name=\"s1\" status=\"PASSED\"><TestCase name=\"a\">PASSED</TestCase></TestSuite>"
+		"<TestSuite name=\"s2\" status=\"FAILED\"><TestCase name=\"c\" allocs=\"3\">FAILED</TestCase></TestSuite>"
+		"<ApiCall name=\"Pololu::getErrors\" calls=\"2\" allocs=\"0\" allocBytes=\"0\" syscalls=\"6\"/>"
+		"</UnitTest>";
+static const char *shard1 =
+		"<UnitTest name=\"U\" status=\"PASSED\" executionTime=\"Sat Oct 17 10:00:01 2026\n\">"
+		"<TestSuite name=\"s1\" status=\"PASSED\"><TestCase name=\"b &amp; x\">PASSED</TestCase>"
+		"<TestCase name=\"a\">PASSED</TestCase></TestSuite>"
+		"<ApiCall name=\"Pololu::getErrors\" calls=\"1\" allocs=\"0\" allocBytes=\"0\" syscalls=\"3\"/>"
+		"</UnitTest>";
+static const char *other =
+		"<UnitTest name=\"V\" status=\"FAILED\"><TestSuite name=\"s\" status=\"FAILED\" fixtureError=\"setUp: no device\">"
+		"</TestSuite></UnitTest>";
+
+bool TC21::testRun(){ // TestReport - merge of shards
+	cout << ".";
+	bool result = true;
+	try{
+		TestReport one;
+		one.addXml(shard0);
+		one.addXml(shard1);
+		string xml = one.toXml();
+		if((one.getUnitCount() != 1) || (one.getCaseCount() != 3) || (one.getFailedCount() != 1) ||
+				(xml.compare(0, 42, "<UnitTest name=\"U\" status=\"FAILED\" executi") != 0) ||
+				(xml.find("10:00:00") == string::npos) ||
+				(xml.find("<TestSuite name=\"s1\" status=\"PASSED\"><TestCase name=\"a\">PASSED</TestCase>"
+						  "<TestCase name=\"b &amp; x\">PASSED</TestCase></TestSuite>") == string::npos) ||
+				(xml.find("<TestCase name=\"c\" allocs=\"3\">FAILED</TestCase>") == string::npos) ||
+				(xml.find("calls=\"3\" allocs=\"0\" allocBytes=\"0\" syscalls=\"9\"") == string::npos)){
+			result = false;
+		}
+
+		// a merged report merges again, a case failed in one input failed
+		TestReport all;
+		all.addXml(xml);
+		all.addXml(other);
+		all.addXml("<UnitTest name=\"U\" status=\"FAILED\"><TestSuite name=\"s1\" status=\"FAILED\">"
+				   "<TestCase name=\"a\">FAILED</TestCase></TestSuite></UnitTest>");
+		xml = all.toXml();
+		if((all.getUnitCount() != 2) || (all.getCaseCount() != 3) || (all.getFailedCount() != 2) || all.getResult() ||
+				(xml.find("<TestReport status=\"FAILED\" units=\"2\" cases=\"3\" failed=\"2\">") != 0) ||
+				(xml.find("fixtureError=\"setUp: no device\"") == string::npos)){
+			result = false;
+		}
+		TestReport again;
+		again.addXml(xml);
+		if((again.toXml() != xml)){
+			result = false;
+		}
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		delete e;
+		return false;
+	}
+	return result;
+}
+
+
+bool TC22::testRun(){ // TestReport - malformed results
+	cout << ".";
+	bool result = true;
+	const char *bad[] = {
+		"<UnitTest name=\"U\" status=\"PASSED\"><TestSuite name=\"s\" status=\"PASSED\">",       // truncated
+		"<TestSuite name=\"s\" status=\"PASSED\"></TestSuite>",                                  // without unit
+		"<UnitTest name=\"U\"><TestSuite name=\"s\"><TestCase name=\"a\"></TestCase></TestSuite></UnitTest>", // no result
+		"<UnitTest name=\"U\" status=PASSED></UnitTest>",                                        // unquoted
+		"<UnitTest name=\"U\""                                                                   // unterminated
+	};
+	for(unsigned i = 0; i < sizeof(bad) / sizeof(bad[0]); i++){
+		TestReport r;
+		try{
+			r.addXml(bad[i]);
+			result = false;
+		}catch(IException *e){
+			delete e;
+		}
+	}
+	TestReport missing;
+	try{
+		missing.addFile("/nonexisting/UT_x.xml");
+		result = false;
+	}catch(IException *e){
+		delete e;
+	}
+	return result;
+}
+
+
+bool TC23::testRun(){ // TestReport - nested suites, cases of the unit and equal names
+	cout << ".";
+	bool result = true;
+	try{
+		// the outer suite continues after the nested one, a case in the unit
+		TestReport report;
+		report.addXml("<UnitTest name=\"U\" status=\"PASSED\"><TestCase name=\"x\">PASSED</TestCase>"
+					  "<TestSuite name=\"outer\" status=\"PASSED\"><TestCase name=\"a\">PASSED</TestCase>"
+					  "<TestSuite name=\"inner\" status=\"PASSED\"><TestCase name=\"a\">PASSED</TestCase></TestSuite>"
+					  "<TestCase name=\"b\">PASSED</TestCase><TestCase name=\"b\">PASSED</TestCase></TestSuite>"
+					  "</UnitTest>");
+		// the second case b failed, the shards are merged in the order of the run
+		report.addXml("<UnitTest name=\"U\" status=\"FAILED\"><TestSuite name=\"outer\" status=\"FAILED\">"
+					  "<TestCase name=\"b\">PASSED</TestCase><TestCase name=\"b\">FAILED</TestCase>"
+					  "<TestCase name=\"c\">PASSED</TestCase></TestSuite><TestCase name=\"y\">TIMEOUT</TestCase>"
+					  "</UnitTest>");
+		string xml = report.toXml();
+		if((report.getCaseCount() != 7) || (report.getFailedCount() != 2) || (report.getTimeoutCount() != 1) ||
+				(xml != "<UnitTest name=\"U\" status=\"FAILED\"><TestCase name=\"x\">PASSED</TestCase>"
+						"<TestSuite name=\"outer\" status=\"FAILED\"><TestCase name=\"a\">PASSED</TestCase>"
+						"<TestSuite name=\"inner\" status=\"PASSED\"><TestCase name=\"a\">PASSED</TestCase></TestSuite>"
+						"<TestCase name=\"b\">PASSED</TestCase><TestCase name=\"b\">FAILED</TestCase>"
+						"<TestCase name=\"c\">PASSED</TestCase></TestSuite><TestCase name=\"y\">TIMEOUT</TestCase>"
+						"</UnitTest>")){
+			result = false;
+		}
+		TestReport again;
+		again.addXml(xml);
+		if(again.toXml() != xml){
+			result = false;
+		}
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		delete e;
+		return false;
+	}
+	return result;
+}
+
+
+bool TC31::testRun(){ // TestCase - timeout of an isolated case, the run continues
+	cout << ".";
+	bool result = true;
+	SleepCase hang("hang", 5000), quick("quick", 0);
+	CrashCase crash("crash");
+	PassCase after("after");
+	UnitTest unit("Unit");
+	TestSuite s("s");
+	unit.addTestItem(&s);
+	s.addTestItem(&hang);
+	s.addTestItem(&crash);
+	s.addTestItem(&quick);
+	s.addTestItem(&after);
+	hang.setTimeoutMs(100);
+
+	TestRun run;
+	run.setIsolate(true);
+	run.setTimeoutMs(2000);
+	TestRun::setInstance(&run);
+	testClock::time_point start = testClock::now();
+	unit.testExecution();
+	double ms = msSince(start);
+	TestRun::setInstance(nullptr);
+
+	// the changes of an isolated case are lost with its child
+	string xml = unit.toXmlStr();
+	if(unit.getResult() || (hang.getStatus() != TEST_TIMEOUT) || (crash.getStatus() != TEST_FAILED) ||
+			(quick.getStatus() != TEST_PASSED) || (after.getStatus() != TEST_PASSED) || (after.runs != 0) ||
+			(ms < 100.0) || (ms > 1500.0) || !hasCase(xml, "hang", "TIMEOUT") ||
+			!hasCase(xml, "crash", "FAILED")){
+		result = false;
+	}
+	return result;
+}
+
+
+bool TC32::testRun(){ // TestSuite - budget of a suite
+	cout << ".";
+	bool result = true;
+	SleepCase a("a", 100), b("b", 100), c("c", 100);
+	PassCase other("other");
+	UnitTest unit("Unit");
+	TestSuite s("s"), t("t");
+	unit.addTestItem(&s);
+	unit.addTestItem(&t);
+	s.addTestItem(&a);
+	s.addTestItem(&b);
+	s.addTestItem(&c);
+	t.addTestItem(&other);
+	s.setTimeoutMs(150);
+
+	// b exceeds the remaining budget, c is not started
+	TestRun run;
+	run.setIsolate(true);
+	TestRun::setInstance(&run);
+	testClock::time_point start = testClock::now();
+	unit.testExecution();
+	double ms = msSince(start);
+	TestRun::setInstance(nullptr);
+	if(s.getResult() || !t.getResult() || (a.getStatus() != TEST_PASSED) || (b.getStatus() != TEST_TIMEOUT) ||
+			(c.getStatus() != TEST_TIMEOUT) || (other.getStatus() != TEST_PASSED) || (ms < 140.0) || (ms > 1000.0)){
+		result = false;
+	}
+
+	// without a budget each case has the time limit of the run
+	s.setTimeoutMs(0);
+	run.setTimeoutMs(150);
+	TestRun::setInstance(&run);
+	unit.testExecution();
+	TestRun::setInstance(nullptr);
+	if(!unit.getResult() || (c.getStatus() != TEST_PASSED)){
+		result = false;
+	}
+	return result;
+}
+
+
+bool TC33::testRun(){ // TestRun - watchdog aborts the run and writes the results
+	cout << ".";
+	bool result = true;
+	string prefix = string("/tmp/mex_ut_timeout_") + to_string(getpid()) + "_";
+	string filename = prefix + "UT_Hang.xml";
+	remove(filename.c_str());
+
+	cout.flush();
+	pid_t pid = fork();
+	if(pid < 0){
+		return false;
+	}
+	if(pid == 0){
+		// the run of the child is aborted within the second case
+		PassCase first("first");
+		SleepCase hang("hang", 5000);
+		PassCase never("never");
+		UnitTest unit("Hang");
+		TestSuite s1("s1"), s2("s2");
+		unit.addTestItem(&s1);
+		unit.addTestItem(&s2);
+		s1.addTestItem(&first);
+		s2.addTestItem(&hang);
+		s2.addTestItem(&never);
+		TestRun run;
+		run.setTimeoutMs(100);
+		run.setXmlPrefix(prefix);
+		TestRun::setInstance(&run);
+		unit.testExecution();
+		_exit(0);
+	}
+	int status = 0;
+	testClock::time_point start = testClock::now();
+	waitpid(pid, &status, 0);
+	double ms = msSince(start);
+	if(!WIFEXITED(status) || (WEXITSTATUS(status) != TestRun::timeoutExitCode) || (ms > 2000.0)){
+		result = false;
+	}
+
+	try{
+		TestReport report;
+		report.addFile(filename);
+		string xml = report.toXml();
+		if((report.getCaseCount() != 2) || (report.getFailedCount() != 1) || (report.getTimeoutCount() != 1) ||
+				(xml.find("<TestSuite name=\"s1\" status=\"PASSED\"><TestCase name=\"first\"") == string::npos) ||
+				(xml.find("<TestSuite name=\"s2\" status=\"FAILED\"><TestCase name=\"hang\"") == string::npos) ||
+				!hasCase(xml, "first", "PASSED") || !hasCase(xml, "hang", "TIMEOUT")){
+			result = false;
+		}
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		delete e;
+		result = false;
+	}
+	remove(filename.c_str());
+	return result;
+}
+
+
+bool TC34::testRun(){ // TestReport - timeouts and command line
+	cout << ".";
+	bool result = true;
+	try{
+		// a timeout outweighs a failure of the same case
+		TestReport report;
+		report.addXml("<UnitTest name=\"U\" status=\"FAILED\"><TestSuite name=\"s\" status=\"FAILED\">"
+					  "<TestCase name=\"a\">FAILED</TestCase><TestCase name=\"b\">PASSED</TestCase></TestSuite></UnitTest>");
+		report.addXml("<UnitTest name=\"U\" status=\"FAILED\"><TestSuite name=\"s\" status=\"FAILED\">"
+					  "<TestCase name=\"a\">TIMEOUT</TestCase><TestCase name=\"b\">TIMEOUT</TestCase></TestSuite></UnitTest>");
+		report.addXml("<UnitTest name=\"V\" status=\"PASSED\"></UnitTest>");
+		if((report.getCaseCount() != 2) || (report.getFailedCount() != 2) || (report.getTimeoutCount() != 2) ||
+				(report.toXml().find("<TestReport status=\"FAILED\" units=\"2\" cases=\"2\" failed=\"2\" timeouts=\"2\">") != 0) ||
+				(report.toXml().find("<TestCase name=\"a\">TIMEOUT</TestCase>") == string::npos)){
+			result = false;
+		}
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		delete e;
+		return false;
+	}
+
+	stringstream err;
+	TestRun run;
+	const char *good[] = {"unitTest", "--timeout=2.5", "--isolate"};
+	if(!run.parse(3, (char**) good, err) || (run.getTimeoutMs() != 2500) || !run.isIsolating()){
+		result = false;
+	}
+	const char *bad[] = {"unitTest", "--timeout=abc"};
+	const char *negative[] = {"unitTest", "--timeout=-1"};
+	TestRun r1, r2;
+	if(r1.parse(2, (char**) bad, err) || r2.parse(2, (char**) negative, err) || r1.getTimeoutMs() != 0){
+		result = false;
+	}
+	return result;
+}
+
+
+bool TC41::testRun(){ // TestPool - results as executed in process
+	cout << ".";
+	bool result = true;
+	PassCase a("a"), b("b", false), c("c"), d("d"), e("e"), f("f"), g("g");
+	CountFixture counting;
+	FailFixture failing;
+	UnitTest unit("Unit");
+	TestSuite s1("s1"), s2("s2"), outer("outer"), inner("inner"), s4("s4");
+	unit.addTestItem(&s1);
+	unit.addTestItem(&s2);
+	unit.addTestItem(&outer);
+	unit.addTestItem(&s4);
+	s1.addTestItem(&a);
+	s1.addTestItem(&b);
+	s2.addTestItem(&c);
+	s2.addTestItem(&d);
+	outer.addTestItem(&inner);
+	outer.addTestItem(&g);
+	inner.addTestItem(&e);
+	s4.addTestItem(&f);
+	s2.setFixture(&counting);
+	s4.setFixture(&failing);
+
+	TestRun local;
+	local.addCase("[abcdef]");
+	TestRun::setInstance(&local);
+	unit.testExecution();
+	string expected = outcomes(unit.toXmlStr());
+	unsigned runs = a.runs;
+
+	TestRun pooled;
+	pooled.addCase("[abcdef]");
+	pooled.setJobs(3);
+	TestRun::setInstance(&pooled);
+	unit.testExecution();
+	TestRun::setInstance(nullptr);
+	string xml = outcomes(unit.toXmlStr());
+
+	// executed by the workers only
+	if((xml != expected) || (a.runs != runs) || unit.getResult() || !s1.wasExecuted() || s1.getResult() ||
+			!s2.getResult() || !outer.getResult() || s4.getResult() || (a.getStatus() != TEST_PASSED) ||
+			(b.getStatus() != TEST_FAILED) || (f.getStatus() != TEST_FAILED) || g.wasExecuted() ||
+			(xml.find("fixtureError=\"setUp: no device\"") == string::npos)){
+		cout << endl << expected << endl << xml << endl;
+		result = false;
+	}
+	return result;
+}
+
+
+bool TC42::testRun(){ // TestPool - crashed, throwing and hung workers are replaced
+	cout << ".";
+	bool result = true;
+	CrashCase crash("crash");
+	ThrowCase leak("leak");
+	SleepCase hang("hang", 5000);
+	PassCase p1("p1"), p2("p2"), p3("p3");
+	UnitTest unit("Unit");
+	TestSuite s("s");
+	unit.addTestItem(&s);
+	s.addTestItem(&crash);
+	s.addTestItem(&p1);
+	s.addTestItem(&leak);
+	s.addTestItem(&p2);
+	s.addTestItem(&hang);
+	s.addTestItem(&p3);
+	hang.setTimeoutMs(100);
+
+	TestRun run;
+	run.setJobs(2);
+	TestPool pool(run);
+	TestRun::setInstance(&run);
+	testClock::time_point start = testClock::now();
+	pool.execute(unit);
+	double ms = msSince(start);
+	TestRun::setInstance(nullptr);
+
+	string xml = unit.toXmlStr();
+	if(unit.getResult() || s.getResult() || (crash.getStatus() != TEST_FAILED) || (leak.getStatus() != TEST_FAILED) ||
+			(hang.getStatus() != TEST_TIMEOUT) || (p1.getStatus() != TEST_PASSED) || (p2.getStatus() != TEST_PASSED) ||
+			(p3.getStatus() != TEST_PASSED) || (pool.getLost() != 3) || (pool.getSpawned() < 4) ||
+			(ms > 2000.0) || !hasCase(xml, "hang", "TIMEOUT") || !hasCase(xml, "p3", "PASSED")){
+		result = false;
+	}
+	return result;
+}
+
+
+bool TC43::testRun(){ // TestPool - parallel jobs and sequential suites
+	cout << ".";
+	bool result = true;
+	string filename = string("/tmp/mex_ut_pool_") + to_string(getpid());
+	remove(filename.c_str());
+	SleepCase w("w", 200), x("x", 200), y("y", 200), z("z", 200);
+	PidCase p("p", filename), q("q", filename), r("r", filename);
+	UnitTest unit("Unit");
+	TestSuite parallel("parallel"), sequential("sequential");
+	unit.addTestItem(&parallel);
+	unit.addTestItem(&sequential);
+	parallel.addTestItem(&w);
+	parallel.addTestItem(&x);
+	parallel.addTestItem(&y);
+	parallel.addTestItem(&z);
+	sequential.addTestItem(&p);
+	sequential.addTestItem(&q);
+	sequential.addTestItem(&r);
+	sequential.setSequential(true);
+
+	TestRun run;
+	run.setJobs(4);
+	TestRun::setInstance(&run);
+	testClock::time_point start = testClock::now();
+	unit.testExecution();
+	double ms = msSince(start);
+	TestRun::setInstance(nullptr);
+
+	// the sequential suite ran in one worker
+	ifstream in(filename.c_str());
+	vector<string> pids;
+	string line;
+	while(getline(in, line)){
+		pids.push_back(line);
+	}
+	in.close();
+	remove(filename.c_str());
+	if(!unit.getResult() || (ms > 700.0) || (pids.size() != 3) || (pids[0] != pids[1]) || (pids[1] != pids[2]) ||
+			(pids[0] == to_string(getpid()))){
+		result = false;
+	}
+
+	stringstream err;
+	TestRun good, bad;
+	const char *jobs[] = {"unitTest", "--jobs=8"};
+	const char *none[] = {"unitTest", "--jobs=0"};
+	if(!good.parse(2, (char**) jobs, err) || (good.getJobs() != 8) || bad.parse(2, (char**) none, err)){
+		result = false;
+	}
+	return result;
+}
+
+
+bool TC51::testRun(){ // TestRun - resources probed once per unit, missing ones skip
+	cout << ".";
+	bool result = true;
+	PassCase a("a"), b("b"), c("c"), d("d"), e("e");
+	CountFixture fixture;
+	UnitTest unit("Unit");
+	TestSuite s1("s1"), s2("s2");
+	unit.addTestItem(&s1);
+	unit.addTestItem(&s2);
+	s1.addTestItem(&a);
+	s1.addTestItem(&b);
+	s1.addTestItem(&c);
+	s1.addTestItem(&e);
+	s2.addTestItem(&d);
+	s2.setFixture(&fixture);
+	a.requireResource("maestro");
+	e.requireResource("maestro");
+	b.requireResource("sim");
+	s2.requireResource("maestro");
+
+	unsigned probes = 0;
+	TestRun run;
+	run.setProbe("maestro", [&](string &reason){probes++; reason = "not attached"; return false;});
+	run.setProbe("sim", [](string &){return true;});
+	TestRun::setInstance(&run);
+	unit.testExecution();
+	string xml = unit.toXmlStr();
+	if(!unit.getResult() || (probes != 1) || (a.getStatus() != TEST_SKIPPED) || (e.getStatus() != TEST_SKIPPED) ||
+			(d.getStatus() != TEST_SKIPPED) || (b.getStatus() != TEST_PASSED) || (c.getStatus() != TEST_PASSED) ||
+			(a.runs != 0) || (d.runs != 0) || (b.runs != 1) || (fixture.setUps != 0) ||
+			(xml.find("skipped=\"maestro: not attached\">SKIPPED</TestCase>") == string::npos)){
+		result = false;
+	}
+	string expected = outcomes(xml);
+
+	// probed again when the unit starts, not by the workers
+	run.setJobs(2);
+	unit.testExecution();
+	if((outcomes(unit.toXmlStr()) != expected) || (probes != 2) || (b.runs != 1)){
+		result = false;
+	}
+
+	// without probing all are executed
+	run.setJobs(1);
+	run.setProbing(false);
+	unit.testExecution();
+	TestRun::setInstance(nullptr);
+	if(!unit.getResult() || (probes != 2) || (a.getStatus() != TEST_PASSED) || (a.runs != 1) || (fixture.setUps != 1)){
+		result = false;
+	}
+	return result;
+}
+
+
+bool TC52::testRun(){ // TestRun - device probes, skipped results and command line
+	cout << ".";
+	bool result = true;
+	TestRun run;
+	if(!run.unavailable("/dev/null").empty() ||
+			(run.unavailable("/dev/mex_nonexisting").find("/dev/mex_nonexisting: ") != 0) ||
+			(run.unavailable("robot") != "robot: no probe")){
+		result = false;
+	}
+
+	try{
+		// a result outweighs a skip of the same case
+		TestReport report;
+		report.addXml("<UnitTest name=\"U\" status=\"PASSED\"><TestSuite name=\"s\" status=\"PASSED\">"
+					  "<TestCase name=\"a\" skipped=\"/dev/ttyACM0: x\">SKIPPED</TestCase>"
+					  "<TestCase name=\"b\" skipped=\"/dev/ttyACM0: x\">SKIPPED</TestCase></TestSuite></UnitTest>");
+		report.addXml("<UnitTest name=\"U\" status=\"PASSED\"><TestSuite name=\"s\" status=\"PASSED\">"
+					  "<TestCase name=\"a\">PASSED</TestCase><TestCase name=\"b\" skipped=\"/dev/ttyACM0: x\">SKIPPED</TestCase>"
+					  "</TestSuite></UnitTest>");
+		report.addXml("<UnitTest name=\"V\" status=\"PASSED\"></UnitTest>");
+		string xml = report.toXml();
+		if(!report.getResult() || (report.getCaseCount() != 2) || (report.getSkippedCount() != 1) ||
+				(xml.find("<TestReport status=\"PASSED\" units=\"2\" cases=\"2\" failed=\"0\" skipped=\"1\">") != 0) ||
+				(xml.find("<TestCase name=\"a\">PASSED</TestCase>") == string::npos) ||
+				(xml.find("<TestCase name=\"b\" skipped=\"/dev/ttyACM0: x\">SKIPPED</TestCase>") == string::npos)){
+			result = false;
+		}
+	}catch(IException *e){
+		cout << e->getMsg() << endl;
+		delete e;
+		return false;
+	}
+
+	stringstream err;
+	TestRun parsed;
+	const char *noSkip[] = {"unitTest", "--no-skip"};
+	if(!parsed.parse(2, (char**) noSkip, err) || !parsed.unavailable("/dev/mex_nonexisting").empty()){
+		result = false;
+	}
+	return result;
+}
+
+} // ende namespace UT_TestRun
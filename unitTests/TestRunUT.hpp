@@ -0,0 +1,138 @@
+/*
+ * TestRunUT.hpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+#ifndef UNITTESTS_TESTRUNUT_HPP_
+#define UNITTESTS_TESTRUNUT_HPP_
+
+
+#include "../SimplUnitTestFW.hpp"
+
+namespace UT_TestRun{
+
+bool execUnitTests(string xmlFilename);
+
+
+class TC11 : public TestCase{
+	TC11() : TestCase(){};
+public:
+	TC11(string s = string("TestRun - unit, suite and case globs, regular expression")) : TestCase(s){};
+	virtual bool testRun(); // TestRun - unit, suite and case globs, regular expression
+};
+
+class TC12 : public TestCase{
+	TC12() : TestCase(){};
+public:
+	TC12(string s = string("TestRun - shards partition the test cases")) : TestCase(s){};
+	virtual bool testRun(); // TestRun - shards partition the test cases
+};
+
+class TC13 : public TestCase{
+	TC13() : TestCase(){};
+public:
+	TC13(string s = string("TestRun - command line")) : TestCase(s){};
+	virtual bool testRun(); // TestRun - command line
+};
+
+class TC14 : public TestCase{
+	TC14() : TestCase(){};
+public:
+	TC14(string s = string("UnitTest - selected cases, fixtures and results only")) : TestCase(s){};
+	virtual bool testRun(); // UnitTest - selected cases, fixtures and results only
+};
+
+
+class TC21 : public TestCase{
+	TC21() : TestCase(){};
+public:
+	TC21(string s = string("TestReport - merge of shards")) : TestCase(s){};
+	virtual bool testRun(); // TestReport - merge of shards
+};
+
+class TC22 : public TestCase{
+	TC22() : TestCase(){};
+public:
+	TC22(string s = string("TestReport - malformed results")) : TestCase(s){};
+	virtual bool testRun(); // TestReport - malformed results
+};
+
+class TC23 : public TestCase{
+	TC23() : TestCase(){};
+public:
+	TC23(string s = string("TestReport - nested suites, cases of the unit and equal names")) : TestCase(s){};
+	virtual bool testRun(); // TestReport - nested suites, cases of the unit and equal names
+};
+
+
+class TC31 : public TestCase{
+	TC31() : TestCase(){};
+public:
+	TC31(string s = string("TestCase - timeout of an isolated case, the run continues")) : TestCase(s){};
+	virtual bool testRun(); // TestCase - timeout of an isolated case, the run continues
+};
+
+class TC32 : public TestCase{
+	TC32() : TestCase(){};
+public:
+	TC32(string s = string("TestSuite - budget of a suite")) : TestCase(s){};
+	virtual bool testRun(); // TestSuite - budget of a suite
+};
+
+class TC33 : public TestCase{
+	TC33() : TestCase(){};
+public:
+	TC33(string s = string("TestRun - watchdog aborts the run and writes the results")) : TestCase(s){};
+	virtual bool testRun(); // TestRun - watchdog aborts the run and writes the results
+};
+
+class TC34 : public TestCase{
+	TC34() : TestCase(){};
+public:
+	TC34(string s = string("TestReport - timeouts and command line")) : TestCase(s){};
+	virtual bool testRun(); // TestReport - timeouts and command line
+};
+
+
+class TC41 : public TestCase{
+	TC41() : TestCase(){};
+public:
+	TC41(string s = string("TestPool - results as executed in process")) : TestCase(s){};
+	virtual bool testRun(); // TestPool - results as executed in process
+};
+
+class TC42 : public TestCase{
+	TC42() : TestCase(){};
+public:
+	TC42(string s = string("TestPool - crashed, throwing and hung workers are replaced")) : TestCase(s){};
+	virtual bool testRun(); // TestPool - crashed, throwing and hung workers are replaced
+};
+
+class TC43 : public TestCase{
+	TC43() : TestCase(){};
+public:
+	TC43(string s = string("TestPool - parallel jobs and sequential suites")) : TestCase(s){};
+	virtual bool testRun(); // TestPool - parallel jobs and sequential suites
+};
+
+
+class TC51 : public TestCase{
+	TC51() : TestCase(){};
+public:
+	TC51(string s = string("TestRun - resources probed once per unit, missing ones skip")) : TestCase(s){};
+	virtual bool testRun(); // TestRun - resources probed once per unit, missing ones skip
+};
+
+class TC52 : public TestCase{
+	TC52() : TestCase(){};
+public:
+	TC52(string s = string("TestRun - device probes, skipped results and command line")) : TestCase(s){};
+	virtual bool testRun(); // TestRun - device probes, skipped results and command line
+};
+
+} // ende namespace UT_TestRun
+
+
+#endif /* UNITTESTS_TESTRUNUT_HPP_ */
@@ -7,29 +7,31 @@
 #include "../Pololu.hpp"
 #include "../SerialCom.hpp"
 #include "../ServoMotor.hpp"
+#include "../Clock.hpp"
+#include "TestUnits.hpp"
 #include <string>
 #include <iostream>
 #include <cmath>
 
 using namespace std;
 
-#ifdef _WIN32
-    #include <windows.h>
-#else
-	#include <unistd.h>
-#endif
+static IClock *testClock = &SystemClock::instance();
 
-/** \brief The function is used for waiting for a certain time, depending on the operating system Sleep () or usleep () is used.
+/** \brief Sets the clock used by wait(...), e.g. a VirtualClock if the
+ *  tests run on a SerialComSim. NULL selects the system clock again.
+ *
+ */
+void setTestClock(IClock *clock){
+	testClock = (clock == nullptr) ? &SystemClock::instance() : clock;
+}
+
+/** \brief The function is used for waiting for a certain time on the clock set by setTestClock(...).
  *
  *	\param milliseconds = Time to wait in milliseconds
  *
  */
 void wait(unsigned long milliseconds){
-	#ifdef _WIN32
-		Sleep(milliseconds);
-	#else
-		usleep(milliseconds);
-	#endif
+	testClock->sleepUs(milliseconds * 1000ULL);
 }
 
 /** \brief Function systematically tests the opening and closing of a serial connection
@@ -193,8 +195,6 @@ void testSetGetMethods (){
  *
  */
 void testMEXMovementSetting1(){
-    unsigned short speed = 100;
-    unsigned short acceleration = 10;
     // Define the port name and the baud rate
    	#ifdef _WIN32
    		const char* portName = "COM5";  		// Windows
@@ -206,6 +206,20 @@ void testMEXMovementSetting1(){
     // Open connection to COM port.
     conn.openConnection();
 
+    testMEXMovementSetting1(conn);
+
+    // Close the serial Connection
+    conn.closeConnection();
+}
+
+/** \brief Motion of testMEXMovementSetting1() on an opened connection,
+ *  e.g. one to a MaestroSimulator (see benchmarks/MexBench.cpp).
+ *
+ */
+void testMEXMovementSetting1(Pololu &conn){
+    unsigned short speed = 100;
+    unsigned short acceleration = 10;
+
     // Define the servos of the robot manipulator
     ServoMotor base(1, 5680, 3600, &conn);
     ServoMotor arm_1(2, 6000, 3600, &conn);
@@ -291,9 +305,6 @@ void testMEXMovementSetting1(){
 
     // Go to Parking Position
     arm_1.setPositionInAbs(2840);
-
-    // Close the serial Connection
-    conn.closeConnection();
 }
 
 /** \brief Function for testing the fully assembled MEX robot manipulator.
@@ -323,8 +334,6 @@ void testMEXMovementSetting1(){
  *
  */
 void testMEXMovementSetting2(){
-    unsigned short speed = 2;
-    unsigned short acceleration = 200;
     // Define the port name and the baud rate
    	#ifdef _WIN32
    		const char* portName = "COM5";  		// Windows
@@ -336,6 +345,20 @@ void testMEXMovementSetting2(){
     // Open connection to COM port.
     conn.openConnection();
 
+    testMEXMovementSetting2(conn);
+
+    // Close the serial Connection
+    conn.closeConnection();
+}
+
+/** \brief Motion of testMEXMovementSetting2() on an opened connection,
+ *  e.g. one to a MaestroSimulator (see benchmarks/MexBench.cpp).
+ *
+ */
+void testMEXMovementSetting2(Pololu &conn){
+    unsigned short speed = 2;
+    unsigned short acceleration = 200;
+
     // Define the servos of the robot manipulator
     ServoMotor arm_0(1, 6240, 3600, &conn);
     ServoMotor arm_1(2, 6560, 3600, &conn);
@@ -438,10 +461,6 @@ void testMEXMovementSetting2(){
     arm_2.setPositionInAbs(arm_2.getMidPosInAbs());
     arm_3.setPositionInAbs(arm_3.getMinPosInAbs());
     while(conn.getMovingState());
-
-
-    // Close the serial Connection
-    conn.closeConnection();
 }
 
 void testSerialCom(){
@@ -7,12 +7,18 @@
 #ifndef TESTUNITS_HPP_
 #define TESTUNITS_HPP_
 
+class IClock;
+class Pololu;
+
+void setTestClock(IClock *clock);
 void wait(unsigned long milliseconds);
 void testSerialCom ();
 void testPololu ();
 void testOpenClose ();
 void testSetGetMethods ();
 void testMEXMovementSetting1 ();
+void testMEXMovementSetting1 (Pololu &conn);
 void testMEXMovementSetting2 ();
+void testMEXMovementSetting2 (Pololu &conn);
 
 #endif /* TESTUNITS_HPP_ */
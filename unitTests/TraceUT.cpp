@@ -0,0 +1,263 @@
+/*
+ * TraceUT.cpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+
+#include <string>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <set>
+#include <cstring>
+#include "../SimplUnitTestFW.hpp"
+#include "../Trace.hpp"
+#include "../ServoMotor.hpp"
+#include "../Pololu.hpp"
+#include "../MaestroSimulator.hpp"
+#include "TraceUT.hpp"
+
+using namespace std;
+
+namespace UT_Trace{
+
+bool execUnitTests(string xmlFilename){
+
+	// a unit a class
+	UnitTest unit("Trace");
+
+	// a unit for each method
+	TestSuite TS01("Tracer");
+	TestSuite TS02("instrumentation");
+
+	// add all test suits to the unit
+	unit.addTestItem(&TS01);
+	unit.addTestItem(&TS02);
+
+	//
+	// test cases for test suite TS01
+	//
+	TC11 tc11("TraceSpan - nesting and correlation ids");
+	TC12 tc12("Tracer - per thread buffers and overflow");
+	TC13 tc13("Tracer - Chrome trace JSON");
+
+	// add specific test cases to test suite TS01
+	TS01.addTestItem(&tc11);
+	TS01.addTestItem(&tc12);
+	TS01.addTestItem(&tc13);
+
+	//
+	// test cases for test suite TS02
+	//
+	TC21 tc21("MEX_TRACE_SPAN - spans through ServoMotor, Pololu and SerialCom");
+
+	// add specific test cases to test suite TS02
+	TS02.addTestItem(&tc21);
+
+	// execute unit tests
+	unit.testExecution();
+	unit.writeResultsToFile(xmlFilename);
+
+	return unit.getResult();
+}
+
+
+static const TraceEvent* find(const vector<TraceEvent> &events, const char *name){
+	for(size_t i = 0; i < events.size(); i++){
+		if(strcmp(events[i].name, name) == 0){
+			return &events[i];
+		}
+	}
+	return nullptr;
+}
+
+
+bool TC11::testRun(){ // TraceSpan - nesting and correlation ids
+	cout << ".";
+	bool result = true;
+	Tracer::clear();
+
+	// nothing is recorded while the tracer is disabled
+	{
+		TraceSpan off("off");
+	}
+	if(Tracer::getEventCount() != 0){
+		result = false;
+	}
+
+	Tracer::setEnabled(true);
+	unsigned long long outerId, innerId, nextId;
+	{
+		TraceSpan outer("outer", 7);
+		{
+			TraceSpan inner("inner");
+			innerId = inner.getId();
+		}
+		outerId = outer.getId();
+		if(Tracer::currentId() != outerId){
+			result = false;
+		}
+	}
+	if(Tracer::currentId() != 0){
+		result = false;
+	}
+	{
+		TraceSpan next("next");
+		nextId = next.getId();
+	}
+	Tracer::setEnabled(false);
+
+	vector<TraceEvent> events = Tracer::snapshot();
+	const TraceEvent *outer = find(events, "outer");
+	const TraceEvent *inner = find(events, "inner");
+	if((events.size() != 3) || (outer == nullptr) || (inner == nullptr)){
+		return false;
+	}
+	if((outerId == 0) || (innerId != outerId) || (nextId == outerId) || (outer->arg != 7)){
+		result = false;
+	}
+	// the inner span lies within the outer one
+	if((inner->startNs < outer->startNs) || (inner->startNs + inner->durNs > outer->startNs + outer->durNs)){
+		result = false;
+	}
+	Tracer::clear();
+	return result;
+}
+
+
+bool TC12::testRun(){ // Tracer - per thread buffers and overflow
+	cout << ".";
+	bool result = true;
+	Tracer::clear();
+	Tracer::setEnabled(true);
+
+	vector<std::thread> threads;
+	for(unsigned t = 0; t < 4; t++){
+		threads.push_back(std::thread([](){
+			for(unsigned i = 0; i < 1000; i++){
+				TraceSpan span("worker", i);
+			}
+		}));
+	}
+	for(size_t t = 0; t < threads.size(); t++){
+		threads[t].join();
+	}
+
+	vector<TraceEvent> events = Tracer::snapshot();
+	set<unsigned> tids;
+	set<unsigned long long> ids;
+	for(size_t i = 0; i < events.size(); i++){
+		tids.insert(events[i].tid);
+		ids.insert(events[i].id);
+	}
+	// every span of a worker is an outermost span with its own id
+	if((events.size() != 4000) || (tids.size() != 4) || (ids.size() != 4000)){
+		result = false;
+	}
+
+	// a full buffer drops and counts
+	Tracer::clear();
+	for(unsigned i = 0; i < MEX_TRACE_CAPACITY + 10; i++){
+		TraceSpan span("fill");
+	}
+	Tracer::setEnabled(false);
+	if((Tracer::getEventCount() != MEX_TRACE_CAPACITY) || (Tracer::getDropped() != 10)){
+		result = false;
+	}
+	Tracer::clear();
+	return result;
+}
+
+
+bool TC13::testRun(){ // Tracer - Chrome trace JSON
+	cout << ".";
+	bool result = true;
+	Tracer::clear();
+	Tracer::setEnabled(true);
+	{
+		TraceSpan outer("Pololu::getPosition", 3);
+		TraceSpan inner("read");
+	}
+	Tracer::setEnabled(false);
+
+	stringstream json;
+	Tracer::writeChromeJson(json);
+	string s = json.str();
+	if((s.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[") != 0) ||
+			(s.find("\"name\":\"Pololu::getPosition\",\"cat\":\"mex\",\"ph\":\"X\",\"ts\":0.000") == string::npos) ||
+			(s.find("\"name\":\"read\"") == string::npos) ||
+			(s.find("\"arg\":3}}") == string::npos) ||
+			(s.find("\n]}") == string::npos)){
+		result = false;
+	}
+
+	try{
+		Tracer::writeChromeJson(string("/nonexistent/trace.json"));
+		result = false;
+	}catch(IException *e){
+		delete e;
+	}
+	Tracer::clear();
+	return result;
+}
+
+
+bool TC21::testRun(){ // MEX_TRACE_SPAN - spans through ServoMotor, Pololu and SerialCom
+	cout << ".";
+	bool result = true;
+	Tracer::clear();
+	try{
+		MaestroSimulator sim(6);
+		MaestroPty pty(&sim);
+		pty.start();
+		Pololu pololu(pty.getPortName(), 9600);
+		pololu.openConnection();
+		ServoMotor servo(1, 6000, 3600, &pololu);
+
+		Tracer::setEnabled(true);
+		servo.setPositionInDeg(10);
+		servo.getPositionInAbs();
+		Tracer::setEnabled(false);
+
+		pololu.closeConnection();
+		pty.stop();
+	}catch(IException *e){
+		Tracer::setEnabled(false);
+		cout << e->getMsg() << endl;
+		return false;
+	}
+
+	vector<TraceEvent> events = Tracer::snapshot();
+#ifdef MEX_TRACE
+	const TraceEvent *setDeg = find(events, "ServoMotor::setPositionInDeg");
+	const TraceEvent *getAbs = find(events, "ServoMotor::getPositionInAbs");
+	const char *setChain[] = {"Pololu::setPosition", "SerialCom::writeSerialCom", "SerialCom::sendSerialCom", "writev"};
+	const char *getChain[] = {"Pololu::getPosition", "SerialCom::receiveSerialCom", "poll", "read"};
+	if((setDeg == nullptr) || (getAbs == nullptr) || (setDeg->id == getAbs->id) || (setDeg->arg != 1)){
+		result = false;
+	}else{
+		// the spans of the lower layers carry the id of the servo call
+		for(unsigned i = 0; i < 4; i++){
+			const TraceEvent *e = find(events, setChain[i]);
+			if((e == nullptr) || (e->id != setDeg->id)){
+				result = false;
+			}
+			e = find(events, getChain[i]);
+			if((e == nullptr) || (e->id != getAbs->id)){
+				result = false;
+			}
+		}
+	}
+#else
+	// compiled out: the instrumented code records nothing
+	if(!events.empty()){
+		result = false;
+	}
+#endif
+	Tracer::clear();
+	return result;
+}
+
+} // ende namespace UT_Trace
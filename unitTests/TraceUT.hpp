@@ -0,0 +1,51 @@
+/*
+ * TraceUT.hpp
+ *
+ *  Created on: 17.10.2026
+ *      Author: aml
+ */
+
+#ifndef UNITTESTS_TRACEUT_HPP_
+#define UNITTESTS_TRACEUT_HPP_
+
+
+#include "../SimplUnitTestFW.hpp"
+
+namespace UT_Trace{
+
+bool execUnitTests(string xmlFilename);
+
+
+class TC11 : public TestCase{
+	TC11() : TestCase(){};
+public:
+	TC11(string s = string("TraceSpan - nesting and correlation ids")) : TestCase(s){};
+	virtual bool testRun(); // TraceSpan - nesting and correlation ids
+};
+
+class TC12 : public TestCase{
+	TC12() : TestCase(){};
+public:
+	TC12(string s = string("Tracer - per thread buffers and overflow")) : TestCase(s){};
+	virtual bool testRun(); // Tracer - per thread buffers and overflow
+};
+
+class TC13 : public TestCase{
+	TC13() : TestCase(){};
+public:
+	TC13(string s = string("Tracer - Chrome trace JSON")) : TestCase(s){};
+	virtual bool testRun(); // Tracer - Chrome trace JSON
+};
+
+
+class TC21 : public TestCase{
+	TC21() : TestCase(){};
+public:
+	TC21(string s = string("MEX_TRACE_SPAN - spans through ServoMotor, Pololu and SerialCom")) : TestCase(s){};
+	virtual bool testRun(); // MEX_TRACE_SPAN - spans through ServoMotor, Pololu and SerialCom
+};
+
+} // ende namespace UT_Trace
+
+
+#endif /* UNITTESTS_TRACEUT_HPP_ */
@@ -6,6 +6,7 @@
  */
 
 #include "../SerialCom.hpp"
+#include "../SerialComRegistry.hpp"
 #include "../Pololu.hpp"
 #include "../ServoMotor.hpp"
 #include "./TestUnits.hpp"
@@ -13,25 +14,79 @@
 #include "./PololuUT.hpp"
 #include "./ServoMotorBaseUT.hpp"
 #include "./ServoMotorUT.hpp"
+#include "./PololuErrorsUT.hpp"
+#include "./RetryPolicyUT.hpp"
+#include "./SerialComURINGUT.hpp"
+#include "./SerialRxRingUT.hpp"
+#include "./PololuFramesUT.hpp"
+#include "./MiniSscUT.hpp"
+#include "./SerialComRegistryUT.hpp"
+#include "./SerialComSocketUT.hpp"
+#include "./SerialComFaultInjectorUT.hpp"
+#include "./SerialComSimUT.hpp"
+#include "./ServoModelUT.hpp"
+#include "./TraceUT.hpp"
+#include "./InstrumentUT.hpp"
+#include "./PololuStatsUT.hpp"
+#include "./BinLogUT.hpp"
+#include "./PerfCountersUT.hpp"
+#include "./TestFixtureUT.hpp"
+#include "./TestRunUT.hpp"
 
 using namespace std;
 
-int main(){
+int main(int argc, char* argv[]){
 
-	bool result, res1, res2, res3, res4;
+	// selection of units, suites and test cases, see TestRun::parse(...)
+	if(!TestRun::instance().parse(argc, argv, cerr)){
+		return 2;
+	}
+
+	bool result, res1, res2, res3, res4, res5, res6, res7, res8, res9, res10, res11, res12, res13, res14, res15, res16, res17, res18, res19, res20, res21, res22;
+
+	// the test cases create many Pololu instances for the same device,
+	// keep the connections open instead of reopening them for each one
+	SerialComRegistry::instance().setKeepIdle(true);
 
 	res1 = UT_SerialCom::execUnitTests("UT_SerialCom.xml");
 	res2 = UT_Pololu::execUnitTests("UT_Pololu.xml");
 	res3 = UT_ServoMotorBase::execUnitTests("UT_ServoMotorBase.xml");
 	res4 = UT_ServoMotor::execUnitTests("UT_ServoMotor.xml");
+	res5 = UT_PololuErrors::execUnitTests("UT_PololuErrors.xml");
+	res6 = UT_RetryPolicy::execUnitTests("UT_RetryPolicy.xml");
+	res7 = UT_SerialComURING::execUnitTests("UT_SerialComURING.xml");
+	res8 = UT_SerialRxRing::execUnitTests("UT_SerialRxRing.xml");
+	res9 = UT_PololuFrames::execUnitTests("UT_PololuFrames.xml");
+	res10 = UT_MiniSsc::execUnitTests("UT_MiniSsc.xml");
+	res11 = UT_SerialComRegistry::execUnitTests("UT_SerialComRegistry.xml");
+	res12 = UT_SerialComSocket::execUnitTests("UT_SerialComSocket.xml");
+	res13 = UT_SerialComFaultInjector::execUnitTests("UT_SerialComFaultInjector.xml");
+	res14 = UT_SerialComSim::execUnitTests("UT_SerialComSim.xml");
+	res15 = UT_ServoModel::execUnitTests("UT_ServoModel.xml");
+	res16 = UT_Trace::execUnitTests("UT_Trace.xml");
+	res17 = UT_Instrument::execUnitTests("UT_Instrument.xml");
+	res18 = UT_PololuStats::execUnitTests("UT_PololuStats.xml");
+	res19 = UT_BinLog::execUnitTests("UT_BinLog.xml");
+	res20 = UT_PerfCounters::execUnitTests("UT_PerfCounters.xml");
+	res21 = UT_TestFixture::execUnitTests("UT_TestFixture.xml");
+	res22 = UT_TestRun::execUnitTests("UT_TestRun.xml");
 
-	result = res1 && res2 && res3 && res4;
+	SerialComRegistry::instance().closeIdle();
+
+	result = res1 && res2 && res3 && res4 && res5 && res6 && res7 && res8 && res9 && res10 && res11 && res12 && res13 && res14 && res15 && res16 && res17 && res18 && res19 && res20 && res21 && res22;
+	if(TestRun::instance().isListing()){
+		return 0;
+	}
 	if(result){
 		cout << "\nAll units tests successfully passed.\n";
 	}else{
 		cout << "\nNOT all unit tests have been successfully passed. Check xml-files for detailed test results.\n";
 	}
+	if(TestRun::instance().getSkipped() > 0){
+		cout << TestRun::instance().getSkipped() << " test cases skipped, their resources are not available (--no-skip runs them).\n";
+	}
 
-	return 0;
+	// the exit status lets scripts and CI gate on the run
+	return result ? 0 : 1;
 }
 